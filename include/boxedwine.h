@@ -7,6 +7,7 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <map>
 #include <memory>
 #include <queue>
 #include <functional>
@@ -68,6 +69,7 @@
 #include "kpoll.h"
 #include "memory.h"
 #include "kthread.h"
+#include "../source/emulation/hardmmu/hard_memory.h"
 #include "kfilelock.h"
 #include "kobject.h"
 #include "kfiledescriptor.h"
@@ -28,5 +28,5 @@ void fbSetCaption(const char* title, const char* icon);
 void fbSwapOpenGL();
 void flipFBNoCheck();
 
-Page* allocFBPage(U32 flags);
+Page* allocFBPage(Memory* memory, U32 address, U32 flags);
 #endif
\ No newline at end of file
@@ -48,13 +48,30 @@ public:
     U32 ctl(U32 op, FD fd, U32 address);
     U32 wait(U32 events, U32 maxevents, U32 timeout);
 private:
-    class Data {
+    class Data : public KObjectWatcher {
     public:
+        Data(KEPoll* epoll) : epoll(epoll), fd(0), data(0), events(0), watched(false), node(this) {}
+        virtual void onObjectChanged();
+        KEPoll* epoll;
         U32 fd;
         U64 data;
         U32 events;
+        std::weak_ptr<KObject> object;
+        bool watched; // the object tells us when it changes, so it only needs to be checked when it is on readyList
+        KListNode<Data*> node; // in readyList if watched, otherwise always in polledList
     };
-    std::unordered_map<U32, Data*> data;
+    void setReady(Data* d);
+    void removeEntry(Data* d);
+    U32 getReadyEvents(Data* d);
+    void reportEntry(Data* d, U32 revents, U32 events, U32 index);
+    U32 getReadyWatchedEntries(U32 events, U32 maxevents);
+    U32 getReadyPolledEntries(U32 events, U32 maxevents, U32 result);
+
+    std::unordered_map<U32, Data*> data; // guarded by entriesMutex
+    BOXEDWINE_MUTEX entriesMutex;
+    KList<Data*> polledList; // entries that report an event are moved to the back so that others aren't starved, guarded by entriesMutex
+    KList<Data*> readyList; // watched entries that changed since they were last checked, guarded by readyCond
+    BOXEDWINE_CONDITION readyCond;
 };
 
 #endif
\ No newline at end of file
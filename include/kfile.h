@@ -40,7 +40,9 @@ public:
     virtual void waitForEvents(BOXEDWINE_CONDITION& parentCondition, U32 events);
     virtual U32  write(U32 buffer, U32 len);
     virtual U32  writeNative(U8* buffer, U32 len);
+    virtual U32  writev(U32 iov, S32 iovcnt);
     virtual U32  read(U32 buffer, U32 len);
+    virtual U32  readv(U32 iov, S32 iovcnt);
     virtual U32  readNative(U8* buffer, U32 len);
     virtual U32  stat(U32 address, bool is64);
     virtual U32  map(U32 address, U32 len, S32 prot, S32 flags, U64 off);
@@ -48,6 +50,9 @@ public:
 
     U32 pwrite(U32 buffer, S64 offset, U32 len);
     U32 pread(U32 buffer,S64 offset,  U32 len);
+    U32 preadNative(U8* buffer, S64 offset, U32 len);
+    U32 pwritev(U32 iov, S32 iovcnt, S64 offset);
+    U32 preadv(U32 iov, S32 iovcnt, S64 offset);
 
     FsOpenNode* openFile;
 
@@ -25,6 +25,16 @@
 #define KTYPE_EPOLL 3
 #define KTYPE_SIGNAL 4
 
+// the most iovec entries readv, writev, preadv and pwritev will take
+#define K_UIO_MAXIOV 1024
+
+class KObjectWatcher {
+public:
+    virtual ~KObjectWatcher() {}
+    // called with the object locked, so this shouldn't call back into the object
+    virtual void onObjectChanged()=0;
+};
+
 class KObject : public std::enable_shared_from_this<KObject> {
 protected:
     KObject(U32 type);
@@ -49,10 +59,15 @@ public:
     virtual U32  writeNative(U8* buffer, U32 len)=0;
     virtual U32  writev(U32 iov, S32 iovcnt);
     virtual U32  read(U32 buffer, U32 len);
+    virtual U32  readv(U32 iov, S32 iovcnt);
     virtual U32  readNative(U8* buffer, U32 len)=0;
     virtual U32  stat(U32 address, bool is64)=0;
     virtual U32  map(U32 address, U32 len, S32 prot, S32 flags, U64 off)=0;
     virtual bool canMap()=0;
+    // epoll keeps a ready list for objects that tell their watchers every time they get new data, more room to write or
+    // their state changes.  The others return false and are checked on every epoll_wait.
+    virtual bool addWatcher(KObjectWatcher* watcher) {return false;}
+    virtual void removeWatcher(KObjectWatcher* watcher) {}
 
     U32 type;
     U32 pid;
@@ -35,6 +35,7 @@ public:
     BoxedPtr<MappedFileCache> systemCacheEntry;
 #endif
     std::shared_ptr<KFile> file;
+    std::string path; // of the file when it was mapped
     U32 address;
     U64 len;
     U64 offset;
@@ -112,6 +113,8 @@ public:
     U32 getNextFileDescriptorHandle(int after);
 
     std::string getModuleName(U32 eip);
+    std::string getModulePath(U32 eip);
+    BoxedPtr<MappedFile> getMappedFile(U32 eip); // caller must hold mappedFilesMutex
     U32 getModuleEip(U32 eip);    
     KFileDescriptor* allocFileDescriptor(const std::shared_ptr<KObject>& kobject, U32 accessFlags, U32 descriptorFlags, S32 handle, U32 afterHandle);
     KFileDescriptor* getFileDescriptor(FD handle);
@@ -184,7 +187,10 @@ public:
     U32 prctl(U32 option, U32 arg2);
     U32 pread64(FD fildes, U32 address, U32 len, U64 offset);
     U32 pwrite64(FD fildes, U32 address, U32 len, U64 offset);
+    U32 preadv(FD fildes, U32 iov, S32 iovcnt, U64 offset);
+    U32 pwritev(FD fildes, U32 iov, S32 iovcnt, U64 offset);
     U32 read(FD fildes, U32 bufferAddress, U32 bufferLen);
+    U32 readv(FD handle, U32 iov, S32 iovcnt);
     U32 readlink(const std::string& path, U32 buffer, U32 bufSize);
     U32 readlinkat(FD dirfd, const std::string& path, U32 buf, U32 bufsiz);
     U32 rename(const std::string& from, const std::string& to);
@@ -281,7 +287,7 @@ private:
     std::unordered_map<U32, BoxedPtr<AttachedSHM> > attachedShm; // key is attached address
     BOXEDWINE_MUTEX attachedShmMutex;
 
-    std::unordered_map<U32, BoxedPtr<MappedFile> > mappedFiles; // key is address
+    std::map<U32, BoxedPtr<MappedFile> > mappedFiles; // key is address, ordered so that getMappedFile doesn't scan
     BOXEDWINE_MUTEX mappedFilesMutex;
 
     std::unordered_map<U32, KThread*> threads;
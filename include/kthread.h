@@ -39,6 +39,7 @@ public:
 
 class KProcess;
 class Memory;
+class KFutexWaiter;
 
 class KThreadGlContext {
 public:
@@ -71,7 +72,7 @@ public:
     void setTLS(struct user_desc* desc);
 
     // syscalls
-    U32 futex(U32 addr, U32 op, U32 value, U32 pTime) ;
+    U32 futex(U32 addr, U32 op, U32 value, U32 pTime, U32 addr2, U32 value3);
     U32 modify_ldt(U32 func, U32 ptr, U32 count);
     U32 signalstack(U32 ss, U32 oss);
     U32 sigprocmask(U32 how, U32 set, U32 oset, U32 sigsetSize);
@@ -146,6 +147,7 @@ public:
     U32 condStartWaitTime;
 private:
     void clearFutexes();
+    U32 futexWait(U32 addr, U8* ramAddress, U32 value, U32 pTime, U32 op, U32 bitset);
 
 #ifdef BOXEDWINE_BINARY_TRANSLATOR
     THREAD_LOCAL
@@ -153,11 +155,10 @@ private:
     static KThread* runningThread;
 
     BOXEDWINE_CONDITION sleepCond;      
+    KFutexWaiter* futexWaiter;
 
     struct user_desc tls[TLS_ENTRIES];
     BOXEDWINE_MUTEX tlsMutex;
-
-    static BOXEDWINE_MUTEX futexesMutex;
 };
 
 class ChangeThread {
@@ -19,15 +19,17 @@
 #ifndef __KTIMER_H__
 #define __KTIMER_H__
 
+#define K_TIMER_NOT_QUEUED 0xFFFFFFFF
+
 class KTimer {
 public:
-    KTimer() : node(this), millies(0), resetMillies(0), active(false) {}
+    KTimer() : heapIndex(K_TIMER_NOT_QUEUED), millies(0), resetMillies(0), active(false) {}
     ~KTimer();
 
-    virtual bool run()=0; // return true of the timer should be removed, don't remove a timer manually in run because it will invalidate the iterator
+    virtual bool run()=0; // return true if the timer should be removed, if it isn't removed it will be queued again using millies
 
-    KListNode<KTimer*> node;
-	U32 millies;
+    U32 heapIndex; // position in the scheduler's timer heap
+	U32 millies; // don't change this while the timer is active without calling addTimer again
 	U32 resetMillies;
 	bool active;
 };
@@ -3,6 +3,7 @@
 
 #include "ksocketmsg.h"
 #include "ksocketobject.h"
+#include "../source/util/kringbuffer.h"
 
 class KUnixSocketObject : public KSocketObject {
 public:
@@ -31,6 +32,8 @@ public:
     virtual U32  stat(U32 address, bool is64);
     virtual U32  map(U32 address, U32 len, S32 prot, S32 flags, U64 off);
     virtual bool canMap();
+    virtual bool addWatcher(KObjectWatcher* watcher);
+    virtual void removeWatcher(KObjectWatcher* watcher);
 
     virtual U32 accept(KFileDescriptor* fd, U32 address, U32 len, U32 flags);
     virtual U32 bind(KFileDescriptor* fd, U32 address, U32 len);
@@ -56,8 +59,10 @@ private:
     std::weak_ptr<KUnixSocketObject> connecting;
 
     BOXEDWINE_CONDITION lockCond;
+    std::vector<KObjectWatcher*> watchers; // guarded by lockCond
+    void notifyWatchers(); // lockCond must be held
 
-    std::deque<S8> recvBuffer;
+    KRingBuffer recvBuffer;
     std::queue<std::shared_ptr<KSocketMsg> > msgs;
 
     U32 internal_write(const std::shared_ptr<KUnixSocketObject>& con, BOXEDWINE_CONDITION& cond, U32 buffer, U32 len);
@@ -20,6 +20,8 @@
 #define __MEMORY_H__
 
 class KFile;
+class NativeMemoryFile;
+class NativeFileMapping;
 
 class MappedFileCache : public BoxedPtrBase {
 public:
@@ -83,6 +85,7 @@ typedef void (OPCALL *OpCallback)(CPU* cpu, DecodedOp* op);
 class Memory {
 public:   
     Memory();
+    Memory(Memory* from); // starts as a copy of from, like the memory of a forked process
     ~Memory();
 
     void log_pf(KThread* thread, U32 address);
@@ -146,7 +149,13 @@ public:
 
     // this will contain id in each page unless that page was mapped to native host memory
     U64 memOffsets[K_NUMBER_OF_PAGES];
+    // set when the platform backs the emulated memory with a file, fork can then share the pages copy-on-write
+    std::shared_ptr<NativeMemoryFile> nativeMemoryFile;
+    // parts of the emulated memory that are mapped directly from a host file, key is the first native page
+    std::map<U32, std::shared_ptr<NativeFileMapping> > nativeFileMappings;
 #define MAX_DYNAMIC_CODE_PAGE_COUNT 0xFF
+// a write to a code page that misses the translated bytes counts this many times less towards MAX_DYNAMIC_CODE_PAGE_COUNT
+#define CODE_PAGE_DATA_WRITES_PER_UPDATE 64
     U8 dynamicCodePageUpdateCount[K_NATIVE_NUMBER_OF_PAGES];
 
 #ifdef BOXEDWINE_BINARY_TRANSLATOR
@@ -158,8 +167,30 @@ private:
 
     std::unordered_map<U32, std::shared_ptr< std::list< std::shared_ptr<BtCodeChunk> > >> codeChunksByHostPage;
     std::unordered_map<U32, std::shared_ptr< std::list< std::shared_ptr<BtCodeChunk> > >> codeChunksByEmulationPage;
+    // where each live chunk sits in the two lists above, so that removing it doesn't walk every chunk on the page
+    class CodeChunkPosition {
+    public:
+        std::list< std::shared_ptr<BtCodeChunk> >::iterator hostPagePos;
+        std::list< std::shared_ptr<BtCodeChunk> >::iterator emulationPagePos;
+    };
+    std::unordered_map<BtCodeChunk*, CodeChunkPosition> codeChunkPositions;
 
     std::list<void*> freeExecutableMemory[EXECUTABLE_SIZES];
+
+    // one bit per byte of an emulated page that is covered by translated code
+    class TranslatedBytes {
+    public:
+        TranslatedBytes() : overlapped(false) {memset(this->bits, 0, sizeof(this->bits));}
+        U64 bits[K_PAGE_SIZE / 64];
+        // two chunks share bytes on this page, so bits are only dropped with the whole page
+        bool overlapped;
+    };
+    std::unordered_map<U32, std::shared_ptr<TranslatedBytes> > translatedBytesByEmulationPage;
+    // writes into a code page that missed the translated bytes, per native page
+    std::unordered_map<U32, U32> codePageDataWrites;
+
+    void setTranslatedBytes(U32 address, U32 len, bool translated);
+    void codePageUpdated(U32 nativePage);
 public:
     std::shared_ptr<BtCodeChunk> getCodeChunkContainingHostAddress(void* hostAddress);
     void invalideHostCode(U32 eip, U32 len);
@@ -173,6 +204,14 @@ public:
     void executableMemoryReleased();
     bool isAddressExecutable(void* address);
 
+    bool isTranslatedCode(U32 address, U32 len);
+
+    // number of times the op at each eip faulted on a PAGE_MAPPED_HOST page
+    std::unordered_map<U32, U32> mappedHostFaults;
+    // number of times the op at each eip faulted writing to a page with translated code
+    std::unordered_map<U32, U32> codePageWriteFaults;
+    BOXEDWINE_MUTEX opFaultsMutex; // guards mappedHostFaults and codePageWriteFaults
+
     class AllocatedMemory {
     public:
         AllocatedMemory(void* memory, U32 size) : memory(memory), size(size) {}
@@ -54,6 +54,7 @@
 #define THREAD_LOCAL __declspec(thread)
 #define PLATFORM_STAT_STRUCT struct _stat32i64
 #define PLATFORM_STAT _stat32i64
+#define PLATFORM_FSTAT _fstat32i64
 #define OPCALL __fastcall
 #define unlink _unlink
 #define ftruncate(h, l) _chsize(h, (long)l)
@@ -79,6 +80,7 @@
 #endif
 #define PLATFORM_STAT_STRUCT struct stat
 #define PLATFORM_STAT stat
+#define PLATFORM_FSTAT fstat
 #define OPCALL
 #define platform_getcwd getcwd
 #define UNISTD <unistd.h>
@@ -128,6 +130,7 @@ public:
     static void setCurrentThreadPriorityHigh();
     static void writeCodeToMemory(void* address, U32 len, std::function<void()> callback);
     static U32 nanoSleep(U64 nano);
+    static std::string getExecutableFilePath();
 
 #ifdef BOXEDWINE_MULTI_THREADED
     static void setCpuAffinityForThread(KThread* thread, U32 count);
@@ -174,6 +177,8 @@ bool platformHasBMI2();
 
 #ifdef BOXEDWINE_MULTI_THREADED
 void ATOMIC_WRITE64(U64* pTarget, U64 value);
+// returns the value that was in pTarget, value was only stored if that is the same as expected
+U32 ATOMIC_COMPARE_EXCHANGE32(U32* pTarget, U32 expected, U32 value);
 #endif
 
 #ifdef BOXEDWINE_MIDI
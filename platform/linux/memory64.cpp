@@ -26,6 +26,13 @@
 U32 nativeMemoryPagesAllocated;
 
 #ifdef BOXEDWINE_64BIT_MMU
+#ifdef BOXEDWINE_MEMFD_MEMORY
+#include <fcntl.h>
+#include <sys/stat.h>
+
+static void removeNativeFileMappings(Memory* memory, U32 nativePage, U32 nativePageCount, bool restore);
+#endif
+
 void updateNativePermission(Memory* memory, U32 nativePage, U32 nativePageCount, bool canRead, bool canWrite) {
     U32 proto = 0;
     if (canRead) {
@@ -68,6 +75,11 @@ void allocNativeMemory(Memory* memory, U32 page, U32 pageCount, U32 flags) {
     if (flags & PAGE_WRITE) {
         proto|=PROT_WRITE;
     }
+#ifdef BOXEDWINE_MEMFD_MEMORY
+    if (memory->nativeFileMappings.size()) {
+        removeNativeFileMappings(memory, nativePageStart, nativePageCount, true);
+    }
+#endif
     void* p = (char*)memory->id + (nativePageStart << K_NATIVE_PAGE_SHIFT);
     if (mprotect(p, nativePageCount << K_NATIVE_PAGE_SHIFT, PROT_READ | PROT_WRITE)<0) {
         kpanic("allocNativeMemory mprotect failed: %s", strerror(errno));
@@ -115,6 +127,11 @@ void freeNativeMemory(Memory* memory, U32 page, U32 pageCount) {
             }
         }
         if (canClear) {
+#ifdef BOXEDWINE_MEMFD_MEMORY
+            if (memory->nativeFlags[nativePageStart+i] & NATIVE_FLAG_FILE_MAPPED) {
+                removeNativeFileMappings(memory, nativePageStart+i, 1, true);
+            }
+#endif
             if (memory->nativeFlags[nativePageStart+i] & NATIVE_FLAG_CODEPAGE_READONLY) {
                 memory->nativeFlags[nativePageStart+i] &= ~ NATIVE_FLAG_CODEPAGE_READONLY;
             }
@@ -245,8 +262,286 @@ static void* reserveNext32GBMemory() {
     return p;
 }
 
-void reserveNativeMemory(Memory* memory) {
+#ifdef BOXEDWINE_MEMFD_MEMORY
+#define PAGEMAP_PRESENT (1ull << 63)
+#define PAGEMAP_SWAPPED (1ull << 62)
+#define PAGEMAP_FILE (1ull << 61)
+#define PAGEMAP_BATCH 512
+#define NATIVE_PROTECTION_FILE_MAPPED 0xFFFFFFFF
+#define NATIVE_FILE_READAHEAD_PAGES 16
+#define NATIVE_FILE_READ_CHUNK (1024 * 1024)
+
+// The emulated memory of a process is a shared mapping of a memfd.  On the first fork both the parent and the child
+// remap it private, after that nothing writes to the file anymore and the host kernel takes care of copy-on-write.
+class NativeMemoryFile {
+public:
+    NativeMemoryFile(int fd) : fd(fd), frozen(false) {}
+    ~NativeMemoryFile() {
+        close(this->fd);
+    }
+    const int fd;
+    bool frozen;
+    BOXEDWINE_MUTEX mutex;
+};
+
+static BOXEDWINE_MUTEX nativeFileHandlesMutex;
+
+// One host descriptor per file, shared by every mapping of that file in every process, so that mapping all the dlls
+// of a dozen processes doesn't use up the host's descriptors.
+//
+// A file that the host can't map but whose content can never change, like a file in a zip, gets a memfd instead.  Its
+// pages are read into the memfd the first time any process maps them and every later mapping shares them.
+class NativeFileHandle {
+public:
+    NativeFileHandle(const std::string& key, int fd, bool writable) : key(key), fd(fd), writable(writable) {}
+    NativeFileHandle(const std::string& key, int fd, const BoxedPtr<FsNode>& fixedContentNode, U32 pageCount) : key(key), fd(fd), writable(false), fixedContentNode(fixedContentNode), loadedPages(pageCount, false) {}
+    ~NativeFileHandle();
+    const std::string key;
+    const int fd;
+    const bool writable;
+    const BoxedPtr<FsNode> fixedContentNode;
+    std::vector<bool> loadedPages;
+    BOXEDWINE_MUTEX loadedPagesMutex;
+};
+
+static std::unordered_map<std::string, std::weak_ptr<NativeFileHandle> > nativeFileHandles;
+
+NativeFileHandle::~NativeFileHandle() {
+    close(this->fd);
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(nativeFileHandlesMutex);
+    auto it = nativeFileHandles.find(this->key);
+    if (it != nativeFileHandles.end() && it->second.expired()) {
+        nativeFileHandles.erase(it);
+    }
+}
+
+class NativeFileMapping {
+public:
+    NativeFileMapping(const std::shared_ptr<NativeFileHandle>& file, U32 nativePageCount, U64 offset, bool shared) : file(file), nativePageCount(nativePageCount), offset(offset), shared(shared) {}
+    const std::shared_ptr<NativeFileHandle> file;
+    const U32 nativePageCount;
+    const U64 offset; // offset in the file of the first page
+    const bool shared;
+};
+
+static std::shared_ptr<NativeFileHandle> getNativeFileHandle(const std::string& key, int handle, const struct stat& handleStat, bool writable) {
+    std::shared_ptr<NativeFileHandle> existing; // released outside the lock, its destructor takes the lock
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(nativeFileHandlesMutex);
+    auto it = nativeFileHandles.find(key);
+    if (it != nativeFileHandles.end()) {
+        existing = it->second.lock();
+        struct stat existingStat;
+        // the path might have been replaced by a different file since it was last mapped
+        if (existing && !existing->fixedContentNode && (existing->writable || !writable) && !fstat(existing->fd, &existingStat) && existingStat.st_dev == handleStat.st_dev && existingStat.st_ino == handleStat.st_ino) {
+            return existing;
+        }
+    }
+    int fd = fcntl(handle, F_DUPFD_CLOEXEC, 0);
+    if (fd < 0) {
+        return NULL;
+    }
+    std::shared_ptr<NativeFileHandle> result = std::make_shared<NativeFileHandle>(key, fd, writable);
+    nativeFileHandles[key] = result;
+    return result;
+}
+
+static std::shared_ptr<NativeFileHandle> getFixedContentFileHandle(FsOpenNode* openFile, U64 size) {
+    std::shared_ptr<NativeFileHandle> existing; // released outside the lock, its destructor takes the lock
+    const std::string& key = openFile->node->path;
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(nativeFileHandlesMutex);
+    auto it = nativeFileHandles.find(key);
+    if (it != nativeFileHandles.end()) {
+        existing = it->second.lock();
+        if (existing && existing->fixedContentNode == openFile->node) {
+            return existing;
+        }
+    }
+    int fd = memfd_create("boxedwine-file", MFD_CLOEXEC);
+    if (fd < 0) {
+        return NULL;
+    }
+    if (ftruncate(fd, size)) {
+        close(fd);
+        return NULL;
+    }
+    std::shared_ptr<NativeFileHandle> result = std::make_shared<NativeFileHandle>(key, fd, openFile->node, (U32)((size + K_PAGE_SIZE - 1) >> K_PAGE_SHIFT));
+    nativeFileHandles[key] = result;
+    return result;
+}
+
+// reads the pages that haven't been read yet, plus a few after them since the next section of a dll is usually mapped
+// next and going backwards in a compressed file means starting over
+static bool loadFixedContentPages(const std::shared_ptr<NativeFileHandle>& nativeFile, const std::shared_ptr<KFile>& file, U32 firstPage, U32 pageCount) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(nativeFile->loadedPagesMutex);
+    U32 filePageCount = (U32)nativeFile->loadedPages.size();
+    U32 lastPage = firstPage + pageCount;
+    std::vector<U8> buffer;
+
+    for (U32 page=firstPage;page<lastPage;) {
+        if (nativeFile->loadedPages[page]) {
+            page++;
+            continue;
+        }
+        U32 runEnd = page + 1;
+        while (runEnd < filePageCount && runEnd < lastPage + NATIVE_FILE_READAHEAD_PAGES && !nativeFile->loadedPages[runEnd]) {
+            runEnd++;
+        }
+        U64 pos = ((U64)page) << K_PAGE_SHIFT;
+        U64 end = ((U64)runEnd) << K_PAGE_SHIFT;
+        buffer.resize((size_t)std::min(end - pos, (U64)NATIVE_FILE_READ_CHUNK));
+        while (pos < end) {
+            U32 todo = (U32)std::min(end - pos, (U64)buffer.size());
+            U32 read = file->preadNative(buffer.data(), pos, todo);
+            if (read == 0 || read > todo) {
+                break; // end of file, the rest of the page stays 0
+            }
+            if (pwrite(nativeFile->fd, buffer.data(), read, pos) != (ssize_t)read) {
+                return false;
+            }
+            pos += read;
+        }
+        for (U32 i=page;i<runEnd;i++) {
+            nativeFile->loadedPages[i] = true;
+        }
+        page = runEnd;
+    }
+    return true;
+}
+
+static void restoreNativeMemory(Memory* memory, U32 nativePage, U32 nativePageCount) {
+    void* p = (char*)memory->id + (((U64)nativePage) << K_NATIVE_PAGE_SHIFT);
+    U64 len = ((U64)nativePageCount) << K_NATIVE_PAGE_SHIFT;
+    void* result;
+
+    if (memory->nativeMemoryFile) {
+        result = mmap(p, len, PROT_NONE, (memory->nativeMemoryFile->frozen ? MAP_PRIVATE : MAP_SHARED) | MAP_FIXED, memory->nativeMemoryFile->fd, ((U64)nativePage) << K_NATIVE_PAGE_SHIFT);
+    } else {
+        result = mmap(p, len, PROT_NONE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_FIXED, -1, 0);
+    }
+    if (result == MAP_FAILED) {
+        kpanic("restoreNativeMemory mmap failed: %s", strerror(errno));
+    }
+}
+
+// forgets the host file mappings in this range, if restore is true the range is mapped back to the process's memory
+// with no access, otherwise the caller is about to map something else there
+static void removeNativeFileMappings(Memory* memory, U32 nativePage, U32 nativePageCount, bool restore) {
+    U32 end = nativePage + nativePageCount;
+    auto it = memory->nativeFileMappings.upper_bound(nativePage);
+
+    if (it != memory->nativeFileMappings.begin()) {
+        --it;
+        if (it->first + it->second->nativePageCount <= nativePage) {
+            ++it;
+        }
+    }
+    while (it != memory->nativeFileMappings.end() && it->first < end) {
+        U32 mappingStart = it->first;
+        U32 mappingEnd = mappingStart + it->second->nativePageCount;
+        std::shared_ptr<NativeFileMapping> mapping = it->second;
+
+        it = memory->nativeFileMappings.erase(it);
+        if (mappingStart < nativePage) {
+            memory->nativeFileMappings[mappingStart] = std::make_shared<NativeFileMapping>(mapping->file, nativePage - mappingStart, mapping->offset, mapping->shared);
+        }
+        if (mappingEnd > end) {
+            memory->nativeFileMappings[end] = std::make_shared<NativeFileMapping>(mapping->file, mappingEnd - end, mapping->offset + (((U64)(end - mappingStart)) << K_NATIVE_PAGE_SHIFT), mapping->shared);
+        }
+        U32 removedStart = std::max(mappingStart, nativePage);
+        U32 removedEnd = std::min(mappingEnd, end);
+        for (U32 i=removedStart;i<removedEnd;i++) {
+            memory->nativeFlags[i] &= ~NATIVE_FLAG_FILE_MAPPED;
+        }
+        if (restore) {
+            restoreNativeMemory(memory, removedStart, removedEnd - removedStart);
+        }
+    }
+}
+
+static U32 getNativeProtection(Memory* memory, U32 nativePage) {
+    if (memory->nativeFlags[nativePage] & NATIVE_FLAG_FILE_MAPPED) {
+        return NATIVE_PROTECTION_FILE_MAPPED;
+    }
+    if (!(memory->nativeFlags[nativePage] & NATIVE_FLAG_COMMITTED)) {
+        return PROT_NONE;
+    }
+    if (memory->nativeFlags[nativePage] & NATIVE_FLAG_CODEPAGE_READONLY) {
+        return PROT_READ;
+    }
+    return PROT_READ | PROT_WRITE;
+}
+
+// one mmap per run of pages with the same protection, so the parent's other threads never see a page with the wrong
+// protection while its memory is being remapped.  Pages mapped from a host file are left alone.
+static void mapNativeMemoryFilePrivate(Memory* memory, int fd) {
+    U32 runStart = 0;
+    U32 runProtection = getNativeProtection(memory, 0);
+
+    for (U32 i=1;i<=K_NATIVE_NUMBER_OF_PAGES;i++) {
+        if (i<K_NATIVE_NUMBER_OF_PAGES && getNativeProtection(memory, i) == runProtection) {
+            continue;
+        }
+        U64 offset = ((U64)runStart) << K_NATIVE_PAGE_SHIFT;
+        U64 len = ((U64)(i - runStart)) << K_NATIVE_PAGE_SHIFT;
+        if (runProtection != NATIVE_PROTECTION_FILE_MAPPED && mmap((char*)memory->id + offset, len, runProtection, MAP_PRIVATE|MAP_FIXED, fd, offset)==MAP_FAILED) {
+            kpanic("mapNativeMemoryFilePrivate mmap failed: %s", strerror(errno));
+        }
+        if (i<K_NATIVE_NUMBER_OF_PAGES) {
+            runStart = i;
+            runProtection = getNativeProtection(memory, i);
+        }
+    }
+}
+
+// Pages written by a process after they were mapped private are anonymous pages of its mapping, /proc/self/pagemap
+// tells them apart from the pages that still come from the file.  Of the pages with nativeFlag set, those are the only
+// ones the child needs a copy of.
+static void copyPrivateNativePages(Memory* memory, Memory* from, U8 nativeFlag) {
+    int pagemap = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+    U64 entries[PAGEMAP_BATCH];
+
+    for (U32 batch=0;batch<K_NATIVE_NUMBER_OF_PAGES;batch+=PAGEMAP_BATCH) {
+        bool found = false;
+        for (U32 i=0;i<PAGEMAP_BATCH;i++) {
+            if (from->nativeFlags[batch+i] & nativeFlag) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            continue;
+        }
+        bool hasEntries = pagemap>=0 && pread(pagemap, entries, sizeof(entries), ((from->id >> K_NATIVE_PAGE_SHIFT) + batch) * sizeof(U64))==sizeof(entries);
+        for (U32 i=0;i<PAGEMAP_BATCH;i++) {
+            if (!(from->nativeFlags[batch+i] & nativeFlag)) {
+                continue;
+            }
+            if (hasEntries && (!(entries[i] & (PAGEMAP_PRESENT | PAGEMAP_SWAPPED)) || (entries[i] & PAGEMAP_FILE))) {
+                continue;
+            }
+            U64 offset = ((U64)(batch+i)) << K_NATIVE_PAGE_SHIFT;
+            memcpy((char*)memory->id + offset, (char*)from->id + offset, K_NATIVE_PAGE_SIZE);
+        }
+    }
+    if (pagemap>=0) {
+        close(pagemap);
+    }
+}
+#endif
+
+void reserveNativeMemory(Memory* memory, bool withFile) {
     memory->id = (U64)reserveNext4GBMemory();
+#ifdef BOXEDWINE_MEMFD_MEMORY
+    // without a memfd fork falls back to copying every page
+    int fd = withFile ? memfd_create("boxedwine", MFD_CLOEXEC) : -1;
+    if (fd>=0) {
+        if (ftruncate(fd, 0x100000000l)==0 && mmap((void*)memory->id, 0x100000000l, PROT_NONE, MAP_SHARED|MAP_FIXED, fd, 0)==(void*)memory->id) {
+            memory->nativeMemoryFile = std::make_shared<NativeMemoryFile>(fd);
+        } else {
+            close(fd);
+        }
+    }
+#endif
     for (int i = 0; i < K_NUMBER_OF_PAGES; i++) {
         memory->memOffsets[i] = memory->id;
     }
@@ -265,6 +560,8 @@ void releaseNativeMemory(Memory* memory) {
     memset(memory->nativeFlags, 0, sizeof(memory->nativeFlags));
     memory->allocated = 0;
     munmap((char*)memory->id, 0x100000000l);
+    memory->nativeMemoryFile = NULL;
+    memory->nativeFileMappings.clear();
 #ifdef BOXEDWINE_BINARY_TRANSLATOR
     memory->executableMemoryReleased();
     for (auto& p : memory->allocatedExecutableMemory) {
@@ -278,6 +575,103 @@ void releaseNativeMemory(Memory* memory) {
 #endif
 }
 
+#ifdef BOXEDWINE_MEMFD_MEMORY
+bool cloneNativeMemory(Memory* memory, Memory* from) {
+    std::shared_ptr<NativeMemoryFile> file = from->nativeMemoryFile;
+    if (!file) {
+        return false;
+    }
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(file->mutex);
+    bool parentWroteToFile = !file->frozen;
+    if (parentWroteToFile) {
+        mapNativeMemoryFilePrivate(from, file->fd);
+        file->frozen = true;
+    }
+    // the child starts with the same pages committed, but none of its code has been seen yet so nothing is read-only
+    memcpy(memory->flags, from->flags, sizeof(memory->flags));
+    for (U32 i=0;i<K_NATIVE_NUMBER_OF_PAGES;i++) {
+        bool wasCommitted = (memory->nativeFlags[i] & NATIVE_FLAG_COMMITTED) != 0;
+        memory->nativeFlags[i] = from->nativeFlags[i] & (NATIVE_FLAG_COMMITTED | NATIVE_FLAG_FILE_MAPPED);
+        if (wasCommitted && !memory->nativeFlags[i]) {
+            nativeMemoryPagesAllocated--;
+        } else if (!wasCommitted && memory->nativeFlags[i]) {
+            nativeMemoryPagesAllocated++;
+        }
+    }
+    memory->allocated = from->allocated;
+    mapNativeMemoryFilePrivate(memory, file->fd);
+    memory->nativeMemoryFile = file;
+    memory->nativeFileMappings = from->nativeFileMappings;
+    for (auto& n : memory->nativeFileMappings) {
+        const std::shared_ptr<NativeFileMapping>& mapping = n.second;
+        if (mmap((char*)memory->id + (((U64)n.first) << K_NATIVE_PAGE_SHIFT), ((U64)mapping->nativePageCount) << K_NATIVE_PAGE_SHIFT, PROT_READ | PROT_WRITE, (mapping->shared ? MAP_SHARED : MAP_PRIVATE) | MAP_FIXED, mapping->file->fd, mapping->offset)==MAP_FAILED) {
+            kpanic("cloneNativeMemory mmap failed: %s", strerror(errno));
+        }
+    }
+    // the parent's memory file only has what was written before the first fork, host file mappings never have the
+    // parent's private changes
+    copyPrivateNativePages(memory, from, parentWroteToFile ? NATIVE_FLAG_FILE_MAPPED : NATIVE_FLAG_COMMITTED);
+    return true;
+}
+
+U32 mapNativeFile(Memory* memory, U32 page, U32 pageCount, U32 flags, const std::shared_ptr<KFile>& file, U64 offset) {
+    FsOpenNode* openFile = file->openFile;
+    S32 handle = openFile->getNativeHandle();
+    std::shared_ptr<NativeFileHandle> nativeFile;
+    bool shared = false;
+    U64 size;
+
+    if (K_NATIVE_PAGES_PER_PAGE != 1) {
+        return 0;
+    }
+    if (handle >= 0) {
+        struct stat handleStat;
+        if (fstat(handle, &handleStat) || !S_ISREG(handleStat.st_mode)) {
+            return 0;
+        }
+        size = handleStat.st_size;
+        // a shared mapping can only write back to the file if the host descriptor allows it, otherwise it gets a
+        // private copy like before
+        shared = (flags & PAGE_SHARED) && (fcntl(handle, F_GETFL) & O_ACCMODE) == O_RDWR;
+        if (size > offset) {
+            nativeFile = getNativeFileHandle(openFile->node->path, handle, handleStat, shared);
+        }
+    } else if (openFile->hasFixedContent()) {
+        size = openFile->length();
+        if (size > offset) {
+            nativeFile = getFixedContentFileHandle(openFile, size);
+        }
+    }
+    if (!nativeFile) {
+        return 0;
+    }
+    // pages past the end of the file would SIGBUS, those are left to the caller
+    U32 nativePageCount = (U32)std::min((U64)pageCount, (size - offset + K_PAGE_SIZE - 1) >> K_PAGE_SHIFT);
+    if (nativeFile->fixedContentNode && !loadFixedContentPages(nativeFile, file, (U32)(offset >> K_PAGE_SHIFT), nativePageCount)) {
+        return 0;
+    }
+    if (memory->nativeFileMappings.size()) {
+        removeNativeFileMappings(memory, page, nativePageCount, false);
+    }
+    // like the rest of the emulated memory the host pages are always readable and writable, flags decide what the
+    // emulated code can do
+    if (mmap((char*)memory->id + (((U64)page) << K_NATIVE_PAGE_SHIFT), ((U64)nativePageCount) << K_NATIVE_PAGE_SHIFT, PROT_READ | PROT_WRITE, (shared ? MAP_SHARED : MAP_PRIVATE) | MAP_FIXED, nativeFile->fd, offset)==MAP_FAILED) {
+        restoreNativeMemory(memory, page, nativePageCount);
+        return 0;
+    }
+    memory->nativeFileMappings[page] = std::make_shared<NativeFileMapping>(nativeFile, nativePageCount, offset, shared);
+    memory->allocated += nativePageCount << K_PAGE_SHIFT;
+    for (U32 i=0;i<nativePageCount;i++) {
+        memory->flags[page+i] = flags | PAGE_ALLOCATED;
+        if (!(memory->nativeFlags[page+i] & NATIVE_FLAG_COMMITTED)) {
+            nativeMemoryPagesAllocated++;
+        }
+        memory->nativeFlags[page+i] = NATIVE_FLAG_COMMITTED | NATIVE_FLAG_FILE_MAPPED;
+    }
+    return nativePageCount;
+}
+#endif
+
 void makeCodePageReadOnly(Memory* memory, U32 page) {
     if (!(memory->nativeFlags[page] & NATIVE_FLAG_CODEPAGE_READONLY)) {
         if (memory->dynamicCodePageUpdateCount[page]==MAX_DYNAMIC_CODE_PAGE_COUNT) {
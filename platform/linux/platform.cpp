@@ -23,6 +23,10 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <SDL.h>
+#include UNISTD
+#ifdef __MACH__
+#include <mach-o/dyld.h>
+#endif
 #ifdef BOXEDWINE_BINARY_TRANSLATOR
 #include "../../source/emulation/cpu/binaryTranslation/btCpu.h"
 #endif
@@ -160,6 +164,23 @@ U32 Platform::nanoSleep(U64 nano) {
     return 0;
 }
 
+std::string Platform::getExecutableFilePath() {
+    char path[1024];
+#ifdef __MACH__
+    uint32_t size = sizeof(path);
+    if (_NSGetExecutablePath(path, &size) == 0) {
+        return path;
+    }
+#else
+    ssize_t len = readlink("/proc/self/exe", path, sizeof(path) - 1);
+    if (len > 0) {
+        path[len] = 0;
+        return path;
+    }
+#endif
+    return "";
+}
+
 #ifdef __MACH__
 extern "C" {
 void MacPlatormSetThreadPriority();
@@ -66,4 +66,8 @@ void ATOMIC_WRITE64(U64* pTarget, U64 value) {
     __sync_lock_test_and_set((volatile S64 *)pTarget, (S64)value);
 }
 
+U32 ATOMIC_COMPARE_EXCHANGE32(U32* pTarget, U32 expected, U32 value) {
+    return __sync_val_compare_and_swap((volatile U32*)pTarget, expected, value);
+}
+
 #endif
@@ -42,7 +42,7 @@ public:
 #ifdef BOXEDWINE_RECORDER
         , bits(0), bitsSize(0)
 #endif
-        , sdlTexture(NULL), sdlTextureHeight(0), sdlTextureWidth(0)
+        , sdlTexture(NULL), sdlTextureHeight(0), sdlTextureWidth(0), uploadedBytes(0), uploadedBytesStartTime(0), uploadedBytesPerSecond(0)
     {}
 
     virtual void setText(char* text) {
@@ -79,6 +79,12 @@ public:
     SDL_Texture* sdlTexture;
     int sdlTextureHeight;
     int sdlTextureWidth;
+
+    // how much bltWnd has been sending to the texture, uploadedBytesPerSecond is updated and logged with kdebug about once a second
+    void countUploadedBytes(U32 bytes);
+    U64 uploadedBytes;
+    U64 uploadedBytesStartTime;
+    U32 uploadedBytesPerSecond;
 };
 
 U32 KNativeWindow::defaultScreenWidth = 800;
@@ -167,7 +173,7 @@ public:
 
     virtual std::shared_ptr<Wnd> getWnd(U32 hwnd);
     virtual std::shared_ptr<Wnd> createWnd(KThread* thread, U32 processId, U32 hwnd, U32 windowRect, U32 clientRect);
-    virtual void bltWnd(KThread* thread, U32 hwnd, U32 bits, S32 xOrg, S32 yOrg, U32 width, U32 height, U32 rect);
+    virtual void bltWnd(KThread* thread, U32 hwnd, U32 bits, S32 xOrg, S32 yOrg, U32 width, U32 height, U32 rects, U32 rectCount);
     virtual void drawWnd(KThread* thread, std::shared_ptr<Wnd> w, U8* bytes, U32 pitch, U32 bpp, U32 width, U32 height);
     virtual void drawAllWindows(KThread* thread, U32 hWnd, int count);
     virtual void setTitle(const std::string& title);
@@ -843,7 +849,77 @@ void KNativeWindowSdl::glSwapBuffers(KThread* thread) {
 static S8 sdlBuffer[1024*1024*4];
 #endif
 
-void KNativeWindowSdl::bltWnd(KThread* thread, U32 hwnd, U32 bits, S32 xOrg, S32 yOrg, U32 width, U32 height, U32 rect) {
+// Wine passes the parts of the surface that were drawn to.  Rects that overlap, or that are close enough that the
+// pixels in between cost less than another upload, are merged.  If there are still too many left after that, the
+// whole bounding box is uploaded at once.
+#define BLT_MERGE_SLACK (64 * 64)
+#define BLT_MAX_RECTS 16
+
+static U64 rectArea(const wRECT& r) {
+    return (U64)(r.right - r.left) * (U64)(r.bottom - r.top);
+}
+
+static wRECT rectUnion(const wRECT& r1, const wRECT& r2) {
+    wRECT result;
+    result.left = std::min(r1.left, r2.left);
+    result.top = std::min(r1.top, r2.top);
+    result.right = std::max(r1.right, r2.right);
+    result.bottom = std::max(r1.bottom, r2.bottom);
+    return result;
+}
+
+static void addDirtyRect(std::vector<wRECT>& rects, wRECT r) {
+    for (U32 i = 0; i < rects.size();) {
+        wRECT merged = rectUnion(rects[i], r);
+        if (rectArea(merged) <= rectArea(rects[i]) + rectArea(r) + BLT_MERGE_SLACK) {
+            // the bigger rect might now reach one that was checked already
+            r = merged;
+            rects.erase(rects.begin() + i);
+            i = 0;
+        } else {
+            i++;
+        }
+    }
+    rects.push_back(r);
+}
+
+static void readDirtyRects(U32 address, U32 count, U32 width, U32 height, std::vector<wRECT>& rects) {
+    for (U32 i = 0; i < count; i++) {
+        wRECT r;
+        r.readRect(address + i * 16);
+        r.left = std::max(r.left, 0);
+        r.top = std::max(r.top, 0);
+        r.right = std::min(r.right, (S32)width);
+        r.bottom = std::min(r.bottom, (S32)height);
+        if (r.left < r.right && r.top < r.bottom) {
+            addDirtyRect(rects, r);
+        }
+    }
+    if (rects.size() > BLT_MAX_RECTS) {
+        wRECT r = rects[0];
+        for (auto& rect : rects) {
+            r = rectUnion(r, rect);
+        }
+        rects.clear();
+        rects.push_back(r);
+    }
+}
+
+void WndSdl::countUploadedBytes(U32 bytes) {
+    U64 now = KSystem::getMilliesSinceStart();
+
+    if (!this->uploadedBytesStartTime) {
+        this->uploadedBytesStartTime = now;
+    } else if (now - this->uploadedBytesStartTime >= 1000) {
+        this->uploadedBytesPerSecond = (U32)(this->uploadedBytes * 1000 / (now - this->uploadedBytesStartTime));
+        this->uploadedBytes = 0;
+        this->uploadedBytesStartTime = now;
+        kdebug("bltWnd hwnd=%X uploaded %d bytes per second", this->hwnd, this->uploadedBytesPerSecond);
+    }
+    this->uploadedBytes += bytes;
+}
+
+void KNativeWindowSdl::bltWnd(KThread* thread, U32 hwnd, U32 bits, S32 xOrg, S32 yOrg, U32 width, U32 height, U32 rects, U32 rectCount) {
     if (!firstWindowCreated) {
         BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(sdlMutex);
         DISPATCH_MAIN_THREAD_BLOCK_BEGIN
@@ -853,9 +929,9 @@ void KNativeWindowSdl::bltWnd(KThread* thread, U32 hwnd, U32 bits, S32 xOrg, S32
     
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(sdlMutex);
     std::shared_ptr<WndSdl> wnd = getWndSdl(hwnd);
-    wRECT r;
     int bpp = screenBpp()==8?32:screenBpp();
-    int pitch = (width*((bpp+7)/8)+3) & ~3;
+    int bytesPerPixel = (bpp+7)/8;
+    int pitch = (width*bytesPerPixel+3) & ~3;
 
     if (!renderer) {
         // final reality will draw its main start window while an OpenGL context is still going
@@ -870,10 +946,10 @@ void KNativeWindowSdl::bltWnd(KThread* thread, U32 hwnd, U32 bits, S32 xOrg, S32
         }
     }
     preDrawWindow();
-    r.readRect(rect);    
     if (wnd)
     {
         SDL_Texture *sdlTexture = NULL;
+        bool fullUpdate = false;
         
         if (wnd->sdlTexture) {
             sdlTexture = (SDL_Texture*)wnd->sdlTexture;
@@ -896,20 +972,23 @@ void KNativeWindowSdl::bltWnd(KThread* thread, U32 hwnd, U32 bits, S32 xOrg, S32
             }
             wnd->sdlTextureHeight = height;
             wnd->sdlTextureWidth = width;
+            // a new texture starts out with nothing in it
+            fullUpdate = true;
         }
         if (!thread->memory->isValidReadAddress(bits, height*pitch)) {
             return;
         }
-#ifdef BOXEDWINE_FLIP_MANUALLY        
-        for (U32 y = 0; y < height; y++) {
-            memcopyToNative(bits+(height-y-1)*pitch, sdlBuffer+y*pitch, pitch);
-        } 
-#endif
         if (screenBpp()!=32) {
             // SDL_ConvertPixels(width, height, )
         }
+#ifdef BOXEDWINE_FLIP_MANUALLY
+        bool copyToBuffer = true;
+#else
+        bool copyToBuffer = false;
+#endif
 #ifdef BOXEDWINE_RECORDER
-        if (Recorder::instance || Player::instance) {
+        bool record = Recorder::instance || Player::instance;
+        if (record) {
             U32 toCopy = pitch*height;
             if (wnd->bitsSize<toCopy) {
                 if (wnd->bits) {
@@ -917,21 +996,52 @@ void KNativeWindowSdl::bltWnd(KThread* thread, U32 hwnd, U32 bits, S32 xOrg, S32
                 }
                 wnd->bits = new U8[toCopy];
                 wnd->bitsSize = toCopy;
+                fullUpdate = true;
             }
-#ifndef BOXEDWINE_FLIP_MANUALLY
-            for (U32 y = 0; y < height; y++) {
-                memcopyToNative(bits+(height-y-1)*pitch, sdlBuffer+y*pitch, pitch);
-            } 
-#endif
-            memcpy(wnd->bits, sdlBuffer, toCopy);
+            copyToBuffer = true;
         }
+#endif
+        std::vector<wRECT> dirty;
+        if (fullUpdate) {
+            wRECT r;
+            r.right = width;
+            r.bottom = height;
+            dirty.push_back(r);
+        } else {
+            readDirtyRects(rects, rectCount, width, height, dirty);
+        }
+        for (auto& r : dirty) {
+            U32 offset = r.left*bytesPerPixel;
+            U32 len = (r.right-r.left)*bytesPerPixel;
+            SDL_Rect sdlRect;
+
+            sdlRect.x = r.left;
+            sdlRect.w = r.right-r.left;
+            sdlRect.h = r.bottom-r.top;
+            if (copyToBuffer) {
+                // the surface is bottom up
+                for (S32 y = r.top; y < r.bottom; y++) {
+                    memcopyToNative(bits+(height-y-1)*pitch+offset, sdlBuffer+y*pitch+offset, len);
+                }
+            }
+#ifdef BOXEDWINE_RECORDER
+            if (record) {
+                for (S32 y = r.top; y < r.bottom; y++) {
+                    memcpy(wnd->bits+y*pitch+offset, sdlBuffer+y*pitch+offset, len);
+                }
+            }
 #endif        
-        if (KSystem::videoEnabled && renderer) {
+            if (KSystem::videoEnabled && renderer) {
 #ifdef BOXEDWINE_FLIP_MANUALLY
-            SDL_UpdateTexture(sdlTexture, NULL, sdlBuffer, pitch);
+                sdlRect.y = r.top;
+                SDL_UpdateTexture(sdlTexture, &sdlRect, sdlBuffer+r.top*pitch+offset, pitch);
 #else
-            SDL_UpdateTexture(sdlTexture, NULL, getNativeAddress(KThread::currentThread()->process->memory, bits), pitch);            
+                // the texture is bottom up too, drawAllWindows flips it
+                sdlRect.y = height-r.bottom;
+                SDL_UpdateTexture(sdlTexture, &sdlRect, (U8*)getNativeAddress(thread->memory, bits)+sdlRect.y*pitch+offset, pitch);
 #endif
+                wnd->countUploadedBytes(len*sdlRect.h);
+            }
         }
     }
 }
@@ -207,7 +207,7 @@ static void* reserveNext32GBMemory() {
     return p;
 }
 
-void reserveNativeMemory(Memory* memory) {    
+void reserveNativeMemory(Memory* memory, bool withFile) {    
     memory->id = (U64)reserveNext4GBMemory();
     for (int i = 0; i < K_NUMBER_OF_PAGES; i++) {
         memory->memOffsets[i] = memory->id;
@@ -366,6 +366,15 @@ void Platform::setCurrentThreadPriorityHigh() {
 
 }
 
+std::string Platform::getExecutableFilePath() {
+    char path[MAX_PATH];
+    DWORD len = GetModuleFileNameA(NULL, path, MAX_PATH);
+    if (len > 0 && len < MAX_PATH) {
+        return path;
+    }
+    return "";
+}
+
 U32 Platform::nanoSleep(U64 nano) {
     U32 millies = (U32)(nano / 1000000);
     LARGE_INTEGER startTime;
@@ -20,8 +20,8 @@ void syncFromException(struct _EXCEPTION_POINTERS *ep, bool includeFPU) {
     cpu->flags = ep->ContextRecord->EFlags;
     cpu->lazyFlags = FLAGS_NONE;
     for (int i=0;i<8;i++) {
-        cpu->xmm[i].pi.u64[0] = ep->ContextRecord->FltSave.XmmRegisters[i].Low;
-        cpu->xmm[i].pi.u64[1] = ep->ContextRecord->FltSave.XmmRegisters[i].High;
+        cpu->xmm[i].u64[0] = ep->ContextRecord->FltSave.XmmRegisters[i].Low;
+        cpu->xmm[i].u64[1] = ep->ContextRecord->FltSave.XmmRegisters[i].High;
     }
 
     if (includeFPU && !cpu->thread->process->emulateFPU) {
@@ -59,8 +59,8 @@ void syncToException(struct _EXCEPTION_POINTERS *ep, bool includeFPU) {
     cpu->fillFlags();
     ep->ContextRecord->EFlags = cpu->flags;
     for (int i=0;i<8;i++) {
-        ep->ContextRecord->FltSave.XmmRegisters[i].Low = cpu->xmm[i].pi.u64[0];
-        ep->ContextRecord->FltSave.XmmRegisters[i].High = cpu->xmm[i].pi.u64[1];
+        ep->ContextRecord->FltSave.XmmRegisters[i].Low = cpu->xmm[i].u64[0];
+        ep->ContextRecord->FltSave.XmmRegisters[i].High = cpu->xmm[i].u64[1];
     }
     if (includeFPU && !cpu->thread->process->emulateFPU) {
         ep->ContextRecord->FltSave.ControlWord = cpu->fpu.CW();
@@ -212,6 +212,10 @@ void scheduleThread(KThread* thread) {
 void ATOMIC_WRITE64(U64* pTarget, U64 value) {
     InterlockedExchange64((volatile LONGLONG *)pTarget, (LONGLONG)value);
 }
+
+U32 ATOMIC_COMPARE_EXCHANGE32(U32* pTarget, U32 expected, U32 value) {
+    return (U32)InterlockedCompareExchange((volatile LONG *)pTarget, (LONG)value, (LONG)expected);
+}
 #endif
 
 #endif
\ No newline at end of file
@@ -20,41 +20,41 @@ CPU* CPU::allocCPU() {
 }
 
 Armv8btCPU::Armv8btCPU() : exitToStartThreadLoop(0), regPage(0), regOffset(0) {
-    sseConstants[SSE_MAX_INT32_PLUS_ONE_AS_DOUBLE].pd.f64[0] = 2147483648.0;
-    sseConstants[SSE_MAX_INT32_PLUS_ONE_AS_DOUBLE].pd.f64[1] = 2147483648.0;
-    sseConstants[SSE_MIN_INT32_MINUS_ONE_AS_DOUBLE].pd.f64[0] = -2147483649.0;
-    sseConstants[SSE_MIN_INT32_MINUS_ONE_AS_DOUBLE].pd.f64[1] = -2147483649.0;
-
-    sseConstants[SSE_MAX_INT32_PLUS_ONE_AS_FLOAT].ps.f32[0] = 2147483648.0;
-    sseConstants[SSE_MAX_INT32_PLUS_ONE_AS_FLOAT].ps.f32[1] = 2147483648.0;
-    sseConstants[SSE_MAX_INT32_PLUS_ONE_AS_FLOAT].ps.f32[2] = 2147483648.0;
-    sseConstants[SSE_MAX_INT32_PLUS_ONE_AS_FLOAT].ps.f32[3] = 2147483648.0;
-    sseConstants[SSE_MIN_INT32_MINUS_ONE_AS_FLOAT].ps.f32[0] = -2147483649.0;
-    sseConstants[SSE_MIN_INT32_MINUS_ONE_AS_FLOAT].ps.f32[1] = -2147483649.0;
-    sseConstants[SSE_MIN_INT32_MINUS_ONE_AS_FLOAT].ps.f32[2] = -2147483649.0;
-    sseConstants[SSE_MIN_INT32_MINUS_ONE_AS_FLOAT].ps.f32[3] = -2147483649.0;
-
-    sseConstants[SSE_INT32_BIT_MASK].ps.u32[0] = 1;
-    sseConstants[SSE_INT32_BIT_MASK].ps.u32[1] = 2;
-    sseConstants[SSE_INT32_BIT_MASK].ps.u32[2] = 4;
-    sseConstants[SSE_INT32_BIT_MASK].ps.u32[3] = 8;
-
-    sseConstants[SSE_BYTE8_BIT_MASK].pi.u8[0] = 1;
-    sseConstants[SSE_BYTE8_BIT_MASK].ps.u8[1] = 2;
-    sseConstants[SSE_BYTE8_BIT_MASK].ps.u8[2] = 4;
-    sseConstants[SSE_BYTE8_BIT_MASK].ps.u8[3] = 8;
-    sseConstants[SSE_BYTE8_BIT_MASK].ps.u8[4] = 16;
-    sseConstants[SSE_BYTE8_BIT_MASK].ps.u8[5] = 32;
-    sseConstants[SSE_BYTE8_BIT_MASK].ps.u8[6] = 64;
-    sseConstants[SSE_BYTE8_BIT_MASK].ps.u8[7] = 128;
-    sseConstants[SSE_BYTE8_BIT_MASK].pi.u8[8] = 1;
-    sseConstants[SSE_BYTE8_BIT_MASK].ps.u8[9] = 2;
-    sseConstants[SSE_BYTE8_BIT_MASK].ps.u8[10] = 4;
-    sseConstants[SSE_BYTE8_BIT_MASK].ps.u8[11] = 8;
-    sseConstants[SSE_BYTE8_BIT_MASK].ps.u8[12] = 16;
-    sseConstants[SSE_BYTE8_BIT_MASK].ps.u8[13] = 32;
-    sseConstants[SSE_BYTE8_BIT_MASK].ps.u8[14] = 64;
-    sseConstants[SSE_BYTE8_BIT_MASK].ps.u8[15] = 128;
+    sseConstants[SSE_MAX_INT32_PLUS_ONE_AS_DOUBLE].f64[0] = 2147483648.0;
+    sseConstants[SSE_MAX_INT32_PLUS_ONE_AS_DOUBLE].f64[1] = 2147483648.0;
+    sseConstants[SSE_MIN_INT32_MINUS_ONE_AS_DOUBLE].f64[0] = -2147483649.0;
+    sseConstants[SSE_MIN_INT32_MINUS_ONE_AS_DOUBLE].f64[1] = -2147483649.0;
+
+    sseConstants[SSE_MAX_INT32_PLUS_ONE_AS_FLOAT].f32[0] = 2147483648.0;
+    sseConstants[SSE_MAX_INT32_PLUS_ONE_AS_FLOAT].f32[1] = 2147483648.0;
+    sseConstants[SSE_MAX_INT32_PLUS_ONE_AS_FLOAT].f32[2] = 2147483648.0;
+    sseConstants[SSE_MAX_INT32_PLUS_ONE_AS_FLOAT].f32[3] = 2147483648.0;
+    sseConstants[SSE_MIN_INT32_MINUS_ONE_AS_FLOAT].f32[0] = -2147483649.0;
+    sseConstants[SSE_MIN_INT32_MINUS_ONE_AS_FLOAT].f32[1] = -2147483649.0;
+    sseConstants[SSE_MIN_INT32_MINUS_ONE_AS_FLOAT].f32[2] = -2147483649.0;
+    sseConstants[SSE_MIN_INT32_MINUS_ONE_AS_FLOAT].f32[3] = -2147483649.0;
+
+    sseConstants[SSE_INT32_BIT_MASK].u32[0] = 1;
+    sseConstants[SSE_INT32_BIT_MASK].u32[1] = 2;
+    sseConstants[SSE_INT32_BIT_MASK].u32[2] = 4;
+    sseConstants[SSE_INT32_BIT_MASK].u32[3] = 8;
+
+    sseConstants[SSE_BYTE8_BIT_MASK].bytes[0] = 1;
+    sseConstants[SSE_BYTE8_BIT_MASK].bytes[1] = 2;
+    sseConstants[SSE_BYTE8_BIT_MASK].bytes[2] = 4;
+    sseConstants[SSE_BYTE8_BIT_MASK].bytes[3] = 8;
+    sseConstants[SSE_BYTE8_BIT_MASK].bytes[4] = 16;
+    sseConstants[SSE_BYTE8_BIT_MASK].bytes[5] = 32;
+    sseConstants[SSE_BYTE8_BIT_MASK].bytes[6] = 64;
+    sseConstants[SSE_BYTE8_BIT_MASK].bytes[7] = 128;
+    sseConstants[SSE_BYTE8_BIT_MASK].bytes[8] = 1;
+    sseConstants[SSE_BYTE8_BIT_MASK].bytes[9] = 2;
+    sseConstants[SSE_BYTE8_BIT_MASK].bytes[10] = 4;
+    sseConstants[SSE_BYTE8_BIT_MASK].bytes[11] = 8;
+    sseConstants[SSE_BYTE8_BIT_MASK].bytes[12] = 16;
+    sseConstants[SSE_BYTE8_BIT_MASK].bytes[13] = 32;
+    sseConstants[SSE_BYTE8_BIT_MASK].bytes[14] = 64;
+    sseConstants[SSE_BYTE8_BIT_MASK].bytes[15] = 128;
 }
 
 typedef void (*StartCPU)();
@@ -761,6 +761,9 @@ void Armv8btCPU::startThread() {
     }
     std::shared_ptr<KProcess> process = thread->process;
 	process->deleteThread(thread);
+    // the free lists are per thread
+    DecodedOp::releaseThreadCache();
+    NormalCPU::releaseThreadCache();
 
     platformThreadCount--;
     if (platformThreadCount==0) {
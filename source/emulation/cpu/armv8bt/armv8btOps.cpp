@@ -4603,10 +4603,10 @@ void opDivssE32(Armv8btAsm* data) {
     data->vReleaseTmpReg(vTmpReg);
 }
 void opRcppsXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].ps.f32[0] = 1.0f / cpu->xmm[rm].ps.f32[0]
-    // cpu->xmm[reg].ps.f32[1] = 1.0f / cpu->xmm[rm].ps.f32[1]
-    // cpu->xmm[reg].ps.f32[2] = 1.0f / cpu->xmm[rm].ps.f32[2]
-    // cpu->xmm[reg].ps.f32[3] = 1.0f / cpu->xmm[rm].ps.f32[3]
+    // cpu->xmm[reg].f32[0] = 1.0f / cpu->xmm[rm].f32[0]
+    // cpu->xmm[reg].f32[1] = 1.0f / cpu->xmm[rm].f32[1]
+    // cpu->xmm[reg].f32[2] = 1.0f / cpu->xmm[rm].f32[2]
+    // cpu->xmm[reg].f32[3] = 1.0f / cpu->xmm[rm].f32[3]
     data->fReciprocal(data->getNativeSseReg(data->decodedOp->reg), data->getNativeSseReg(data->decodedOp->rm), S4);
 }
 void opRcppsE128(Armv8btAsm* data) {
@@ -4618,7 +4618,7 @@ void opRcppsE128(Armv8btAsm* data) {
     data->vReleaseTmpReg(vTmpReg);
 }
 void opRcpssXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].ps.f32[0] = 1.0f / cpu->xmm[rm].ps.f32[0]
+    // cpu->xmm[reg].f32[0] = 1.0f / cpu->xmm[rm].f32[0]
     U8 vTmpReg = data->vGetTmpReg();
     data->fReciprocal(vTmpReg, data->getNativeSseReg(data->decodedOp->rm), S_scaler);
     data->vMov32(data->getNativeSseReg(data->decodedOp->reg), 0, vTmpReg, 0);
@@ -4634,10 +4634,10 @@ void opRcpssE32(Armv8btAsm* data) {
     data->vReleaseTmpReg(vTmpReg);
 }
 void opSqrtpsXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].pd.f32[0] = sqrt(cpu->xmm[rm].pd.f32[0] )
-    // cpu->xmm[reg].pd.f32[1] = sqrt(cpu->xmm[rm].pd.f32[1] )
-    // cpu->xmm[reg].pd.f32[2] = sqrt(cpu->xmm[rm].pd.f32[2] )
-    // cpu->xmm[reg].pd.f32[3] = sqrt(cpu->xmm[rm].pd.f32[3] )
+    // cpu->xmm[reg].f32[0] = sqrt(cpu->xmm[rm].f32[0] )
+    // cpu->xmm[reg].f32[1] = sqrt(cpu->xmm[rm].f32[1] )
+    // cpu->xmm[reg].f32[2] = sqrt(cpu->xmm[rm].f32[2] )
+    // cpu->xmm[reg].f32[3] = sqrt(cpu->xmm[rm].f32[3] )
     data->fSqrt(data->getNativeSseReg(data->decodedOp->reg), data->getNativeSseReg(data->decodedOp->rm), S4);
 }
 void opSqrtpsE128(Armv8btAsm* data) {
@@ -4649,7 +4649,7 @@ void opSqrtpsE128(Armv8btAsm* data) {
     data->vReleaseTmpReg(vTmpReg);
 }
 void opSqrtssXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].ps.f32[0] = sqrt(cpu->xmm[rm].ps.f32[0] )
+    // cpu->xmm[reg].f32[0] = sqrt(cpu->xmm[rm].f32[0] )
     U8 vTmpReg = data->vGetTmpReg();
     data->fSqrt(vTmpReg, data->getNativeSseReg(data->decodedOp->rm), S_scaler);
     data->vMov32(data->getNativeSseReg(data->decodedOp->reg), 0, vTmpReg, 0);
@@ -4666,10 +4666,10 @@ void opSqrtssE32(Armv8btAsm* data) {
 }
 
 void opRsqrtpsXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].ps.f32[0] = 1.0f / sqrt(cpu->xmm[rm].ps.f32[0] )
-    // cpu->xmm[reg].ps.f32[1] = 1.0f / sqrt(cpu->xmm[rm].ps.f32[1] )
-    // cpu->xmm[reg].ps.f32[2] = 1.0f / sqrt(cpu->xmm[rm].ps.f32[2] )
-    // cpu->xmm[reg].ps.f32[3] = 1.0f / sqrt(cpu->xmm[rm].ps.f32[3] )
+    // cpu->xmm[reg].f32[0] = 1.0f / sqrt(cpu->xmm[rm].f32[0] )
+    // cpu->xmm[reg].f32[1] = 1.0f / sqrt(cpu->xmm[rm].f32[1] )
+    // cpu->xmm[reg].f32[2] = 1.0f / sqrt(cpu->xmm[rm].f32[2] )
+    // cpu->xmm[reg].f32[3] = 1.0f / sqrt(cpu->xmm[rm].f32[3] )
     data->fRsqrt(data->getNativeSseReg(data->decodedOp->reg), data->getNativeSseReg(data->decodedOp->rm), S4);
 }
 void opRsqrtpsE128(Armv8btAsm* data) {
@@ -4681,7 +4681,7 @@ void opRsqrtpsE128(Armv8btAsm* data) {
     data->vReleaseTmpReg(vTmpReg);
 }
 void opRsqrtssXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].ps.f32[0] = 1.0f / sqrt(cpu->xmm[rm].ps.f32[0] )
+    // cpu->xmm[reg].f32[0] = 1.0f / sqrt(cpu->xmm[rm].f32[0] )
     U8 vTmpReg = data->vGetTmpReg();
     data->fRsqrt(vTmpReg, data->getNativeSseReg(data->decodedOp->rm), S_scaler);
     data->vMov32(data->getNativeSseReg(data->decodedOp->reg), 0, vTmpReg, 0);
@@ -4918,40 +4918,40 @@ void opMovapsE128Xmm(Armv8btAsm* data) {
     data->releaseTmpReg(addressReg);
 }
 void opMovhlpsXmmXmm(Armv8btAsm* data) {
-    // cpu->xmm[r1].ps.u64[0] = cpu->xmm[r2].ps.u64[1];
+    // cpu->xmm[r1].u64[0] = cpu->xmm[r2].u64[1];
     data->vMov64(data->getNativeSseReg(data->decodedOp->reg), 0, data->getNativeSseReg(data->decodedOp->rm), 1);
 }
 void opMovlhpsXmmXmm(Armv8btAsm* data) {
-    // cpu->xmm[r1].ps.u64[1] = cpu->xmm[r2].ps.u64[0];
+    // cpu->xmm[r1].u64[1] = cpu->xmm[r2].u64[0];
     data->vMov64(data->getNativeSseReg(data->decodedOp->reg), 1, data->getNativeSseReg(data->decodedOp->rm), 0);
 }
 void opMovhpsXmmE64(Armv8btAsm* data) {
-    // cpu->xmm[reg].ps.u64[1] = readq(address);
+    // cpu->xmm[reg].u64[1] = readq(address);
     U8 addressReg = data->getAddressReg();
     data->vReadMemory64(addressReg, data->getNativeSseReg(data->decodedOp->reg), 1, true);
     data->releaseTmpReg(addressReg);
 }
 void opMovhpsE64Xmm(Armv8btAsm* data) {
-    // writeq(address, cpu->xmm[reg].ps.u64[1]);
+    // writeq(address, cpu->xmm[reg].u64[1]);
     U8 addressReg = data->getAddressReg();
     data->vWriteMemory64(addressReg, data->getNativeSseReg(data->decodedOp->reg), 1, true);
     data->releaseTmpReg(addressReg);
 }
 void opMovlpsXmmE64(Armv8btAsm* data) {
-    // cpu->xmm[reg].ps.u64[0] = readq(address);
+    // cpu->xmm[reg].u64[0] = readq(address);
     U8 addressReg = data->getAddressReg();
     data->vReadMemory64(addressReg, data->decodedOp->reg, 0, true);
     data->releaseTmpReg(addressReg);
 }
 void opMovlpsE64Xmm(Armv8btAsm* data) {
-    // writeq(address, cpu->xmm[reg].ps.u64[0]);
+    // writeq(address, cpu->xmm[reg].u64[0]);
     U8 addressReg = data->getAddressReg();
     data->vWriteMemory64(addressReg, data->getNativeSseReg(data->decodedOp->reg), 0, true);
     data->releaseTmpReg(addressReg);
 }
 
 void opMovmskpsR32Xmm(Armv8btAsm* data) {
-    // cpu->reg[reg].u32 = (cpu->xmm[rm].pd.u32[0] >> 31) | ((cpu->xmm[rm].pd.u32[1] >> 31) << 1) | ((cpu->xmm[rm].pd.u32[2] >> 31) << 2) | ((cpu->xmm[rm].pd.u32[3] >> 31) << 3)
+    // cpu->reg[reg].u32 = (cpu->xmm[rm].u32[0] >> 31) | ((cpu->xmm[rm].u32[1] >> 31) << 1) | ((cpu->xmm[rm].u32[2] >> 31) << 2) | ((cpu->xmm[rm].u32[3] >> 31) << 3)
     U8 vTmpReg = data->vGetTmpReg();
 
     U8 bitMaskReg = data->getSSEConstant(SSE_INT32_BIT_MASK);
@@ -4964,20 +4964,20 @@ void opMovmskpsR32Xmm(Armv8btAsm* data) {
     data->vReleaseTmpReg(bitMaskReg);
 }
 void opMovssXmmXmm(Armv8btAsm* data) {
-    // cpu->xmm[r1].ps.u32[0] = cpu->xmm[r2].ps.u32[0];
+    // cpu->xmm[r1].u32[0] = cpu->xmm[r2].u32[0];
     data->vMov32(data->getNativeSseReg(data->decodedOp->reg), 0, data->getNativeSseReg(data->decodedOp->rm), 0);
 }
 void opMovssXmmE32(Armv8btAsm* data) {
-    // cpu->xmm[reg].ps.u32[0] = readd(address);
-    // cpu->xmm[reg].ps.u32[1] = 0;
-    // cpu->xmm[reg].ps.u32[2] = 0;
-    // cpu->xmm[reg].ps.u32[3] = 0;
+    // cpu->xmm[reg].u32[0] = readd(address);
+    // cpu->xmm[reg].u32[1] = 0;
+    // cpu->xmm[reg].u32[2] = 0;
+    // cpu->xmm[reg].u32[3] = 0;
     U8 addressReg = data->getAddressReg();
     data->vReadMemory32(addressReg, data->getNativeSseReg(data->decodedOp->reg), true);
     data->releaseTmpReg(addressReg);
 }
 void opMovssE32Xmm(Armv8btAsm* data) {
-    // writed(address, cpu->xmm[reg].ps.u32[0]);
+    // writed(address, cpu->xmm[reg].u32[0]);
     U8 addressReg = data->getAddressReg();
     data->vWriteMemory32(addressReg, data->getNativeSseReg(data->decodedOp->reg), 0, true);
     data->releaseTmpReg(addressReg);
@@ -4997,8 +4997,8 @@ void opMovupsE128Xmm(Armv8btAsm* data) {
     data->releaseTmpReg(addressReg);
 }
 void opMovntpsE128Xmm(Armv8btAsm* data) {
-    // writeq(address, cpu->xmm[reg].ps.u64[0]);
-    // writeq(address + 8, cpu->xmm[reg].ps.u64[1]);
+    // writeq(address, cpu->xmm[reg].u64[0]);
+    // writeq(address + 8, cpu->xmm[reg].u64[1]);
     U8 addressReg = data->getAddressReg();
     data->vWriteMemory128(addressReg, data->getNativeSseReg(data->decodedOp->reg), true);
     data->releaseTmpReg(addressReg);
@@ -5015,10 +5015,10 @@ void opUnpckhpsXmmE128(Armv8btAsm* data) {
     data->releaseTmpReg(addressReg);
 }
 void opUnpcklpsXmmXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].ps.f32[0] = cpu->xmm[reg].ps.f32[0];
-    // cpu->xmm[reg].ps.f32[1] = cpu->xmm[rm].ps.f32[0];
-    // cpu->xmm[reg].ps.f32[2] = cpu->xmm[reg].ps.f32[1];
-    // cpu->xmm[reg].ps.f32[3] = cpu->xmm[rm].ps.f32[1];
+    // cpu->xmm[reg].f32[0] = cpu->xmm[reg].f32[0];
+    // cpu->xmm[reg].f32[1] = cpu->xmm[rm].f32[0];
+    // cpu->xmm[reg].f32[2] = cpu->xmm[reg].f32[1];
+    // cpu->xmm[reg].f32[3] = cpu->xmm[rm].f32[1];
     data->vZipFromLow128(data->getNativeSseReg(data->decodedOp->reg), data->getNativeSseReg(data->decodedOp->reg), data->getNativeSseReg(data->decodedOp->rm), S4);
 }
 void opUnpcklpsXmmE128(Armv8btAsm* data) {
@@ -5513,8 +5513,8 @@ void opPmullwXmmE128(Armv8btAsm* data) {
     data->vReleaseTmpReg(vTmpReg);
 }
 void opPmuludqXmmXmm(Armv8btAsm* data) {
-    // cpu->xmm[r1].pi.u64[0] = cpu->xmm[r1].pi.u32[0] * cpu->xmm[r2].pi.u32[0]
-    // cpu->xmm[r1].pi.u64[1] = cpu->xmm[r1].pi.u32[2] * cpu->xmm[r2].pi.u32[2]
+    // cpu->xmm[r1].u64[0] = cpu->xmm[r1].u32[0] * cpu->xmm[r2].u32[0]
+    // cpu->xmm[r1].u64[1] = cpu->xmm[r1].u32[2] * cpu->xmm[r2].u32[2]
     U8 vTmpReg1 = data->vGetTmpReg();
     U8 vTmpReg2 = data->vGetTmpReg();
     data->vConvertInt64ToLowerInt32(vTmpReg1, data->getNativeSseReg(data->decodedOp->reg));
@@ -5536,8 +5536,8 @@ void opPmuludqXmmE128(Armv8btAsm* data) {
     data->vReleaseTmpReg(vTmpReg2);
 }
 void opSqrtpdXmmXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].pd.f64[0] = sqrt(cpu->xmm[rm].pd.f64[0] )
-    // cpu->xmm[reg].pd.f64[1] = sqrt(cpu->xmm[rm].pd.f64[1] )
+    // cpu->xmm[reg].f64[0] = sqrt(cpu->xmm[rm].f64[0] )
+    // cpu->xmm[reg].f64[1] = sqrt(cpu->xmm[rm].f64[1] )
     data->fSqrt(data->getNativeSseReg(data->decodedOp->reg), data->getNativeSseReg(data->decodedOp->rm), D2);
 }
 void opSqrtpdXmmE128(Armv8btAsm* data) {
@@ -5549,7 +5549,7 @@ void opSqrtpdXmmE128(Armv8btAsm* data) {
     data->vReleaseTmpReg(vTmpReg);
 }
 void opSqrtsdXmmXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].pd.f64[0] = sqrt(cpu->xmm[rm].pd.f64[0] )
+    // cpu->xmm[reg].f64[0] = sqrt(cpu->xmm[rm].f64[0] )
     U8 vTmpReg = data->vGetTmpReg();
     data->fSqrt(vTmpReg, data->getNativeSseReg(data->decodedOp->rm), D_scaler);
     data->vMov64(data->getNativeSseReg(data->decodedOp->reg), 0, vTmpReg, 0);
@@ -5942,36 +5942,36 @@ void opPcmpeqdXmmE128(Armv8btAsm* data) {
 }
 
 void opMovqXmmXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].pi.u64[0] = cpu->xmm[rm].pi.u64[0];
-    // cpu->xmm[reg].pi.u64[1] = 0;
+    // cpu->xmm[reg].u64[0] = cpu->xmm[rm].u64[0];
+    // cpu->xmm[reg].u64[1] = 0;
     data->vZeroExtend64To128(data->getNativeSseReg(data->decodedOp->reg), data->getNativeSseReg(data->decodedOp->rm));
 }
 void opMovqE64Xmm(Armv8btAsm* data) {
-    // writeq(address, cpu->xmm[reg].pi.u64[0]);
+    // writeq(address, cpu->xmm[reg].u64[0]);
     U8 addressReg = data->getAddressReg();
     data->vWriteMemory64(addressReg, data->getNativeSseReg(data->decodedOp->reg), 0, true);
     data->releaseTmpReg(addressReg);
 }
 void opMovqXmmE64(Armv8btAsm* data) {
-    // cpu->xmm[reg].pi.u64[0] = readq(address);
-    // cpu->xmm[reg].pi.u64[1] = 0;
+    // cpu->xmm[reg].u64[0] = readq(address);
+    // cpu->xmm[reg].u64[1] = 0;
     U8 addressReg = data->getAddressReg();
     data->vReadMemory64(addressReg, data->getNativeSseReg(data->decodedOp->reg), true);
     data->releaseTmpReg(addressReg);
 }
 void opMovsdXmmXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].pd.u64[0] = cpu->xmm[rm].pd.u64[0]
+    // cpu->xmm[reg].u64[0] = cpu->xmm[rm].u64[0]
     data->vMov64(data->getNativeSseReg(data->decodedOp->reg), 0, data->getNativeSseReg(data->decodedOp->rm), 0);
 }
 void opMovsdXmmE64(Armv8btAsm* data) {
-    // cpu->xmm[reg].pd.u64[0] = readq(address);
-    // cpu->xmm[reg].pd.u64[1] = 0; // yes, memory to reg will 0 out the top, but xmm to xmm does not, unlike movq
+    // cpu->xmm[reg].u64[0] = readq(address);
+    // cpu->xmm[reg].u64[1] = 0; // yes, memory to reg will 0 out the top, but xmm to xmm does not, unlike movq
     U8 addressReg = data->getAddressReg();
     data->vReadMemory64(addressReg, data->getNativeSseReg(data->decodedOp->reg), true);
     data->releaseTmpReg(addressReg);
 }
 void opMovsdE64Xmm(Armv8btAsm* data) {
-    // writeq(address, cpu->xmm[reg].pd.u64[0]);
+    // writeq(address, cpu->xmm[reg].u64[0]);
     U8 addressReg = data->getAddressReg();
     data->vWriteMemory64(addressReg, data->getNativeSseReg(data->decodedOp->reg), 0, true);
     data->releaseTmpReg(addressReg);
@@ -5981,15 +5981,15 @@ void opMovapdXmmXmm(Armv8btAsm* data) {
     data->vMov128(data->getNativeSseReg(data->decodedOp->reg), data->getNativeSseReg(data->decodedOp->rm));
 }
 void opMovapdXmmE128(Armv8btAsm* data) {
-    // cpu->xmm[reg].pd.u64[0] = readq(address);
-    // cpu->xmm[reg].pd.u64[1] = readq(address + 8);
+    // cpu->xmm[reg].u64[0] = readq(address);
+    // cpu->xmm[reg].u64[1] = readq(address + 8);
     U8 addressReg = data->getAddressReg();
     data->vReadMemory128(addressReg, data->getNativeSseReg(data->decodedOp->reg), true);
     data->releaseTmpReg(addressReg);
 }
 void opMovapdE128Xmm(Armv8btAsm* data) {
-    // writeq(address, cpu->xmm[reg].pd.u64[0]);
-    // writeq(address + 8, cpu->xmm[reg].pd.u64[1]);
+    // writeq(address, cpu->xmm[reg].u64[0]);
+    // writeq(address + 8, cpu->xmm[reg].u64[1]);
     U8 addressReg = data->getAddressReg();
     data->vWriteMemory128(addressReg, data->getNativeSseReg(data->decodedOp->reg), true);
     data->releaseTmpReg(addressReg);
@@ -5999,46 +5999,46 @@ void opMovupdXmmXmm(Armv8btAsm* data) {
     data->vMov128(data->getNativeSseReg(data->decodedOp->reg), data->getNativeSseReg(data->decodedOp->rm));
 }
 void opMovupdXmmE128(Armv8btAsm* data) {
-    // cpu->xmm[reg].pd.u64[0] = readq(address);
-    // cpu->xmm[reg].pd.u64[1] = readq(address + 8);
+    // cpu->xmm[reg].u64[0] = readq(address);
+    // cpu->xmm[reg].u64[1] = readq(address + 8);
     U8 addressReg = data->getAddressReg();
     data->vReadMemory128(addressReg, data->getNativeSseReg(data->decodedOp->reg), true);
     data->releaseTmpReg(addressReg);
 }
 void opMovupdE128Xmm(Armv8btAsm* data) {
-    // writeq(address, cpu->xmm[reg].pd.u64[0]);
-    // writeq(address + 8, cpu->xmm[reg].pd.u64[1]);
+    // writeq(address, cpu->xmm[reg].u64[0]);
+    // writeq(address + 8, cpu->xmm[reg].u64[1]);
     U8 addressReg = data->getAddressReg();
     data->vWriteMemory128(addressReg, data->getNativeSseReg(data->decodedOp->reg), true);
     data->releaseTmpReg(addressReg);
 }
 void opMovhpdXmmE64(Armv8btAsm* data) {
-    // cpu->xmm[reg].pd.u64[1] = readq(address);
+    // cpu->xmm[reg].u64[1] = readq(address);
     U8 addressReg = data->getAddressReg();
     data->vReadMemory64(addressReg, data->getNativeSseReg(data->decodedOp->reg), 1, true);
     data->releaseTmpReg(addressReg);
 }
 void opMovhpdE64Xmm(Armv8btAsm* data) {
-    // writeq(address, cpu->xmm[reg].pd.u64[1]);
+    // writeq(address, cpu->xmm[reg].u64[1]);
     U8 addressReg = data->getAddressReg();
     data->vWriteMemory64(addressReg, data->getNativeSseReg(data->decodedOp->reg), 1, true);
     data->releaseTmpReg(addressReg);
 }
 void opMovlpdXmmE64(Armv8btAsm* data) {
-    // cpu->xmm[reg].pd.u64[0] = readq(address);
+    // cpu->xmm[reg].u64[0] = readq(address);
     U8 addressReg = data->getAddressReg();
     data->vReadMemory64(addressReg, data->decodedOp->reg, 0, true);
     data->releaseTmpReg(addressReg);
 }
 void opMovlpdE64Xmm(Armv8btAsm* data) {
-    // writeq(address, cpu->xmm[reg].pd.u64[0]);
+    // writeq(address, cpu->xmm[reg].u64[0]);
     U8 addressReg = data->getAddressReg();
     data->vWriteMemory64(addressReg, data->getNativeSseReg(data->decodedOp->reg), 0, true);
     data->releaseTmpReg(addressReg);
 }
 
 void opMovmskpdR32Xmm(Armv8btAsm* data) {
-    // cpu->reg[reg].u32 = (cpu->xmm[rm].pd.u64[0] >> 63) | ((cpu->xmm[rm].pd.u64[1] >> 63) << 1)
+    // cpu->reg[reg].u32 = (cpu->xmm[rm].u64[0] >> 63) | ((cpu->xmm[rm].u64[1] >> 63) << 1)
     U8 vTmpReg = data->vGetTmpReg();
     U8 tmpReg = data->getTmpReg();         
 
@@ -6096,8 +6096,8 @@ void opMovdquE128Xmm(Armv8btAsm* data) {
     data->releaseTmpReg(addressReg);
 }
 void opMovntpdE128Xmm(Armv8btAsm* data) {
-    // writeq(address, cpu->xmm[reg].pd.u64[0]);
-    // writeq(address + 8, cpu->xmm[reg].pd.u64[1]);
+    // writeq(address, cpu->xmm[reg].u64[0]);
+    // writeq(address + 8, cpu->xmm[reg].u64[1]);
     U8 addressReg = data->getAddressReg();
     data->vWriteMemory128(addressReg, data->getNativeSseReg(data->decodedOp->reg), true);
     data->releaseTmpReg(addressReg);
@@ -6159,8 +6159,8 @@ void opUnpckhpdXmmE128(Armv8btAsm* data) {
     data->releaseTmpReg(addressReg);
 }
 void opUnpcklpdXmmXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].pd.u64[0] = cpu->xmm[reg].pd.u64[0];
-    // cpu->xmm[reg].pd.u64[1] = cpu->xmm[rm].pd.u64[0];
+    // cpu->xmm[reg].u64[0] = cpu->xmm[reg].u64[0];
+    // cpu->xmm[reg].u64[1] = cpu->xmm[rm].u64[0];
     data->vMov64(data->getNativeSseReg(data->decodedOp->reg), 1, data->getNativeSseReg(data->decodedOp->rm), 0);
 }
 void opUnpcklpdXmmE128(Armv8btAsm* data) {
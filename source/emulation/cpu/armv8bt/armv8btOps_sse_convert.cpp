@@ -5,13 +5,13 @@
 // When converting Double/Float to int32, if the value doesn't fit, SSE convert the value to 0x80000000, but ARM converts it to 0x7FFFFFFF,
 // so we have to spend a lot of effort to correct that
 static void cvtps2piXmm(Armv8btAsm* data, U8 to, U8 from, bool truncate) {
-    // cpu->reg_mmx[reg].sd.d0 = cpu->xmm[rm].pd.f32[0];
-    // cpu->reg_mmx[reg].sd.d1 = cpu->xmm[rm].pd.f32[1];
+    // cpu->reg_mmx[reg].sd.d0 = cpu->xmm[rm].f32[0];
+    // cpu->reg_mmx[reg].sd.d1 = cpu->xmm[rm].f32[1];
 
-    //if (cpu->xmm[rm].pd.f32[0] >= 2147483648.0 || cpu->xmm[rm].pd.f32[0] <= -2147483649.0) {
+    //if (cpu->xmm[rm].f32[0] >= 2147483648.0 || cpu->xmm[rm].f32[0] <= -2147483649.0) {
     //    cpu->reg_mmx[reg].sd.d0 = 0x80000000;
     //} else {
-    //    cpu->reg_mmx[reg].sd.d0 = (int32_t)cpu->xmm[rm].pd.f32[0];
+    //    cpu->reg_mmx[reg].sd.d0 = (int32_t)cpu->xmm[rm].f32[0];
     //}    
 
     // :TODO: I'm not sure if it is necessary to set the top 2 floats to 0 before doing the conversions
@@ -56,12 +56,12 @@ static void cvtps2piXmm(Armv8btAsm* data, U8 to, U8 from, bool truncate) {
 }
 
 static void cvtsd2siR32Xmm(Armv8btAsm* data, U8 to, U8 from, bool truncate) {
-    // cpu->reg[r1].u32 = cpu->xmm[rm].pd.f64[0];
+    // cpu->reg[r1].u32 = cpu->xmm[rm].f64[0];
 
-    //if (cpu->xmm[rm].pd.f64[0] >= 2147483648.0 || cpu->xmm[rm].pd.f64[0] <= -2147483649.0) {
+    //if (cpu->xmm[rm].f64[0] >= 2147483648.0 || cpu->xmm[rm].f64[0] <= -2147483649.0) {
     //    cpu->reg[r1].u32 = 0x80000000;
     //} else {
-    //    cpu->reg[r1].u32 = (int32_t)cpu->xmm[rm].pd.f64[0];
+    //    cpu->reg[r1].u32 = (int32_t)cpu->xmm[rm].f64[0];
     //}    
 
     U8 vPlusOne = data->getSSEConstant(SSE_MAX_INT32_PLUS_ONE_AS_DOUBLE);
@@ -103,13 +103,13 @@ static void cvtsd2siR32Xmm(Armv8btAsm* data, U8 to, U8 from, bool truncate) {
 }
 
 static void cvtpd2piXmm(Armv8btAsm* data, U8 to, U8 from, bool truncate) {
-    // cpu->reg_mmx[reg].sd.d0 = cpu->xmm[rm].pd.f64[0];
-    // cpu->reg_mmx[reg].sd.d1 = cpu->xmm[rm].pd.f64[1];
+    // cpu->reg_mmx[reg].sd.d0 = cpu->xmm[rm].f64[0];
+    // cpu->reg_mmx[reg].sd.d1 = cpu->xmm[rm].f64[1];
 
-    //if (cpu->xmm[rm].pd.f64[0] >= 2147483648.0 || cpu->xmm[rm].pd.f64[0] <= -2147483649.0) {
+    //if (cpu->xmm[rm].f64[0] >= 2147483648.0 || cpu->xmm[rm].f64[0] <= -2147483649.0) {
     //    cpu->reg_mmx[reg].sd.d0 = 0x80000000;
     //} else {
-    //    cpu->reg_mmx[reg].sd.d0 = (int32_t)cpu->xmm[rm].pd.f64[0];
+    //    cpu->reg_mmx[reg].sd.d0 = (int32_t)cpu->xmm[rm].f64[0];
     //}    
 
     U8 vPlusOne = data->getSSEConstant(SSE_MAX_INT32_PLUS_ONE_AS_DOUBLE);
@@ -152,12 +152,12 @@ static void cvtpd2piXmm(Armv8btAsm* data, U8 to, U8 from, bool truncate) {
 }
 
 static void cvtss2siR32Xmm(Armv8btAsm* data, U8 to, U8 from, bool truncate) {
-    // cpu->reg[r1].u32 = cpu->xmm[rm].ps.f32[0];
+    // cpu->reg[r1].u32 = cpu->xmm[rm].f32[0];
 
-    //if (cpu->xmm[rm].ps.f32[0] >= 2147483648.0 || cpu->xmm[rm].ps.f32[0] <= -2147483649.0) {
+    //if (cpu->xmm[rm].f32[0] >= 2147483648.0 || cpu->xmm[rm].f32[0] <= -2147483649.0) {
     //    cpu->reg[r1].u32 = 0x80000000;
     //} else {
-    //    cpu->reg[r1].u32 = (int32_t)cpu->xmm[rm].ps.f32[0];
+    //    cpu->reg[r1].u32 = (int32_t)cpu->xmm[rm].f32[0];
     //}    
 
     U8 vPlusOne = data->getSSEConstant(SSE_MAX_INT32_PLUS_ONE_AS_FLOAT);
@@ -246,7 +246,7 @@ void opCvtps2piMmxE64(Armv8btAsm* data) {
     data->vReleaseTmpReg(vTmpReg);
 }
 void opCvtsi2ssXmmR32(Armv8btAsm* data) {
-    // cpu->xmm[reg].pd.f32[0] = cpu->reg_mmx[reg].sd.d0;
+    // cpu->xmm[reg].f32[0] = cpu->reg_mmx[reg].sd.d0;
     U8 tmpReg = data->vGetTmpReg();
     data->vMovFromGeneralReg32(tmpReg, 0, data->getNativeReg(data->decodedOp->rm));
     data->vConvertInt32ToFloat(tmpReg, tmpReg, false);
@@ -276,8 +276,8 @@ void opCvtpd2piMmxE128(Armv8btAsm* data) {
 }
 
 void opCvtpi2pdXmmMmx(Armv8btAsm* data) {
-    // cpu->xmm[reg].pd.f64[0] = cpu->reg_mmx[reg].sd.d0;
-    // cpu->xmm[reg].pd.f64[1] = cpu->reg_mmx[reg].sd.d1;    
+    // cpu->xmm[reg].f64[0] = cpu->reg_mmx[reg].sd.d0;
+    // cpu->xmm[reg].f64[1] = cpu->reg_mmx[reg].sd.d1;    
     data->vSignExtend64To128(data->getNativeSseReg(data->decodedOp->reg), data->getNativeMmxReg(data->decodedOp->rm), S4);
     data->vConvertInt64ToDouble(data->getNativeSseReg(data->decodedOp->reg), data->getNativeSseReg(data->decodedOp->reg), true);
 }
@@ -303,7 +303,7 @@ void opCvtsd2siR32E64(Armv8btAsm* data) {
 }
 
 void opCvtsi2sdXmmR32(Armv8btAsm* data) {
-    // cpu->xmm[reg].pd.f64[0] = cpu->reg[rm].u32;
+    // cpu->xmm[reg].f64[0] = cpu->reg[rm].u32;
     U8 tmpReg = data->vGetTmpReg();
     data->vMovFromGeneralReg32(tmpReg, 0, data->getNativeReg(data->decodedOp->rm));
     data->vSignExtend64To128(tmpReg, tmpReg, S4);
@@ -345,8 +345,8 @@ void opCvttsd2siR32E64(Armv8btAsm* data) {
 }
 
 void opCvtpi2psXmmMmx(Armv8btAsm* data) {
-    // cpu->xmm[reg].pd.f32[0] = cpu->reg_mmx[reg].sd.d0;
-    // cpu->xmm[reg].pd.f32[1] = cpu->reg_mmx[reg].sd.d1; 
+    // cpu->xmm[reg].f32[0] = cpu->reg_mmx[reg].sd.d0;
+    // cpu->xmm[reg].f32[1] = cpu->reg_mmx[reg].sd.d1; 
     U8 tmpReg = data->vGetTmpReg();
     data->vConvertInt32ToFloat(tmpReg, data->getNativeSseReg(data->decodedOp->reg), true);
     data->vMov64(data->getNativeSseReg(data->decodedOp->reg), 0, tmpReg, 0); // need to maintain the high 64-bits
@@ -363,10 +363,10 @@ void opCvtpi2psXmmE64(Armv8btAsm* data) {
 }
 
 void opCvtpd2psXmmXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].ps.f32[0] = (float)cpu->xmm[rm].pd.f64[0];
-    // cpu->xmm[reg].ps.f32[1] = (float)cpu->xmm[rm].pd.f64[1];
-    // cpu->xmm[reg].pi.u32[2] = 0
-    // cpu->xmm[reg].pi.u32[3] = 0
+    // cpu->xmm[reg].f32[0] = (float)cpu->xmm[rm].f64[0];
+    // cpu->xmm[reg].f32[1] = (float)cpu->xmm[rm].f64[1];
+    // cpu->xmm[reg].u32[2] = 0
+    // cpu->xmm[reg].u32[3] = 0
     U8 tmpReg = data->vGetTmpReg();
     data->vLoadConst(tmpReg, 0, B16);
     data->vConvertDoubleToFloatRoundToCurrentModeAndKeep(tmpReg, data->getNativeSseReg(data->decodedOp->rm));
@@ -384,8 +384,8 @@ void opCvtpd2psXmmE128(Armv8btAsm* data) {
 }
 
 void opCvtps2pdXmmXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].pd.f64[0] = (double)cpu->xmm[rm].ps.f32[0];
-    // cpu->xmm[reg].pd.f64[1] = (double)cpu->xmm[rm].ps.f32[1];
+    // cpu->xmm[reg].f64[0] = (double)cpu->xmm[rm].f32[0];
+    // cpu->xmm[reg].f64[1] = (double)cpu->xmm[rm].f32[1];
     data->vConvertFloatToDouble(data->getNativeSseReg(data->decodedOp->reg), data->getNativeSseReg(data->decodedOp->rm), true);
 }
 
@@ -399,7 +399,7 @@ void opCvtps2pdXmmE64(Armv8btAsm* data) {
 }
 
 void opCvtsd2ssXmmXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].ps.f32[0] = (double)cpu->xmm[rm].pd.f64[0];
+    // cpu->xmm[reg].f32[0] = (double)cpu->xmm[rm].f64[0];
     U8 tmpReg = data->vGetTmpReg();
     data->vConvertDoubleToFloatRoundToCurrentModeAndKeep(tmpReg, data->getNativeSseReg(data->decodedOp->rm));
     data->vMov32(data->getNativeSseReg(data->decodedOp->reg), 0, tmpReg, 0);
@@ -416,8 +416,8 @@ void opCvtsd2ssXmmE64(Armv8btAsm* data) {
 }
 
 void opCvtdq2pdXmmXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].pd.f64[0] = (double)cpu->xmm[rm].pi.i32[0];
-    // cpu->xmm[reg].pd.f64[1] = (double)cpu->xmm[rm].pi.i32[1];
+    // cpu->xmm[reg].f64[0] = (double)cpu->xmm[rm].i32[0];
+    // cpu->xmm[reg].f64[1] = (double)cpu->xmm[rm].i32[1];
     data->vSignExtend64To128(data->getNativeSseReg(data->decodedOp->reg), data->getNativeSseReg(data->decodedOp->rm), S4);
     data->vConvertInt64ToDouble(data->getNativeSseReg(data->decodedOp->reg), data->getNativeSseReg(data->decodedOp->reg), true);
 }
@@ -432,10 +432,10 @@ void opCvtdq2pdXmmE128(Armv8btAsm* data) {
 }
 
 void opCvtdq2psXmmXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].ps.f32[0] = (float)cpu->xmm[rm].pi.i32[0];
-    // cpu->xmm[reg].ps.f32[1] = (float)cpu->xmm[rm].pi.i32[1];
-    // cpu->xmm[reg].ps.f32[2] = (float)cpu->xmm[rm].pi.i32[2];
-    // cpu->xmm[reg].ps.f32[3] = (float)cpu->xmm[rm].pi.i32[3];
+    // cpu->xmm[reg].f32[0] = (float)cpu->xmm[rm].i32[0];
+    // cpu->xmm[reg].f32[1] = (float)cpu->xmm[rm].i32[1];
+    // cpu->xmm[reg].f32[2] = (float)cpu->xmm[rm].i32[2];
+    // cpu->xmm[reg].f32[3] = (float)cpu->xmm[rm].i32[3];
     data->vConvertInt32ToFloat(data->getNativeSseReg(data->decodedOp->reg), data->getNativeSseReg(data->decodedOp->rm), true);
 }
 void opCvtdq2psXmmE128(Armv8btAsm* data) {
@@ -471,7 +471,7 @@ void opCvtps2dqXmmE128(Armv8btAsm* data) {
 }
 
 void opCvtss2sdXmmXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].pd.f64[0] = (float)cpu->xmm[rm].ps.f32[0];
+    // cpu->xmm[reg].f64[0] = (float)cpu->xmm[rm].f32[0];
     U8 tmpReg = data->vGetTmpReg();
     data->vConvertFloatToDouble(tmpReg, data->getNativeSseReg(data->decodedOp->rm), false);
     data->vMov64(data->getNativeSseReg(data->decodedOp->reg), 0, tmpReg, 0);
@@ -487,10 +487,10 @@ void opCvtss2sdXmmE32(Armv8btAsm* data) {
     data->vReleaseTmpReg(tmpReg);
 }
 void opCvttpd2dqXmmXmm(Armv8btAsm* data) {
-    // cpu->xmm[reg].pi.s32[0] = (S32)cpu->xmm[rm].pd.f64[0];
-    // cpu->xmm[reg].pi.s32[1] = (S32)cpu->xmm[rm].pd.f64[1];
-    // cpu->xmm[reg].pi.u32[2] = 0
-    // cpu->xmm[reg].pi.u32[3] = 0
+    // cpu->xmm[reg].pi.s32[0] = (S32)cpu->xmm[rm].f64[0];
+    // cpu->xmm[reg].pi.s32[1] = (S32)cpu->xmm[rm].f64[1];
+    // cpu->xmm[reg].u32[2] = 0
+    // cpu->xmm[reg].u32[3] = 0
     cvtpd2piXmm(data, data->getNativeSseReg(data->decodedOp->reg), data->getNativeSseReg(data->decodedOp->rm), true);
 }
 void opCvttpd2dqXmmE128(Armv8btAsm* data) {
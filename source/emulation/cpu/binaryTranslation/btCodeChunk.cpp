@@ -159,11 +159,18 @@ std::shared_ptr<BtCodeChunkLink> BtCodeChunk::addLinkFrom(std::shared_ptr<BtCode
 }
 
 void BtCodeChunk::releaseAndRetranslate() {
-    // remove this chunk and its mappings from being used (since it is about to be replaced)
     BtCPU* cpu = (BtCPU*)KThread::currentThread()->cpu;
+    U32 ip = this->emulatedAddress - cpu->seg[CS].address;
+    this->releaseAndReplace(cpu, [cpu, ip]() {
+        return cpu->translateChunk(ip);
+        });
+}
+
+void BtCodeChunk::releaseAndReplace(BtCPU* cpu, const std::function<std::shared_ptr<BtCodeChunk>(void)>& translate) {
+    // remove this chunk and its mappings from being used (since it is about to be replaced)
     detachFromHost(cpu->thread->memory);
 
-    std::shared_ptr<BtCodeChunk> chunk = cpu->translateChunk(this->emulatedAddress - cpu->seg[CS].address);
+    std::shared_ptr<BtCodeChunk> chunk = translate();
     cpu->makePendingCodePagesReadOnly();
     for (auto& link : this->linksFrom) {
         U64 destHost = (U64)chunk->getHostFromEip(link->toEip);
@@ -25,6 +25,8 @@ public:
 
     void release(Memory* memory);
     void releaseAndRetranslate();
+    // like releaseAndRetranslate, but the new chunk comes from translate, which runs after this chunk is detached
+    void releaseAndReplace(BtCPU* cpu, const std::function<std::shared_ptr<BtCodeChunk>(void)>& translate);
     void invalidateStartingAt(U32 eipAddress);
     void makeLive();
 
@@ -196,7 +196,7 @@ void common_FDIVR_ST0_STj(CPU* cpu, U32 reg) {
 }
 
 void common_FLD_SINGLE_REAL(CPU* cpu,U32 address) {
-    U32 value = readd(address); // might generate PF, so do before we adjust the stack
+    U32 value = readd(cpu->thread->memory, address); // might generate PF, so do before we adjust the stack
     cpu->fpu.PREP_PUSH();
     cpu->fpu.FLD_F32(value, cpu->fpu.STV(0));
 #ifdef LOG_FPU
@@ -249,7 +249,7 @@ void common_FNSTCW(CPU* cpu, U32 address) {
 #ifdef LOG_FPU
     flog("FNSTCW %.04X @%.08X", cpu->fpu.CW(), address);
 #endif
-    writew(address, cpu->fpu.CW());
+    writew(cpu->thread->memory, address, cpu->fpu.CW());
 }
 
 void common_FLD_STi(CPU* cpu, U32 reg) {
@@ -516,7 +516,7 @@ void common_FIADD_DWORD_INTEGER(CPU* cpu, U32 address) {
     cpu->fpu.FLD_I32_EA(cpu, address);
     cpu->fpu.FADD_EA();
 #ifdef LOG_FPU
-    flog("FIADD %f + %f (%X) = %f", d, cpu->fpu.regs[8].d, readd(address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
+    flog("FIADD %f + %f (%X) = %f", d, cpu->fpu.regs[8].d, readd(cpu->thread->memory, address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -528,7 +528,7 @@ void common_FIMUL_DWORD_INTEGER(CPU* cpu, U32 address) {
     cpu->fpu.FLD_I32_EA(cpu, address);
     cpu->fpu.FMUL_EA();
 #ifdef LOG_FPU
-    flog("FIMUL %f * %f (%X) = %f", d, cpu->fpu.regs[8].d, readd(address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
+    flog("FIMUL %f * %f (%X) = %f", d, cpu->fpu.regs[8].d, readd(cpu->thread->memory, address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -537,7 +537,7 @@ void common_FICOM_DWORD_INTEGER(CPU* cpu, U32 address) {
     cpu->fpu.FLD_I32_EA(cpu, address);
     cpu->fpu.FCOM_EA();
 #ifdef LOG_FPU
-    flog("FICOM %f  %f (%X)", cpu->fpu.regs[8].d, readd(address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
+    flog("FICOM %f  %f (%X)", cpu->fpu.regs[8].d, readd(cpu->thread->memory, address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -546,7 +546,7 @@ void common_FICOM_DWORD_INTEGER_Pop(CPU* cpu, U32 address) {
     cpu->fpu.FLD_I32_EA(cpu, address);
     cpu->fpu.FCOM_EA();
 #ifdef LOG_FPU
-    flog("FICOMP %f  %f (%X)", cpu->fpu.regs[8].d, readd(address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
+    flog("FICOMP %f  %f (%X)", cpu->fpu.regs[8].d, readd(cpu->thread->memory, address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
 #endif
     cpu->fpu.FPOP();
 #ifdef LOG_FPU
@@ -561,7 +561,7 @@ void common_FISUB_DWORD_INTEGER(CPU* cpu, U32 address) {
     cpu->fpu.FLD_I32_EA(cpu, address);
     cpu->fpu.FSUB_EA();
 #ifdef LOG_FPU
-    flog("FISUB %f - %f (%X) = %f", d, cpu->fpu.regs[8].d, readd(address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
+    flog("FISUB %f - %f (%X) = %f", d, cpu->fpu.regs[8].d, readd(cpu->thread->memory, address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -573,7 +573,7 @@ void common_FISUBR_DWORD_INTEGER(CPU* cpu, U32 address) {
     cpu->fpu.FLD_I32_EA(cpu, address);
     cpu->fpu.FSUBR_EA();
 #ifdef LOG_FPU
-    flog("FISUBR %f (%X) - %f = %f", cpu->fpu.regs[8].d, readd(address), d, cpu->fpu.regs[cpu->fpu.STV(0)].d);
+    flog("FISUBR %f (%X) - %f = %f", cpu->fpu.regs[8].d, readd(cpu->thread->memory, address), d, cpu->fpu.regs[cpu->fpu.STV(0)].d);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -585,7 +585,7 @@ void common_FIDIV_DWORD_INTEGER(CPU* cpu, U32 address) {
     cpu->fpu.FLD_I32_EA(cpu, address);
     cpu->fpu.FDIV_EA();
 #ifdef LOG_FPU
-    flog("FIDIV %f / %f (%X) = %f", d, cpu->fpu.regs[8].d, readd(address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
+    flog("FIDIV %f / %f (%X) = %f", d, cpu->fpu.regs[8].d, readd(cpu->thread->memory, address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -597,7 +597,7 @@ void common_FIDIVR_DWORD_INTEGER(CPU* cpu, U32 address) {
     cpu->fpu.FLD_I32_EA(cpu, address);
     cpu->fpu.FDIVR_EA();
 #ifdef LOG_FPU
-    flog("FIDIVR %f (%X) / %f = %f", cpu->fpu.regs[8].d, readd(address), d, cpu->fpu.regs[cpu->fpu.STV(0)].d);
+    flog("FIDIVR %f (%X) / %f = %f", cpu->fpu.regs[8].d, readd(cpu->thread->memory, address), d, cpu->fpu.regs[cpu->fpu.STV(0)].d);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -711,7 +711,7 @@ void common_FUCOMPP(CPU* cpu) {
 }
 
 void common_FILD_DWORD_INTEGER(CPU* cpu, U32 address) {
-    U32 value = readd(address); // might generate PF, so do before we adjust the stack
+    U32 value = readd(cpu->thread->memory, address); // might generate PF, so do before we adjust the stack
     cpu->fpu.PREP_PUSH();
     cpu->fpu.FLD_I32(value, cpu->fpu.STV(0));
 #ifdef LOG_FPU
@@ -724,7 +724,7 @@ void common_FISTTP32(CPU* cpu, U32 address) {
     cpu->fpu.FSTT_I32(cpu, address);
     cpu->fpu.FPOP();
 #ifdef LOG_FPU
-    flog("FISTTP32 %d @%.08X", readd(address), address);
+    flog("FISTTP32 %d @%.08X", readd(cpu->thread->memory, address), address);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -732,7 +732,7 @@ void common_FISTTP32(CPU* cpu, U32 address) {
 void common_FIST_DWORD_INTEGER(CPU* cpu, U32 address) {
     cpu->fpu.FST_I32(cpu, address);
 #ifdef LOG_FPU
-    flog("FIST I32 %d @%.08X", readd(address), address);
+    flog("FIST I32 %d @%.08X", readd(cpu->thread->memory, address), address);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -741,14 +741,14 @@ void common_FIST_DWORD_INTEGER_Pop(CPU* cpu, U32 address) {
     cpu->fpu.FST_I32(cpu, address);
     cpu->fpu.FPOP();
 #ifdef LOG_FPU
-    flog("FISTP I32 %d @%.08X", readd(address), address);
+    flog("FISTP I32 %d @%.08X", readd(cpu->thread->memory, address), address);
     cpu->fpu.LOG_STACK();
 #endif
 }
 
 void common_FLD_EXTENDED_REAL(CPU* cpu, U32 address) {
-    U64 low = readq(address); // might generate PF, so do before we adjust the stack
-    U32 high = readw(address + 8);
+    U64 low = readq(cpu->thread->memory, address); // might generate PF, so do before we adjust the stack
+    U32 high = readw(cpu->thread->memory, address + 8);
     cpu->fpu.PREP_PUSH();
     cpu->fpu.FLD_F80(low, high);
 #ifdef LOG_FPU
@@ -1070,7 +1070,7 @@ void common_FDIV_STi_ST0_Pop(CPU* cpu, U32 reg) {
 }
 
 void common_FLD_DOUBLE_REAL(CPU* cpu, U32 address) {
-    U64 value = readq(address); // might generate PF, so do before we adjust the stack
+    U64 value = readq(cpu->thread->memory, address); // might generate PF, so do before we adjust the stack
     cpu->fpu.PREP_PUSH();
     cpu->fpu.FLD_F64(value, cpu->fpu.STV(0));
 #ifdef LOG_FPU
@@ -1086,7 +1086,7 @@ void common_FISTTP64(CPU* cpu, U32 address) {
     cpu->fpu.FSTT_I64(cpu, address);
     cpu->fpu.FPOP();
 #ifdef LOG_FPU
-    flog("FISTTP64 %f -> %" PRIx64 " @%.08X", d, readq(address), address);
+    flog("FISTTP64 %f -> %" PRIx64 " @%.08X", d, readq(cpu->thread->memory, address), address);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -1127,7 +1127,7 @@ void common_FNSAVE(CPU* cpu, U32 address) {
 }
 
 void common_FNSTSW(CPU* cpu, U32 address) {
-    writew(address, cpu->fpu.SW());
+    writew(cpu->thread->memory, address, cpu->fpu.SW());
 #ifdef LOG_FPU
     flog("FNSTSW %X @%.08X", cpu->fpu.SW(), address);
     cpu->fpu.LOG_STACK();
@@ -1168,7 +1168,7 @@ void common_FIADD_WORD_INTEGER(CPU* cpu, U32 address) {
     cpu->fpu.FLD_I16_EA(cpu, address);
     cpu->fpu.FADD_EA();
 #ifdef LOG_FPU
-    flog("FIADD %f + %f (%X) = %f", d, cpu->fpu.regs[8].d, readw(address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
+    flog("FIADD %f + %f (%X) = %f", d, cpu->fpu.regs[8].d, readw(cpu->thread->memory, address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -1180,7 +1180,7 @@ void common_FIMUL_WORD_INTEGER(CPU* cpu, U32 address) {
     cpu->fpu.FLD_I16_EA(cpu, address);
     cpu->fpu.FMUL_EA();
 #ifdef LOG_FPU
-    flog("FIMUL %f * %f (%X) = %f", d, cpu->fpu.regs[8].d, readw(address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
+    flog("FIMUL %f * %f (%X) = %f", d, cpu->fpu.regs[8].d, readw(cpu->thread->memory, address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -1189,7 +1189,7 @@ void common_FICOM_WORD_INTEGER(CPU* cpu, U32 address) {
     cpu->fpu.FLD_I16_EA(cpu, address);
     cpu->fpu.FCOM_EA();
 #ifdef LOG_FPU
-    flog("FICOM %f %f (%X)", cpu->fpu.regs[cpu->fpu.STV(0)].d, cpu->fpu.regs[8].d, readw(address));
+    flog("FICOM %f %f (%X)", cpu->fpu.regs[cpu->fpu.STV(0)].d, cpu->fpu.regs[8].d, readw(cpu->thread->memory, address));
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -1198,7 +1198,7 @@ void common_FICOM_WORD_INTEGER_Pop(CPU* cpu, U32 address) {
     cpu->fpu.FLD_I16_EA(cpu, address);
     cpu->fpu.FCOM_EA();
 #ifdef LOG_FPU
-    flog("FICOM %f %f (%X)", cpu->fpu.regs[cpu->fpu.STV(0)].d, cpu->fpu.regs[8].d, readw(address));
+    flog("FICOM %f %f (%X)", cpu->fpu.regs[cpu->fpu.STV(0)].d, cpu->fpu.regs[8].d, readw(cpu->thread->memory, address));
 #endif
     cpu->fpu.FPOP();
 #ifdef LOG_FPU
@@ -1213,7 +1213,7 @@ void common_FISUB_WORD_INTEGER(CPU* cpu, U32 address) {
     cpu->fpu.FLD_I16_EA(cpu, address);
     cpu->fpu.FSUB_EA();
 #ifdef LOG_FPU
-    flog("FISUB %f - %f (%X) = %f", d, cpu->fpu.regs[8].d, readw(address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
+    flog("FISUB %f - %f (%X) = %f", d, cpu->fpu.regs[8].d, readw(cpu->thread->memory, address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -1225,7 +1225,7 @@ void common_FISUBR_WORD_INTEGER(CPU* cpu, U32 address) {
     cpu->fpu.FLD_I16_EA(cpu, address);
     cpu->fpu.FSUBR_EA();
 #ifdef LOG_FPU
-    flog("FISUBR %f (%X) - f = %f", cpu->fpu.regs[8].d, readw(address), d, cpu->fpu.regs[cpu->fpu.STV(0)].d);
+    flog("FISUBR %f (%X) - f = %f", cpu->fpu.regs[8].d, readw(cpu->thread->memory, address), d, cpu->fpu.regs[cpu->fpu.STV(0)].d);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -1237,7 +1237,7 @@ void common_FIDIV_WORD_INTEGER(CPU* cpu, U32 address) {
     cpu->fpu.FLD_I16_EA(cpu, address);
     cpu->fpu.FDIV_EA();
 #ifdef LOG_FPU
-    flog("FIDIV %f / %f (%X) = %f", d, cpu->fpu.regs[8].d, readw(address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
+    flog("FIDIV %f / %f (%X) = %f", d, cpu->fpu.regs[8].d, readw(cpu->thread->memory, address), cpu->fpu.regs[cpu->fpu.STV(0)].d);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -1249,7 +1249,7 @@ void common_FIDIVR_WORD_INTEGER(CPU* cpu, U32 address) {
     cpu->fpu.FLD_I16_EA(cpu, address);
     cpu->fpu.FDIVR_EA();
 #ifdef LOG_FPU
-    flog("FIDIVR %f (%X) / f = %f", cpu->fpu.regs[8].d, readw(address), d, cpu->fpu.regs[cpu->fpu.STV(0)].d);
+    flog("FIDIVR %f (%X) / f = %f", cpu->fpu.regs[8].d, readw(cpu->thread->memory, address), d, cpu->fpu.regs[cpu->fpu.STV(0)].d);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -1267,7 +1267,7 @@ void common_FCOMPP(CPU* cpu) {
 }
 
 void common_FILD_WORD_INTEGER(CPU* cpu, U32 address) {
-    S16 value = (S16)readw(address); // might generate PF, so do before we adjust the stack
+    S16 value = (S16)readw(cpu->thread->memory, address); // might generate PF, so do before we adjust the stack
     cpu->fpu.PREP_PUSH();
     cpu->fpu.FLD_I16(value, cpu->fpu.STV(0));
 #ifdef LOG_FPU
@@ -1280,7 +1280,7 @@ void common_FISTTP16(CPU* cpu, U32 address) {
     cpu->fpu.FSTT_I16(cpu, address);
     cpu->fpu.FPOP();
 #ifdef LOG_FPU
-    flog("FISTTP16 %d @%.08X", readw(address), address);
+    flog("FISTTP16 %d @%.08X", readw(cpu->thread->memory, address), address);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -1288,7 +1288,7 @@ void common_FISTTP16(CPU* cpu, U32 address) {
 void common_FIST_WORD_INTEGER(CPU* cpu, U32 address) {
     cpu->fpu.FST_I16(cpu, address);
 #ifdef LOG_FPU
-    flog("FIST I16 %d @%.08X", readw(address), address);
+    flog("FIST I16 %d @%.08X", readw(cpu->thread->memory, address), address);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -1297,7 +1297,7 @@ void common_FIST_WORD_INTEGER_Pop(CPU* cpu, U32 address) {
     cpu->fpu.FST_I16(cpu, address);
     cpu->fpu.FPOP();
 #ifdef LOG_FPU
-    flog("FISTP I16 %d @%.08X", readw(address), address);
+    flog("FISTP I16 %d @%.08X", readw(cpu->thread->memory, address), address);
     cpu->fpu.LOG_STACK();
 #endif
 }
@@ -1314,7 +1314,7 @@ void common_FBLD_PACKED_BCD(CPU* cpu, U32 address) {
 }
 
 void common_FILD_QWORD_INTEGER(CPU* cpu, U32 address) {
-    U64 value = readq(address); // might generate PF, so do before we adjust the stack
+    U64 value = readq(cpu->thread->memory, address); // might generate PF, so do before we adjust the stack
     cpu->fpu.PREP_PUSH();
     cpu->fpu.FLD_I64(value, cpu->fpu.STV(0));
 #ifdef LOG_FPU
@@ -199,8 +199,8 @@ void common_fxsave(CPU* cpu, U32 address) {
         }
     }
     for (int i=0;i<8;i++) {
-        writeq(address+160+i*16, cpu->xmm[i].pi.u64[0]);
-        writeq(address+168+i*16, cpu->xmm[i].pi.u64[1]);
+        writeq(address+160+i*16, cpu->xmm[i].u64[0]);
+        writeq(address+168+i*16, cpu->xmm[i].u64[1]);
     }
 }
 
@@ -213,8 +213,8 @@ void common_fxrstor(CPU* cpu, U32 address) {
         cpu->fpu.FLD_F80(readq(address+32+i*16), (S16)readw(address+40+i*16));
     }
     for (int i=0;i<8;i++) {
-        cpu->xmm[i].pi.u64[0] = readq(address+160+i*16);
-        cpu->xmm[i].pi.u64[1] = readq(address+168+i*16);
+        cpu->xmm[i].u64[0] = readq(address+160+i*16);
+        cpu->xmm[i].u64[1] = readq(address+168+i*16);
     }
 }
 
@@ -25,10 +25,10 @@ void common_addpsXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_addpsE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].ps = simde_mm_add_ps(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].ps = simde_mm_add_ps(cpu->xmm[reg].ps, value.ps);
 }
 
 void common_addssXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -36,9 +36,9 @@ void common_addssXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_addssE32(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u32[0] = readd(address);
-    cpu->xmm[reg].ps = simde_mm_add_ss(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u32[0] = readd(cpu->thread->memory, address);
+    cpu->xmm[reg].ps = simde_mm_add_ss(cpu->xmm[reg].ps, value.ps);
 }
 
 void common_subpsXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -46,10 +46,10 @@ void common_subpsXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_subpsE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].ps = simde_mm_sub_ps(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].ps = simde_mm_sub_ps(cpu->xmm[reg].ps, value.ps);
 }
 
 void common_subssXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -57,9 +57,9 @@ void common_subssXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_subssE32(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u32[0] = readd(address);
-    cpu->xmm[reg].ps = simde_mm_sub_ss(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u32[0] = readd(cpu->thread->memory, address);
+    cpu->xmm[reg].ps = simde_mm_sub_ss(cpu->xmm[reg].ps, value.ps);
 }
 
 void common_mulpsXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -67,10 +67,10 @@ void common_mulpsXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_mulpsE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].ps = simde_mm_mul_ps(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].ps = simde_mm_mul_ps(cpu->xmm[reg].ps, value.ps);
 }
 
 void common_mulssXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -78,9 +78,9 @@ void common_mulssXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_mulssE32(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u32[0] = readd(address);
-    cpu->xmm[reg].ps = simde_mm_mul_ss(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u32[0] = readd(cpu->thread->memory, address);
+    cpu->xmm[reg].ps = simde_mm_mul_ss(cpu->xmm[reg].ps, value.ps);
 }
 
 void common_divpsXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -88,10 +88,10 @@ void common_divpsXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_divpsE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].ps = simde_mm_div_ps(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].ps = simde_mm_div_ps(cpu->xmm[reg].ps, value.ps);
 }
 
 void common_divssXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -99,9 +99,9 @@ void common_divssXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_divssE32(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u32[0] = readd(address);
-    cpu->xmm[reg].ps = simde_mm_div_ss(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u32[0] = readd(cpu->thread->memory, address);
+    cpu->xmm[reg].ps = simde_mm_div_ss(cpu->xmm[reg].ps, value.ps);
 }
 
 void common_rcppsXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -109,10 +109,10 @@ void common_rcppsXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_rcppsE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].ps = simde_mm_rcp_ps(value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].ps = simde_mm_rcp_ps(value.ps);
 }
 
 void common_rcpssXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -120,9 +120,10 @@ void common_rcpssXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_rcpssE32(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value = cpu->xmm[reg].ps;
-    value.u32[0] = readd(address);
-    cpu->xmm[reg].ps = simde_mm_rcp_ss(value);
+    SSE value;
+    value.ps = cpu->xmm[reg].ps;
+    value.u32[0] = readd(cpu->thread->memory, address);
+    cpu->xmm[reg].ps = simde_mm_rcp_ss(value.ps);
 }
 
 void common_sqrtpsXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -130,10 +131,10 @@ void common_sqrtpsXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_sqrtpsE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);  
-    cpu->xmm[reg].ps = simde_mm_sqrt_ps(value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);  
+    cpu->xmm[reg].ps = simde_mm_sqrt_ps(value.ps);
 }
 
 void common_sqrtssXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -141,9 +142,10 @@ void common_sqrtssXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_sqrtssE32(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value = cpu->xmm[reg].ps;
-    value.u32[0] = readd(address);
-    cpu->xmm[reg].ps = simde_mm_sqrt_ss(value);
+    SSE value;
+    value.ps = cpu->xmm[reg].ps;
+    value.u32[0] = readd(cpu->thread->memory, address);
+    cpu->xmm[reg].ps = simde_mm_sqrt_ss(value.ps);
 }
 
 void common_rsqrtpsXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -151,10 +153,10 @@ void common_rsqrtpsXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_rsqrtpsE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);  
-    cpu->xmm[reg].ps = simde_mm_rsqrt_ps(value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);  
+    cpu->xmm[reg].ps = simde_mm_rsqrt_ps(value.ps);
 }
 
 void common_rsqrtssXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -162,9 +164,10 @@ void common_rsqrtssXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_rsqrtssE32(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value = cpu->xmm[reg].ps;
-    value.u32[0] = readd(address);
-    cpu->xmm[reg].ps = simde_mm_rsqrt_ss(value);
+    SSE value;
+    value.ps = cpu->xmm[reg].ps;
+    value.u32[0] = readd(cpu->thread->memory, address);
+    cpu->xmm[reg].ps = simde_mm_rsqrt_ss(value.ps);
 }
 
 void common_maxpsXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -172,10 +175,10 @@ void common_maxpsXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_maxpsE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);  
-    cpu->xmm[reg].ps = simde_mm_max_ps(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);  
+    cpu->xmm[reg].ps = simde_mm_max_ps(cpu->xmm[reg].ps, value.ps);
 }
 
 void common_maxssXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -183,9 +186,9 @@ void common_maxssXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_maxssE32(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u32[0] = readd(address);
-    cpu->xmm[reg].ps = simde_mm_max_ss(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u32[0] = readd(cpu->thread->memory, address);
+    cpu->xmm[reg].ps = simde_mm_max_ss(cpu->xmm[reg].ps, value.ps);
 }
 
 void common_minpsXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -193,10 +196,10 @@ void common_minpsXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_minpsE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);  
-    cpu->xmm[reg].ps = simde_mm_min_ps(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);  
+    cpu->xmm[reg].ps = simde_mm_min_ps(cpu->xmm[reg].ps, value.ps);
 }
 
 void common_minssXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -204,203 +207,161 @@ void common_minssXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_minssE32(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u32[0] = readd(address);
-    cpu->xmm[reg].ps = simde_mm_min_ss(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u32[0] = readd(cpu->thread->memory, address);
+    cpu->xmm[reg].ps = simde_mm_min_ss(cpu->xmm[reg].ps, value.ps);
 }
 
 void common_pavgbMmxMmx(CPU* cpu, U32 r1, U32 r2) {
-    simde__m64 m1;
-    simde__m64 m2;
-    m1.u64[0] = cpu->reg_mmx[r1].q;
-    m2.u64[0] = cpu->reg_mmx[r2].q;
+    simde__m64 m1 = simde_mm_cvtsi64_m64(cpu->reg_mmx[r1].q);
+    simde__m64 m2 = simde_mm_cvtsi64_m64(cpu->reg_mmx[r2].q);
     simde__m64 r = simde_mm_avg_pu8(m1, m2);
-    cpu->reg_mmx[r1].q = r.u64[0];
+    cpu->reg_mmx[r1].q = simde_mm_cvtm64_si64(r);
 }
 
 void common_pavgbMmxE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m64 m1;
-    simde__m64 m2;
-    m1.u64[0] = cpu->reg_mmx[reg].q;
-    m2.u64[0] = readq(address);
+    simde__m64 m1 = simde_mm_cvtsi64_m64(cpu->reg_mmx[reg].q);
+    simde__m64 m2 = simde_mm_cvtsi64_m64(readq(cpu->thread->memory, address));
     simde__m64 r = simde_mm_avg_pu8(m1, m2);
-    cpu->reg_mmx[reg].q = r.u64[0];
+    cpu->reg_mmx[reg].q = simde_mm_cvtm64_si64(r);
 }
 
 void common_pavgwMmxMmx(CPU* cpu, U32 r1, U32 r2) {
-    simde__m64 m1;
-    simde__m64 m2;
-    m1.u64[0] = cpu->reg_mmx[r1].q;
-    m2.u64[0] = cpu->reg_mmx[r2].q;
+    simde__m64 m1 = simde_mm_cvtsi64_m64(cpu->reg_mmx[r1].q);
+    simde__m64 m2 = simde_mm_cvtsi64_m64(cpu->reg_mmx[r2].q);
     simde__m64 r = simde_mm_avg_pu16(m1, m2);
-    cpu->reg_mmx[r1].q = r.u64[0];
+    cpu->reg_mmx[r1].q = simde_mm_cvtm64_si64(r);
 }
 
 void common_pavgwMmxE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m64 m1;
-    simde__m64 m2;
-    m1.u64[0] = cpu->reg_mmx[reg].q;
-    m2.u64[0] = readq(address);
+    simde__m64 m1 = simde_mm_cvtsi64_m64(cpu->reg_mmx[reg].q);
+    simde__m64 m2 = simde_mm_cvtsi64_m64(readq(cpu->thread->memory, address));
     simde__m64 r = simde_mm_avg_pu16(m1, m2);
-    cpu->reg_mmx[reg].q = r.u64[0];
+    cpu->reg_mmx[reg].q = simde_mm_cvtm64_si64(r);
 }
 
 void common_psadbwMmxMmx(CPU* cpu, U32 r1, U32 r2) {
-    simde__m64 m1;
-    simde__m64 m2;
-    m1.u64[0] = cpu->reg_mmx[r1].q;
-    m2.u64[0] = cpu->reg_mmx[r2].q;
+    simde__m64 m1 = simde_mm_cvtsi64_m64(cpu->reg_mmx[r1].q);
+    simde__m64 m2 = simde_mm_cvtsi64_m64(cpu->reg_mmx[r2].q);
     simde__m64 r = simde_mm_sad_pu8(m1, m2);
-    cpu->reg_mmx[r1].q = r.u64[0];
+    cpu->reg_mmx[r1].q = simde_mm_cvtm64_si64(r);
 }
 
 void common_psadbwMmxE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m64 m1;
-    simde__m64 m2;
-    m1.u64[0] = cpu->reg_mmx[reg].q;
-    m2.u64[0] = readq(address);
+    simde__m64 m1 = simde_mm_cvtsi64_m64(cpu->reg_mmx[reg].q);
+    simde__m64 m2 = simde_mm_cvtsi64_m64(readq(cpu->thread->memory, address));
     simde__m64 r = simde_mm_sad_pu8(m1, m2);
-    cpu->reg_mmx[reg].q = r.u64[0];
+    cpu->reg_mmx[reg].q = simde_mm_cvtm64_si64(r);
 }
 
 void common_pextrwR32Mmx(CPU* cpu, U32 r1, U32 r2, U8 imm) {
-    simde__m64 m;
-    m.u64[0] = cpu->reg_mmx[r2].q;
-    cpu->reg[r1].u32 = simde_mm_extract_pi16(m, imm);
+    cpu->reg[r1].u32 = (U16)(cpu->reg_mmx[r2].q >> ((imm & 3) * 16));
 }
 
 void common_pextrwE16Mmx(CPU* cpu, U32 reg, U32 address, U8 imm) {
-    simde__m64 m;
-    m.u64[0] = cpu->reg_mmx[reg].q;
-    writew(address, (U16)simde_mm_extract_pi16(m, imm));
+    writew(cpu->thread->memory, address, (U16)(cpu->reg_mmx[reg].q >> ((imm & 3) * 16)));
 }
 
 void common_pinsrwMmxR32(CPU* cpu, U32 r1, U32 r2, U8 imm) {
-    simde__m64 m;
-    m.u64[0] = cpu->reg_mmx[r1].q;
-    m = simde_mm_insert_pi16(m, cpu->reg[r2].u16, imm);
-    cpu->reg_mmx[r1].q = m.u64[0];
+    U32 shift = (imm & 3) * 16;
+    cpu->reg_mmx[r1].q = (cpu->reg_mmx[r1].q & ~(0xFFFFull << shift)) | ((U64)cpu->reg[r2].u16 << shift);
 }
 
 void common_pinsrwMmxE16(CPU* cpu, U32 reg, U32 address, U8 imm) {
-    simde__m64 m;
-    m.u64[0] = cpu->reg_mmx[reg].q;
-    m = simde_mm_insert_pi16(m, readw(address), imm);
-    cpu->reg_mmx[reg].q = m.u64[0];
+    U32 shift = (imm & 3) * 16;
+    cpu->reg_mmx[reg].q = (cpu->reg_mmx[reg].q & ~(0xFFFFull << shift)) | ((U64)readw(cpu->thread->memory, address) << shift);
 }
 
 void common_pmaxswMmxMmx(CPU* cpu, U32 r1, U32 r2) {
-    simde__m64 m1;
-    simde__m64 m2;
-    m1.u64[0] = cpu->reg_mmx[r1].q;
-    m2.u64[0] = cpu->reg_mmx[r2].q;
+    simde__m64 m1 = simde_mm_cvtsi64_m64(cpu->reg_mmx[r1].q);
+    simde__m64 m2 = simde_mm_cvtsi64_m64(cpu->reg_mmx[r2].q);
     simde__m64 r = simde_mm_max_pi16(m1, m2);
-    cpu->reg_mmx[r1].q = r.u64[0];
+    cpu->reg_mmx[r1].q = simde_mm_cvtm64_si64(r);
 }
 
 void common_pmaxswMmxE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m64 m1;
-    simde__m64 m2;
-    m1.u64[0] = cpu->reg_mmx[reg].q;
-    m2.u64[0] = readq(address);
+    simde__m64 m1 = simde_mm_cvtsi64_m64(cpu->reg_mmx[reg].q);
+    simde__m64 m2 = simde_mm_cvtsi64_m64(readq(cpu->thread->memory, address));
     simde__m64 r = simde_mm_max_pi16(m1, m2);
-    cpu->reg_mmx[reg].q = r.u64[0];
+    cpu->reg_mmx[reg].q = simde_mm_cvtm64_si64(r);
 }
 
 void common_pmaxubMmxMmx(CPU* cpu, U32 r1, U32 r2) {
-    simde__m64 m1;
-    simde__m64 m2;
-    m1.u64[0] = cpu->reg_mmx[r1].q;
-    m2.u64[0] = cpu->reg_mmx[r2].q;
+    simde__m64 m1 = simde_mm_cvtsi64_m64(cpu->reg_mmx[r1].q);
+    simde__m64 m2 = simde_mm_cvtsi64_m64(cpu->reg_mmx[r2].q);
     simde__m64 r = simde_mm_max_pu8(m1, m2);
-    cpu->reg_mmx[r1].q = r.u64[0];
+    cpu->reg_mmx[r1].q = simde_mm_cvtm64_si64(r);
 }
 
 void common_pmaxubMmxE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m64 m1;
-    simde__m64 m2;
-    m1.u64[0] = cpu->reg_mmx[reg].q;
-    m2.u64[0] = readq(address);
+    simde__m64 m1 = simde_mm_cvtsi64_m64(cpu->reg_mmx[reg].q);
+    simde__m64 m2 = simde_mm_cvtsi64_m64(readq(cpu->thread->memory, address));
     simde__m64 r = simde_mm_max_pu8(m1, m2);
-    cpu->reg_mmx[reg].q = r.u64[0];
+    cpu->reg_mmx[reg].q = simde_mm_cvtm64_si64(r);
 }
 
 void common_pminswMmxMmx(CPU* cpu, U32 r1, U32 r2) {
-    simde__m64 m1;
-    simde__m64 m2;
-    m1.u64[0] = cpu->reg_mmx[r1].q;
-    m2.u64[0] = cpu->reg_mmx[r2].q;
+    simde__m64 m1 = simde_mm_cvtsi64_m64(cpu->reg_mmx[r1].q);
+    simde__m64 m2 = simde_mm_cvtsi64_m64(cpu->reg_mmx[r2].q);
     simde__m64 r = simde_mm_min_pi16(m1, m2);
-    cpu->reg_mmx[r1].q = r.u64[0];
+    cpu->reg_mmx[r1].q = simde_mm_cvtm64_si64(r);
 }
 
 void common_pminswMmxE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m64 m1;
-    simde__m64 m2;
-    m1.u64[0] = cpu->reg_mmx[reg].q;
-    m2.u64[0] = readq(address);
+    simde__m64 m1 = simde_mm_cvtsi64_m64(cpu->reg_mmx[reg].q);
+    simde__m64 m2 = simde_mm_cvtsi64_m64(readq(cpu->thread->memory, address));
     simde__m64 r = simde_mm_min_pi16(m1, m2);
-    cpu->reg_mmx[reg].q = r.u64[0];
+    cpu->reg_mmx[reg].q = simde_mm_cvtm64_si64(r);
 }
 
 void common_pminubMmxMmx(CPU* cpu, U32 r1, U32 r2) {
-    simde__m64 m1;
-    simde__m64 m2;
-    m1.u64[0] = cpu->reg_mmx[r1].q;
-    m2.u64[0] = cpu->reg_mmx[r2].q;
+    simde__m64 m1 = simde_mm_cvtsi64_m64(cpu->reg_mmx[r1].q);
+    simde__m64 m2 = simde_mm_cvtsi64_m64(cpu->reg_mmx[r2].q);
     simde__m64 r = simde_mm_min_pu8(m1, m2);
-    cpu->reg_mmx[r1].q = r.u64[0];
+    cpu->reg_mmx[r1].q = simde_mm_cvtm64_si64(r);
 }
 
 void common_pminubMmxE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m64 m1;
-    simde__m64 m2;
-    m1.u64[0] = cpu->reg_mmx[reg].q;
-    m2.u64[0] = readq(address);
+    simde__m64 m1 = simde_mm_cvtsi64_m64(cpu->reg_mmx[reg].q);
+    simde__m64 m2 = simde_mm_cvtsi64_m64(readq(cpu->thread->memory, address));
     simde__m64 r = simde_mm_min_pu8(m1, m2);
-    cpu->reg_mmx[reg].q = r.u64[0];
+    cpu->reg_mmx[reg].q = simde_mm_cvtm64_si64(r);
 }
 
 void common_pmovmskbR32Mmx(CPU* cpu, U32 r1, U32 r2) {
-    simde__m64 m;
-    m.u64[0] = cpu->reg_mmx[r2].q;
+    simde__m64 m = simde_mm_cvtsi64_m64(cpu->reg_mmx[r2].q);
     cpu->reg[r1].u32 = (U32)simde_mm_movemask_pi8(m);
 }
 
 void common_pmulhuwMmxMmx(CPU* cpu, U32 r1, U32 r2) {
-    simde__m64 m1;
-    simde__m64 m2;
-    m1.u64[0] = cpu->reg_mmx[r1].q;
-    m2.u64[0] = cpu->reg_mmx[r2].q;
+    simde__m64 m1 = simde_mm_cvtsi64_m64(cpu->reg_mmx[r1].q);
+    simde__m64 m2 = simde_mm_cvtsi64_m64(cpu->reg_mmx[r2].q);
     simde__m64 r = simde_mm_mulhi_pu16(m1, m2);
-    cpu->reg_mmx[r1].q = r.u64[0];
+    cpu->reg_mmx[r1].q = simde_mm_cvtm64_si64(r);
 }
 
 void common_pmulhuwMmxE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m64 m1;
-    simde__m64 m2;
-    m1.u64[0] = cpu->reg_mmx[reg].q;
-    m2.u64[0] = readq(address);
+    simde__m64 m1 = simde_mm_cvtsi64_m64(cpu->reg_mmx[reg].q);
+    simde__m64 m2 = simde_mm_cvtsi64_m64(readq(cpu->thread->memory, address));
     simde__m64 r = simde_mm_mulhi_pu16(m1, m2);
-    cpu->reg_mmx[reg].q = r.u64[0];
+    cpu->reg_mmx[reg].q = simde_mm_cvtm64_si64(r);
+}
+
+// the shuffles take their immediate at runtime, simde's native versions need it to be a constant
+static U64 pshufw(U64 value, U8 imm) {
+    U64 result = 0;
+    for (U32 i = 0; i < 4; i++) {
+        result |= ((value >> (((imm >> (i * 2)) & 3) * 16)) & 0xFFFF) << (i * 16);
+    }
+    return result;
 }
 
 void common_pshufwMmxMmx(CPU* cpu, U32 r1, U32 r2, U8 imm) {
-    simde__m64 m1;
-    simde__m64 m2;
-    m1.u64[0] = cpu->reg_mmx[r1].q;
-    m2.u64[0] = cpu->reg_mmx[r2].q;
-    simde__m64 r = simde_mm_shuffle_pi16(m2, imm);
-    cpu->reg_mmx[r1].q = r.u64[0];
+    cpu->reg_mmx[r1].q = pshufw(cpu->reg_mmx[r2].q, imm);
 }
 
 void common_pshufwMmxE64(CPU* cpu, U32 reg, U32 address, U8 imm) {
-    simde__m64 m1;
-    simde__m64 m2;
-    m1.u64[0] = cpu->reg_mmx[reg].q;
-    m2.u64[0] = readq(address);
-    simde__m64 r = simde_mm_shuffle_pi16(m2, imm);
-    cpu->reg_mmx[reg].q = r.u64[0];
+    cpu->reg_mmx[reg].q = pshufw(readq(cpu->thread->memory, address), imm);
 }
 
 void common_andnpsXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -408,10 +369,10 @@ void common_andnpsXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_andnpsXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8); 
-    cpu->xmm[reg].ps = simde_mm_andnot_ps(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8); 
+    cpu->xmm[reg].ps = simde_mm_andnot_ps(cpu->xmm[reg].ps, value.ps);
 }
 
 void common_andpsXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -419,10 +380,10 @@ void common_andpsXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_andpsXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8); 
-    cpu->xmm[reg].ps = simde_mm_and_ps(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8); 
+    cpu->xmm[reg].ps = simde_mm_and_ps(cpu->xmm[reg].ps, value.ps);
 }
 
 void common_orpsXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -430,10 +391,10 @@ void common_orpsXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_orpsXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8); 
-    cpu->xmm[reg].ps = simde_mm_or_ps(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8); 
+    cpu->xmm[reg].ps = simde_mm_or_ps(cpu->xmm[reg].ps, value.ps);
 }
 
 void common_xorpsXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -441,32 +402,30 @@ void common_xorpsXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_xorpsXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8); 
-    cpu->xmm[reg].ps = simde_mm_xor_ps(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8); 
+    cpu->xmm[reg].ps = simde_mm_xor_ps(cpu->xmm[reg].ps, value.ps);
 }
 
 void common_cvtpi2psXmmMmx(CPU* cpu, U32 r1, U32 r2) {
-    simde__m64 value;
-    value.u64[0] = cpu->reg_mmx[r2].q;
+    simde__m64 value = simde_mm_cvtsi64_m64(cpu->reg_mmx[r2].q);
     cpu->xmm[r1].ps = simde_mm_cvtpi32_ps(cpu->xmm[r1].ps, value);
 }
 
 void common_cvtpi2psXmmE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m64 value;
-    value.u64[0] = readq(address);
+    simde__m64 value = simde_mm_cvtsi64_m64(readq(cpu->thread->memory, address));
     cpu->xmm[reg].ps = simde_mm_cvtpi32_ps(cpu->xmm[reg].ps, value);
 }
 
 void common_cvtps2piMmxXmm(CPU* cpu, U32 r1, U32 r2) {
-    cpu->reg_mmx[r1].q = simde_mm_cvtps_pi32(cpu->xmm[r2].ps).u64[0];
+    cpu->reg_mmx[r1].q = simde_mm_cvtm64_si64(simde_mm_cvtps_pi32(cpu->xmm[r2].ps));
 }
 
 void common_cvtps2piMmxE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    cpu->reg_mmx[reg].q = simde_mm_cvtps_pi32(value).u64[0];
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    cpu->reg_mmx[reg].q = simde_mm_cvtm64_si64(simde_mm_cvtps_pi32(value.ps));
 }
 
 void common_cvtsi2ssXmmR32(CPU* cpu, U32 r1, U32 r2) {
@@ -474,7 +433,7 @@ void common_cvtsi2ssXmmR32(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_cvtsi2ssXmmE32(CPU* cpu, U32 reg, U32 address) {
-    cpu->xmm[reg].ps = simde_mm_cvtsi32_ss(cpu->xmm[reg].ps, (S32)readd(address));
+    cpu->xmm[reg].ps = simde_mm_cvtsi32_ss(cpu->xmm[reg].ps, (S32)readd(cpu->thread->memory, address));
 }
 
 void common_cvtss2siR32Xmm(CPU* cpu, U32 r1, U32 r2) {
@@ -482,21 +441,21 @@ void common_cvtss2siR32Xmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_cvtss2siR32E32(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u32[0] = readd(address);
-    cpu->reg[reg].u32 = (U32)simde_mm_cvtss_si32(value);
+    SSE value;
+    value.u32[0] = readd(cpu->thread->memory, address);
+    cpu->reg[reg].u32 = (U32)simde_mm_cvtss_si32(value.ps);
 }
 
 void common_cvttps2piMmxXmm(CPU* cpu, U32 r1, U32 r2) {
     simde__m64 r = simde_mm_cvttps_pi32(cpu->xmm[r2].ps);
-    cpu->reg_mmx[r1].q = r.u64[0];
+    cpu->reg_mmx[r1].q = simde_mm_cvtm64_si64(r);
 }
 
 void common_cvttps2piMmxE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    simde__m64 r = simde_mm_cvttps_pi32(value);
-    cpu->reg_mmx[reg].q = r.u64[0];
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    simde__m64 r = simde_mm_cvttps_pi32(value.ps);
+    cpu->reg_mmx[reg].q = simde_mm_cvtm64_si64(r);
 }
 
 void common_cvttss2siR32Xmm(CPU* cpu, U32 r1, U32 r2) {
@@ -504,9 +463,9 @@ void common_cvttss2siR32Xmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_cvttss2siR32E32(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u32[0] = readd(address);
-    cpu->reg[reg].u32 = simde_mm_cvttss_si32(value);
+    SSE value;
+    value.u32[0] = readd(cpu->thread->memory, address);
+    cpu->reg[reg].u32 = simde_mm_cvttss_si32(value.ps);
 }
 
 void common_movapsXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -514,37 +473,37 @@ void common_movapsXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_movapsXmmE128(CPU* cpu, U32 reg, U32 address) {
-    cpu->xmm[reg].ps.u64[0] = readq(address);
-    cpu->xmm[reg].ps.u64[1] = readq(address+8);
+    cpu->xmm[reg].u64[0] = readq(cpu->thread->memory, address);
+    cpu->xmm[reg].u64[1] = readq(cpu->thread->memory, address+8);
 }
 
 void common_movapsE128Xmm(CPU* cpu, U32 reg, U32 address) {
-    writeq(address, cpu->xmm[reg].ps.u64[0]);
-    writeq(address+8, cpu->xmm[reg].ps.u64[1]);
+    writeq(cpu->thread->memory, address, cpu->xmm[reg].u64[0]);
+    writeq(cpu->thread->memory, address+8, cpu->xmm[reg].u64[1]);
 }
 
 void common_movhlpsXmmXmm(CPU* cpu, U32 r1, U32 r2) {
-    cpu->xmm[r1].ps.u64[0] = cpu->xmm[r2].ps.u64[1];
+    cpu->xmm[r1].u64[0] = cpu->xmm[r2].u64[1];
 }
 
 void common_movlhpsXmmXmm(CPU* cpu, U32 r1, U32 r2) {
-    cpu->xmm[r1].ps.u64[1] = cpu->xmm[r2].ps.u64[0];
+    cpu->xmm[r1].u64[1] = cpu->xmm[r2].u64[0];
 }
 
 void common_movhpsXmmE64(CPU* cpu, U32 reg, U32 address) {
-    cpu->xmm[reg].ps.u64[1] = readq(address);
+    cpu->xmm[reg].u64[1] = readq(cpu->thread->memory, address);
 }
 
 void common_movhpsE64Xmm(CPU* cpu, U32 reg, U32 address) {
-    writeq(address, cpu->xmm[reg].ps.u64[1]);
+    writeq(cpu->thread->memory, address, cpu->xmm[reg].u64[1]);
 }
 
 void common_movlpsXmmE64(CPU* cpu, U32 reg, U32 address) {
-    cpu->xmm[reg].ps.u64[0] = readq(address);
+    cpu->xmm[reg].u64[0] = readq(cpu->thread->memory, address);
 }
 
 void common_movlpsE64Xmm(CPU* cpu, U32 reg, U32 address) {
-    writeq(address, cpu->xmm[reg].ps.u64[0]);
+    writeq(cpu->thread->memory, address, cpu->xmm[reg].u64[0]);
 }
 
 void common_movmskpsR32Xmm(CPU* cpu, U32 r1, U32 r2) {
@@ -552,18 +511,18 @@ void common_movmskpsR32Xmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_movssXmmXmm(CPU* cpu, U32 r1, U32 r2) {
-    cpu->xmm[r1].ps.u32[0] = cpu->xmm[r2].ps.u32[0];
+    cpu->xmm[r1].u32[0] = cpu->xmm[r2].u32[0];
 }
 
 void common_movssXmmE32(CPU* cpu, U32 reg, U32 address) {
-    cpu->xmm[reg].ps.u32[0] = readd(address);
-    cpu->xmm[reg].ps.u32[1] = 0;
-    cpu->xmm[reg].ps.u32[2] = 0;
-    cpu->xmm[reg].ps.u32[3] = 0;
+    cpu->xmm[reg].u32[0] = readd(cpu->thread->memory, address);
+    cpu->xmm[reg].u32[1] = 0;
+    cpu->xmm[reg].u32[2] = 0;
+    cpu->xmm[reg].u32[3] = 0;
 }
 
 void common_movssE32Xmm(CPU* cpu, U32 reg, U32 address) {
-    writed(address, cpu->xmm[reg].ps.u32[0]);
+    writed(cpu->thread->memory, address, cpu->xmm[reg].u32[0]);
 }
 
 void common_movupsXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -571,21 +530,19 @@ void common_movupsXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_movupsXmmE128(CPU* cpu, U32 reg, U32 address) {
-    cpu->xmm[reg].ps.u64[0] = readq(address);
-    cpu->xmm[reg].ps.u64[1] = readq(address+8);
+    cpu->xmm[reg].u64[0] = readq(cpu->thread->memory, address);
+    cpu->xmm[reg].u64[1] = readq(cpu->thread->memory, address+8);
 }
 
 void common_movupsE128Xmm(CPU* cpu, U32 reg, U32 address) {
-    writeq(address, cpu->xmm[reg].ps.u64[0]);
-    writeq(address+8, cpu->xmm[reg].ps.u64[1]);
+    writeq(cpu->thread->memory, address, cpu->xmm[reg].u64[0]);
+    writeq(cpu->thread->memory, address+8, cpu->xmm[reg].u64[1]);
 }
 
 void common_maskmovqEDIMmxMmx(CPU* cpu, U32 r1, U32 r2, U32 address) {
-    simde__m64 a;
-    simde__m64 mask;
     U8 result[8];
-    a.u64[0] = cpu->reg_mmx[r1].q;
-    mask.u64[0] = cpu->reg_mmx[r2].q;
+    simde__m64 a = simde_mm_cvtsi64_m64(cpu->reg_mmx[r1].q);
+    simde__m64 mask = simde_mm_cvtsi64_m64(cpu->reg_mmx[r2].q);
 
     readMemory(result, address, 8);
     simde_mm_maskmove_si64(a, mask, (int8_t*)result);
@@ -593,23 +550,32 @@ void common_maskmovqEDIMmxMmx(CPU* cpu, U32 r1, U32 r2, U32 address) {
 }
 
 void common_movntpsE128Xmm(CPU* cpu, U32 reg, U32 address) {
-    writeq(address, cpu->xmm[reg].ps.u64[0]);
-    writeq(address+8, cpu->xmm[reg].ps.u64[1]);
+    writeq(cpu->thread->memory, address, cpu->xmm[reg].u64[0]);
+    writeq(cpu->thread->memory, address+8, cpu->xmm[reg].u64[1]);
 }
 
 void common_movntqE64Mmx(CPU* cpu, U32 reg, U32 address) {
-    writeq(address, cpu->reg_mmx[reg].q);
+    writeq(cpu->thread->memory, address, cpu->reg_mmx[reg].q);
+}
+
+static void shufps(SSE& dest, const SSE& src, U8 imm) {
+    SSE result;
+    result.u32[0] = dest.u32[imm & 3];
+    result.u32[1] = dest.u32[(imm >> 2) & 3];
+    result.u32[2] = src.u32[(imm >> 4) & 3];
+    result.u32[3] = src.u32[(imm >> 6) & 3];
+    dest = result;
 }
 
 void common_shufpsXmmXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
-    cpu->xmm[r1].ps = simde_mm_shuffle_ps(cpu->xmm[r1].ps, cpu->xmm[r2].ps, imm);
+    shufps(cpu->xmm[r1], cpu->xmm[r2], imm);
 }
 
 void common_shufpsXmmE128(CPU* cpu, U32 reg, U32 address, U8 imm) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);  
-    cpu->xmm[reg].ps = simde_mm_shuffle_ps(cpu->xmm[reg].ps, value, imm);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);  
+    shufps(cpu->xmm[reg], value, imm);
 }
 
 void common_unpckhpsXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -617,10 +583,10 @@ void common_unpckhpsXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_unpckhpsXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);    
-    cpu->xmm[reg].ps = simde_mm_unpackhi_ps(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);    
+    cpu->xmm[reg].ps = simde_mm_unpackhi_ps(cpu->xmm[reg].ps, value.ps);
 }
 
 void common_unpcklpsXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -628,10 +594,10 @@ void common_unpcklpsXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_unpcklpsXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);    
-    cpu->xmm[reg].ps = simde_mm_unpacklo_ps(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);    
+    cpu->xmm[reg].ps = simde_mm_unpacklo_ps(cpu->xmm[reg].ps, value.ps);
 }
 
 void common_prefetchT0(CPU* cpu) {
@@ -661,19 +627,19 @@ void common_cmppsXmmXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
 }
 
 void common_cmppsXmmE128(CPU* cpu, U32 reg, U32 address, U8 imm) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
     int which = imm & 7;
     switch (which) {
-    case 0: cpu->xmm[reg].ps = simde_mm_cmpeq_ps(cpu->xmm[reg].ps, value); break;
-    case 1: cpu->xmm[reg].ps = simde_mm_cmplt_ps(cpu->xmm[reg].ps, value); break;
-    case 2: cpu->xmm[reg].ps = simde_mm_cmple_ps(cpu->xmm[reg].ps, value); break;
-    case 3: cpu->xmm[reg].ps = simde_mm_cmpunord_ps(cpu->xmm[reg].ps, value); break;
-    case 4: cpu->xmm[reg].ps = simde_mm_cmpneq_ps(cpu->xmm[reg].ps, value); break;
-    case 5: cpu->xmm[reg].ps = simde_mm_cmpnlt_ps(cpu->xmm[reg].ps, value); break;
-    case 6: cpu->xmm[reg].ps = simde_mm_cmpnle_ps(cpu->xmm[reg].ps, value); break;
-    case 7: cpu->xmm[reg].ps = simde_mm_cmpord_ps(cpu->xmm[reg].ps, value); break;
+    case 0: cpu->xmm[reg].ps = simde_mm_cmpeq_ps(cpu->xmm[reg].ps, value.ps); break;
+    case 1: cpu->xmm[reg].ps = simde_mm_cmplt_ps(cpu->xmm[reg].ps, value.ps); break;
+    case 2: cpu->xmm[reg].ps = simde_mm_cmple_ps(cpu->xmm[reg].ps, value.ps); break;
+    case 3: cpu->xmm[reg].ps = simde_mm_cmpunord_ps(cpu->xmm[reg].ps, value.ps); break;
+    case 4: cpu->xmm[reg].ps = simde_mm_cmpneq_ps(cpu->xmm[reg].ps, value.ps); break;
+    case 5: cpu->xmm[reg].ps = simde_mm_cmpnlt_ps(cpu->xmm[reg].ps, value.ps); break;
+    case 6: cpu->xmm[reg].ps = simde_mm_cmpnle_ps(cpu->xmm[reg].ps, value.ps); break;
+    case 7: cpu->xmm[reg].ps = simde_mm_cmpord_ps(cpu->xmm[reg].ps, value.ps); break;
     }
 }
 
@@ -692,19 +658,19 @@ void common_cmpssXmmXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
 }
 
 void common_cmpssXmmE32(CPU* cpu, U32 reg, U32 address, U8 imm) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
     int which = imm & 7;
     switch (which) {
-    case 0: cpu->xmm[reg].ps = simde_mm_cmpeq_ss(cpu->xmm[reg].ps, value); break;
-    case 1: cpu->xmm[reg].ps = simde_mm_cmplt_ss(cpu->xmm[reg].ps, value); break;
-    case 2: cpu->xmm[reg].ps = simde_mm_cmple_ss(cpu->xmm[reg].ps, value); break;
-    case 3: cpu->xmm[reg].ps = simde_mm_cmpunord_ss(cpu->xmm[reg].ps, value); break;
-    case 4: cpu->xmm[reg].ps = simde_mm_cmpneq_ss(cpu->xmm[reg].ps, value); break;
-    case 5: cpu->xmm[reg].ps = simde_mm_cmpnlt_ss(cpu->xmm[reg].ps, value); break;
-    case 6: cpu->xmm[reg].ps = simde_mm_cmpnle_ss(cpu->xmm[reg].ps, value); break;
-    case 7: cpu->xmm[reg].ps = simde_mm_cmpord_ss(cpu->xmm[reg].ps, value); break;
+    case 0: cpu->xmm[reg].ps = simde_mm_cmpeq_ss(cpu->xmm[reg].ps, value.ps); break;
+    case 1: cpu->xmm[reg].ps = simde_mm_cmplt_ss(cpu->xmm[reg].ps, value.ps); break;
+    case 2: cpu->xmm[reg].ps = simde_mm_cmple_ss(cpu->xmm[reg].ps, value.ps); break;
+    case 3: cpu->xmm[reg].ps = simde_mm_cmpunord_ss(cpu->xmm[reg].ps, value.ps); break;
+    case 4: cpu->xmm[reg].ps = simde_mm_cmpneq_ss(cpu->xmm[reg].ps, value.ps); break;
+    case 5: cpu->xmm[reg].ps = simde_mm_cmpnlt_ss(cpu->xmm[reg].ps, value.ps); break;
+    case 6: cpu->xmm[reg].ps = simde_mm_cmpnle_ss(cpu->xmm[reg].ps, value.ps); break;
+    case 7: cpu->xmm[reg].ps = simde_mm_cmpord_ss(cpu->xmm[reg].ps, value.ps); break;
     }
 }
 
@@ -712,8 +678,8 @@ void common_cmpssXmmE32(CPU* cpu, U32 reg, U32 address, U8 imm) {
 void common_comissXmmXmm(CPU* cpu, U32 r1, U32 r2) {
     cpu->fillFlags();
     cpu->flags&=~(AF|OF|SF|CF|PF|ZF);
-    const simde__m128& a = cpu->xmm[r1].ps;
-    const simde__m128& b = cpu->xmm[r2].ps;
+    const SSE& a = cpu->xmm[r1];
+    const SSE& b = cpu->xmm[r2];
     if (isnan(a.f32[0]) || isnan(b.f32[0])) {
         cpu->flags|=CF|ZF|PF;
     } else if (a.f32[0] == b.f32[0]) {
@@ -726,9 +692,9 @@ void common_comissXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 void common_comissXmmE32(CPU* cpu, U32 reg, U32 address) {
     cpu->fillFlags();
     cpu->flags&=~(AF|OF|SF|CF|PF|ZF);
-    const simde__m128& a = cpu->xmm[reg].ps;
-    simde__m128 b;
-    b.u32[0] = readd(address);
+    const SSE& a = cpu->xmm[reg];
+    SSE b;
+    b.u32[0] = readd(cpu->thread->memory, address);
     if (isnan(a.f32[0]) || isnan(b.f32[0])) {
         cpu->flags|=CF|ZF|PF;
     } else if (a.f32[0] == b.f32[0]) {
@@ -747,7 +713,7 @@ void common_ucomissXmmE32(CPU* cpu, U32 reg, U32 address) {
 }
 
 void common_stmxcsr(CPU* cpu, U32 reg, U32 address) {
-    writed(address, 0x1F80);
+    writed(cpu->thread->memory, address, 0x1F80);
 }
 
 void common_ldmxcsr(CPU* cpu, U32 reg, U32 address) {
@@ -28,10 +28,10 @@ void common_addpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_addpdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pd = simde_mm_add_pd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pd = simde_mm_add_pd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_addsdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -39,9 +39,9 @@ void common_addsdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_addsdXmmE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    cpu->xmm[reg].pd = simde_mm_add_sd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    cpu->xmm[reg].pd = simde_mm_add_sd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_subpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -49,10 +49,10 @@ void common_subpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_subpdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pd = simde_mm_sub_pd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pd = simde_mm_sub_pd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_subsdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -60,9 +60,9 @@ void common_subsdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_subsdXmmE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    cpu->xmm[reg].pd = simde_mm_sub_sd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    cpu->xmm[reg].pd = simde_mm_sub_sd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_mulpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -70,10 +70,10 @@ void common_mulpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_mulpdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pd = simde_mm_mul_pd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pd = simde_mm_mul_pd(cpu->xmm[reg].pd, value.pd);
 }    
 
 void common_mulsdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -81,9 +81,9 @@ void common_mulsdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_mulsdXmmE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    cpu->xmm[reg].pd = simde_mm_mul_sd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    cpu->xmm[reg].pd = simde_mm_mul_sd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_divpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -91,10 +91,10 @@ void common_divpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_divpdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pd = simde_mm_div_pd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pd = simde_mm_div_pd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_divsdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -102,9 +102,9 @@ void common_divsdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_divsdXmmE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    cpu->xmm[reg].pd = simde_mm_div_sd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    cpu->xmm[reg].pd = simde_mm_div_sd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_maxpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -112,10 +112,10 @@ void common_maxpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_maxpdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pd = simde_mm_max_pd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pd = simde_mm_max_pd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_maxsdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -123,9 +123,9 @@ void common_maxsdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_maxsdXmmE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    cpu->xmm[reg].pd = simde_mm_max_sd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    cpu->xmm[reg].pd = simde_mm_max_sd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_minpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -133,10 +133,10 @@ void common_minpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_minpdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pd = simde_mm_min_pd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pd = simde_mm_min_pd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_minsdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -144,9 +144,9 @@ void common_minsdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_minsdXmmE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    cpu->xmm[reg].pd = simde_mm_min_sd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    cpu->xmm[reg].pd = simde_mm_min_sd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_paddbXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -154,10 +154,10 @@ void common_paddbXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_paddbXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_add_epi8(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_add_epi8(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_paddwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -165,10 +165,10 @@ void common_paddwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_paddwXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_add_epi16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_add_epi16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_padddXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -176,10 +176,10 @@ void common_padddXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_padddXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_add_epi32(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_add_epi32(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_paddqMmxMmx(CPU* cpu, U32 r1, U32 r2) {
@@ -187,7 +187,7 @@ void common_paddqMmxMmx(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_paddqMmxE64(CPU* cpu, U32 reg, U32 address) {
-    cpu->reg_mmx[reg].q = cpu->reg_mmx[reg].q + readq(address);
+    cpu->reg_mmx[reg].q = cpu->reg_mmx[reg].q + readq(cpu->thread->memory, address);
 }
 
 void common_paddqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -195,10 +195,10 @@ void common_paddqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_paddqXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_add_epi64(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_add_epi64(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_paddsbXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -206,10 +206,10 @@ void common_paddsbXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_paddsbXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_adds_epi8(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_adds_epi8(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_paddswXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -217,10 +217,10 @@ void common_paddswXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_paddswXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_adds_epi16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_adds_epi16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_paddusbXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -228,10 +228,10 @@ void common_paddusbXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_paddusbXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_adds_epu8(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_adds_epu8(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_padduswXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -239,10 +239,10 @@ void common_padduswXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_padduswXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_adds_epu16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_adds_epu16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_psubbXmmXmm(CPU* cpu,U32 r1, U32 r2 ) {
@@ -250,10 +250,10 @@ void common_psubbXmmXmm(CPU* cpu,U32 r1, U32 r2 ) {
 }
 
 void common_psubbXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_sub_epi8(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_sub_epi8(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_psubwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -261,10 +261,10 @@ void common_psubwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_psubwXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_sub_epi16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_sub_epi16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_psubdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -272,10 +272,10 @@ void common_psubdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_psubdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_sub_epi32(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_sub_epi32(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_psubqMmxMmx(CPU* cpu, U32 r1, U32 r2) {
@@ -283,7 +283,7 @@ void common_psubqMmxMmx(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_psubqMmxE64(CPU* cpu, U32 reg, U32 address) {
-    cpu->reg_mmx[reg].q = cpu->reg_mmx[reg].q - readq(address);
+    cpu->reg_mmx[reg].q = cpu->reg_mmx[reg].q - readq(cpu->thread->memory, address);
 }
 
 void common_psubqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -291,10 +291,10 @@ void common_psubqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_psubqXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_sub_epi64(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_sub_epi64(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_psubsbXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -302,10 +302,10 @@ void common_psubsbXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_psubsbXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_subs_epi8(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_subs_epi8(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_psubswXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -313,10 +313,10 @@ void common_psubswXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_psubswXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_subs_epi16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_subs_epi16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_psubusbXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -324,10 +324,10 @@ void common_psubusbXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_psubusbXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_subs_epu8(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_subs_epu8(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_psubuswXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -335,10 +335,10 @@ void common_psubuswXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_psubuswXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_subs_epu16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_subs_epu16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_pmaddwdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -346,10 +346,10 @@ void common_pmaddwdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pmaddwdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_madd_epi16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_madd_epi16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_pmulhwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -357,10 +357,10 @@ void common_pmulhwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pmulhwXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_mulhi_epi16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_mulhi_epi16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_pmullwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -368,10 +368,10 @@ void common_pmullwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pmullwXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_mullo_epi16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_mullo_epi16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_pmuludqMmxMmx(CPU* cpu, U32 r1, U32 r2) {
@@ -379,7 +379,7 @@ void common_pmuludqMmxMmx(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pmuludqMmxE64(CPU* cpu, U32 reg, U32 address) {
-    cpu->reg_mmx[reg].q = (U64)cpu->reg_mmx[reg].ud.d0 * (U64)readd(address);
+    cpu->reg_mmx[reg].q = (U64)cpu->reg_mmx[reg].ud.d0 * (U64)readd(cpu->thread->memory, address);
 }
 
 void common_pmuludqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -387,10 +387,10 @@ void common_pmuludqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pmuludqXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_mul_epu32(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_mul_epu32(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_sqrtpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -398,10 +398,10 @@ void common_sqrtpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_sqrtpdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pd = simde_mm_sqrt_pd(value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pd = simde_mm_sqrt_pd(value.pd);
 }
 
 void common_sqrtsdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -409,10 +409,10 @@ void common_sqrtsdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_sqrtsdXmmE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    //value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pd = simde_mm_sqrt_sd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    //value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pd = simde_mm_sqrt_sd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_andnpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -420,10 +420,10 @@ void common_andnpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_andnpdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pd = simde_mm_andnot_pd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pd = simde_mm_andnot_pd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_andpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -431,10 +431,10 @@ void common_andpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_andpdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pd = simde_mm_and_pd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pd = simde_mm_and_pd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_pandXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -442,10 +442,10 @@ void common_pandXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pandXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pd = simde_mm_and_pd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pd = simde_mm_and_pd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_pandnXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -453,10 +453,10 @@ void common_pandnXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pandnXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_andnot_si128(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_andnot_si128(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_porXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -464,14 +464,19 @@ void common_porXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_porXmmXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_or_si128(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_or_si128(cpu->xmm[reg].pi, value.pi);
 }
 
+// the byte shifts and shuffles take their immediate at runtime, simde's native versions need it to be a constant
 void common_pslldqXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
-    cpu->xmm[r1].pi = simde_mm_slli_si128(cpu->xmm[r1].pi, imm);
+    SSE result;
+    for (U32 i = 0; i < 16; i++) {
+        result.bytes[i] = (i >= imm) ? cpu->xmm[r1].bytes[i - imm] : 0;
+    }
+    cpu->xmm[r1] = result;
 }
 
 void common_psllqXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
@@ -483,10 +488,10 @@ void common_psllqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_psllqXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_sll_epi64(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_sll_epi64(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_pslldXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
@@ -498,10 +503,10 @@ void common_pslldXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pslldXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_sll_epi32(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_sll_epi32(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_psllwXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
@@ -513,10 +518,10 @@ void common_psllwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_psllwXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_sll_epi16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_sll_epi16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_psradXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
@@ -528,10 +533,10 @@ void common_psradXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_psradXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_sra_epi32(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_sra_epi32(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_psrawXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
@@ -543,14 +548,18 @@ void common_psrawXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_psrawXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_sra_epi16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_sra_epi16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_psrldqXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
-    cpu->xmm[r1].pi = simde_mm_srli_si128(cpu->xmm[r1].pi, imm);
+    SSE result;
+    for (U32 i = 0; i < 16; i++) {
+        result.bytes[i] = (i + imm < 16) ? cpu->xmm[r1].bytes[i + imm] : 0;
+    }
+    cpu->xmm[r1] = result;
 }
 
 void common_psrlqXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
@@ -562,10 +571,10 @@ void common_psrlqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_psrlqXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_srl_epi64(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_srl_epi64(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_psrldXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
@@ -577,10 +586,10 @@ void common_psrldXmmXmm(CPU* cpu,U32 r1, U32 r2 ) {
 }
 
 void common_psrldXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_srl_epi32(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_srl_epi32(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_psrlwXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
@@ -592,10 +601,10 @@ void common_psrlwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_psrlwXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_srl_epi16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_srl_epi16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_pxorXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -603,10 +612,10 @@ void common_pxorXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pxorXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_xor_si128(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_xor_si128(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_orpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -614,10 +623,10 @@ void common_orpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_orpdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pd = simde_mm_or_pd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pd = simde_mm_or_pd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_xorpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -625,10 +634,10 @@ void common_xorpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_xorpdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pd = simde_mm_xor_pd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pd = simde_mm_xor_pd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_cmppdXmmXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
@@ -646,19 +655,19 @@ void common_cmppdXmmXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
 }
 
 void common_cmppdXmmE128(CPU* cpu, U32 reg, U32 address, U8 imm) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
     int which = imm & 7;
     switch (which) {
-    case 0: cpu->xmm[reg].pd = simde_mm_cmpeq_pd(cpu->xmm[reg].pd, value); break;
-    case 1: cpu->xmm[reg].pd = simde_mm_cmplt_pd(cpu->xmm[reg].pd, value); break;
-    case 2: cpu->xmm[reg].pd = simde_mm_cmple_pd(cpu->xmm[reg].pd, value); break;
-    case 3: cpu->xmm[reg].pd = simde_mm_cmpunord_pd(cpu->xmm[reg].pd, value); break;
-    case 4: cpu->xmm[reg].pd = simde_mm_cmpneq_pd(cpu->xmm[reg].pd, value); break;
-    case 5: cpu->xmm[reg].pd = simde_mm_cmpnlt_pd(cpu->xmm[reg].pd, value); break;
-    case 6: cpu->xmm[reg].pd = simde_mm_cmpnle_pd(cpu->xmm[reg].pd, value); break;
-    case 7: cpu->xmm[reg].pd = simde_mm_cmpord_pd(cpu->xmm[reg].pd, value); break;
+    case 0: cpu->xmm[reg].pd = simde_mm_cmpeq_pd(cpu->xmm[reg].pd, value.pd); break;
+    case 1: cpu->xmm[reg].pd = simde_mm_cmplt_pd(cpu->xmm[reg].pd, value.pd); break;
+    case 2: cpu->xmm[reg].pd = simde_mm_cmple_pd(cpu->xmm[reg].pd, value.pd); break;
+    case 3: cpu->xmm[reg].pd = simde_mm_cmpunord_pd(cpu->xmm[reg].pd, value.pd); break;
+    case 4: cpu->xmm[reg].pd = simde_mm_cmpneq_pd(cpu->xmm[reg].pd, value.pd); break;
+    case 5: cpu->xmm[reg].pd = simde_mm_cmpnlt_pd(cpu->xmm[reg].pd, value.pd); break;
+    case 6: cpu->xmm[reg].pd = simde_mm_cmpnle_pd(cpu->xmm[reg].pd, value.pd); break;
+    case 7: cpu->xmm[reg].pd = simde_mm_cmpord_pd(cpu->xmm[reg].pd, value.pd); break;
     }
 }
 
@@ -677,27 +686,27 @@ void common_cmpsdXmmXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
 }
 
 void common_cmpsdXmmE64(CPU* cpu, U32 reg, U32 address, U8 imm) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
     int which = imm & 7;
     switch (which) {
-    case 0: cpu->xmm[reg].pd = simde_mm_cmpeq_sd(cpu->xmm[reg].pd, value); break;
-    case 1: cpu->xmm[reg].pd = simde_mm_cmplt_sd(cpu->xmm[reg].pd, value); break;
-    case 2: cpu->xmm[reg].pd = simde_mm_cmple_sd(cpu->xmm[reg].pd, value); break;
-    case 3: cpu->xmm[reg].pd = simde_mm_cmpunord_sd(cpu->xmm[reg].pd, value); break;
-    case 4: cpu->xmm[reg].pd = simde_mm_cmpneq_sd(cpu->xmm[reg].pd, value); break;
-    case 5: cpu->xmm[reg].pd = simde_mm_cmpnlt_sd(cpu->xmm[reg].pd, value); break;
-    case 6: cpu->xmm[reg].pd = simde_mm_cmpnle_sd(cpu->xmm[reg].pd, value); break;
-    case 7: cpu->xmm[reg].pd = simde_mm_cmpord_sd(cpu->xmm[reg].pd, value); break;
+    case 0: cpu->xmm[reg].pd = simde_mm_cmpeq_sd(cpu->xmm[reg].pd, value.pd); break;
+    case 1: cpu->xmm[reg].pd = simde_mm_cmplt_sd(cpu->xmm[reg].pd, value.pd); break;
+    case 2: cpu->xmm[reg].pd = simde_mm_cmple_sd(cpu->xmm[reg].pd, value.pd); break;
+    case 3: cpu->xmm[reg].pd = simde_mm_cmpunord_sd(cpu->xmm[reg].pd, value.pd); break;
+    case 4: cpu->xmm[reg].pd = simde_mm_cmpneq_sd(cpu->xmm[reg].pd, value.pd); break;
+    case 5: cpu->xmm[reg].pd = simde_mm_cmpnlt_sd(cpu->xmm[reg].pd, value.pd); break;
+    case 6: cpu->xmm[reg].pd = simde_mm_cmpnle_sd(cpu->xmm[reg].pd, value.pd); break;
+    case 7: cpu->xmm[reg].pd = simde_mm_cmpord_sd(cpu->xmm[reg].pd, value.pd); break;
     }
 }
 
 void common_comisdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
     cpu->fillFlags();
     cpu->flags&=~(AF|OF|SF|CF|PF|ZF);
-    const simde__m128d& a = cpu->xmm[r1].pd;
-    const simde__m128d& b = cpu->xmm[r2].pd;
+    const SSE& a = cpu->xmm[r1];
+    const SSE& b = cpu->xmm[r2];
     if (isnan(a.f64[0]) || isnan(b.f64[0])) {
         cpu->flags|=CF|ZF|PF;
     } else if (a.f64[0] == b.f64[0]) {
@@ -710,9 +719,9 @@ void common_comisdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 void common_comisdXmmE64(CPU* cpu, U32 reg, U32 address) {
     cpu->fillFlags();
     cpu->flags&=~(AF|OF|SF|CF|PF|ZF);
-    const simde__m128d& a = cpu->xmm[reg].pd;
-    simde__m128d b;
-    b.u64[0] = readq(address);
+    const SSE& a = cpu->xmm[reg];
+    SSE b;
+    b.u64[0] = readq(cpu->thread->memory, address);
     if (isnan(a.f64[0]) || isnan(b.f64[0])) {
         cpu->flags|=CF|ZF|PF;
     } else if (a.f64[0] == b.f64[0]) {
@@ -735,10 +744,10 @@ void common_pcmpgtbXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pcmpgtbXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_cmpgt_epi8(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_cmpgt_epi8(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_pcmpgtwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -746,10 +755,10 @@ void common_pcmpgtwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pcmpgtwXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_cmpgt_epi16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_cmpgt_epi16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_pcmpgtdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -757,10 +766,10 @@ void common_pcmpgtdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pcmpgtdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_cmpgt_epi32(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_cmpgt_epi32(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_pcmpeqbXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -768,10 +777,10 @@ void common_pcmpeqbXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pcmpeqbXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_cmpeq_epi8(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_cmpeq_epi8(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_pcmpeqwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -779,10 +788,10 @@ void common_pcmpeqwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pcmpeqwXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_cmpeq_epi16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_cmpeq_epi16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_pcmpeqdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -790,10 +799,10 @@ void common_pcmpeqdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pcmpeqdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_cmpeq_epi32(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_cmpeq_epi32(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_cvtdq2pdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -801,10 +810,10 @@ void common_cvtdq2pdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_cvtdq2pdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pd = simde_mm_cvtepi32_pd(value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pd = simde_mm_cvtepi32_pd(value.pi);
 }
 
 void common_cvtdq2psXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -812,21 +821,21 @@ void common_cvtdq2psXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_cvtdq2psXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].ps = simde_mm_cvtepi32_ps(value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].ps = simde_mm_cvtepi32_ps(value.pi);
 }
 
 void common_cvtpd2piMmxXmm(CPU* cpu, U32 r1, U32 r2) {
-    cpu->reg_mmx[r1].q = simde_mm_cvtpd_pi32(cpu->xmm[r2].pd).u64[0];
+    cpu->reg_mmx[r1].q = simde_mm_cvtm64_si64(simde_mm_cvtpd_pi32(cpu->xmm[r2].pd));
 }
 
 void common_cvtpd2piMmxE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->reg_mmx[reg].q = simde_mm_cvtpd_pi32(value).u64[0];
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->reg_mmx[reg].q = simde_mm_cvtm64_si64(simde_mm_cvtpd_pi32(value.pd));
 }
 
 void common_cvtpd2dqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -834,10 +843,10 @@ void common_cvtpd2dqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_cvtpd2dqXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_cvtpd_epi32(value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_cvtpd_epi32(value.pd);
 }
 
 void common_cvtpd2psXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -845,21 +854,19 @@ void common_cvtpd2psXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_cvtpd2psXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].ps = simde_mm_cvtpd_ps(value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].ps = simde_mm_cvtpd_ps(value.pd);
 }
 
 void common_cvtpi2pdXmmMmx(CPU* cpu, U32 r1, U32 r2) {
-    simde__m64 value;
-    value.u64[0] = cpu->reg_mmx[r2].q;
+    simde__m64 value = simde_mm_cvtsi64_m64(cpu->reg_mmx[r2].q);
     cpu->xmm[r1].pd = simde_mm_cvtpi32_pd(value);
 }
 
 void common_cvtpi2pdXmmE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m64 value;
-    value.u64[0] = readq(address);
+    simde__m64 value = simde_mm_cvtsi64_m64(readq(cpu->thread->memory, address));
     cpu->xmm[reg].pd = simde_mm_cvtpi32_pd(value);
 }
 
@@ -868,10 +875,10 @@ void common_cvtps2dqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_cvtps2dqXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_cvtps_epi32(value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_cvtps_epi32(value.ps);
 }
 
 void common_cvtps2pdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -879,9 +886,9 @@ void common_cvtps2pdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_cvtps2pdXmmE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    cpu->xmm[reg].pd = simde_mm_cvtps_pd(value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    cpu->xmm[reg].pd = simde_mm_cvtps_pd(value.ps);
 }
 
 void common_cvtsd2siR32Xmm(CPU* cpu, U32 r1, U32 r2) {
@@ -889,10 +896,10 @@ void common_cvtsd2siR32Xmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_cvtsd2siR32E64(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    //value.u64[1] = readq(address+8);
-    cpu->reg[reg].u32 = simde_mm_cvtsd_si32(value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    //value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->reg[reg].u32 = simde_mm_cvtsd_si32(value.pd);
 }
 
 void common_cvtsd2ssXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -900,10 +907,10 @@ void common_cvtsd2ssXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_cvtsd2ssXmmE64(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    //value.u64[1] = readq(address+8);
-    cpu->xmm[reg].ps = simde_mm_cvtsd_ss(cpu->xmm[reg].ps, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    //value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].ps = simde_mm_cvtsd_ss(cpu->xmm[reg].ps, value.pd);
 }
 
 void common_cvtsi2sdXmmR32(CPU* cpu, U32 r1, U32 r2) {
@@ -911,7 +918,7 @@ void common_cvtsi2sdXmmR32(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_cvtsi2sdXmmE32(CPU* cpu, U32 reg, U32 address) {
-    cpu->xmm[reg].pd = simde_mm_cvtsi32_sd(cpu->xmm[reg].pd, readd(address));
+    cpu->xmm[reg].pd = simde_mm_cvtsi32_sd(cpu->xmm[reg].pd, readd(cpu->thread->memory, address));
 }
 
 void common_cvtss2sdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -919,20 +926,20 @@ void common_cvtss2sdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_cvtss2sdXmmE32(CPU* cpu, U32 reg, U32 address) {
-    simde__m128 value;
-    value.u32[0] = readd(address);
-    cpu->xmm[reg].pd = simde_mm_cvtss_sd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u32[0] = readd(cpu->thread->memory, address);
+    cpu->xmm[reg].pd = simde_mm_cvtss_sd(cpu->xmm[reg].pd, value.ps);
 }
 
 void common_cvttpd2piMmxXmm(CPU* cpu, U32 r1, U32 r2) {
-    cpu->reg_mmx[r1].q = simde_mm_cvttpd_pi32(cpu->xmm[r2].pd).u64[0];
+    cpu->reg_mmx[r1].q = simde_mm_cvtm64_si64(simde_mm_cvttpd_pi32(cpu->xmm[r2].pd));
 }
 
 void common_cvttpd2piMmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->reg_mmx[reg].q = simde_mm_cvttpd_pi32(value).u64[0];
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->reg_mmx[reg].q = simde_mm_cvtm64_si64(simde_mm_cvttpd_pi32(value.pd));
 }
 
 void common_cvttpd2dqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -940,10 +947,10 @@ void common_cvttpd2dqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_cvttpd2dqXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_cvttpd_epi32(value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_cvttpd_epi32(value.pd);
 }
 
 void common_cvttps2dqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -951,10 +958,10 @@ void common_cvttps2dqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_cvttps2dqXmmE128(CPU* cpu,U32 reg, U32 address ) {
-    simde__m128 value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_cvttps_epi32(value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_cvttps_epi32(value.ps);
 }
 
 void common_cvttsd2siR32Xmm(CPU* cpu, U32 r1, U32 r2) {
@@ -962,10 +969,10 @@ void common_cvttsd2siR32Xmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_cvttsd2siR32E64(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->reg[reg].u32 = simde_mm_cvttsd_si32(value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->reg[reg].u32 = simde_mm_cvttsd_si32(value.pd);
 }
 
 void common_movqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -973,12 +980,12 @@ void common_movqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_movqE64Xmm(CPU* cpu, U32 reg, U32 address) {
-    writeq(address, cpu->xmm[reg].pi.u64[0]);
+    writeq(cpu->thread->memory, address, cpu->xmm[reg].u64[0]);
 }
 
 void common_movqXmmE64(CPU* cpu, U32 reg, U32 address) {
-    cpu->xmm[reg].pi.u64[0] = readq(address);
-    cpu->xmm[reg].pi.u64[1] = 0;
+    cpu->xmm[reg].u64[0] = readq(cpu->thread->memory, address);
+    cpu->xmm[reg].u64[1] = 0;
 }
 
 void common_movsdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -986,12 +993,12 @@ void common_movsdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_movsdXmmE64(CPU* cpu, U32 reg, U32 address) {
-    cpu->xmm[reg].pd.u64[0] = readq(address);
-    cpu->xmm[reg].pd.u64[1] = 0; // yes, memory to reg will 0 out the top, but xmm to xmm does not, unlike movq
+    cpu->xmm[reg].u64[0] = readq(cpu->thread->memory, address);
+    cpu->xmm[reg].u64[1] = 0; // yes, memory to reg will 0 out the top, but xmm to xmm does not, unlike movq
 }
 
 void common_movsdE64Xmm(CPU* cpu, U32 reg, U32 address) {
-    writeq(address, cpu->xmm[reg].pd.u64[0]);
+    writeq(cpu->thread->memory, address, cpu->xmm[reg].u64[0]);
 }
 
 void common_movapdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -999,13 +1006,13 @@ void common_movapdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_movapdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    cpu->xmm[reg].pd.u64[0] = readq(address);
-    cpu->xmm[reg].pd.u64[1] = readq(address+8);
+    cpu->xmm[reg].u64[0] = readq(cpu->thread->memory, address);
+    cpu->xmm[reg].u64[1] = readq(cpu->thread->memory, address+8);
 }
 
 void common_movapdE128Xmm(CPU* cpu, U32 reg, U32 address) {
-    writeq(address, cpu->xmm[reg].pd.u64[0]);
-    writeq(address+8, cpu->xmm[reg].pd.u64[1]);
+    writeq(cpu->thread->memory, address, cpu->xmm[reg].u64[0]);
+    writeq(cpu->thread->memory, address+8, cpu->xmm[reg].u64[1]);
 }
 
 void common_movupdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1013,29 +1020,29 @@ void common_movupdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_movupdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    cpu->xmm[reg].pd.u64[0] = readq(address);
-    cpu->xmm[reg].pd.u64[1] = readq(address+8);
+    cpu->xmm[reg].u64[0] = readq(cpu->thread->memory, address);
+    cpu->xmm[reg].u64[1] = readq(cpu->thread->memory, address+8);
 }
 
 void common_movupdE128Xmm(CPU* cpu, U32 reg, U32 address) {
-    writeq(address, cpu->xmm[reg].pd.u64[0]);
-    writeq(address+8, cpu->xmm[reg].pd.u64[1]);
+    writeq(cpu->thread->memory, address, cpu->xmm[reg].u64[0]);
+    writeq(cpu->thread->memory, address+8, cpu->xmm[reg].u64[1]);
 }
 
 void common_movhpdXmmE64(CPU* cpu, U32 reg, U32 address) {
-    cpu->xmm[reg].pd.u64[1] = readq(address);
+    cpu->xmm[reg].u64[1] = readq(cpu->thread->memory, address);
 }
 
 void common_movhpdE64Xmm(CPU* cpu, U32 reg, U32 address) {
-    writeq(address, cpu->xmm[reg].pd.u64[1]);
+    writeq(cpu->thread->memory, address, cpu->xmm[reg].u64[1]);
 }
 
 void common_movlpdXmmE64(CPU* cpu, U32 reg, U32 address) {
-    cpu->xmm[reg].pd.u64[0] = readq(address);
+    cpu->xmm[reg].u64[0] = readq(cpu->thread->memory, address);
 }
 
 void common_movlpdE64Xmm(CPU* cpu, U32 reg, U32 address) {
-    writeq(address, cpu->xmm[reg].pd.u64[0]);
+    writeq(cpu->thread->memory, address, cpu->xmm[reg].u64[0]);
 }
 
 void common_movmskpdR32Xmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1047,7 +1054,7 @@ void common_movdXmmR32(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_movdXmmE32(CPU* cpu, U32 reg, U32 address) {
-    cpu->xmm[reg].pi = simde_mm_cvtsi32_si128(readd(address));
+    cpu->xmm[reg].pi = simde_mm_cvtsi32_si128(readd(cpu->thread->memory, address));
 }
 
 void common_movdR32Xmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1055,7 +1062,7 @@ void common_movdR32Xmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_movdE32Xmm(CPU* cpu, U32 reg, U32 address) {
-    writed(address, simde_mm_cvtsi128_si32(cpu->xmm[reg].pi));
+    writed(cpu->thread->memory, address, simde_mm_cvtsi128_si32(cpu->xmm[reg].pi));
 }
 
 void common_movdqaXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1063,13 +1070,13 @@ void common_movdqaXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_movdqaXmmE128(CPU* cpu, U32 reg, U32 address) {
-    cpu->xmm[reg].pi.u64[0] = readq(address);
-    cpu->xmm[reg].pi.u64[1] = readq(address+8);
+    cpu->xmm[reg].u64[0] = readq(cpu->thread->memory, address);
+    cpu->xmm[reg].u64[1] = readq(cpu->thread->memory, address+8);
 }
 
 void common_movdqaE128Xmm(CPU* cpu, U32 reg, U32 address) {
-    writeq(address, cpu->xmm[reg].pi.u64[0]);
-    writeq(address+8, cpu->xmm[reg].pi.u64[1]);
+    writeq(cpu->thread->memory, address, cpu->xmm[reg].u64[0]);
+    writeq(cpu->thread->memory, address+8, cpu->xmm[reg].u64[1]);
 }
 
 void common_movdquXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1077,37 +1084,36 @@ void common_movdquXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_movdquXmmE128(CPU* cpu, U32 reg, U32 address) {
-    cpu->xmm[reg].pi.u64[0] = readq(address);
-    cpu->xmm[reg].pi.u64[1] = readq(address+8);
+    cpu->xmm[reg].u64[0] = readq(cpu->thread->memory, address);
+    cpu->xmm[reg].u64[1] = readq(cpu->thread->memory, address+8);
 }
 
 void common_movdquE128Xmm(CPU* cpu, U32 reg, U32 address) {
-    writeq(address, cpu->xmm[reg].pi.u64[0]);
-    writeq(address+8, cpu->xmm[reg].pi.u64[1]);
+    writeq(cpu->thread->memory, address, cpu->xmm[reg].u64[0]);
+    writeq(cpu->thread->memory, address+8, cpu->xmm[reg].u64[1]);
 }
 
 void common_movdq2qMmxXmm(CPU* cpu, U32 r1, U32 r2) {
-    cpu->reg_mmx[r1].q = simde_mm_movepi64_pi64(cpu->xmm[r2].pi).u64[0];
+    cpu->reg_mmx[r1].q = simde_mm_cvtm64_si64(simde_mm_movepi64_pi64(cpu->xmm[r2].pi));
 }
 
 void common_movq2dqXmmMmx(CPU* cpu, U32 r1, U32 r2) {
-    simde__m64 value;
-    value.u64[0] = cpu->reg_mmx[r2].q;
+    simde__m64 value = simde_mm_cvtsi64_m64(cpu->reg_mmx[r2].q);
     cpu->xmm[r1].pi = simde_mm_movpi64_epi64(value);
 }
 
 void common_movntpdE128Xmm(CPU* cpu, U32 reg, U32 address) {
-    writeq(address, cpu->xmm[reg].pd.u64[0]);
-    writeq(address+8, cpu->xmm[reg].pd.u64[1]);
+    writeq(cpu->thread->memory, address, cpu->xmm[reg].u64[0]);
+    writeq(cpu->thread->memory, address+8, cpu->xmm[reg].u64[1]);
 }
 
 void common_movntdqE128Xmm(CPU* cpu, U32 reg, U32 address) {
-    writeq(address, cpu->xmm[reg].pd.u64[0]);
-    writeq(address+8, cpu->xmm[reg].pd.u64[1]);
+    writeq(cpu->thread->memory, address, cpu->xmm[reg].u64[0]);
+    writeq(cpu->thread->memory, address+8, cpu->xmm[reg].u64[1]);
 }
 
 void common_movntiE32R32(CPU* cpu, U32 reg, U32 address) {
-    writed(address, cpu->reg[reg].u32);
+    writed(cpu->thread->memory, address, cpu->reg[reg].u32);
 }
 
 void common_maskmovdquE128XmmXmm(CPU* cpu, U32 r1, U32 r2, U32 address) {
@@ -1117,37 +1123,54 @@ void common_maskmovdquE128XmmXmm(CPU* cpu, U32 r1, U32 r2, U32 address) {
     writeMemory(address, (U8*)result, 16);
 }
 
+static void pshufd(SSE& dest, const SSE& src, U8 imm) {
+    SSE result;
+    for (U32 i = 0; i < 4; i++) {
+        result.u32[i] = src.u32[(imm >> (i * 2)) & 3];
+    }
+    dest = result;
+}
+
+// lanes is 0 for the low 4 words (pshuflw) or 4 for the high 4 words (pshufhw), the other 4 are copied
+static void pshufw(SSE& dest, const SSE& src, U8 imm, U32 lanes) {
+    SSE result = src;
+    for (U32 i = 0; i < 4; i++) {
+        result.words[lanes + i] = src.words[lanes + ((imm >> (i * 2)) & 3)];
+    }
+    dest = result;
+}
+
 void common_pshufdXmmXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
-    cpu->xmm[r1].pi = simde_mm_shuffle_epi32(cpu->xmm[r2].pi, imm);
+    pshufd(cpu->xmm[r1], cpu->xmm[r2], imm);
 }
 
 void common_pshufdXmmE128(CPU* cpu, U32 reg, U32 address, U8 imm) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_shuffle_epi32(value, imm);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    pshufd(cpu->xmm[reg], value, imm);
 }
 
 void common_pshufhwXmmXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
-    cpu->xmm[r1].pi = simde_mm_shufflehi_epi16(cpu->xmm[r2].pi, imm);
+    pshufw(cpu->xmm[r1], cpu->xmm[r2], imm, 4);
 }
 
 void common_pshufhwXmmE128(CPU* cpu, U32 reg, U32 address, U8 imm) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_shufflehi_epi16(value, imm);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    pshufw(cpu->xmm[reg], value, imm, 4);
 }
 
 void common_pshuflwXmmXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
-    cpu->xmm[r1].pi = simde_mm_shufflelo_epi16(cpu->xmm[r2].pi, imm);
+    pshufw(cpu->xmm[r1], cpu->xmm[r2], imm, 0);
 }
 
 void common_pshuflwXmmE128(CPU* cpu, U32 reg, U32 address, U8 imm) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_shufflelo_epi16(value, imm);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    pshufw(cpu->xmm[reg], value, imm, 0);
 }
 
 void common_unpckhpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1155,10 +1178,10 @@ void common_unpckhpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_unpckhpdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pd = simde_mm_unpackhi_pd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pd = simde_mm_unpackhi_pd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_unpcklpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1166,10 +1189,10 @@ void common_unpcklpdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_unpcklpdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pd = simde_mm_unpacklo_pd(cpu->xmm[reg].pd, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pd = simde_mm_unpacklo_pd(cpu->xmm[reg].pd, value.pd);
 }
 
 void common_punpckhbwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1177,10 +1200,10 @@ void common_punpckhbwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_punpckhbwXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_unpackhi_epi8(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_unpackhi_epi8(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_punpckhwdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1188,10 +1211,10 @@ void common_punpckhwdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_punpckhwdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_unpackhi_epi16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_unpackhi_epi16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_punpckhdqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1199,10 +1222,10 @@ void common_punpckhdqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_punpckhdqXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_unpackhi_epi32(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_unpackhi_epi32(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_punpckhqdqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1210,10 +1233,10 @@ void common_punpckhqdqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_punpckhqdqXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_unpackhi_epi64(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_unpackhi_epi64(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_punpcklbwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1221,10 +1244,10 @@ void common_punpcklbwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_punpcklbwXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_unpacklo_epi8(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_unpacklo_epi8(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_punpcklwdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1232,10 +1255,10 @@ void common_punpcklwdXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_punpcklwdXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_unpacklo_epi16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_unpacklo_epi16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_punpckldqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1243,10 +1266,10 @@ void common_punpckldqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_punpckldqXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_unpacklo_epi32(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_unpacklo_epi32(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_punpcklqdqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1254,10 +1277,10 @@ void common_punpcklqdqXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_punpcklqdqXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_unpacklo_epi64(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_unpacklo_epi64(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_packssdwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1265,10 +1288,10 @@ void common_packssdwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_packssdwXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_packs_epi32(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_packs_epi32(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_packsswbXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1276,10 +1299,10 @@ void common_packsswbXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_packsswbXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_packs_epi16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_packs_epi16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_packuswbXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1287,21 +1310,27 @@ void common_packuswbXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_packuswbXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_packus_epi16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_packus_epi16(cpu->xmm[reg].pi, value.pi);
+}
+
+static void shufpd(SSE& dest, const SSE& src, U8 imm) {
+    U64 low = dest.u64[imm & 1];
+    dest.u64[1] = src.u64[(imm >> 1) & 1];
+    dest.u64[0] = low;
 }
 
 void common_shufpdXmmXmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
-    cpu->xmm[r1].pd = simde_mm_shuffle_pd(cpu->xmm[r1].pd, cpu->xmm[r2].pd, imm);
+    shufpd(cpu->xmm[r1], cpu->xmm[r2], imm);
 }
 
 void common_shufpdXmmE128(CPU* cpu, U32 reg, U32 address, U8 imm) {
-    simde__m128d value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pd = simde_mm_shuffle_pd(cpu->xmm[reg].pd, value, imm);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    shufpd(cpu->xmm[reg], value, imm);
 }
 
 void common_pause(CPU* cpu) {
@@ -1312,10 +1341,10 @@ void common_pavgbXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pavgbXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_avg_epu8(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_avg_epu8(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_pavgwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1323,10 +1352,10 @@ void common_pavgwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pavgwXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_avg_epu16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_avg_epu16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_psadbwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1334,29 +1363,29 @@ void common_psadbwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_psadbwXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_sad_epu8(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_sad_epu8(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_pextrwR32Xmm(CPU* cpu, U32 r1, U32 r2, U8 imm) {
-    cpu->reg[r1].u32 = simde_mm_extract_epi16(cpu->xmm[r2].pi, imm);
+    cpu->reg[r1].u32 = cpu->xmm[r2].words[imm & 7];
 }
 
 void common_pextrwE16Xmm(CPU* cpu, U32 reg, U32 address, U8 imm) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->reg[reg].u32 = simde_mm_extract_epi16(value, imm);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->reg[reg].u32 = value.words[imm & 7];
 }
 
 void common_pinsrwXmmR32(CPU* cpu, U32 r1, U32 r2, U8 imm) {
-    cpu->xmm[r1].pi = simde_mm_insert_epi16(cpu->xmm[r1].pi, cpu->reg[r2].u32, imm);
+    cpu->xmm[r1].words[imm & 7] = cpu->reg[r2].u16;
 }
 
 void common_pinsrwXmmE16(CPU* cpu, U32 reg, U32 address, U8 imm) {
-    cpu->xmm[reg].pi = simde_mm_insert_epi16(cpu->xmm[reg].pi, readw(address), imm);
+    cpu->xmm[reg].words[imm & 7] = readw(cpu->thread->memory, address);
 }
 
 void common_pmaxswXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1364,10 +1393,10 @@ void common_pmaxswXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pmaxswXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_max_epi16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_max_epi16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_pmaxubXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1375,10 +1404,10 @@ void common_pmaxubXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pmaxubXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_max_epu8(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_max_epu8(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_pminswXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1386,10 +1415,10 @@ void common_pminswXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pminswXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_min_epi16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_min_epi16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_pminubXmmXmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1397,10 +1426,10 @@ void common_pminubXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pminubXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_min_epu8(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_min_epu8(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_pmovmskbR32Xmm(CPU* cpu, U32 r1, U32 r2) {
@@ -1412,10 +1441,10 @@ void common_pmulhuwXmmXmm(CPU* cpu, U32 r1, U32 r2) {
 }
 
 void common_pmulhuwXmmE128(CPU* cpu, U32 reg, U32 address) {
-    simde__m128i value;
-    value.u64[0] = readq(address);
-    value.u64[1] = readq(address+8);
-    cpu->xmm[reg].pi = simde_mm_mulhi_epu16(cpu->xmm[reg].pi, value);
+    SSE value;
+    value.u64[0] = readq(cpu->thread->memory, address);
+    value.u64[1] = readq(cpu->thread->memory, address+8);
+    cpu->xmm[reg].pi = simde_mm_mulhi_epu16(cpu->xmm[reg].pi, value.pi);
 }
 
 void common_lfence(CPU* cpu) {
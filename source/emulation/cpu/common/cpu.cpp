@@ -80,8 +80,8 @@ void CPU::reset() {
     }
     this->resetMMX();
     for (int i=0;i<8;i++) {
-        this->xmm[i].pi.u64[0] = 0;
-        this->xmm[i].pi.u64[1] = 0;
+        this->xmm[i].u64[0] = 0;
+        this->xmm[i].u64[1] = 0;
     }
     this->lazyFlags = 0;
     this->setIsBig(1);
@@ -5,12 +5,21 @@
 #include "lazyFlags.h"
 #include "fpu.h"
 #include "../decoder.h"
+// By default the SSE/SSE2/MMX helpers use simde's portable scalar code.  BOXEDWINE_NATIVE_SIMD lets simde use the
+// host's vector instructions, SSE2 is always there on x86-64 and NEON on aarch64 so it is decided at compile time.
+// Host MMX instructions are never used, they would share the x87 registers with the host's own floating point code.
+#ifdef BOXEDWINE_NATIVE_SIMD
+#ifndef SIMDE_X86_MMX_NO_NATIVE
+#define SIMDE_X86_MMX_NO_NATIVE
+#endif
+#else
 #ifndef SIMDE_NO_NATIVE
 #define SIMDE_NO_NATIVE
 #endif
 #ifndef SIMDE_NO_VECTOR
 #define SIMDE_NO_VECTOR
 #endif
+#endif
 #ifndef SIMDE_NO_CHECK_IMMEDIATE_CONSTANT
 #define SIMDE_NO_CHECK_IMMEDIATE_CONSTANT
 #endif
@@ -217,10 +226,22 @@ struct user_desc {
 class KThread;
 class Memory;
 
+// ps/pd/pi are what is passed to simde, the arrays are for getting at the lanes since simde's types might be the
+// host's native vector types
 union SSE {
     simde__m128 ps;
     simde__m128d pd;
     simde__m128i pi;
+    U8 bytes[16]; // u8 and u16 are taken by the Reg macros
+    S8 i8[16];
+    U16 words[8];
+    S16 i16[8];
+    U32 u32[4];
+    S32 i32[4];
+    U64 u64[2];
+    S64 i64[2];
+    float f32[4];
+    double f64[2];
 };
 
 class CPU {
@@ -286,9 +286,9 @@ void FPU::ST80(CPU* cpu, U32 addr, int reg) {
         //Ca-cyber doesn't like this when result is zero.
         exp80final += (BIAS80 - BIAS64);
     }
-    writed(addr, (U32) mant80final);
-    writed(addr + 4, (U32) (mant80final >> 32));
-    writew(addr + 8, ((sign80 << 15) | (exp80final)));
+    writed(cpu->thread->memory, addr, (U32) mant80final);
+    writed(cpu->thread->memory, addr + 4, (U32) (mant80final >> 32));
+    writew(cpu->thread->memory, addr + 8, ((sign80 << 15) | (exp80final)));
 }
 
 void FPU::ST80(U32 reg, U64* pLow, U64* pHigh) {
@@ -365,30 +365,30 @@ void FPU::FBLD(U8 data[], int store_to) {
 }
 
 void FPU::FLD_F32_EA(CPU* cpu, U32 address) {
-    FLD_F32(readd(address), 8);
+    FLD_F32(readd(cpu->thread->memory, address), 8);
 }
 
 void FPU::FLD_F64_EA(CPU* cpu, U32 address) {
-    FLD_F64(readq(address), 8);
+    FLD_F64(readq(cpu->thread->memory, address), 8);
 }
 
 void FPU::FLD_I32_EA(CPU* cpu, U32 address) {
-    FLD_I32(readd(address), 8);
+    FLD_I32(readd(cpu->thread->memory, address), 8);
 }
 
 void FPU::FLD_I16_EA(CPU* cpu, U32 address) {
-    FLD_I16(readw(address), 8);
+    FLD_I16(readw(cpu->thread->memory, address), 8);
 }
 
 void FPU::FST_F32(CPU* cpu, U32 addr) {
     //should depend on rounding method
     struct FPU_Float f;
     f.f = (float)this->regs[this->top].d;
-    writed(addr, f.i);
+    writed(cpu->thread->memory, addr, f.i);
 }
 
 void FPU::FST_F64(CPU* cpu, U32 addr) {
-    writeq(addr, this->regs[this->top].l);
+    writeq(cpu->thread->memory, addr, this->regs[this->top].l);
 }
 
 void FPU::FST_F80(CPU* cpu, U32 addr) {
@@ -397,36 +397,36 @@ void FPU::FST_F80(CPU* cpu, U32 addr) {
 
 void FPU::FST_I16(CPU* cpu, U32 addr) {
     S16 value = (S16) (FROUND(this->regs[this->top].d));
-    writew(addr, value);
+    writew(cpu->thread->memory, addr, value);
 }
 
 void FPU::FSTT_I16(CPU* cpu, U32 addr) {
     S16 value = (S16)this->regs[this->top].d;
-    writew(addr, value);
+    writew(cpu->thread->memory, addr, value);
 }
 
 void FPU::FSTT_I32(CPU* cpu, U32 addr) {
     S32 value = (S32)this->regs[this->top].d;
-    writed(addr, value);
+    writed(cpu->thread->memory, addr, value);
 }
 
 void FPU::FST_I32(CPU* cpu, U32 addr) {
     S32 value = (S32) (FROUND(this->regs[this->top].d));
-    writed(addr, value);
+    writed(cpu->thread->memory, addr, value);
 }
 
 void FPU::FSTT_I64(CPU* cpu, U32 addr) {
     if (this->isIntegerLoaded[this->top])
-        writeq(addr, this->loadedInteger[this->top]);
+        writeq(cpu->thread->memory, addr, this->loadedInteger[this->top]);
     else
-        writeq(addr, (S64)this->regs[this->top].d);
+        writeq(cpu->thread->memory, addr, (S64)this->regs[this->top].d);
 }
 
 void FPU::FST_I64(CPU* cpu, U32 addr) {
     if (this->isIntegerLoaded[this->top])
-        writeq(addr, this->loadedInteger[this->top]);
+        writeq(cpu->thread->memory, addr, this->loadedInteger[this->top]);
     else
-        writeq(addr, (S64) (FROUND(this->regs[this->top].d)));
+        writeq(cpu->thread->memory, addr, (S64) (FROUND(this->regs[this->top].d)));
 }
 
 void FPU::FBST(CPU* cpu, U32 addr) {
@@ -449,14 +449,14 @@ void FPU::FBST(CPU* cpu, U32 addr) {
         val.d=temp;
         temp = (double)((S64)(floor(val.d/10.0)));
         p |= ((int)(val.d - 10.0*temp)<<4);
-        writeb(addr+i,p);
+        writeb(cpu->thread->memory, addr+i,p);
     }
     val.d=temp;
     temp = (double)((S64)(floor(val.d/10.0)));
     p = (int)(val.d - 10.0*temp);
     if(sign)
         p|=0x80;
-    writeb(addr+9,p); 
+    writeb(cpu->thread->memory, addr+9,p); 
 }
 
 void FPU::FADD(int op1, int op2) {
@@ -775,13 +775,13 @@ U32 FPU::SW() {
 void FPU::FSTENV(CPU* cpu, U32 addr) {
     FPU_SET_TOP(this, this->top);
     if (!cpu->isBig()) {
-        writew(addr + 0, this->cw);
-        writew(addr + 2, this->sw);
-        writew(addr + 4, GetTag());
+        writew(cpu->thread->memory, addr + 0, this->cw);
+        writew(cpu->thread->memory, addr + 2, this->sw);
+        writew(cpu->thread->memory, addr + 4, GetTag());
     } else {
-        writed(addr + 0, this->cw);
-        writed(addr + 4, this->sw);
-        writed(addr + 8, GetTag());
+        writed(cpu->thread->memory, addr + 0, this->cw);
+        writed(cpu->thread->memory, addr + 4, this->sw);
+        writed(cpu->thread->memory, addr + 8, GetTag());
     }
 }
 
@@ -790,13 +790,13 @@ void FPU::FLDENV(CPU* cpu, U32 addr) {
     U32 cw;
         
     if (!cpu->isBig()) {
-        cw = readw(addr + 0);
-        this->sw = readw(addr + 2);
-        tag = readw(addr + 4);
+        cw = readw(cpu->thread->memory, addr + 0);
+        this->sw = readw(cpu->thread->memory, addr + 2);
+        tag = readw(cpu->thread->memory, addr + 4);
     } else {
-        cw = readd(addr + 0);
-        this->sw = readd(addr + 4);
-        tag = readd(addr + 8);
+        cw = readd(cpu->thread->memory, addr + 0);
+        this->sw = readd(cpu->thread->memory, addr + 4);
+        tag = readd(cpu->thread->memory, addr + 8);
     }
     SetTag(tag);
     SetCW(cw);
@@ -823,7 +823,7 @@ void FPU::FRSTOR(CPU* cpu, U32 addr) {
     FLDENV(cpu, addr);
             
     for (i = 0; i < 8; i++) {
-        this->regs[STV(i)].d = FLD80(readq(addr + start), readw(addr + start + 8));
+        this->regs[STV(i)].d = FLD80(readq(cpu->thread->memory, addr + start), readw(cpu->thread->memory, addr + start + 8));
         this->isIntegerLoaded[STV(i)] = 0;
         start += 10;
     }
@@ -932,7 +932,7 @@ void FPU::FCOM_EA() {
 }
 
 void FPU::FLDCW(CPU* cpu, U32 addr) {
-    U32 temp = readw(addr);
+    U32 temp = readw(cpu->thread->memory, addr);
     SetCW(temp);
 }    
 
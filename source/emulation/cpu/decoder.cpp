@@ -5943,18 +5943,115 @@ U32 DecodeData::fetch32() {
     return ((U32)this->fetch16()) | (((U32)this->fetch16()) << 16);
 }
 
-static DecodedOp* freeOps;
-BOXEDWINE_MUTEX freeOpsMutex;
+// Every thread keeps its own list of free ops, so decoding and freeing blocks never needs a lock.  New ops are
+// allocated DECODED_OP_SLAB_SIZE at a time, which keeps the ops of a freshly decoded block next to each other in
+// memory.  Once a thread has collected DECODED_OP_MAX_THREAD_FREE free ops the whole list is handed over to
+// sharedFreeOps where any thread can pick it up, the same happens when a thread exits (releaseThreadCache).  The lock
+// is only taken when a whole list moves between a thread and sharedFreeOps or a slab is allocated.
+#define DECODED_OP_SLAB_SIZE 256
+#define DECODED_OP_MAX_THREAD_FREE 4096
+
+class DecodedOpList {
+public:
+    DecodedOp* first;
+    U32 count;
+};
+
+static THREAD_LOCAL DecodedOp* threadFreeOps;
+static THREAD_LOCAL U32 threadFreeOpCount;
+static std::vector<DecodedOpList> sharedFreeOps;
+static U32 sharedFreeOpCount;
+static std::vector<DecodedOp*> opSlabs;
+static BOXEDWINE_MUTEX sharedFreeOpsMutex;
+
+static void refillThreadFreeOps() {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(sharedFreeOpsMutex);
+    if (sharedFreeOps.size()) {
+        DecodedOpList list = sharedFreeOps.back();
+        sharedFreeOps.pop_back();
+        sharedFreeOpCount -= list.count;
+        threadFreeOps = list.first;
+        threadFreeOpCount = list.count;
+        return;
+    }
+    DecodedOp* slab = new DecodedOp[DECODED_OP_SLAB_SIZE];
+    opSlabs.push_back(slab);
+    // linked in order so that consecutive allocations are consecutive in memory
+    for (U32 i = 0; i < DECODED_OP_SLAB_SIZE - 1; i++) {
+        slab[i].next = &slab[i + 1];
+    }
+    slab[DECODED_OP_SLAB_SIZE - 1].next = NULL;
+    threadFreeOps = slab;
+    threadFreeOpCount = DECODED_OP_SLAB_SIZE;
+}
+
+static void releaseThreadFreeOps() {
+    if (!threadFreeOps) {
+        return;
+    }
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(sharedFreeOpsMutex);
+    DecodedOpList list;
+    list.first = threadFreeOps;
+    list.count = threadFreeOpCount;
+    sharedFreeOps.push_back(list);
+    sharedFreeOpCount += list.count;
+    threadFreeOps = NULL;
+    threadFreeOpCount = 0;
+}
 
 DecodedOp::DecodedOp() {
     this->init();
 }
 
+void DecodedOp::releaseThreadCache() {
+    releaseThreadFreeOps();
+}
+
 void DecodedOp::clearCache() {
-    while (freeOps) {
-        DecodedOp* next = freeOps->next;
-        delete freeOps;
-        freeOps = next;
+    releaseThreadFreeOps();
+
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(sharedFreeOpsMutex);
+    // an op can only be freed along with the rest of its slab, so count the free ops of each slab
+    std::sort(opSlabs.begin(), opSlabs.end());
+    std::vector<U32> slabFreeCount(opSlabs.size(), 0);
+    for (auto& list : sharedFreeOps) {
+        for (DecodedOp* op = list.first; op; op = op->next) {
+            size_t index = std::upper_bound(opSlabs.begin(), opSlabs.end(), op) - opSlabs.begin() - 1;
+            slabFreeCount[index]++;
+        }
+    }
+
+    // free the slabs that are completely free, the free ops of the slabs that are still in use go back to
+    // sharedFreeOps as one list
+    DecodedOpList remaining;
+    remaining.first = NULL;
+    remaining.count = 0;
+    for (auto& list : sharedFreeOps) {
+        DecodedOp* op = list.first;
+        while (op) {
+            DecodedOp* next = op->next;
+            size_t index = std::upper_bound(opSlabs.begin(), opSlabs.end(), op) - opSlabs.begin() - 1;
+            if (slabFreeCount[index] != DECODED_OP_SLAB_SIZE) {
+                op->next = remaining.first;
+                remaining.first = op;
+                remaining.count++;
+            }
+            op = next;
+        }
+    }
+    std::vector<DecodedOp*> usedSlabs;
+    for (size_t i = 0; i < opSlabs.size(); i++) {
+        if (slabFreeCount[i] == DECODED_OP_SLAB_SIZE) {
+            delete[] opSlabs[i];
+        } else {
+            usedSlabs.push_back(opSlabs[i]);
+        }
+    }
+    opSlabs = usedSlabs;
+    sharedFreeOps.clear();
+    sharedFreeOpCount = remaining.count;
+    if (remaining.count) {
+        sharedFreeOps.push_back(remaining);
     }
 }
 
@@ -5974,33 +6071,43 @@ void DecodedOp::init() {
     this->pfn = NULL;
 }
 DecodedOp* DecodedOp::alloc() {
-    DecodedOp* result;
-    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(freeOpsMutex);
-
-    if (freeOps) {
-        result = freeOps;
-        freeOps = freeOps->next;
-        result->init();
-        return result;
-    } else {
-        return new DecodedOp();
-    }    
+    if (!threadFreeOps) {
+        refillThreadFreeOps();
+    }
+    DecodedOp* result = threadFreeOps;
+    threadFreeOps = result->next;
+    threadFreeOpCount--;
+    result->init();
+    return result;
 }
 
 void DecodedOp::dealloc(bool deallocNext) {
-    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(freeOpsMutex);
+    // the whole chain is added to the free list at once
+    DecodedOp* last = this;
+    U32 count = 1;
 
-#ifdef _DEBUG
-    if (this->inst == InstructionCount) {
-        kpanic("tried to dealloc a DecodedOp that was already deallocated");
+    if (!deallocNext) {
+        this->next = NULL;
     }
+    while (true) {
+#ifdef _DEBUG
+        if (last->inst == InstructionCount) {
+            kpanic("tried to dealloc a DecodedOp that was already deallocated");
+        }
 #endif
-    if (deallocNext && this->next) {
-        this->next->dealloc(deallocNext);
+        last->inst = InstructionCount;
+        if (!last->next) {
+            break;
+        }
+        last = last->next;
+        count++;
+    }
+    last->next = threadFreeOps;
+    threadFreeOps = this;
+    threadFreeOpCount += count;
+    if (threadFreeOpCount >= DECODED_OP_MAX_THREAD_FREE) {
+        releaseThreadFreeOps();
     }
-    this->next = freeOps;
-    this->inst = InstructionCount;
-    freeOps = this;
 }
 
 bool DecodedOp::isFpuOp() {
@@ -1442,6 +1442,8 @@ class DecodedOp {
 public:    
     static DecodedOp* alloc();
     static void clearCache();
+    // gives the calling thread's free ops to the other threads, must be called before a thread that decoded ops exits
+    static void releaseThreadCache();
 
     DecodedOp();
 
@@ -36,9 +36,16 @@
 #include "normal_other.h"
 #include "normal_jump.h"
 #include "normal_move.h"
+#include "normal_noflags.h"
 
 static OpCallback normalOps[NUMBER_OF_OPS];
 static U32 normalOpsInitialized;
+// used instead of normalOps when nothing reads the flags the op sets
+static OpCallback normalNoFlagsOps[NUMBER_OF_OPS];
+
+U32 NormalCPU::traceCount;
+U32 NormalCPU::decodedOpCount;
+U32 NormalCPU::noFlagsOpCount;
 
 void OPCALL normal_sidt(CPU* cpu, DecodedOp* op) {
     START_OP(cpu, op);    
@@ -86,6 +93,202 @@ static void initNormalOps() {
     normalOps[LMSW] = 0;
     normalOps[INVLPG] = 0;
     normalOps[Callback] = 0;
+
+    normalNoFlagsOps[AddR8R8] = normal_addr8r8_noflags;
+    normalNoFlagsOps[AddE8R8] = normal_adde8r8_noflags;
+    normalNoFlagsOps[AddR8E8] = normal_addr8e8_noflags;
+    normalNoFlagsOps[AddR8I8] = normal_add8_reg_noflags;
+    normalNoFlagsOps[AddE8I8] = normal_add8_mem_noflags;
+    normalNoFlagsOps[AddR16R16] = normal_addr16r16_noflags;
+    normalNoFlagsOps[AddE16R16] = normal_adde16r16_noflags;
+    normalNoFlagsOps[AddR16E16] = normal_addr16e16_noflags;
+    normalNoFlagsOps[AddR16I16] = normal_add16_reg_noflags;
+    normalNoFlagsOps[AddE16I16] = normal_add16_mem_noflags;
+    normalNoFlagsOps[AddR32R32] = normal_addr32r32_noflags;
+    normalNoFlagsOps[AddE32R32] = normal_adde32r32_noflags;
+    normalNoFlagsOps[AddR32E32] = normal_addr32e32_noflags;
+    normalNoFlagsOps[AddR32I32] = normal_add32_reg_noflags;
+    normalNoFlagsOps[AddE32I32] = normal_add32_mem_noflags;
+    normalNoFlagsOps[OrR8R8] = normal_orr8r8_noflags;
+    normalNoFlagsOps[OrE8R8] = normal_ore8r8_noflags;
+    normalNoFlagsOps[OrR8E8] = normal_orr8e8_noflags;
+    normalNoFlagsOps[OrR8I8] = normal_or8_reg_noflags;
+    normalNoFlagsOps[OrE8I8] = normal_or8_mem_noflags;
+    normalNoFlagsOps[OrR16R16] = normal_orr16r16_noflags;
+    normalNoFlagsOps[OrE16R16] = normal_ore16r16_noflags;
+    normalNoFlagsOps[OrR16E16] = normal_orr16e16_noflags;
+    normalNoFlagsOps[OrR16I16] = normal_or16_reg_noflags;
+    normalNoFlagsOps[OrE16I16] = normal_or16_mem_noflags;
+    normalNoFlagsOps[OrR32R32] = normal_orr32r32_noflags;
+    normalNoFlagsOps[OrE32R32] = normal_ore32r32_noflags;
+    normalNoFlagsOps[OrR32E32] = normal_orr32e32_noflags;
+    normalNoFlagsOps[OrR32I32] = normal_or32_reg_noflags;
+    normalNoFlagsOps[OrE32I32] = normal_or32_mem_noflags;
+    normalNoFlagsOps[AdcR8R8] = normal_adcr8r8_noflags;
+    normalNoFlagsOps[AdcE8R8] = normal_adce8r8_noflags;
+    normalNoFlagsOps[AdcR8E8] = normal_adcr8e8_noflags;
+    normalNoFlagsOps[AdcR8I8] = normal_adc8_reg_noflags;
+    normalNoFlagsOps[AdcE8I8] = normal_adc8_mem_noflags;
+    normalNoFlagsOps[AdcR16R16] = normal_adcr16r16_noflags;
+    normalNoFlagsOps[AdcE16R16] = normal_adce16r16_noflags;
+    normalNoFlagsOps[AdcR16E16] = normal_adcr16e16_noflags;
+    normalNoFlagsOps[AdcR16I16] = normal_adc16_reg_noflags;
+    normalNoFlagsOps[AdcE16I16] = normal_adc16_mem_noflags;
+    normalNoFlagsOps[AdcR32R32] = normal_adcr32r32_noflags;
+    normalNoFlagsOps[AdcE32R32] = normal_adce32r32_noflags;
+    normalNoFlagsOps[AdcR32E32] = normal_adcr32e32_noflags;
+    normalNoFlagsOps[AdcR32I32] = normal_adc32_reg_noflags;
+    normalNoFlagsOps[AdcE32I32] = normal_adc32_mem_noflags;
+    normalNoFlagsOps[SbbR8R8] = normal_sbbr8r8_noflags;
+    normalNoFlagsOps[SbbE8R8] = normal_sbbe8r8_noflags;
+    normalNoFlagsOps[SbbR8E8] = normal_sbbr8e8_noflags;
+    normalNoFlagsOps[SbbR8I8] = normal_sbb8_reg_noflags;
+    normalNoFlagsOps[SbbE8I8] = normal_sbb8_mem_noflags;
+    normalNoFlagsOps[SbbR16R16] = normal_sbbr16r16_noflags;
+    normalNoFlagsOps[SbbE16R16] = normal_sbbe16r16_noflags;
+    normalNoFlagsOps[SbbR16E16] = normal_sbbr16e16_noflags;
+    normalNoFlagsOps[SbbR16I16] = normal_sbb16_reg_noflags;
+    normalNoFlagsOps[SbbE16I16] = normal_sbb16_mem_noflags;
+    normalNoFlagsOps[SbbR32R32] = normal_sbbr32r32_noflags;
+    normalNoFlagsOps[SbbE32R32] = normal_sbbe32r32_noflags;
+    normalNoFlagsOps[SbbR32E32] = normal_sbbr32e32_noflags;
+    normalNoFlagsOps[SbbR32I32] = normal_sbb32_reg_noflags;
+    normalNoFlagsOps[SbbE32I32] = normal_sbb32_mem_noflags;
+    normalNoFlagsOps[AndR8R8] = normal_andr8r8_noflags;
+    normalNoFlagsOps[AndE8R8] = normal_ande8r8_noflags;
+    normalNoFlagsOps[AndR8E8] = normal_andr8e8_noflags;
+    normalNoFlagsOps[AndR8I8] = normal_and8_reg_noflags;
+    normalNoFlagsOps[AndE8I8] = normal_and8_mem_noflags;
+    normalNoFlagsOps[AndR16R16] = normal_andr16r16_noflags;
+    normalNoFlagsOps[AndE16R16] = normal_ande16r16_noflags;
+    normalNoFlagsOps[AndR16E16] = normal_andr16e16_noflags;
+    normalNoFlagsOps[AndR16I16] = normal_and16_reg_noflags;
+    normalNoFlagsOps[AndE16I16] = normal_and16_mem_noflags;
+    normalNoFlagsOps[AndR32R32] = normal_andr32r32_noflags;
+    normalNoFlagsOps[AndE32R32] = normal_ande32r32_noflags;
+    normalNoFlagsOps[AndR32E32] = normal_andr32e32_noflags;
+    normalNoFlagsOps[AndR32I32] = normal_and32_reg_noflags;
+    normalNoFlagsOps[AndE32I32] = normal_and32_mem_noflags;
+    normalNoFlagsOps[SubR8R8] = normal_subr8r8_noflags;
+    normalNoFlagsOps[SubE8R8] = normal_sube8r8_noflags;
+    normalNoFlagsOps[SubR8E8] = normal_subr8e8_noflags;
+    normalNoFlagsOps[SubR8I8] = normal_sub8_reg_noflags;
+    normalNoFlagsOps[SubE8I8] = normal_sub8_mem_noflags;
+    normalNoFlagsOps[SubR16R16] = normal_subr16r16_noflags;
+    normalNoFlagsOps[SubE16R16] = normal_sube16r16_noflags;
+    normalNoFlagsOps[SubR16E16] = normal_subr16e16_noflags;
+    normalNoFlagsOps[SubR16I16] = normal_sub16_reg_noflags;
+    normalNoFlagsOps[SubE16I16] = normal_sub16_mem_noflags;
+    normalNoFlagsOps[SubR32R32] = normal_subr32r32_noflags;
+    normalNoFlagsOps[SubE32R32] = normal_sube32r32_noflags;
+    normalNoFlagsOps[SubR32E32] = normal_subr32e32_noflags;
+    normalNoFlagsOps[SubR32I32] = normal_sub32_reg_noflags;
+    normalNoFlagsOps[SubE32I32] = normal_sub32_mem_noflags;
+    normalNoFlagsOps[XorR8R8] = normal_xorr8r8_noflags;
+    normalNoFlagsOps[XorE8R8] = normal_xore8r8_noflags;
+    normalNoFlagsOps[XorR8E8] = normal_xorr8e8_noflags;
+    normalNoFlagsOps[XorR8I8] = normal_xor8_reg_noflags;
+    normalNoFlagsOps[XorE8I8] = normal_xor8_mem_noflags;
+    normalNoFlagsOps[XorR16R16] = normal_xorr16r16_noflags;
+    normalNoFlagsOps[XorE16R16] = normal_xore16r16_noflags;
+    normalNoFlagsOps[XorR16E16] = normal_xorr16e16_noflags;
+    normalNoFlagsOps[XorR16I16] = normal_xor16_reg_noflags;
+    normalNoFlagsOps[XorE16I16] = normal_xor16_mem_noflags;
+    normalNoFlagsOps[XorR32R32] = normal_xorr32r32_noflags;
+    normalNoFlagsOps[XorE32R32] = normal_xore32r32_noflags;
+    normalNoFlagsOps[XorR32E32] = normal_xorr32e32_noflags;
+    normalNoFlagsOps[XorR32I32] = normal_xor32_reg_noflags;
+    normalNoFlagsOps[XorE32I32] = normal_xor32_mem_noflags;
+    normalNoFlagsOps[CmpR8R8] = normal_cmptest_reg_noflags;
+    normalNoFlagsOps[CmpR8I8] = normal_cmptest_reg_noflags;
+    normalNoFlagsOps[CmpR16R16] = normal_cmptest_reg_noflags;
+    normalNoFlagsOps[CmpR16I16] = normal_cmptest_reg_noflags;
+    normalNoFlagsOps[CmpR32R32] = normal_cmptest_reg_noflags;
+    normalNoFlagsOps[CmpR32I32] = normal_cmptest_reg_noflags;
+    normalNoFlagsOps[TestR8R8] = normal_cmptest_reg_noflags;
+    normalNoFlagsOps[TestR8I8] = normal_cmptest_reg_noflags;
+    normalNoFlagsOps[TestR16R16] = normal_cmptest_reg_noflags;
+    normalNoFlagsOps[TestR16I16] = normal_cmptest_reg_noflags;
+    normalNoFlagsOps[TestR32R32] = normal_cmptest_reg_noflags;
+    normalNoFlagsOps[TestR32I32] = normal_cmptest_reg_noflags;
+    normalNoFlagsOps[NegR8] = normal_negr8_noflags;
+    normalNoFlagsOps[NegE8] = normal_nege8_noflags;
+    normalNoFlagsOps[NegR16] = normal_negr16_noflags;
+    normalNoFlagsOps[NegE16] = normal_nege16_noflags;
+    normalNoFlagsOps[NegR32] = normal_negr32_noflags;
+    normalNoFlagsOps[NegE32] = normal_nege32_noflags;
+    normalNoFlagsOps[IncR8] = normal_inc8_reg_noflags;
+    normalNoFlagsOps[IncE8] = normal_inc8_mem32_noflags;
+    normalNoFlagsOps[IncR16] = normal_inc16_reg_noflags;
+    normalNoFlagsOps[IncE16] = normal_inc16_mem32_noflags;
+    normalNoFlagsOps[IncR32] = normal_inc32_reg_noflags;
+    normalNoFlagsOps[IncE32] = normal_inc32_mem32_noflags;
+    normalNoFlagsOps[DecR8] = normal_dec8_reg_noflags;
+    normalNoFlagsOps[DecE8] = normal_dec8_mem32_noflags;
+    normalNoFlagsOps[DecR16] = normal_dec16_reg_noflags;
+    normalNoFlagsOps[DecE16] = normal_dec16_mem32_noflags;
+    normalNoFlagsOps[DecR32] = normal_dec32_reg_noflags;
+    normalNoFlagsOps[DecE32] = normal_dec32_mem32_noflags;
+    normalNoFlagsOps[ShlR8I8] = normal_shl8_reg_noflags;
+    normalNoFlagsOps[ShlE8I8] = normal_shl8_mem_noflags;
+    normalNoFlagsOps[ShlR8Cl] = normal_shl8cl_reg_noflags;
+    normalNoFlagsOps[ShlE8Cl] = normal_shl8cl_mem_noflags;
+    normalNoFlagsOps[ShlR16I8] = normal_shl16_reg_noflags;
+    normalNoFlagsOps[ShlE16I8] = normal_shl16_mem_noflags;
+    normalNoFlagsOps[ShlR16Cl] = normal_shl16cl_reg_noflags;
+    normalNoFlagsOps[ShlE16Cl] = normal_shl16cl_mem_noflags;
+    normalNoFlagsOps[ShlR32I8] = normal_shl32_reg_noflags;
+    normalNoFlagsOps[ShlE32I8] = normal_shl32_mem_noflags;
+    normalNoFlagsOps[ShlR32Cl] = normal_shl32cl_reg_noflags;
+    normalNoFlagsOps[ShlE32Cl] = normal_shl32cl_mem_noflags;
+    normalNoFlagsOps[ShrR8I8] = normal_shr8_reg_noflags;
+    normalNoFlagsOps[ShrE8I8] = normal_shr8_mem_noflags;
+    normalNoFlagsOps[ShrR8Cl] = normal_shr8cl_reg_noflags;
+    normalNoFlagsOps[ShrE8Cl] = normal_shr8cl_mem_noflags;
+    normalNoFlagsOps[ShrR16I8] = normal_shr16_reg_noflags;
+    normalNoFlagsOps[ShrE16I8] = normal_shr16_mem_noflags;
+    normalNoFlagsOps[ShrR16Cl] = normal_shr16cl_reg_noflags;
+    normalNoFlagsOps[ShrE16Cl] = normal_shr16cl_mem_noflags;
+    normalNoFlagsOps[ShrR32I8] = normal_shr32_reg_noflags;
+    normalNoFlagsOps[ShrE32I8] = normal_shr32_mem_noflags;
+    normalNoFlagsOps[ShrR32Cl] = normal_shr32cl_reg_noflags;
+    normalNoFlagsOps[ShrE32Cl] = normal_shr32cl_mem_noflags;
+    normalNoFlagsOps[SarR8I8] = normal_sar8_reg_noflags;
+    normalNoFlagsOps[SarE8I8] = normal_sar8_mem_noflags;
+    normalNoFlagsOps[SarR8Cl] = normal_sar8cl_reg_noflags;
+    normalNoFlagsOps[SarE8Cl] = normal_sar8cl_mem_noflags;
+    normalNoFlagsOps[SarR16I8] = normal_sar16_reg_noflags;
+    normalNoFlagsOps[SarE16I8] = normal_sar16_mem_noflags;
+    normalNoFlagsOps[SarR16Cl] = normal_sar16cl_reg_noflags;
+    normalNoFlagsOps[SarE16Cl] = normal_sar16cl_mem_noflags;
+    normalNoFlagsOps[SarR32I8] = normal_sar32_reg_noflags;
+    normalNoFlagsOps[SarE32I8] = normal_sar32_mem_noflags;
+    normalNoFlagsOps[SarR32Cl] = normal_sar32cl_reg_noflags;
+    normalNoFlagsOps[SarE32Cl] = normal_sar32cl_mem_noflags;
+    normalNoFlagsOps[RolR8I8] = normal_rol8_reg_noflags;
+    normalNoFlagsOps[RolE8I8] = normal_rol8_mem_noflags;
+    normalNoFlagsOps[RolR8Cl] = normal_rol8cl_reg_noflags;
+    normalNoFlagsOps[RolE8Cl] = normal_rol8cl_mem_noflags;
+    normalNoFlagsOps[RolR16I8] = normal_rol16_reg_noflags;
+    normalNoFlagsOps[RolE16I8] = normal_rol16_mem_noflags;
+    normalNoFlagsOps[RolR16Cl] = normal_rol16cl_reg_noflags;
+    normalNoFlagsOps[RolE16Cl] = normal_rol16cl_mem_noflags;
+    normalNoFlagsOps[RolR32I8] = normal_rol32_reg_noflags;
+    normalNoFlagsOps[RolE32I8] = normal_rol32_mem_noflags;
+    normalNoFlagsOps[RolR32Cl] = normal_rol32cl_reg_noflags;
+    normalNoFlagsOps[RolE32Cl] = normal_rol32cl_mem_noflags;
+    normalNoFlagsOps[RorR8I8] = normal_ror8_reg_noflags;
+    normalNoFlagsOps[RorE8I8] = normal_ror8_mem_noflags;
+    normalNoFlagsOps[RorR8Cl] = normal_ror8cl_reg_noflags;
+    normalNoFlagsOps[RorE8Cl] = normal_ror8cl_mem_noflags;
+    normalNoFlagsOps[RorR16I8] = normal_ror16_reg_noflags;
+    normalNoFlagsOps[RorE16I8] = normal_ror16_mem_noflags;
+    normalNoFlagsOps[RorR16Cl] = normal_ror16cl_reg_noflags;
+    normalNoFlagsOps[RorE16Cl] = normal_ror16cl_mem_noflags;
+    normalNoFlagsOps[RorR32I8] = normal_ror32_reg_noflags;
+    normalNoFlagsOps[RorE32I8] = normal_ror32_mem_noflags;
+    normalNoFlagsOps[RorR32Cl] = normal_ror32cl_reg_noflags;
+    normalNoFlagsOps[RorE32Cl] = normal_ror32cl_mem_noflags;
 }
 
 OpCallback NormalCPU::getFunctionForOp(DecodedOp* op) {
@@ -109,6 +312,14 @@ U8 fetchByte(U32 *eip) {
     return readb((*eip)++);
 }
 
+// Once a block has run NORMAL_TRACE_THRESHOLD times it is stitched together with the blocks that usually run after
+// it into a trace.  The trace has its own copy of the ops, with the jumps between the blocks replaced by guards that
+// either continue with the next block in the trace or leave the trace.  Since the trace knows which ops will run
+// next, even across blocks, flags that are always overwritten before they are read don't need to be calculated.
+#define NORMAL_TRACE_THRESHOLD 50
+#define NORMAL_TRACE_MAX_BLOCKS 8
+#define NORMAL_TRACE_MAX_OPS 256
+
 class NormalBlock : public DecodedBlock {
 public:
     static NormalBlock* alloc();
@@ -120,11 +331,115 @@ public:
 
     void run(CPU* cpu);
 
+    U32 noFlagsOpCount; // ops that were switched to a version that doesn't calculate flags, see removeDeadFlags
+
 private:
     void init();
+    void buildTrace();
+    void invalidateTrace();
+
     NormalBlock* next;
+    NormalBlock* trace; // the trace that starts with this block
+    DecodedBlockFromNode* traceBlocks; // if this is a trace, the blocks it was built from
+    DecodedBlockFromNode* usedByTraces; // traces that have a copy of this block's ops
 };
 
+typedef U32 (*pfnCondition)(CPU* cpu);
+static pfnCondition traceConditions[] = {common_condition_o, common_condition_no, common_condition_b, common_condition_nb, common_condition_z, common_condition_nz, common_condition_be, common_condition_nbe, common_condition_s, common_condition_ns, common_condition_p, common_condition_np, common_condition_l, common_condition_nl, common_condition_le, common_condition_nle};
+
+// op->disp is the number of instructions in the rest of the trace, they won't run if we leave here
+#define NEXT_TRACE_EXIT() cpu->blockInstructionCount-=op->disp; NEXT_DONE()
+
+// the trace continues at the jump target
+static void OPCALL normal_traceJumpTaken(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    if (traceConditions[op->inst-JumpO](cpu)) {
+        cpu->eip.u32+=op->imm;
+        NEXT();
+    } else {
+        cpu->eip.u32+=op->len;
+        NEXT_TRACE_EXIT();
+    }
+}
+
+// the trace continues after the jump
+static void OPCALL normal_traceJumpNotTaken(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    if (traceConditions[op->inst-JumpO](cpu)) {
+        cpu->eip.u32+=op->len+op->imm;
+        NEXT_TRACE_EXIT();
+    } else {
+        NEXT();
+    }
+}
+
+// op->imm was sign extended when the trace was built
+static void OPCALL normal_traceJmp(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->eip.u32+=op->imm;
+    NEXT();
+}
+
+// a block the trace was built from was modified by the trace itself
+static void OPCALL normal_traceInvalidated(CPU* cpu, DecodedOp* op) {
+    NEXT_DONE();
+}
+
+static void addBlockNode(DecodedBlockFromNode** list, DecodedBlock* block) {
+    DecodedBlockFromNode* node = DecodedBlockFromNode::alloc();
+    node->block = block;
+    node->next = *list;
+    *list = node;
+}
+
+static void removeBlockNode(DecodedBlockFromNode** list, DecodedBlock* block) {
+    while (*list) {
+        DecodedBlockFromNode* node = *list;
+        if (node->block == block) {
+            *list = node->next;
+            node->dealloc();
+        } else {
+            list = &node->next;
+        }
+    }
+}
+
+// Walks backwards through ops, an op doesn't need to calculate flags if none of them are read before they are set
+// again.  neededFlags is what is needed after the last op, exitFlags (if not NULL) is what might be needed if we leave
+// early after each op.  Returns how many of the ops don't calculate flags.
+static U32 removeDeadFlags(const std::vector<DecodedOp*>& ops, const std::vector<U32>* exitFlags, U32 neededFlags) {
+    U32 result = 0;
+
+    for (S32 i = (S32)ops.size() - 1; i >= 0; i--) {
+        DecodedOp* op = ops[i];
+        const InstructionInfo& info = instructionInfo[op->inst];
+        OpCallback noFlagsOp = normalNoFlagsOps[op->inst];
+
+        if (exitFlags) {
+            neededFlags |= (*exitFlags)[i];
+        }
+        if (noFlagsOp && op->pfn == normalOps[op->inst] && !(neededFlags & info.flagsSets)) {
+            op->pfn = noFlagsOp;
+        }
+        if (noFlagsOp && op->pfn == noFlagsOp) {
+            result++;
+        }
+        if (!(info.flagsSets & MAYBE)) {
+            neededFlags &= ~(info.flagsSets | info.flagsUndefined);
+        }
+        neededFlags |= info.flagsUsed;
+    }
+    return result;
+}
+
+static DecodedOp* getLastOp(DecodedBlock* block) {
+    DecodedOp* op = block->op;
+    while (op->next) {
+        op = op->next;
+    }
+    return op;
+}
+
 NormalBlock::NormalBlock() {
     this->init();
 }
@@ -135,12 +450,133 @@ void NormalBlock::run(CPU* cpu) {
         kpanic("NormalBlock::run is about to crash");
     }
 #endif  
+#ifndef BOXEDWINE_DYNAMIC
+    if (this->runCount == NORMAL_TRACE_THRESHOLD && !this->traceBlocks) {
+        this->buildTrace();
+    }
+    if (this->trace) {
+        this->runCount++;
+        DecodedBlock::currentBlock = this->trace;
+        this->trace->run(cpu);
+        return;
+    }
+#endif
     this->op->pfn(cpu, this->op);
     this->runCount++;
     cpu->blockInstructionCount+=this->opCount;
 }
 
-static NormalBlock* freeBlocks;
+void NormalBlock::buildTrace() {
+    NormalBlock* blocks[NORMAL_TRACE_MAX_BLOCKS];
+    U32 blockCount = 0;
+    U32 opCount = 0;
+    NormalBlock* block = this;
+
+    while (true) {
+        blocks[blockCount++] = block;
+        opCount += block->opCount;
+
+        DecodedOp* lastOp = getLastOp(block);
+        NormalBlock* next = NULL;
+        if (lastOp->inst >= JumpO && lastOp->inst <= JumpNLE) {
+            // follow the side that has run the most
+            if (block->next1 && (!block->next2 || block->next1->runCount >= block->next2->runCount)) {
+                next = (NormalBlock*)block->next1;
+            } else {
+                next = (NormalBlock*)block->next2;
+            }
+        } else if (lastOp->inst == JmpJb || lastOp->inst == JmpJw || lastOp->inst == JmpJd) {
+            next = (NormalBlock*)block->next1;
+        }
+        if (!next || next->runCount < NORMAL_TRACE_THRESHOLD/2 || blockCount == NORMAL_TRACE_MAX_BLOCKS || opCount + next->opCount > NORMAL_TRACE_MAX_OPS) {
+            break;
+        }
+        bool alreadyInTrace = false;
+        for (U32 i = 0; i < blockCount; i++) {
+            if (blocks[i] == next) {
+                alreadyInTrace = true;
+            }
+        }
+        if (alreadyInTrace) {
+            break;
+        }
+        block = next;
+    }
+    if (blockCount == 1 && !this->next1 && !this->next2) {
+        // nothing is known about what runs after this block, so there is nothing to gain
+        return;
+    }
+
+    NormalBlock* trace = NormalBlock::alloc();
+    std::vector<DecodedOp*> ops;
+    std::vector<U32> exitFlags; // flags that might be needed if the trace is left after this op
+    DecodedOp** to = &trace->op;
+    U32 remainingOpCount = opCount;
+
+    trace->address = this->address;
+    for (U32 i = 0; i < blockCount; i++) {
+        remainingOpCount -= blocks[i]->opCount;
+        for (DecodedOp* op = blocks[i]->op; op; op = op->next) {
+            DecodedOp* copy = DecodedOp::alloc();
+            *copy = *op;
+            copy->next = NULL;
+            *to = copy;
+            to = &copy->next;
+            ops.push_back(copy);
+            exitFlags.push_back(0);
+
+            if (op->next || i + 1 == blockCount) {
+                continue;
+            }
+            copy->disp = remainingOpCount;
+            if (op->inst == JmpJb) {
+                copy->imm = (U32)(S8)op->imm;
+                copy->pfn = normal_traceJmp;
+            } else if (op->inst == JmpJw) {
+                copy->imm = (U32)(S16)op->imm;
+                copy->pfn = normal_traceJmp;
+            } else if (op->inst == JmpJd) {
+                copy->pfn = normal_traceJmp;
+            } else {
+                // this includes what the side that stays in the trace needs, that is ok, it just means we won't
+                // remove as many flags
+                exitFlags.back() = DecodedOp::getNeededFlags(blocks[i], op, FMASK_TEST);
+                if (blocks[i + 1] == blocks[i]->next1) {
+                    copy->pfn = normal_traceJumpTaken;
+                } else {
+                    copy->pfn = normal_traceJumpNotTaken;
+                }
+            }
+        }
+        trace->bytes += blocks[i]->bytes;
+        trace->opCount += blocks[i]->opCount;
+        addBlockNode(&trace->traceBlocks, blocks[i]);
+        addBlockNode(&blocks[i]->usedByTraces, trace);
+    }
+
+    trace->noFlagsOpCount = removeDeadFlags(ops, &exitFlags, DecodedOp::getNeededFlags(blocks[blockCount - 1], getLastOp(blocks[blockCount - 1]), FMASK_TEST));
+    this->trace = trace;
+    NormalCPU::traceCount++;
+}
+
+// called when one of the blocks this trace was built from goes away
+void NormalBlock::invalidateTrace() {
+    if (this == DecodedBlock::currentBlock) {
+        // we don't have a pointer to the current op, so just set them all
+        DecodedOp* op = this->op;
+        while (op) {
+            op->pfn = normal_traceInvalidated; // This will cause the trace to return after the current op
+            op = op->next;
+        }
+    }
+    this->dealloc(true);
+}
+
+// like DecodedOp, each thread keeps its own free blocks so that no lock is needed
+#define NORMAL_MAX_THREAD_FREE_BLOCKS 1024
+
+static THREAD_LOCAL NormalBlock* freeBlocks;
+static THREAD_LOCAL U32 freeBlockCount;
 
 void NormalBlock::init() {
     this->next = 0;
@@ -151,6 +587,10 @@ void NormalBlock::init() {
     this->next1 = NULL;
     this->next2 = NULL;
     this->referencedFrom = NULL;
+    this->trace = NULL;
+    this->traceBlocks = NULL;
+    this->usedByTraces = NULL;
+    this->noFlagsOpCount = 0;
 }
 
 void NormalBlock::clearCache() {
@@ -159,6 +599,7 @@ void NormalBlock::clearCache() {
         delete freeBlocks;
         freeBlocks = next;
     }
+    freeBlockCount = 0;
 }
 
 NormalBlock* NormalBlock::alloc() {
@@ -167,6 +608,7 @@ NormalBlock* NormalBlock::alloc() {
     if (freeBlocks) {
         result = freeBlocks;
         freeBlocks = freeBlocks->next;
+        freeBlockCount--;
         result->init();
         return result;
     } else {
@@ -175,7 +617,22 @@ NormalBlock* NormalBlock::alloc() {
 }
 
 void NormalBlock::dealloc(bool delayed) {
+    // a trace has copies of this block's ops, they can't be used after this block's code changes
+    while (this->usedByTraces) {
+        ((NormalBlock*)this->usedByTraces->block)->invalidateTrace();
+    }
+    // if this is a trace, forget about the blocks it was built from
+    while (this->traceBlocks) {
+        NormalBlock* block = (NormalBlock*)this->traceBlocks->block;
+        removeBlockNode(&block->usedByTraces, this);
+        if (block->trace == this) {
+            block->trace = NULL;
+        }
+        removeBlockNode(&this->traceBlocks, block);
+    }
+
     KThread* thread = KThread::currentThread();
+    bool freed = false;
     if (thread) {
         CPU* cpu = thread->cpu;
         if (cpu && cpu->delayedFreeBlock && cpu->delayedFreeBlock != DecodedBlock::currentBlock) {
@@ -187,15 +644,13 @@ void NormalBlock::dealloc(bool delayed) {
             cpu->delayedFreeBlock = this;
         } else {
             this->op->dealloc(true);
-            this->next = freeBlocks;
             this->op = NULL;
-            freeBlocks = this;
+            freed = true;
         }
     } else {
         this->op->dealloc(true);
-        this->next = freeBlocks;
         this->op = NULL;
-        freeBlocks = this;
+        freed = true;
     }
     if (this->next1) {
         this->next1->removeReferenceFrom(this);
@@ -218,6 +673,18 @@ void NormalBlock::dealloc(bool delayed) {
         from = n;
     }
     this->referencedFrom = NULL;
+    if (freed) {
+        this->next = freeBlocks;
+        freeBlocks = this;
+        freeBlockCount++;
+        if (freeBlockCount > NORMAL_MAX_THREAD_FREE_BLOCKS) {
+            // only a block that has been sitting in the free list is deleted, nothing can still point to it
+            NormalBlock* block = this->next;
+            this->next = block->next;
+            delete block;
+            freeBlockCount--;
+        }
+    }
 }
 
 DecodedBlock* NormalCPU::getBlockForInspectionButNotUsed(U32 address, bool big) {
@@ -235,7 +702,10 @@ DecodedBlock* NormalCPU::getNextBlock() {
     DecodedBlock* block = this->thread->memory->getCodeBlock(startIp);
 
     if (!block) {
-        block = NormalBlock::alloc();
+        NormalBlock* normalBlock = NormalBlock::alloc();
+        std::vector<DecodedOp*> ops;
+
+        block = normalBlock;
         decodeBlock(fetchByte, startIp, this->isBig(), 0, K_PAGE_SIZE, 0, block);
         block->address = startIp;
         
@@ -243,8 +713,13 @@ DecodedBlock* NormalCPU::getNextBlock() {
         while (op) {
             if (!op->pfn) // callback will be set by decoder
                 op->pfn = normalOps[op->inst];
+            ops.push_back(op);
             op = op->next;
         }
+        // the blocks that will run after this one aren't known yet, so all flags are needed at the end
+        normalBlock->noFlagsOpCount = removeDeadFlags(ops, NULL, FMASK_TEST);
+        NormalCPU::decodedOpCount += block->opCount;
+        NormalCPU::noFlagsOpCount += normalBlock->noFlagsOpCount;
         this->thread->memory->addCodeBlock(startIp, block);
         if (this->firstOp) {
             op = DecodedOp::alloc();
@@ -269,5 +744,12 @@ void NormalCPU::run() {
 }
 
 void NormalCPU::clearCache() {
+    if (NormalCPU::decodedOpCount) {
+        klog("normal cpu: %d of %d decoded ops don't calculate flags, %d traces were built", NormalCPU::noFlagsOpCount, NormalCPU::decodedOpCount, NormalCPU::traceCount);
+    }
+    NormalBlock::clearCache();
+}
+
+void NormalCPU::releaseThreadCache() {
     NormalBlock::clearCache();
 }
@@ -8,6 +8,8 @@ public:
     NormalCPU();
 
     static void clearCache();
+    // frees the calling thread's free blocks, must be called before a thread that ran the normal core exits
+    static void releaseThreadCache();
 
     virtual void run();
     virtual DecodedBlock* getNextBlock();
@@ -17,6 +19,10 @@ public:
     static DecodedBlock* getBlockForInspectionButNotUsed(U32 address, bool big);
 
     OpCallback firstOp;
+
+    static U32 traceCount; // number of traces built, see NormalBlock::buildTrace
+    static U32 decodedOpCount;
+    static U32 noFlagsOpCount; // decoded ops that were switched to a version that doesn't calculate flags
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,1174 @@
+/*
+ *  Copyright (C) 2016  The BoxedWine Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+// These are only used when it is known that nothing will read the flags the original op would have set, so they
+// leave cpu->lazyFlags, dst, src and result alone.  NormalCPU::getNextBlock and NormalBlock::buildTrace decide when
+// they can be used.
+
+void OPCALL normal_addr8r8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] + *cpu->reg8[op->rm];
+    NEXT();
+}
+void OPCALL normal_adde8r8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writeb(eaa, readb(eaa) + *cpu->reg8[op->reg]);
+    NEXT();
+}
+void OPCALL normal_addr8e8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] + readb(eaa(cpu, op));
+    NEXT();
+}
+void OPCALL normal_add8_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] + op->imm;
+    NEXT();
+}
+void OPCALL normal_add8_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writeb(eaa, readb(eaa) + op->imm);
+    NEXT();
+}
+void OPCALL normal_addr16r16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 + cpu->reg[op->rm].u16;
+    NEXT();
+}
+void OPCALL normal_adde16r16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writew(eaa, readw(eaa) + cpu->reg[op->reg].u16);
+    NEXT();
+}
+void OPCALL normal_addr16e16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 + readw(eaa(cpu, op));
+    NEXT();
+}
+void OPCALL normal_add16_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 + op->imm;
+    NEXT();
+}
+void OPCALL normal_add16_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writew(eaa, readw(eaa) + op->imm);
+    NEXT();
+}
+void OPCALL normal_addr32r32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 + cpu->reg[op->rm].u32;
+    NEXT();
+}
+void OPCALL normal_adde32r32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writed(eaa, readd(eaa) + cpu->reg[op->reg].u32);
+    NEXT();
+}
+void OPCALL normal_addr32e32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 + readd(eaa(cpu, op));
+    NEXT();
+}
+void OPCALL normal_add32_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 + op->imm;
+    NEXT();
+}
+void OPCALL normal_add32_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writed(eaa, readd(eaa) + op->imm);
+    NEXT();
+}
+void OPCALL normal_orr8r8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] | *cpu->reg8[op->rm];
+    NEXT();
+}
+void OPCALL normal_ore8r8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writeb(eaa, readb(eaa) | *cpu->reg8[op->reg]);
+    NEXT();
+}
+void OPCALL normal_orr8e8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] | readb(eaa(cpu, op));
+    NEXT();
+}
+void OPCALL normal_or8_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] | op->imm;
+    NEXT();
+}
+void OPCALL normal_or8_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writeb(eaa, readb(eaa) | op->imm);
+    NEXT();
+}
+void OPCALL normal_orr16r16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 | cpu->reg[op->rm].u16;
+    NEXT();
+}
+void OPCALL normal_ore16r16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writew(eaa, readw(eaa) | cpu->reg[op->reg].u16);
+    NEXT();
+}
+void OPCALL normal_orr16e16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 | readw(eaa(cpu, op));
+    NEXT();
+}
+void OPCALL normal_or16_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 | op->imm;
+    NEXT();
+}
+void OPCALL normal_or16_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writew(eaa, readw(eaa) | op->imm);
+    NEXT();
+}
+void OPCALL normal_orr32r32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 | cpu->reg[op->rm].u32;
+    NEXT();
+}
+void OPCALL normal_ore32r32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writed(eaa, readd(eaa) | cpu->reg[op->reg].u32);
+    NEXT();
+}
+void OPCALL normal_orr32e32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 | readd(eaa(cpu, op));
+    NEXT();
+}
+void OPCALL normal_or32_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 | op->imm;
+    NEXT();
+}
+void OPCALL normal_or32_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writed(eaa, readd(eaa) | op->imm);
+    NEXT();
+}
+void OPCALL normal_adcr8r8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] + *cpu->reg8[op->rm] + cpu->getCF();
+    NEXT();
+}
+void OPCALL normal_adce8r8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writeb(eaa, readb(eaa) + *cpu->reg8[op->reg] + cpu->getCF());
+    NEXT();
+}
+void OPCALL normal_adcr8e8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] + readb(eaa(cpu, op)) + cpu->getCF();
+    NEXT();
+}
+void OPCALL normal_adc8_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] + op->imm + cpu->getCF();
+    NEXT();
+}
+void OPCALL normal_adc8_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writeb(eaa, readb(eaa) + op->imm + cpu->getCF());
+    NEXT();
+}
+void OPCALL normal_adcr16r16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 + cpu->reg[op->rm].u16 + cpu->getCF();
+    NEXT();
+}
+void OPCALL normal_adce16r16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writew(eaa, readw(eaa) + cpu->reg[op->reg].u16 + cpu->getCF());
+    NEXT();
+}
+void OPCALL normal_adcr16e16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 + readw(eaa(cpu, op)) + cpu->getCF();
+    NEXT();
+}
+void OPCALL normal_adc16_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 + op->imm + cpu->getCF();
+    NEXT();
+}
+void OPCALL normal_adc16_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writew(eaa, readw(eaa) + op->imm + cpu->getCF());
+    NEXT();
+}
+void OPCALL normal_adcr32r32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 + cpu->reg[op->rm].u32 + cpu->getCF();
+    NEXT();
+}
+void OPCALL normal_adce32r32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writed(eaa, readd(eaa) + cpu->reg[op->reg].u32 + cpu->getCF());
+    NEXT();
+}
+void OPCALL normal_adcr32e32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 + readd(eaa(cpu, op)) + cpu->getCF();
+    NEXT();
+}
+void OPCALL normal_adc32_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 + op->imm + cpu->getCF();
+    NEXT();
+}
+void OPCALL normal_adc32_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writed(eaa, readd(eaa) + op->imm + cpu->getCF());
+    NEXT();
+}
+void OPCALL normal_sbbr8r8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] - (*cpu->reg8[op->rm] + cpu->getCF());
+    NEXT();
+}
+void OPCALL normal_sbbe8r8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writeb(eaa, readb(eaa) - (*cpu->reg8[op->reg] + cpu->getCF()));
+    NEXT();
+}
+void OPCALL normal_sbbr8e8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] - (readb(eaa(cpu, op)) + cpu->getCF());
+    NEXT();
+}
+void OPCALL normal_sbb8_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] - (op->imm + cpu->getCF());
+    NEXT();
+}
+void OPCALL normal_sbb8_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writeb(eaa, readb(eaa) - (op->imm + cpu->getCF()));
+    NEXT();
+}
+void OPCALL normal_sbbr16r16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 - (cpu->reg[op->rm].u16 + cpu->getCF());
+    NEXT();
+}
+void OPCALL normal_sbbe16r16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writew(eaa, readw(eaa) - (cpu->reg[op->reg].u16 + cpu->getCF()));
+    NEXT();
+}
+void OPCALL normal_sbbr16e16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 - (readw(eaa(cpu, op)) + cpu->getCF());
+    NEXT();
+}
+void OPCALL normal_sbb16_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 - (op->imm + cpu->getCF());
+    NEXT();
+}
+void OPCALL normal_sbb16_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writew(eaa, readw(eaa) - (op->imm + cpu->getCF()));
+    NEXT();
+}
+void OPCALL normal_sbbr32r32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 - (cpu->reg[op->rm].u32 + cpu->getCF());
+    NEXT();
+}
+void OPCALL normal_sbbe32r32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writed(eaa, readd(eaa) - (cpu->reg[op->reg].u32 + cpu->getCF()));
+    NEXT();
+}
+void OPCALL normal_sbbr32e32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 - (readd(eaa(cpu, op)) + cpu->getCF());
+    NEXT();
+}
+void OPCALL normal_sbb32_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 - (op->imm + cpu->getCF());
+    NEXT();
+}
+void OPCALL normal_sbb32_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writed(eaa, readd(eaa) - (op->imm + cpu->getCF()));
+    NEXT();
+}
+void OPCALL normal_andr8r8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] & *cpu->reg8[op->rm];
+    NEXT();
+}
+void OPCALL normal_ande8r8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writeb(eaa, readb(eaa) & *cpu->reg8[op->reg]);
+    NEXT();
+}
+void OPCALL normal_andr8e8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] & readb(eaa(cpu, op));
+    NEXT();
+}
+void OPCALL normal_and8_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] & op->imm;
+    NEXT();
+}
+void OPCALL normal_and8_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writeb(eaa, readb(eaa) & op->imm);
+    NEXT();
+}
+void OPCALL normal_andr16r16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 & cpu->reg[op->rm].u16;
+    NEXT();
+}
+void OPCALL normal_ande16r16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writew(eaa, readw(eaa) & cpu->reg[op->reg].u16);
+    NEXT();
+}
+void OPCALL normal_andr16e16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 & readw(eaa(cpu, op));
+    NEXT();
+}
+void OPCALL normal_and16_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 & op->imm;
+    NEXT();
+}
+void OPCALL normal_and16_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writew(eaa, readw(eaa) & op->imm);
+    NEXT();
+}
+void OPCALL normal_andr32r32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 & cpu->reg[op->rm].u32;
+    NEXT();
+}
+void OPCALL normal_ande32r32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writed(eaa, readd(eaa) & cpu->reg[op->reg].u32);
+    NEXT();
+}
+void OPCALL normal_andr32e32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 & readd(eaa(cpu, op));
+    NEXT();
+}
+void OPCALL normal_and32_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 & op->imm;
+    NEXT();
+}
+void OPCALL normal_and32_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writed(eaa, readd(eaa) & op->imm);
+    NEXT();
+}
+void OPCALL normal_subr8r8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] - *cpu->reg8[op->rm];
+    NEXT();
+}
+void OPCALL normal_sube8r8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writeb(eaa, readb(eaa) - *cpu->reg8[op->reg]);
+    NEXT();
+}
+void OPCALL normal_subr8e8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] - readb(eaa(cpu, op));
+    NEXT();
+}
+void OPCALL normal_sub8_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] - op->imm;
+    NEXT();
+}
+void OPCALL normal_sub8_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writeb(eaa, readb(eaa) - op->imm);
+    NEXT();
+}
+void OPCALL normal_subr16r16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 - cpu->reg[op->rm].u16;
+    NEXT();
+}
+void OPCALL normal_sube16r16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writew(eaa, readw(eaa) - cpu->reg[op->reg].u16);
+    NEXT();
+}
+void OPCALL normal_subr16e16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 - readw(eaa(cpu, op));
+    NEXT();
+}
+void OPCALL normal_sub16_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 - op->imm;
+    NEXT();
+}
+void OPCALL normal_sub16_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writew(eaa, readw(eaa) - op->imm);
+    NEXT();
+}
+void OPCALL normal_subr32r32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 - cpu->reg[op->rm].u32;
+    NEXT();
+}
+void OPCALL normal_sube32r32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writed(eaa, readd(eaa) - cpu->reg[op->reg].u32);
+    NEXT();
+}
+void OPCALL normal_subr32e32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 - readd(eaa(cpu, op));
+    NEXT();
+}
+void OPCALL normal_sub32_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 - op->imm;
+    NEXT();
+}
+void OPCALL normal_sub32_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writed(eaa, readd(eaa) - op->imm);
+    NEXT();
+}
+void OPCALL normal_xorr8r8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] ^ *cpu->reg8[op->rm];
+    NEXT();
+}
+void OPCALL normal_xore8r8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writeb(eaa, readb(eaa) ^ *cpu->reg8[op->reg]);
+    NEXT();
+}
+void OPCALL normal_xorr8e8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] ^ readb(eaa(cpu, op));
+    NEXT();
+}
+void OPCALL normal_xor8_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] ^ op->imm;
+    NEXT();
+}
+void OPCALL normal_xor8_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writeb(eaa, readb(eaa) ^ op->imm);
+    NEXT();
+}
+void OPCALL normal_xorr16r16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 ^ cpu->reg[op->rm].u16;
+    NEXT();
+}
+void OPCALL normal_xore16r16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writew(eaa, readw(eaa) ^ cpu->reg[op->reg].u16);
+    NEXT();
+}
+void OPCALL normal_xorr16e16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 ^ readw(eaa(cpu, op));
+    NEXT();
+}
+void OPCALL normal_xor16_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 ^ op->imm;
+    NEXT();
+}
+void OPCALL normal_xor16_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writew(eaa, readw(eaa) ^ op->imm);
+    NEXT();
+}
+void OPCALL normal_xorr32r32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 ^ cpu->reg[op->rm].u32;
+    NEXT();
+}
+void OPCALL normal_xore32r32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writed(eaa, readd(eaa) ^ cpu->reg[op->reg].u32);
+    NEXT();
+}
+void OPCALL normal_xorr32e32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 ^ readd(eaa(cpu, op));
+    NEXT();
+}
+void OPCALL normal_xor32_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 ^ op->imm;
+    NEXT();
+}
+void OPCALL normal_xor32_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writed(eaa, readd(eaa) ^ op->imm);
+    NEXT();
+}
+// cmp and test only set flags.  The memory versions are left alone, the read can fault and some code, like stack
+// probes, depends on that
+void OPCALL normal_cmptest_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    NEXT();
+}
+void OPCALL normal_negr8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = 0 - *cpu->reg8[op->reg];
+    NEXT();
+}
+void OPCALL normal_nege8_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writeb(eaa, 0 - readb(eaa));
+    NEXT();
+}
+void OPCALL normal_negr16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = 0 - cpu->reg[op->reg].u16;
+    NEXT();
+}
+void OPCALL normal_nege16_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writew(eaa, 0 - readw(eaa));
+    NEXT();
+}
+void OPCALL normal_negr32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = 0 - cpu->reg[op->reg].u32;
+    NEXT();
+}
+void OPCALL normal_nege32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writed(eaa, 0 - readd(eaa));
+    NEXT();
+}
+void OPCALL normal_inc8_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] + 1;
+    NEXT();
+}
+void OPCALL normal_inc8_mem32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writeb(eaa, readb(eaa) + 1);
+    NEXT();
+}
+void OPCALL normal_inc16_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 + 1;
+    NEXT();
+}
+void OPCALL normal_inc16_mem32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writew(eaa, readw(eaa) + 1);
+    NEXT();
+}
+void OPCALL normal_inc32_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 + 1;
+    NEXT();
+}
+void OPCALL normal_inc32_mem32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writed(eaa, readd(eaa) + 1);
+    NEXT();
+}
+void OPCALL normal_dec8_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] - 1;
+    NEXT();
+}
+void OPCALL normal_dec8_mem32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writeb(eaa, readb(eaa) - 1);
+    NEXT();
+}
+void OPCALL normal_dec16_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 - 1;
+    NEXT();
+}
+void OPCALL normal_dec16_mem32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writew(eaa, readw(eaa) - 1);
+    NEXT();
+}
+void OPCALL normal_dec32_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 - 1;
+    NEXT();
+}
+void OPCALL normal_dec32_mem32_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    writed(eaa, readd(eaa) - 1);
+    NEXT();
+}
+void OPCALL normal_shl8_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm;
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] << count;
+    NEXT();
+}
+void OPCALL normal_shl8_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    U32 count = op->imm;
+    writeb(eaa, readb(eaa) << count);
+    NEXT();
+}
+void OPCALL normal_shl8cl_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 0x1F;
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] << count;
+    NEXT();
+}
+void OPCALL normal_shl8cl_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 0x1F;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        writeb(eaa, readb(eaa) << count);
+    }
+    NEXT();
+}
+void OPCALL normal_shl16_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm;
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 << count;
+    NEXT();
+}
+void OPCALL normal_shl16_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    U32 count = op->imm;
+    writew(eaa, readw(eaa) << count);
+    NEXT();
+}
+void OPCALL normal_shl16cl_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 0x1F;
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 << count;
+    NEXT();
+}
+void OPCALL normal_shl16cl_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 0x1F;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        writew(eaa, readw(eaa) << count);
+    }
+    NEXT();
+}
+void OPCALL normal_shl32_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm;
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 << count;
+    NEXT();
+}
+void OPCALL normal_shl32_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    U32 count = op->imm;
+    writed(eaa, readd(eaa) << count);
+    NEXT();
+}
+void OPCALL normal_shl32cl_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 0x1F;
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 << count;
+    NEXT();
+}
+void OPCALL normal_shl32cl_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 0x1F;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        writed(eaa, readd(eaa) << count);
+    }
+    NEXT();
+}
+void OPCALL normal_shr8_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm;
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] >> count;
+    NEXT();
+}
+void OPCALL normal_shr8_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    U32 count = op->imm;
+    writeb(eaa, readb(eaa) >> count);
+    NEXT();
+}
+void OPCALL normal_shr8cl_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 0x1F;
+    *cpu->reg8[op->reg] = *cpu->reg8[op->reg] >> count;
+    NEXT();
+}
+void OPCALL normal_shr8cl_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 0x1F;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        writeb(eaa, readb(eaa) >> count);
+    }
+    NEXT();
+}
+void OPCALL normal_shr16_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm;
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 >> count;
+    NEXT();
+}
+void OPCALL normal_shr16_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    U32 count = op->imm;
+    writew(eaa, readw(eaa) >> count);
+    NEXT();
+}
+void OPCALL normal_shr16cl_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 0x1F;
+    cpu->reg[op->reg].u16 = cpu->reg[op->reg].u16 >> count;
+    NEXT();
+}
+void OPCALL normal_shr16cl_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 0x1F;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        writew(eaa, readw(eaa) >> count);
+    }
+    NEXT();
+}
+void OPCALL normal_shr32_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm;
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 >> count;
+    NEXT();
+}
+void OPCALL normal_shr32_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    U32 count = op->imm;
+    writed(eaa, readd(eaa) >> count);
+    NEXT();
+}
+void OPCALL normal_shr32cl_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 0x1F;
+    cpu->reg[op->reg].u32 = cpu->reg[op->reg].u32 >> count;
+    NEXT();
+}
+void OPCALL normal_shr32cl_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 0x1F;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        writed(eaa, readd(eaa) >> count);
+    }
+    NEXT();
+}
+void OPCALL normal_sar8_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm;
+    *cpu->reg8[op->reg] = (S8)*cpu->reg8[op->reg] >> count;
+    NEXT();
+}
+void OPCALL normal_sar8_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    U32 count = op->imm;
+    writeb(eaa, (S8)readb(eaa) >> count);
+    NEXT();
+}
+void OPCALL normal_sar8cl_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 0x1F;
+    *cpu->reg8[op->reg] = (S8)*cpu->reg8[op->reg] >> count;
+    NEXT();
+}
+void OPCALL normal_sar8cl_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 0x1F;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        writeb(eaa, (S8)readb(eaa) >> count);
+    }
+    NEXT();
+}
+void OPCALL normal_sar16_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm;
+    cpu->reg[op->reg].u16 = (S16)cpu->reg[op->reg].u16 >> count;
+    NEXT();
+}
+void OPCALL normal_sar16_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    U32 count = op->imm;
+    writew(eaa, (S16)readw(eaa) >> count);
+    NEXT();
+}
+void OPCALL normal_sar16cl_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 0x1F;
+    cpu->reg[op->reg].u16 = (S16)cpu->reg[op->reg].u16 >> count;
+    NEXT();
+}
+void OPCALL normal_sar16cl_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 0x1F;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        writew(eaa, (S16)readw(eaa) >> count);
+    }
+    NEXT();
+}
+void OPCALL normal_sar32_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm;
+    cpu->reg[op->reg].u32 = (S32)cpu->reg[op->reg].u32 >> count;
+    NEXT();
+}
+void OPCALL normal_sar32_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 eaa = eaa(cpu, op);
+    U32 count = op->imm;
+    writed(eaa, (S32)readd(eaa) >> count);
+    NEXT();
+}
+void OPCALL normal_sar32cl_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 0x1F;
+    cpu->reg[op->reg].u32 = (S32)cpu->reg[op->reg].u32 >> count;
+    NEXT();
+}
+void OPCALL normal_sar32cl_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 0x1F;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        writed(eaa, (S32)readd(eaa) >> count);
+    }
+    NEXT();
+}
+void OPCALL normal_rol8_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm & 7;
+    if (count) {
+        U8 var1 = *cpu->reg8[op->reg];
+        *cpu->reg8[op->reg] = (var1 << count) | (var1 >> (8 - count));
+    }
+    NEXT();
+}
+void OPCALL normal_rol8_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm & 7;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        U8 var1 = readb(eaa);
+        writeb(eaa, (var1 << count) | (var1 >> (8 - count)));
+    }
+    NEXT();
+}
+void OPCALL normal_rol8cl_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 7;
+    if (count) {
+        U8 var1 = *cpu->reg8[op->reg];
+        *cpu->reg8[op->reg] = (var1 << count) | (var1 >> (8 - count));
+    }
+    NEXT();
+}
+void OPCALL normal_rol8cl_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 7;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        U8 var1 = readb(eaa);
+        writeb(eaa, (var1 << count) | (var1 >> (8 - count)));
+    }
+    NEXT();
+}
+void OPCALL normal_rol16_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm & 15;
+    if (count) {
+        U16 var1 = cpu->reg[op->reg].u16;
+        cpu->reg[op->reg].u16 = (var1 << count) | (var1 >> (16 - count));
+    }
+    NEXT();
+}
+void OPCALL normal_rol16_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm & 15;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        U16 var1 = readw(eaa);
+        writew(eaa, (var1 << count) | (var1 >> (16 - count)));
+    }
+    NEXT();
+}
+void OPCALL normal_rol16cl_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 15;
+    if (count) {
+        U16 var1 = cpu->reg[op->reg].u16;
+        cpu->reg[op->reg].u16 = (var1 << count) | (var1 >> (16 - count));
+    }
+    NEXT();
+}
+void OPCALL normal_rol16cl_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 15;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        U16 var1 = readw(eaa);
+        writew(eaa, (var1 << count) | (var1 >> (16 - count)));
+    }
+    NEXT();
+}
+void OPCALL normal_rol32_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm & 31;
+    if (count) {
+        U32 var1 = cpu->reg[op->reg].u32;
+        cpu->reg[op->reg].u32 = (var1 << count) | (var1 >> (32 - count));
+    }
+    NEXT();
+}
+void OPCALL normal_rol32_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm & 31;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        U32 var1 = readd(eaa);
+        writed(eaa, (var1 << count) | (var1 >> (32 - count)));
+    }
+    NEXT();
+}
+void OPCALL normal_rol32cl_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 31;
+    if (count) {
+        U32 var1 = cpu->reg[op->reg].u32;
+        cpu->reg[op->reg].u32 = (var1 << count) | (var1 >> (32 - count));
+    }
+    NEXT();
+}
+void OPCALL normal_rol32cl_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 31;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        U32 var1 = readd(eaa);
+        writed(eaa, (var1 << count) | (var1 >> (32 - count)));
+    }
+    NEXT();
+}
+void OPCALL normal_ror8_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm & 7;
+    if (count) {
+        U8 var1 = *cpu->reg8[op->reg];
+        *cpu->reg8[op->reg] = (var1 >> count) | (var1 << (8 - count));
+    }
+    NEXT();
+}
+void OPCALL normal_ror8_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm & 7;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        U8 var1 = readb(eaa);
+        writeb(eaa, (var1 >> count) | (var1 << (8 - count)));
+    }
+    NEXT();
+}
+void OPCALL normal_ror8cl_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 7;
+    if (count) {
+        U8 var1 = *cpu->reg8[op->reg];
+        *cpu->reg8[op->reg] = (var1 >> count) | (var1 << (8 - count));
+    }
+    NEXT();
+}
+void OPCALL normal_ror8cl_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 7;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        U8 var1 = readb(eaa);
+        writeb(eaa, (var1 >> count) | (var1 << (8 - count)));
+    }
+    NEXT();
+}
+void OPCALL normal_ror16_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm & 15;
+    if (count) {
+        U16 var1 = cpu->reg[op->reg].u16;
+        cpu->reg[op->reg].u16 = (var1 >> count) | (var1 << (16 - count));
+    }
+    NEXT();
+}
+void OPCALL normal_ror16_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm & 15;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        U16 var1 = readw(eaa);
+        writew(eaa, (var1 >> count) | (var1 << (16 - count)));
+    }
+    NEXT();
+}
+void OPCALL normal_ror16cl_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 15;
+    if (count) {
+        U16 var1 = cpu->reg[op->reg].u16;
+        cpu->reg[op->reg].u16 = (var1 >> count) | (var1 << (16 - count));
+    }
+    NEXT();
+}
+void OPCALL normal_ror16cl_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 15;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        U16 var1 = readw(eaa);
+        writew(eaa, (var1 >> count) | (var1 << (16 - count)));
+    }
+    NEXT();
+}
+void OPCALL normal_ror32_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm & 31;
+    if (count) {
+        U32 var1 = cpu->reg[op->reg].u32;
+        cpu->reg[op->reg].u32 = (var1 >> count) | (var1 << (32 - count));
+    }
+    NEXT();
+}
+void OPCALL normal_ror32_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = op->imm & 31;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        U32 var1 = readd(eaa);
+        writed(eaa, (var1 >> count) | (var1 << (32 - count)));
+    }
+    NEXT();
+}
+void OPCALL normal_ror32cl_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 31;
+    if (count) {
+        U32 var1 = cpu->reg[op->reg].u32;
+        cpu->reg[op->reg].u32 = (var1 >> count) | (var1 << (32 - count));
+    }
+    NEXT();
+}
+void OPCALL normal_ror32cl_mem_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 count = CL & 31;
+    if (count) {
+        U32 eaa = eaa(cpu, op);
+        U32 var1 = readd(eaa);
+        writed(eaa, (var1 >> count) | (var1 << (32 - count)));
+    }
+    NEXT();
+}
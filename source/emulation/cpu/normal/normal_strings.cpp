@@ -17,6 +17,187 @@
  */
 
 #include "boxedwine.h"
+
+// The rep versions of the 32-bit string instructions work one page run at a time.  A run is as many elements, up to
+// ECX, as can be done without the source or destination leaving its current page, so it only needs one page lookup
+// and can be done with memmove/memset/memcmp on host memory.  ECX/ESI/EDI are updated after each run.  If a page
+// can't be accessed directly (not present, read only, code page, etc) or an element straddles two pages, the
+// element goes through readX/writeX like before, so a fault leaves the same partial progress it always did.
+
+// how many elements of width bytes fit in the page starting at address and moving in the direction of inc
+static inline U32 stringElementsInPage(U32 address, S32 inc, U32 width) {
+    U32 offset = address & K_PAGE_MASK;
+    if (offset + width > K_PAGE_SIZE) {
+        return 0;
+    }
+    if (inc > 0) {
+        return (K_PAGE_SIZE - offset) / width;
+    }
+    return offset / width + 1;
+}
+
+// the lowest address touched by count elements starting at address, when DF is set the run goes down from address
+static inline U32 stringRunStart(U32 address, S32 inc, U32 count) {
+    return inc > 0 ? address : address + (count - 1) * inc;
+}
+
+// Copies len bytes in the same order the elements would be copied one at a time.  That is what memmove does unless
+// the destination is ahead of the source in the direction of the copy and they overlap, for example rep movsb with
+// EDI = ESI + 1 to fill memory with a byte.  Then the copy is done in pieces no bigger than the distance between the
+// two so that each piece sees what the one before it wrote.  Returns false if they are less than one element apart.
+static bool stringCopy(U8* to, const U8* from, U32 len, U32 width, bool forward) {
+    if (forward && to > from && to < from + len) {
+        U32 distance = (U32)(to - from);
+        if (distance < width) {
+            return false;
+        }
+        for (U32 i = 0; i < len; i += distance) {
+            memcpy(to + i, from + i, std::min(distance, len - i));
+        }
+    } else if (!forward && to < from && to + len > from) {
+        U32 distance = (U32)(from - to);
+        if (distance < width) {
+            return false;
+        }
+        U32 i = len;
+        while (i) {
+            U32 todo = std::min(distance, i);
+            i -= todo;
+            memcpy(to + i, from + i, todo);
+        }
+    } else {
+        memmove(to, from, len);
+    }
+    return true;
+}
+
+template <typename T>
+static U32 movsRun32(CPU* cpu, U32 dBase, U32 sBase, S32 inc) {
+    U32 src = sBase + ESI;
+    U32 dst = dBase + EDI;
+    U32 count = std::min(ECX, std::min(stringElementsInPage(src, inc, sizeof(T)), stringElementsInPage(dst, inc, sizeof(T))));
+    if (!count) {
+        return 0;
+    }
+    U32 len = count * sizeof(T);
+    U8* from = getPhysicalReadAddress(stringRunStart(src, inc, count), len);
+    if (!from) {
+        return 0;
+    }
+    U8* to = getPhysicalWriteAddress(stringRunStart(dst, inc, count), len);
+    if (!to || !stringCopy(to, from, len, sizeof(T), inc > 0)) {
+        return 0;
+    }
+    ESI += count * inc;
+    EDI += count * inc;
+    ECX -= count;
+    return count;
+}
+
+template <typename T>
+static U32 stosRun32(CPU* cpu, U32 dBase, S32 inc, T value) {
+    U32 dst = dBase + EDI;
+    U32 count = std::min(ECX, stringElementsInPage(dst, inc, sizeof(T)));
+    if (!count) {
+        return 0;
+    }
+    U8* to = getPhysicalWriteAddress(stringRunStart(dst, inc, count), count * sizeof(T));
+    if (!to) {
+        return 0;
+    }
+    if (sizeof(T) == 1 || !value) {
+        memset(to, (U8)value, count * sizeof(T));
+    } else {
+        for (U32 i = 0; i < count; i++) {
+            memcpy(to + i * sizeof(T), &value, sizeof(T));
+        }
+    }
+    EDI += count * inc;
+    ECX -= count;
+    return count;
+}
+
+// stops after the first element that ends the rep, v1 and v2 are left with the last element compared
+template <typename T>
+static U32 cmpsRun32(CPU* cpu, U32 dBase, U32 sBase, S32 inc, U32 rep_zero, T& v1, T& v2) {
+    U32 src = sBase + ESI;
+    U32 dst = dBase + EDI;
+    U32 count = std::min(ECX, std::min(stringElementsInPage(src, inc, sizeof(T)), stringElementsInPage(dst, inc, sizeof(T))));
+    if (!count) {
+        return 0;
+    }
+    U32 len = count * sizeof(T);
+    U8* s = getPhysicalReadAddress(stringRunStart(src, inc, count), len);
+    if (!s) {
+        return 0;
+    }
+    U8* d = getPhysicalReadAddress(stringRunStart(dst, inc, count), len);
+    if (!d) {
+        return 0;
+    }
+    U32 i = 0;
+    if (rep_zero && !memcmp(d, s, len)) {
+        // repe over a run that is all the same, only the last element matters for the flags
+        i = count;
+        memcpy(&v1, d + (inc > 0 ? len - sizeof(T) : 0), sizeof(T));
+        v2 = v1;
+    } else {
+        if (inc < 0) {
+            s += len - sizeof(T);
+            d += len - sizeof(T);
+        }
+        while (i < count) {
+            memcpy(&v1, d, sizeof(T));
+            memcpy(&v2, s, sizeof(T));
+            d += inc;
+            s += inc;
+            i++;
+            if ((v1 == v2) != rep_zero) {
+                break;
+            }
+        }
+    }
+    ESI += i * inc;
+    EDI += i * inc;
+    ECX -= i;
+    return i;
+}
+
+// stops after the first element that ends the rep, v1 is left with the last element compared
+template <typename T>
+static U32 scasRun32(CPU* cpu, U32 dBase, S32 inc, U32 rep_zero, T value, T& v1) {
+    U32 dst = dBase + EDI;
+    U32 count = std::min(ECX, stringElementsInPage(dst, inc, sizeof(T)));
+    if (!count) {
+        return 0;
+    }
+    U8* d = getPhysicalReadAddress(stringRunStart(dst, inc, count), count * sizeof(T));
+    if (!d) {
+        return 0;
+    }
+    U32 i = 0;
+    if (sizeof(T) == 1 && !rep_zero && inc > 0) {
+        // repne scasb, usually strlen
+        U8* found = (U8*)memchr(d, (U8)value, count);
+        i = found ? (U32)(found - d) + 1 : count;
+        v1 = d[i - 1];
+    } else {
+        if (inc < 0) {
+            d += (count - 1) * sizeof(T);
+        }
+        while (i < count) {
+            memcpy(&v1, d, sizeof(T));
+            d += inc;
+            i++;
+            if ((value == v1) != rep_zero) {
+                break;
+            }
+        }
+    }
+    EDI += i * inc;
+    ECX -= i;
+    return i;
+}
 void movsb16(CPU* cpu, U32 base) {
     U32 dBase = cpu->seg[ES].address;
     U32 sBase = cpu->seg[base].address;
@@ -50,13 +231,13 @@ void movsb32r(CPU* cpu, U32 base) {
     U32 dBase = cpu->seg[ES].address;
     U32 sBase = cpu->seg[base].address;
     S32 inc = cpu->df;
-    U32 count = ECX;
-    U32 i;
-    for (i=0;i<count;i++) {
-        writeb(dBase+EDI, readb(sBase+ESI));
-        EDI+=inc;
-        ESI+=inc;
-        ECX--;
+    while (ECX) {
+        if (!movsRun32<U8>(cpu, dBase, sBase, inc)) {
+            writeb(dBase+EDI, readb(sBase+ESI));
+            EDI+=inc;
+            ESI+=inc;
+            ECX--;
+        }
     }
 }
 void movsw16(CPU* cpu, U32 base) {
@@ -92,13 +273,13 @@ void movsw32r(CPU* cpu, U32 base) {
     U32 dBase = cpu->seg[ES].address;
     U32 sBase = cpu->seg[base].address;
     S32 inc = cpu->df << 1;
-    U32 count = ECX;
-    U32 i;
-    for (i=0;i<count;i++) {
-        writew(dBase+EDI, readw(sBase+ESI));
-        EDI+=inc;
-        ESI+=inc;
-        ECX--;
+    while (ECX) {
+        if (!movsRun32<U16>(cpu, dBase, sBase, inc)) {
+            writew(dBase+EDI, readw(sBase+ESI));
+            EDI+=inc;
+            ESI+=inc;
+            ECX--;
+        }
     }
 }
 void movsd16(CPU* cpu, U32 base) {
@@ -134,13 +315,13 @@ void movsd32r(CPU* cpu, U32 base) {
     U32 dBase = cpu->seg[ES].address;
     U32 sBase = cpu->seg[base].address;
     S32 inc = cpu->df << 2;
-    U32 count = ECX;
-    U32 i;
-    for (i=0;i<count;i++) {
-        writed(dBase+EDI, readd(sBase+ESI));
-        EDI+=inc;
-        ESI+=inc;
-        ECX--;
+    while (ECX) {
+        if (!movsRun32<U32>(cpu, dBase, sBase, inc)) {
+            writed(dBase+EDI, readd(sBase+ESI));
+            EDI+=inc;
+            ESI+=inc;
+            ECX--;
+        }
     }
 }
 void cmpsb16(CPU* cpu, U32 rep_zero, U32 base) {
@@ -204,12 +385,14 @@ void cmpsb32r(CPU* cpu, U32 rep_zero, U32 base) {
     if (count) {
         U8 v1=0;
         U8 v2=0;
-        for (U32 i=0;i<count;i++) {
-            v1 = readb(dBase+EDI);
-            v2 = readb(sBase+ESI);
-            EDI+=inc;
-            ESI+=inc;
-            ECX--;
+        while (ECX) {
+            if (!cmpsRun32<U8>(cpu, dBase, sBase, inc, rep_zero, v1, v2)) {
+                v1 = readb(dBase+EDI);
+                v2 = readb(sBase+ESI);
+                EDI+=inc;
+                ESI+=inc;
+                ECX--;
+            }
             if ((v1==v2)!=rep_zero) break;
         }
         cpu->dst.u8 = v2;
@@ -278,12 +461,14 @@ void cmpsw32r(CPU* cpu, U32 rep_zero, U32 base) {
     if (count) {
         U16 v1=0;
         U16 v2=0;
-        for (U32 i=0;i<count;i++) {
-            v1 = readw(dBase+EDI);
-            v2 = readw(sBase+ESI);
-            EDI+=inc;
-            ESI+=inc;
-            ECX--;
+        while (ECX) {
+            if (!cmpsRun32<U16>(cpu, dBase, sBase, inc, rep_zero, v1, v2)) {
+                v1 = readw(dBase+EDI);
+                v2 = readw(sBase+ESI);
+                EDI+=inc;
+                ESI+=inc;
+                ECX--;
+            }
             if ((v1==v2)!=rep_zero) break;
         }
         cpu->dst.u16 = v2;
@@ -352,12 +537,14 @@ void cmpsd32r(CPU* cpu, U32 rep_zero, U32 base) {
     if (count) {
         U32 v1=0;
         U32 v2=0;
-        for (U32 i=0;i<count;i++) {
-            v1 = readd(dBase+EDI);
-            v2 = readd(sBase+ESI);
-            EDI+=inc;
-            ESI+=inc;
-            ECX--;
+        while (ECX) {
+            if (!cmpsRun32<U32>(cpu, dBase, sBase, inc, rep_zero, v1, v2)) {
+                v1 = readd(dBase+EDI);
+                v2 = readd(sBase+ESI);
+                EDI+=inc;
+                ESI+=inc;
+                ECX--;
+            }
             if ((v1==v2)!=rep_zero) break;
         }
         cpu->dst.u32 = v2;
@@ -388,12 +575,12 @@ void stosb32(CPU* cpu) {
 void stosb32r(CPU* cpu) {
     U32 dBase = cpu->seg[ES].address;
     S32 inc = cpu->df;
-    U32 count = ECX;
-    U32 i;
-    for (i=0;i<count;i++) {
-        writeb(dBase+EDI, AL);
-        EDI+=inc;
-        ECX--;
+    while (ECX) {
+        if (!stosRun32<U8>(cpu, dBase, inc, AL)) {
+            writeb(dBase+EDI, AL);
+            EDI+=inc;
+            ECX--;
+        }
     }
 }
 void stosw16(CPU* cpu) {
@@ -418,12 +605,12 @@ void stosw32(CPU* cpu) {
 void stosw32r(CPU* cpu) {
     U32 dBase = cpu->seg[ES].address;
     S32 inc = cpu->df << 1;
-    U32 count = ECX;
-    U32 i;
-    for (i=0;i<count;i++) {
-        writew(dBase+EDI, AX);
-        EDI+=inc;
-        ECX--;
+    while (ECX) {
+        if (!stosRun32<U16>(cpu, dBase, inc, AX)) {
+            writew(dBase+EDI, AX);
+            EDI+=inc;
+            ECX--;
+        }
     }
 }
 void stosd16(CPU* cpu) {
@@ -448,12 +635,12 @@ void stosd32(CPU* cpu) {
 void stosd32r(CPU* cpu) {
     U32 dBase = cpu->seg[ES].address;
     S32 inc = cpu->df << 2;
-    U32 count = ECX;
-    U32 i;
-    for (i=0;i<count;i++) {
-        writed(dBase+EDI, EAX);
-        EDI+=inc;
-        ECX--;
+    while (ECX) {
+        if (!stosRun32<U32>(cpu, dBase, inc, EAX)) {
+            writed(dBase+EDI, EAX);
+            EDI+=inc;
+            ECX--;
+        }
     }
 }
 void lodsb16(CPU* cpu, U32 base) {
@@ -592,10 +779,12 @@ void scasb32r(CPU* cpu, U32 rep_zero) {
     U32 count = ECX;
     if (count) {
         U8 v1=0;
-        for (U32 i=0;i<count;i++) {
-            v1 = readb(dBase+EDI);
-            EDI+=inc;
-            ECX--;
+        while (ECX) {
+            if (!scasRun32<U8>(cpu, dBase, inc, rep_zero, AL, v1)) {
+                v1 = readb(dBase+EDI);
+                EDI+=inc;
+                ECX--;
+            }
             if ((AL==v1)!=rep_zero) break;
         }
         cpu->dst.u8 = AL;
@@ -650,10 +839,12 @@ void scasw32r(CPU* cpu, U32 rep_zero) {
     U32 count = ECX;
     if (count) {
         U16 v1=0;
-        for (U32 i=0;i<count;i++) {
-            v1 = readw(dBase+EDI);
-            EDI+=inc;
-            ECX--;
+        while (ECX) {
+            if (!scasRun32<U16>(cpu, dBase, inc, rep_zero, AX, v1)) {
+                v1 = readw(dBase+EDI);
+                EDI+=inc;
+                ECX--;
+            }
             if ((AX==v1)!=rep_zero) break;
         }
         cpu->dst.u16 = AX;
@@ -708,10 +899,12 @@ void scasd32r(CPU* cpu, U32 rep_zero) {
     U32 count = ECX;
     if (count) {
         U32 v1=0;
-        for (U32 i=0;i<count;i++) {
-            v1 = readd(dBase+EDI);
-            EDI+=inc;
-            ECX--;
+        while (ECX) {
+            if (!scasRun32<U32>(cpu, dBase, inc, rep_zero, EAX, v1)) {
+                v1 = readd(dBase+EDI);
+                EDI+=inc;
+                ECX--;
+            }
             if ((EAX==v1)!=rep_zero) break;
         }
         cpu->dst.u32 = EAX;
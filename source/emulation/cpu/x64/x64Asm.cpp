@@ -258,7 +258,95 @@ void X64Asm::writeToRegFromValue(U8 reg, bool isRexReg, U64 value, U8 bytes) {
     }
 }
 
+// any pointer into the Boxedwine image must be written with this so that the code cache can relocate it
+void X64Asm::writeToRegFromHostPtr(U8 reg, bool isRexReg, void* value) {
+    writeToRegFromValue(reg, isRexReg, (U64)value, 8);
+    this->relocations.push_back(this->bufferPos - 8);
+}
+
+void x64_writeCodePage(x64CPU* cpu, U32 address) {
+    cpu->writeCodePage(address);
+}
+
 void X64Asm::writeHostPlusTmp(U8 rm, bool checkG, bool isG8bit, bool isE8bit, U8 tmpReg) {
+    if (this->checkCodePageWrite && !this->tmp1InUse + !this->tmp2InUse + !this->tmp3InUse >= 2) {
+        // this op keeps writing to pages with code, checking the page here is a lot cheaper than the exception
+        this->checkCodePageWrite = false;
+        U8 pageReg = getTmpReg();
+        U8 flagsReg = getTmpReg();
+
+        // pageReg = &cpu->nativeFlags[tmpReg >> K_NATIVE_PAGE_SHIFT]
+        writeToRegFromReg(pageReg, true, tmpReg, true, 4);
+        pushFlagsToReg(flagsReg, true, true);
+        shiftRightReg(pageReg, true, K_NATIVE_PAGE_SHIFT);
+        doMemoryInstruction(0x03, pageReg, true, HOST_CPU, true, -1, false, 0, CPU_OFFSET_NATIVE_FLAGS, 8);
+
+        // test byte [pageReg], NATIVE_FLAG_CODEPAGE_READONLY
+        write8(REX_BASE | REX_MOD_RM);
+        write8(0xf6);
+        write8(pageReg);
+        write8(NATIVE_FLAG_CODEPAGE_READONLY);
+        releaseTmpReg(pageReg);
+
+        // jz
+        write8(0x0f);
+        write8(0x84);
+        U32 pos = this->bufferPos;
+        write32(0);
+
+        // the page has code, let x64_writeCodePage run the op.  This never falls through so the other tmp regs are
+        // free, the op hasn't changed anything yet.  tmpReg still holds the address, the params can't be set before
+        // syncRegsFromHost since they overlap the emulated regs.
+        popFlagsFromReg(flagsReg, true, true);
+        bool tmp1 = this->tmp1InUse;
+        bool tmp2 = this->tmp2InUse;
+        bool tmp3 = this->tmp3InUse;
+        this->tmp1InUse = tmpReg == HOST_TMP;
+        this->tmp2InUse = tmpReg == HOST_TMP2;
+        this->tmp3InUse = tmpReg == HOST_TMP3;
+        syncRegsFromHost();
+        lockParamReg(PARAM_1_REG, PARAM_1_REX);
+        writeToRegFromReg(PARAM_1_REG, PARAM_1_REX, HOST_CPU, true, 8); // CPU* param
+        lockParamReg(PARAM_2_REG, PARAM_2_REX);
+        writeToRegFromReg(PARAM_2_REG, PARAM_2_REX, tmpReg, true, 4); // address param
+        releaseTmpReg(tmpReg); // callHost needs tmp3
+        callHost((void*)x64_writeCodePage);
+        syncRegsToHost();
+        doJmp(true);
+        this->tmp1InUse = tmp1;
+        this->tmp2InUse = tmp2;
+        this->tmp3InUse = tmp3;
+        write32Buffer(this->buffer + pos, this->bufferPos - pos - 4);
+
+        popFlagsFromReg(flagsReg, true, true);
+        releaseTmpReg(flagsReg);
+    }
+    if (this->useMemOffsets && !this->tmp1InUse + !this->tmp2InUse + !this->tmp3InUse >= 2) {
+        // the page might be mapped to host memory, so use memOffsets[page] instead of HOST_MEM
+        U8 pageReg = getTmpReg();
+        U8 flagsReg = getTmpReg();
+
+        // pageReg = tmpReg >> 12
+        writeToRegFromReg(pageReg, true, tmpReg, true, 4);
+        pushFlagsToReg(flagsReg, true, true);
+        shiftRightReg(pageReg, true, K_PAGE_SHIFT);
+        popFlagsFromReg(flagsReg, true, true);
+
+        // pageReg = cpu->memOffsets[pageReg]
+        writeToRegFromMem(flagsReg, true, HOST_CPU, true, -1, false, 0, CPU_OFFSET_MEM_OFFSETS, 8, false);
+        writeToRegFromMem(pageReg, true, flagsReg, true, pageReg, true, 3, 0, 8, false);
+
+        // tmpReg = pageReg + tmpReg
+        addWithLea(tmpReg, true, pageReg, true, tmpReg, true, 0, 0, 8);
+        releaseTmpReg(flagsReg);
+        releaseTmpReg(pageReg);
+
+        // [tmpReg]
+        this->rex |= REX_BASE | REX_MOD_RM;
+        setRM(rm, checkG, false, isG8bit, isE8bit);
+        setSib(tmpReg | (4 << 3), false);
+        return;
+    }
     this->rex |= REX_BASE | REX_SIB_INDEX|REX_MOD_RM;    
     setRM(rm, checkG, false, isG8bit, isE8bit);
     setSib(HOST_MEM | (tmpReg << 3), false); 
@@ -326,12 +414,12 @@ void X64Asm::translateMemory16(U32 rm, bool checkG, bool isG8bit, bool isE8bit,
 
     // tmpReg = tmpReg + seg
     addWithLea(tmpReg, true, tmpReg, true, getRegForSeg(seg, tmpReg2), true, 0, 0, 4);
+    releaseTmpReg(tmpReg2);
 
     // [HOST_MEM + tmpReg]
     writeHostPlusTmp((rm & (7<<3)) | 4, checkG, isG8bit, isE8bit, tmpReg);
 
     autoReleaseTmpAfterWriteOp = tmpReg;
-    releaseTmpReg(tmpReg2);
 }
 
 void X64Asm::translateMemory(U32 rm, bool checkG, bool isG8bit, bool isE8bit) {
@@ -443,7 +531,7 @@ void X64Asm::translateMemory(U32 rm, bool checkG, bool isG8bit, bool isE8bit) {
                     // converts [reg] to HOST_TMP = reg+SEG; [HOST_TMP+HOST_MEM]
                                     
                     // don't need to worry about E(rm) == 5, that is handled below
-                    if (!this->cpu->thread->process->hasSetSeg[this->ds]) {
+                    if (!this->cpu->thread->process->hasSetSeg[this->ds] && !this->needsHostPlusTmp()) {
                         // [HOST_MEM + reg]
                         this->rex |= REX_BASE | REX_MOD_RM;    
                         setRM((rm & ~(7)) | 4, checkG, false, isG8bit, isE8bit);
@@ -469,7 +557,7 @@ void X64Asm::translateMemory(U32 rm, bool checkG, bool isG8bit, bool isE8bit) {
                     setDisplacement32(this->fetch32());
                 } else {
                     U32 disp = this->fetch32();
-                    if (!this->cpu->thread->process->hasSetSeg[this->ds] && disp<=0x7FFFFFFF) {
+                    if (!this->cpu->thread->process->hasSetSeg[this->ds] && disp<=0x7FFFFFFF && !this->needsHostPlusTmp()) {
                         // converts [disp32] to [HOST_MEM+disp32]
                         this->rex |= REX_BASE | REX_MOD_RM;    
                         setRM((rm & ~(0xC7)) | 4 | 0x80, checkG, false, isG8bit, isE8bit);
@@ -518,7 +606,7 @@ void X64Asm::translateMemory(U32 rm, bool checkG, bool isG8bit, bool isE8bit) {
                             U8 seg = base==4?this->ss:this->ds;
                             // convert [base + index << shift] to HOST_TMP=[base + index << shift];HOST_TMP=[HOST_TMP+SEG];[HOST_TMP+MEM]
                             if (!this->cpu->thread->process->hasSetSeg[seg]) {                                                                 
-                                if (index==4) { // no index
+                                if (index==4 && !this->needsHostPlusTmp()) { // no index
                                     // probably something like mov ebx,DWORD PTR [esp] 
                                     this->rex |= REX_BASE | REX_SIB_INDEX | REX_MOD_RM;    
                                     setRM(rm, checkG, false, isG8bit, isE8bit);
@@ -526,7 +614,7 @@ void X64Asm::translateMemory(U32 rm, bool checkG, bool isG8bit, bool isE8bit) {
                                 } else {
                                     U32 tmpReg = getTmpReg();
                                     // HOST_TMP=[base+index<<shift];
-                                    addWithLea(tmpReg, true, base, false, index, false, sib >> 6, 0, 4);
+                                    addWithLea(tmpReg, true, base, false, (index==4?-1:index), false, sib >> 6, 0, 4);
                                     // [HOST_MEM + HOST_TMP]
                                     writeHostPlusTmp((rm & ~(7)) | 4, checkG, isG8bit, isE8bit, tmpReg);
                                     autoReleaseTmpAfterWriteOp = tmpReg;
@@ -655,6 +743,10 @@ void X64Asm::setRM(U8 rm, bool checkG, bool checkE, bool isG8bit, bool isE8bit)
 // rm could be set to use the rexReg in tmpReg
 void X64Asm::translateRM(U8 rm, bool checkG, bool checkE, bool isG8bit, bool isE8bit, U8 immWidth) {    
     this->autoReleaseTmpAfterWriteOp = 0xFF;
+    if (this->checkCodePageWrite && (this->bufferPos != this->startOfOpBufferPos || this->tmp1InUse || this->tmp2InUse || this->tmp3InUse)) {
+        // x64_writeCodePage runs the whole op, so nothing can happen before the check
+        this->checkCodePageWrite = false;
+    }
     if (rm<0xC0) {
         translateMemory(rm, checkG, isG8bit, isE8bit);
     } else {
@@ -1487,7 +1579,7 @@ void X64Asm::callHost(void* pfn) {
     write8(0x74);
     U32 pos = this->bufferPos;
     write8(0);
-    writeToRegFromValue(tmp, true, (U64)badStack, 8);
+    writeToRegFromHostPtr(tmp, true, (void*)badStack);
     write8(REX_BASE | REX_64);
     write8(0x83);
     write8(0xEC);
@@ -1502,7 +1594,7 @@ void X64Asm::callHost(void* pfn) {
 
     write8(0xfc); // cld
 
-    writeToRegFromValue(tmp, true, (U64)pfn, 8);
+    writeToRegFromHostPtr(tmp, true, (void*)pfn);
 
 #ifdef BOXEDWINE_MSVC
     // part of the x64 windows ABI, shadow store
@@ -1728,6 +1820,7 @@ void X64Asm::setPF_onAL(U8 flagReg) {
     write8(REX_BASE | REX_64 | REX_MOD_RM);
     write8(0xb8+tmpReg);
     write64((U64)parity_lookup);
+    this->relocations.push_back(this->bufferPos - 8);
     
     // or HOST_TMPb, byte ptr [HOST_TMP2]
     write8(REX_BASE | REX_MOD_REG | REX_MOD_RM);
@@ -2075,15 +2168,53 @@ void X64Asm::popA32() {
 }
 
 void X64Asm::jumpConditional(U8 condition, U32 eip) {    
-    if (this->stopAfterInstruction!=(S32)this->ipAddressCount && (this->calculatedEipLen==0 || (eip>=this->startOfDataIp && eip<this->startOfDataIp+this->calculatedEipLen))) {
+    if (isStartOfInstruction(eip)) {
         write8(0x0F);
         write8(0x80+condition);
         write32(0);
         addTodoLinkJump(eip, 4, true);
     } else {
-        write8(0x70+condition);
-        doLoop(eip);
+        // skip over the jump if the condition is not met
+        U32 pos = this->bufferPos;
+        write8(0x70+(condition ^ 1));
+        write8(0);
+        jumpTo(eip);
+        if (this->bufferPos-pos-2>127) {
+            kpanic("X64Asm::jumpConditional tried to jump too far");
+        }
+        this->buffer[pos+1] = this->bufferPos-pos-2;
+        if (this->jumpFixups.size() && this->jumpFixups.back().todoJumpIndex==this->todoJump.size()-1) {
+            // if eip ends up in this chunk, resolveJumpFixups can replace this with a single jcc
+            this->jumpFixups.back() = JumpFixup((U32)this->todoJump.size()-1, pos, this->bufferPos, condition);
+        }
+    }
+}
+
+void X64Asm::resolveJumpFixups() {
+    for (auto& fixup : this->jumpFixups) {
+        TodoJump& jump = this->todoJump[fixup.todoJumpIndex];
+        if (!isStartOfInstruction(jump.eip)) {
+            continue;
+        }
+        U8* p = this->buffer+fixup.pos;
+        if (fixup.condition<0) {
+            // jmp rel32, the rest of the long form will never be reached
+            p[0] = 0xE9;
+            write32Buffer(p+1, 0);
+            jump.bufferPos = fixup.pos+1;
+        } else {
+            // jcc rel32 followed by a short jmp over what is left of the long form
+            p[0] = 0x0F;
+            p[1] = 0x80+fixup.condition;
+            write32Buffer(p+2, 0);
+            p[6] = 0xEB;
+            p[7] = (U8)(fixup.endPos-fixup.pos-8);
+            jump.bufferPos = fixup.pos+2;
+        }
+        jump.offsetSize = 4;
+        jump.sameChunk = true;
     }
+    this->jumpFixups.clear();
 }
 
 void X64Asm::write64Buffer(U8* buffer, U64 value) {
@@ -2123,7 +2254,7 @@ void X64Asm::jumpTo(U32 eip) {
 #endif
     // :TODO: is this necessary?  who uses it?
     this->writeToMemFromValue(eip, HOST_CPU, true, -1, false, 0, CPU_OFFSET_EIP, 4, false);
-    if (this->stopAfterInstruction!=(S32)this->ipAddressCount && (this->calculatedEipLen==0 || (eip>=this->startOfDataIp && eip<this->startOfDataIp+this->calculatedEipLen))) {
+    if (isStartOfInstruction(eip)) {
         write8(0xE9);
         write32(0);
         addTodoLinkJump(eip, 4, true);
@@ -2138,11 +2269,14 @@ void X64Asm::jumpTo(U32 eip) {
             write32(0);
             addTodoLinkJump(eip, 4, false);
         } else {
+            U32 pos = this->bufferPos;
             writeToRegFromValue(HOST_TMP, true, 0x0101010101010101l, 8);
             write8(0x41);
             write8(0xff);
             write8(0x20 | HOST_TMP);
             addTodoLinkJump(eip, 8, false);
+            // eip might be translated later in this chunk
+            this->jumpFixups.push_back(JumpFixup((U32)this->todoJump.size()-1, pos, this->bufferPos, -1));
         }
     }
 }
@@ -3349,7 +3483,7 @@ static void x64_errorMsg(const char* msg) {
 void X64Asm::errorMsg(const char* msg) {
     //syncRegsFromHost(); 
     lockParamReg(PARAM_1_REG, PARAM_1_REX);
-    writeToRegFromValue(PARAM_1_REG, PARAM_1_REX, (U64)msg, 8);
+    writeToRegFromHostPtr(PARAM_1_REG, PARAM_1_REX, (void*)msg);
     callHost((void*)x64_errorMsg);
     //syncRegsToHost();
     //doJmp();
@@ -3539,7 +3673,7 @@ void X64Asm::stos16(void* pfn, U32 size, bool repeat) {
     writeToRegFromReg(PARAM_1_REG, PARAM_1_REX, HOST_CPU, true, 8); // CPU* param
 
     lockParamReg(PARAM_2_REG, PARAM_2_REX);
-    writeToRegFromValue(PARAM_2_REG, PARAM_2_REX, (U64)pfn, 8);
+    writeToRegFromHostPtr(PARAM_2_REG, PARAM_2_REX, (void*)pfn);
 
     lockParamReg(PARAM_3_REG, PARAM_3_REX);
     writeToRegFromValue(PARAM_3_REG, PARAM_3_REX, size, 4);
@@ -3557,7 +3691,7 @@ void X64Asm::scas16(void* pfn, U32 size, bool repeat, bool repeatZero) {
     writeToRegFromReg(PARAM_1_REG, PARAM_1_REX, HOST_CPU, true, 8); // CPU* param
 
     lockParamReg(PARAM_2_REG, PARAM_2_REX);
-    writeToRegFromValue(PARAM_2_REG, PARAM_2_REX, (U64)pfn, 8);
+    writeToRegFromHostPtr(PARAM_2_REG, PARAM_2_REX, (void*)pfn);
 
     lockParamReg(PARAM_3_REG, PARAM_3_REX);
     writeToRegFromValue(PARAM_3_REG, PARAM_3_REX, (U32)repeatZero?1:0, 4);
@@ -3578,7 +3712,7 @@ void X64Asm::movs16(void* pfn, U32 size, bool repeat, U32 base) {
     writeToRegFromReg(PARAM_1_REG, PARAM_1_REX, HOST_CPU, true, 8); // CPU* param
 
     lockParamReg(PARAM_2_REG, PARAM_2_REX);
-    writeToRegFromValue(PARAM_2_REG, PARAM_2_REX, (U64)pfn, 8);
+    writeToRegFromHostPtr(PARAM_2_REG, PARAM_2_REX, (void*)pfn);
 
     lockParamReg(PARAM_3_REG, PARAM_3_REX);
     writeToRegFromValue(PARAM_3_REG, PARAM_3_REX, base, 4);
@@ -3599,7 +3733,7 @@ void X64Asm::lods16(void* pfn, U32 size, bool repeat, U32 base) {
     writeToRegFromReg(PARAM_1_REG, PARAM_1_REX, HOST_CPU, true, 8); // CPU* param
 
     lockParamReg(PARAM_2_REG, PARAM_2_REX);
-    writeToRegFromValue(PARAM_2_REG, PARAM_2_REX, (U64)pfn, 8);
+    writeToRegFromHostPtr(PARAM_2_REG, PARAM_2_REX, (void*)pfn);
 
     lockParamReg(PARAM_3_REG, PARAM_3_REX);
     writeToRegFromValue(PARAM_3_REG, PARAM_3_REX, base, 4);
@@ -3620,7 +3754,7 @@ void X64Asm::cmps16(void* pfn, U32 size, bool repeat, bool repeatZero, U32 base)
     writeToRegFromReg(PARAM_1_REG, PARAM_1_REX, HOST_CPU, true, 8); // CPU* param
 
     lockParamReg(PARAM_2_REG, PARAM_2_REX);
-    writeToRegFromValue(PARAM_2_REG, PARAM_2_REX, (U64)pfn, 8);
+    writeToRegFromHostPtr(PARAM_2_REG, PARAM_2_REX, (void*)pfn);
 
     lockParamReg(PARAM_3_REG, PARAM_3_REX);
     writeToRegFromValue(PARAM_3_REG, PARAM_3_REX, (U32)repeatZero?1:0, 4);
@@ -3758,7 +3892,7 @@ void X64Asm::callFpuWithAddressWrite(PFN_FPU_ADDRESS pfn, U8 rm, U32 len) {
     writeToRegFromReg(PARAM_1_REG, PARAM_1_REX, HOST_CPU, true, 8); // CPU* param
 
     lockParamReg(PARAM_2_REG, PARAM_2_REX);
-    writeToRegFromValue(PARAM_2_REG, PARAM_2_REX, (U64)pfn, 8);
+    writeToRegFromHostPtr(PARAM_2_REG, PARAM_2_REX, (void*)pfn);
 
     lockParamReg(PARAM_3_REG, PARAM_3_REX);
     writeToRegFromValue(PARAM_3_REG, PARAM_3_REX, len, 4);
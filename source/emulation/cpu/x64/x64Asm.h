@@ -28,6 +28,8 @@
 
 #define CPU_OFFSET_MEM (U32)(offsetof(x64CPU, memOffset))
 #define CPU_OFFSET_NEG_MEM (U32)(offsetof(x64CPU, negMemOffset))
+#define CPU_OFFSET_MEM_OFFSETS (U32)(offsetof(x64CPU, memOffsets))
+#define CPU_OFFSET_NATIVE_FLAGS (U32)(offsetof(x64CPU, nativeFlags))
 #define CPU_OFFSET_OP_PAGES (U32)(offsetof(x64CPU, eipToHostInstructionPages))
 #define CPU_OFFSET_EIP_HOST_MAPPING (U32)(offsetof(x64CPU, eipToHostInstructionAddressSpaceMapping))
 
@@ -99,6 +101,7 @@ public:
     void loopz(U32 eip, bool ea16);
     void loopnz(U32 eip, bool ea16);
     void jumpTo(U32 eip);
+    void resolveJumpFixups();
     void jmp(bool big, U32 sel, U32 offset, U32 oldEip);
     void call(bool big, U32 sel, U32 offset, U32 oldEip);
     void retn16(U32 bytes);
@@ -121,6 +124,7 @@ public:
     void bswapSp();
     void string32(bool hasSi, bool hasDi);
     void writeToRegFromValue(U8 reg, bool isRexReg, U64 value, U8 bytes);
+    void writeToRegFromHostPtr(U8 reg, bool isRexReg, void* value);
     void enter(bool big, U32 bytes, U32 level);
     void leave(bool big);
     void callE(bool big, U8 rm);
@@ -217,6 +221,8 @@ private:
     void zeroReg(U8 reg, bool isRexReg, bool keepFlags);
     void doMemoryInstruction(U8 op, U8 reg1, bool isReg1Rex, U8 reg2, bool isReg2Rex, S8 reg3, bool isReg3Rex, U8 reg3Shift, S32 displacement, U8 bytes);
     void writeHostPlusTmp(U8 rm, bool checkG, bool isG8bit, bool isE8bit, U8 tmpReg);
+    // the memory operand must be built with writeHostPlusTmp so that it can check or remap the address
+    bool needsHostPlusTmp() {return this->useMemOffsets || this->checkCodePageWrite;}
     U8 getRegForSeg(U8 base, U8 tmpReg);
     U8 getRegForNegSeg(U8 base, U8 tmpReg);
     void translateMemory16(U32 rm, bool checkG, bool isG8bit, bool isE8bit, S8 r1, S8 r2, S16 disp, U8 seg);    
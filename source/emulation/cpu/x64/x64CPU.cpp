@@ -11,6 +11,8 @@
 #include "knativethread.h"
 #include "knativesystem.h"
 #include "../binaryTranslation/btCodeMemoryWrite.h"
+#include "x64CodeCache.h"
+#include "x64Translator.h"
 
 CPU* CPU::allocCPU() {
     return new x64CPU();
@@ -38,6 +40,8 @@ void x64CPU::run() {
     while (true) {
         this->memOffset = this->thread->process->memory->id;
         this->negMemOffset = (U64)(-(S64)this->memOffset);
+        this->memOffsets = this->thread->process->memory->memOffsets;
+        this->nativeFlags = this->thread->process->memory->nativeFlags;
         for (int i=0;i<6;i++) {
             this->negSegAddress[i] = (U32)(-((S32)(this->seg[i].address)));
         }
@@ -77,6 +81,8 @@ void x64CPU::run() {
 void x64CPU::restart() {
 	this->memOffset = this->thread->process->memory->id;
 	this->negMemOffset = (U64)(-(S64)this->memOffset);
+	this->memOffsets = this->thread->process->memory->memOffsets;
+	this->nativeFlags = this->thread->process->memory->nativeFlags;
 	for (int i = 0; i < 6; i++) {
 		this->negSegAddress[i] = (U32)(-((S32)(this->seg[i].address)));
 	}
@@ -120,7 +126,6 @@ void* x64CPU::init() {
     data.writeToRegFromValue(6, false, ESI, 4);
     data.writeToRegFromValue(7, false, EDI, 4);        
     
-    data.calculatedEipLen = 1; // will force the long x64 chunk jump
     data.doJmp(false);
     std::shared_ptr<BtCodeChunk> chunk = data.commit(true);
     result = chunk->getHostAddress();
@@ -177,44 +182,26 @@ std::shared_ptr<BtCodeChunk> x64CPU::translateChunk(U32 ip) {
 }
 
 std::shared_ptr<BtCodeChunk> x64CPU::translateChunk(X64Asm* parent, U32 ip) {
-    X64Asm data1(this);
-    data1.ip = ip;
-    data1.startOfDataIp = ip;       
-    data1.parent = parent;
-    translateData(&data1);
+    std::shared_ptr<BtCodeChunk> cachedChunk = X64CodeCache::load(this, ip);
+    if (cachedChunk) {
+        return cachedChunk;
+    }
+    U8 segsBeforeTranslation = X64CodeCache::getSegMask(this);
 
     X64Asm data(this);
     data.ip = ip;
-    data.startOfDataIp = ip;  
-    data.calculatedEipLen = data1.ip - data1.startOfDataIp;
+    data.startOfDataIp = ip;       
     data.parent = parent;
-    translateData(&data, &data1);        
-    S32 failedJumpOpIndex = this->preLinkCheck(&data);
+    translateData(&data);
+    data.resolveJumpFixups();
+    return this->commitChunk(&data, segsBeforeTranslation);
+}
 
-    if (failedJumpOpIndex==-1) {
-        std::shared_ptr<BtCodeChunk> chunk = data.commit(false);
-        link(&data, chunk);
-        return chunk;
-    } else {
-        X64Asm data2(this);
-        data2.ip = ip;
-        data2.startOfDataIp = ip;       
-        data2.parent = parent;
-        data2.stopAfterInstruction = failedJumpOpIndex;
-        translateData(&data2);
-
-        X64Asm data3(this);
-        data3.ip = ip;
-        data3.startOfDataIp = ip;  
-        data3.calculatedEipLen = data2.ip - data2.startOfDataIp;
-        data3.parent = parent;
-        data3.stopAfterInstruction = failedJumpOpIndex;
-        translateData(&data3, &data2);
-
-        std::shared_ptr<BtCodeChunk> chunk = data3.commit(false);
-        link(&data3, chunk);
-        return chunk;
-    }    
+std::shared_ptr<BtCodeChunk> x64CPU::commitChunk(X64Asm* data, U8 segsBeforeTranslation) {
+    std::shared_ptr<BtCodeChunk> chunk = data->commit(false);
+    link(data, chunk);
+    X64CodeCache::save(this, data, segsBeforeTranslation);
+    return chunk;
 }
 
 void* x64CPU::translateEipInternal(X64Asm* parent, U32 ip) {
@@ -238,8 +225,8 @@ void x64CPU::postTestRun() {
         reg_mmx[i].q = *((U64*)(fpuState + 32 + i * 16));
     }
     for (int i = 0; i < 8; i++) {
-        xmm[i].pi.u64[0] = *((U64*)(fpuState + 160 + i * 16));
-        xmm[i].pi.u64[1] = *((U64*)(fpuState + 160 + i * 16 + 8));
+        xmm[i].u64[0] = *((U64*)(fpuState + 160 + i * 16));
+        xmm[i].u64[1] = *((U64*)(fpuState + 160 + i * 16 + 8));
     }
 }
 
@@ -250,28 +237,6 @@ void x64CPU::addReturnFromTest() {
 }
 #endif
 
-S32 x64CPU::preLinkCheck(X64Asm* data) {
-    for (S32 i=0;i<(S32)data->todoJump.size();i++) {
-        U32 eip = this->seg[CS].address+data->todoJump[i].eip;        
-        U8 size = data->todoJump[i].offsetSize;
-
-        if (size==4 && data->todoJump[i].sameChunk) {
-            bool found = false;
-
-            for (U32 ip=0;ip<data->ipAddressCount;ip++) {
-                if (data->ipAddress[ip] == eip) {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) {
-                return data->todoJump[i].opIndex;
-            }
-        }
-    }
-    return -1;
-}
-
 void x64CPU::link(X64Asm* data, std::shared_ptr<BtCodeChunk>& fromChunk, U32 offsetIntoChunk) {
     U32 i;
     if (!fromChunk) {
@@ -297,6 +262,7 @@ void x64CPU::link(X64Asm* data, std::shared_ptr<BtCodeChunk>& fromChunk, U32 off
                 std::shared_ptr<X64CodeChunk> chunk = std::make_shared<X64CodeChunk>(1, &eip, &hostIndex, &op, 1, eip-this->seg[CS].address, 1, false);
                 chunk->makeLive();
                 toHostAddress = (U8*)chunk->getHostAddress();            
+                X64Translator::queueStub(this, chunk);
             }
             std::shared_ptr<BtCodeChunk> toChunk = this->thread->memory->getCodeChunkContainingHostAddress(toHostAddress);
             if (!toChunk) {
@@ -315,6 +281,7 @@ void x64CPU::link(X64Asm* data, std::shared_ptr<BtCodeChunk>& fromChunk, U32 off
                 std::shared_ptr<X64CodeChunk> chunk = std::make_shared<X64CodeChunk>(1, &eip, &hostIndex, returnData.buffer, returnData.bufferPos, eip - this->seg[CS].address, 1, false);
                 chunk->makeLive();
                 toHostAddress = (U8*)chunk->getHostAddress();
+                X64Translator::queueStub(this, chunk);
             }
             std::shared_ptr<BtCodeChunk> toChunk = this->thread->memory->getCodeChunkContainingHostAddress(toHostAddress);
             if (!toChunk) {
@@ -359,8 +326,9 @@ void* x64CPU::translateEip(U32 ip) {
     return result;
 }
 
-void x64CPU::translateInstruction(X64Asm* data, X64Asm* firstPass) {
+void x64CPU::translateInstruction(X64Asm* data) {
     data->startOfOpIp = data->ip;  
+    data->useMemOffsets = this->isMappedHostOp(data->ip + this->seg[CS].address);
 #ifdef _DEBUG
     //data->logOp(data->ip);
     // just makes debugging the asm output easier
@@ -375,6 +343,13 @@ void x64CPU::translateInstruction(X64Asm* data, X64Asm* firstPass) {
         //data->addDynamicCheck(true);
 #endif
     }   
+    data->startOfOpBufferPos = data->bufferPos;
+    if (!this->thread->process->emulateFPU && this->isCodePageWriteOp(data->ip + this->seg[CS].address)) {
+        // x64_writeCodePage runs the op with the normal core, which only has the host x87 state after an exception
+        DecodedBlock* block = NormalCPU::getBlockForInspectionButNotUsed(data->ip + this->seg[CS].address, this->isBig());
+        data->checkCodePageWrite = !block->op->isFpuOp();
+        block->dealloc(false);
+    }
     while (1) {  
         data->op = data->fetch8();            
         data->inst = data->baseOp + data->op;        
@@ -385,9 +360,11 @@ void x64CPU::translateInstruction(X64Asm* data, X64Asm* firstPass) {
     data->tmp1InUse = false;
     data->tmp2InUse = false;
     data->tmp3InUse = false;
+    data->useMemOffsets = false;
+    data->checkCodePageWrite = false;
 }
 
-void x64CPU::translateData(X64Asm* data, X64Asm* firstPass) {
+void x64CPU::translateData(X64Asm* data) {
     U32 codePage = (data->ip+data->cpu->seg[CS].address) >> K_PAGE_SHIFT;
     U32 nativePage = this->thread->memory->getNativePage(codePage);
     if (this->thread->memory->dynamicCodePageUpdateCount[nativePage]==MAX_DYNAMIC_CODE_PAGE_COUNT) {
@@ -396,39 +373,40 @@ void x64CPU::translateData(X64Asm* data, X64Asm* firstPass) {
     while (1) {  
         U32 address = data->cpu->seg[CS].address+data->ip;
         void* hostAddress = this->thread->memory->getExistingHostAddress(address);
-        if (hostAddress) {
+        // the start never has code yet, except for the stub that a translator thread is decoding a replacement for
+        if (hostAddress && data->ip != data->startOfDataIp) {
             data->jumpTo(data->ip);
             break;
         }
-        if (firstPass) {
-            U32 nextEipLen = firstPass->calculateEipLen(data->ip+data->cpu->seg[CS].address);
-            U32 page = (data->ip+data->cpu->seg[CS].address+nextEipLen) >> K_PAGE_SHIFT;
-
-            if (page!=codePage) {
-                codePage = page;
-                nativePage = this->thread->memory->getNativePage(codePage);
-                if (data->dynamic) {                    
-                    if (this->thread->memory->dynamicCodePageUpdateCount[nativePage] == MAX_DYNAMIC_CODE_PAGE_COUNT) {
-                        // continue to cross from my dynamic page into another dynamic page
-                    } else {
-                        // we will continue to emit code that will self check for modified code, even though the page we spill into is not dynamic
-                    }
+        // the length of the next instruction isn't known until it is decoded, so assume the longest
+        U32 page = (address+K_MAX_X86_OP_LEN-1) >> K_PAGE_SHIFT;
+
+        if (page!=codePage) {
+            codePage = page;
+            nativePage = this->thread->memory->getNativePage(codePage);
+            if (data->dynamic) {                    
+                if (this->thread->memory->dynamicCodePageUpdateCount[nativePage] == MAX_DYNAMIC_CODE_PAGE_COUNT) {
+                    // continue to cross from my dynamic page into another dynamic page
                 } else {
-                    if (this->thread->memory->dynamicCodePageUpdateCount[nativePage] == MAX_DYNAMIC_CODE_PAGE_COUNT) {
-                        // we crossed a page boundry from a non dynamic page to a dynamic page
-                        data->dynamic = true; // the instructions from this point on will do their own check
-                    } else {
-                        // continue to cross from one non dynamic page into another non dynamic page
-                    }
+                    // we will continue to emit code that will self check for modified code, even though the page we spill into is not dynamic
+                }
+            } else {
+                if (this->thread->memory->dynamicCodePageUpdateCount[nativePage] == MAX_DYNAMIC_CODE_PAGE_COUNT) {
+                    // we crossed a page boundry from a non dynamic page to a dynamic page
+                    data->dynamic = true; // the instructions from this point on will do their own check
+                } else {
+                    // continue to cross from one non dynamic page into another non dynamic page
                 }
             }
         }
-        data->mapAddress(address, data->bufferPos);
-        translateInstruction(data, firstPass);
-        if (data->done) {
+        if (X64Translator::isBackgroundThread() && !X64Translator::isCodeReadable(this->thread->memory, address, K_MAX_X86_OP_LEN)) {
+            // the background translator can't handle a fault, the emulated thread will translate the rest if it gets here
+            data->jumpTo(data->ip);
             break;
         }
-        if (data->stopAfterInstruction!=-1 && (int)data->ipAddressCount==data->stopAfterInstruction) {
+        data->mapAddress(address, data->bufferPos);
+        translateInstruction(data);
+        if (data->done) {
             break;
         }
         data->resetForNewOp();
@@ -456,6 +434,75 @@ DecodedOp* x64CPU::getOp(U32 eip, bool existing) {
     return NULL;
 }
 
+// runs the op that writes to a code page with the normal core, any translated code it writes over is invalidated
+void x64CPU::runCodePatchOp(DecodedOp* op, U32 address, U64 rsi, U64 rdi, std::function<void(DecodedOp*)> doSyncFrom, std::function<void(DecodedOp*)> doSyncTo) {
+    // change permission of the page so that we can write to it
+    U32 len = instructionInfo[op->inst].writeMemWidth/8;
+    BtCodeMemoryWrite w(this);        
+    static DecodedBlock b;
+    DecodedBlock::currentBlock = &b;
+    b.next1 = &b;
+    b.next2 = &b;
+    // do the write
+    op->pfn = NormalCPU::getFunctionForOp(op);
+    op->next = DecodedOp::alloc();
+    op->next->inst = Done;
+    op->next->pfn = NormalCPU::getFunctionForOp(op->next);
+    if (doSyncFrom) {
+        doSyncFrom(op);
+    }
+
+    if (this->flags & DF) {
+        this->df = -1;
+    } else {
+        this->df = 1;
+    }
+    // for string instruction, we modify (add memory offset and segment) rdi and rsi so that the native string instruction can be used, this code will revert it back to the original values
+    // uses si
+    if (op->inst==Lodsb || op->inst==Lodsw || op->inst==Lodsd) {
+        THIS_ESI=(U32)(rsi - this->memOffset);
+        if (this->thread->process->hasSetSeg[op->base]) {
+            THIS_ESI-=this->seg[op->base].address;
+        }
+        // doesn't write            
+    }
+    // uses di (Examples: diablo 1 will trigger this in the middle of the Stosd when creating a new game)
+    else if (op->inst==Stosb || op->inst==Stosw || op->inst==Stosd ||
+        op->inst==Scasb || op->inst==Scasw || op->inst==Scasd) {
+        THIS_EDI=(U32)(rdi - this->memOffset);
+        if (this->thread->process->hasSetSeg[ES]) {
+            THIS_EDI-=this->seg[ES].address;
+        }
+        if (instructionInfo[op->inst].writeMemWidth) {
+            w.invalidateStringWriteToDi(op->repNotZero || op->repZero, instructionInfo[op->inst].writeMemWidth/8);
+        }
+    }
+    // uses si and di
+    else if (op->inst==Movsb || op->inst==Movsw || op->inst==Movsd ||
+        op->inst==Cmpsb || op->inst==Cmpsw || op->inst==Cmpsd) {
+        THIS_ESI=(U32)(rsi - this->memOffset);
+        THIS_EDI=(U32)(rdi - this->memOffset);
+        if (this->thread->process->hasSetSeg[ES]) {
+            THIS_EDI-=this->seg[ES].address;
+        }
+        if (this->thread->process->hasSetSeg[op->base]) {
+            THIS_ESI-=this->seg[op->base].address;
+        }
+        if (instructionInfo[op->inst].writeMemWidth) {
+            w.invalidateStringWriteToDi(op->repNotZero || op->repZero, instructionInfo[op->inst].writeMemWidth/8);
+        }
+    } else {
+        w.invalidateCode(address, len);
+    }  
+    FILE* f = (FILE*)this->logFile;
+    this->logFile = NULL;       
+    op->pfn(this, op);   
+    this->logFile = f;        
+    if (doSyncTo) {
+        doSyncTo(op);
+    }
+}
+
 U64 x64CPU::handleCodePatch(U64 rip, U32 address, U64 rsi, U64 rdi, std::function<void(DecodedOp*)> doSyncFrom, std::function<void(DecodedOp*)> doSyncTo) {
 #ifndef __TEST
     // only one thread at a time can update the host code pages and related date like opToAddressPages
@@ -468,71 +515,7 @@ U64 x64CPU::handleCodePatch(U64 rip, U32 address, U64 rsi, U64 rdi, std::functio
     // get the emulated op that caused the write
     DecodedOp* op = this->getOp(this->eip.u32, true);
     if (op) {             
-        // change permission of the page so that we can write to it
-        U32 len = instructionInfo[op->inst].writeMemWidth/8;
-        BtCodeMemoryWrite w(this);        
-        static DecodedBlock b;
-        DecodedBlock::currentBlock = &b;
-        b.next1 = &b;
-        b.next2 = &b;
-        // do the write
-        op->pfn = NormalCPU::getFunctionForOp(op);
-        op->next = DecodedOp::alloc();
-        op->next->inst = Done;
-        op->next->pfn = NormalCPU::getFunctionForOp(op->next);
-        if (doSyncFrom) {
-            doSyncFrom(op);
-        }
-
-        if (this->flags & DF) {
-            this->df = -1;
-        } else {
-            this->df = 1;
-        }
-        // for string instruction, we modify (add memory offset and segment) rdi and rsi so that the native string instruction can be used, this code will revert it back to the original values
-        // uses si
-        if (op->inst==Lodsb || op->inst==Lodsw || op->inst==Lodsd) {
-            THIS_ESI=(U32)(rsi - this->memOffset);
-            if (this->thread->process->hasSetSeg[op->base]) {
-                THIS_ESI-=this->seg[op->base].address;
-            }
-            // doesn't write            
-        }
-        // uses di (Examples: diablo 1 will trigger this in the middle of the Stosd when creating a new game)
-        else if (op->inst==Stosb || op->inst==Stosw || op->inst==Stosd ||
-            op->inst==Scasb || op->inst==Scasw || op->inst==Scasd) {
-            THIS_EDI=(U32)(rdi - this->memOffset);
-            if (this->thread->process->hasSetSeg[ES]) {
-                THIS_EDI-=this->seg[ES].address;
-            }
-            if (instructionInfo[op->inst].writeMemWidth) {
-                w.invalidateStringWriteToDi(op->repNotZero || op->repZero, instructionInfo[op->inst].writeMemWidth/8);
-            }
-        }
-        // uses si and di
-        else if (op->inst==Movsb || op->inst==Movsw || op->inst==Movsd ||
-            op->inst==Cmpsb || op->inst==Cmpsw || op->inst==Cmpsd) {
-            THIS_ESI=(U32)(rsi - this->memOffset);
-            THIS_EDI=(U32)(rdi - this->memOffset);
-            if (this->thread->process->hasSetSeg[ES]) {
-                THIS_EDI-=this->seg[ES].address;
-            }
-            if (this->thread->process->hasSetSeg[op->base]) {
-                THIS_ESI-=this->seg[op->base].address;
-            }
-            if (instructionInfo[op->inst].writeMemWidth) {
-                w.invalidateStringWriteToDi(op->repNotZero || op->repZero, instructionInfo[op->inst].writeMemWidth/8);
-            }
-        } else {
-            w.invalidateCode(address, len);
-        }  
-        FILE* f = (FILE*)this->logFile;
-        this->logFile = NULL;       
-        op->pfn(this, op);   
-        this->logFile = f;        
-        if (doSyncTo) {
-            doSyncTo(op);
-        }
+        this->runCodePatchOp(op, address, rsi, rdi, doSyncFrom, doSyncTo);
 
         // eip was ajusted after running this instruction                        
         U32 a = this->getEipAddress();
@@ -551,6 +534,85 @@ U64 x64CPU::handleCodePatch(U64 rip, U32 address, U64 rsi, U64 rdi, std::functio
     return 0;
 }
 
+// runs the op with handleCodePatch and counts the fault against it, once the op has faulted limit times its chunk is
+// retranslated so that isMappedHostOp/isCodePageWriteOp will change how the op is translated
+U64 x64CPU::handleCountedCodePatch(std::unordered_map<U32, U32>& opFaults, U32 limit, U64 rip, U32 address, U64 rsi, U64 rdi, std::function<void(DecodedOp*)> doSyncFrom, std::function<void(DecodedOp*)> doSyncTo) {
+#ifndef __TEST
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->thread->memory->executableMemoryMutex);
+#endif
+    std::shared_ptr<BtCodeChunk> chunk = this->thread->memory->getCodeChunkContainingHostAddress((void*)rip);
+    U32 opAddress = chunk->getEipThatContainsHostAddress((void*)rip, NULL, NULL);
+    U64 result = this->handleCodePatch(rip, address, rsi, rdi, doSyncFrom, doSyncTo);
+    bool reachedLimit;
+    {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->thread->memory->opFaultsMutex);
+        U32& faults = opFaults[opAddress];
+        reachedLimit = faults < limit && ++faults == limit;
+    }
+    if (reachedLimit) {
+        // the op might have invalidated its own chunk
+        chunk = this->thread->memory->getCodeChunkContainingEip(opAddress);
+        if (chunk) {
+            chunk->releaseAndRetranslate();
+        }
+        // the host address handleCodePatch returned might have been in the chunk that was just released
+        result = (U64)this->thread->memory->getExistingHostAddress(this->getEipAddress());
+        if (!result) {
+            result = (U64)this->translateEip(this->eip.u32);
+        }
+    }
+    return result;
+}
+
+static bool isFaultingOp(Memory* memory, std::unordered_map<U32, U32>& faults, U32 address, U32 limit) {
+    // translator threads decode without executableMemoryMutex
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(memory->opFaultsMutex);
+    if (faults.empty()) {
+        return false;
+    }
+    auto it = faults.find(address);
+    return it != faults.end() && it->second >= limit;
+}
+
+bool x64CPU::isMappedHostOp(U32 address) {
+    return isFaultingOp(this->thread->memory, this->thread->memory->mappedHostFaults, address, X64_MAPPED_HOST_FAULT_LIMIT);
+}
+
+bool x64CPU::isCodePageWriteOp(U32 address) {
+    return isFaultingOp(this->thread->memory, this->thread->memory->codePageWriteFaults, address, X64_CODE_PAGE_WRITE_FAULT_LIMIT);
+}
+
+#ifdef __TEST
+U32 lastWriteCodePageAddress;
+#endif
+
+// called from the translated code of an op that was translated with checkCodePageWrite when the page it writes to is
+// read-only because it has code, this does the same thing as the exception would have without the signal.  The
+// registers were already synced and the translated code will jump to the new eip.
+void x64CPU::writeCodePage(U32 address) {
+#ifdef __TEST
+    lastWriteCodePageAddress = address;
+#else
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->thread->memory->executableMemoryMutex);
+#endif
+    DecodedOp* op = this->getOp(this->eip.u32, true);
+    if (!op) {
+        kpanic("x64CPU::writeCodePage could not decode the op at %x", this->getEipAddress());
+    }
+    this->lazyFlags = FLAGS_NONE;
+    for (int i = 0; i < 8; i++) {
+        this->reg_mmx[i].q = *((U64*)(this->fpuState + 32 + i * 16));
+        memcpy(&this->xmm[i], this->fpuState + 160 + i * 16, 16);
+    }
+    this->runCodePatchOp(op, address, 0, 0, NULL, NULL);
+    this->fillFlags();
+    for (int i = 0; i < 8; i++) {
+        *((U64*)(this->fpuState + 32 + i * 16)) = this->reg_mmx[i].q;
+        memcpy(this->fpuState + 160 + i * 16, &this->xmm[i], 16);
+    }
+    op->dealloc(true);
+}
+
 U64 x64CPU::handleChangedUnpatchedCode(U64 rip) {
 #ifndef __TEST
     // only one thread at a time can update the host code pages and related date like opToAddressPages
@@ -633,11 +695,11 @@ U64 x64CPU::handleAccessException(U64 rip, U64 address, bool readAddress, std::f
         U32 emulatedAddress = (U32)address;
         U32 page = emulatedAddress >> K_PAGE_SHIFT;
         if (this->thread->memory->flags[page] & PAGE_MAPPED_HOST) {
-            // if this ends up being too slow for each read/write, perhaps the code block could be changed to use
-            // memory->memOffsets[page] instead of memory->id
-            //
-            // Fire Fight and Age of Empires will hammer this code
-            return this->handleCodePatch(rip, emulatedAddress, getReg(6), getReg(7), doSyncFrom, doSyncTo);
+            // Fire Fight and Age of Empires will hammer this code.  The op is run by the normal core each time, once it
+            // has faulted X64_MAPPED_HOST_FAULT_LIMIT times it is retranslated to look up memory->memOffsets[page]
+            // instead of assuming memory->id.  Only modrm memory operands are converted, string ops and push/pop keep
+            // coming through here.
+            return this->handleCountedCodePatch(this->thread->memory->mappedHostFaults, X64_MAPPED_HOST_FAULT_LIMIT, rip, emulatedAddress, getReg(6), getReg(7), doSyncFrom, doSyncTo);
         }
     }
 
@@ -671,8 +733,10 @@ U64 x64CPU::handleAccessException(U64 rip, U64 address, bool readAddress, std::f
             
             // check if emulated memory that caused the exception is a page that has code
             if (this->thread->memory->nativeFlags[emulatedAddress>>K_PAGE_SHIFT] & NATIVE_FLAG_CODEPAGE_READONLY) {                    
-                dynamicCodeExceptionCount++;                    
-                return this->handleCodePatch(rip, emulatedAddress, getReg(6), getReg(7), doSyncFrom, doSyncTo);                    
+                dynamicCodeExceptionCount++;
+                // an op that keeps writing to a page with code, usually data that shares the page, is retranslated
+                // to check the page flags itself and call x64_writeCodePage instead of taking a signal
+                return this->handleCountedCodePatch(this->thread->memory->codePageWriteFaults, X64_CODE_PAGE_WRITE_FAULT_LIMIT, rip, emulatedAddress, getReg(6), getReg(7), doSyncFrom, doSyncTo);
             }
         }   
 #ifdef _DEBUG
@@ -753,6 +817,9 @@ void x64CPU::startThread() {
     }
     std::shared_ptr<KProcess> process = thread->process;
 	process->deleteThread(thread);
+    // the free lists are per thread
+    DecodedOp::releaseThreadCache();
+    NormalCPU::releaseThreadCache();
 
     platformThreadCount--;
     if (platformThreadCount==0) {
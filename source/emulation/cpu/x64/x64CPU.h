@@ -8,6 +8,11 @@
 
 class X64Asm;
 
+// an op that faults this many times on PAGE_MAPPED_HOST memory is retranslated to look up memOffsets instead of using memOffset
+#define X64_MAPPED_HOST_FAULT_LIMIT 16
+// an op that faults this many times writing to a page with code is retranslated to check the page before it writes
+#define X64_CODE_PAGE_WRITE_FAULT_LIMIT 16
+
 class x64CPU : public BtCPU {
 public:
     x64CPU();
@@ -24,6 +29,8 @@ public:
 
     U64 memOffset;
     U64 negMemOffset;
+    U64* memOffsets;
+    U8* nativeFlags;
     U64 exceptionRSP;
     U64 exceptionRSI;
     U64 exceptionRDI;
@@ -54,18 +61,23 @@ public:
     void addReturnFromTest();
 #endif
 
-    void translateInstruction(X64Asm* data, X64Asm* firstPass);    
+    void translateInstruction(X64Asm* data);    
     void link(X64Asm* data, std::shared_ptr<BtCodeChunk>& fromChunk, U32 offsetIntoChunk=0);
-    S32 preLinkCheck(X64Asm* data); // returns the index of the jump that failed
     virtual void makePendingCodePagesReadOnly();
     virtual std::shared_ptr<BtCodeChunk> translateChunk(U32 ip);
-    void translateData(X64Asm* data, X64Asm* firstPass=NULL);
+    void translateData(X64Asm* data);
     std::shared_ptr<BtCodeChunk> translateChunk(X64Asm* parent, U32 ip);
+    std::shared_ptr<BtCodeChunk> commitChunk(X64Asm* data, U8 segsBeforeTranslation); // executableMemoryMutex must be held
 
     U64 reTranslateChunk();
     U64 handleChangedUnpatchedCode(U64 rip);
     U64 handleCodePatch(U64 rip, U32 address, U64 rsi, U64 rdi, std::function<void(DecodedOp*)> doSyncFrom, std::function<void(DecodedOp*)> doSyncTo);
     U64 handleMissingCode(U64 r8, U64 r9, U32 inst);
+    U64 handleCountedCodePatch(std::unordered_map<U32, U32>& opFaults, U32 limit, U64 rip, U32 address, U64 rsi, U64 rdi, std::function<void(DecodedOp*)> doSyncFrom, std::function<void(DecodedOp*)> doSyncTo);
+    void runCodePatchOp(DecodedOp* op, U32 address, U64 rsi, U64 rdi, std::function<void(DecodedOp*)> doSyncFrom, std::function<void(DecodedOp*)> doSyncTo);
+    void writeCodePage(U32 address);
+    bool isMappedHostOp(U32 address);
+    bool isCodePageWriteOp(U32 address);
     U64 handleAccessException(U64 ip, U64 address, bool readAddress, std::function<U64(U32 reg)>getReg, std::function<void(U32 reg, U64 value)>setReg, std::function<void(DecodedOp*)> doSyncFrom, std::function<void(DecodedOp*)> doSyncTo); // returns new ip, if 0 then don't set ip, but continue execution
 
     virtual U64 handleIllegalInstruction(U64 rip);
@@ -0,0 +1,418 @@
+#include "boxedwine.h"
+
+#ifdef BOXEDWINE_X64
+#include "x64CodeCache.h"
+#include "x64Asm.h"
+#include "x64CodeChunk.h"
+#include "x64Translator.h"
+#include "crc.h"
+
+#define X64_CODE_CACHE_MAGIC 0x43435842
+#define X64_CODE_CACHE_VERSION 1
+
+std::string X64CodeCache::path;
+U32 X64CodeCache::hits;
+U32 X64CodeCache::misses;
+U32 X64CodeCache::invalidations;
+
+class X64CodeCacheEntry {
+public:
+    U32 eip; // relative to cs
+    U32 eipLen;
+    U32 crc; // crc of the emulated code bytes the chunk was translated from
+    U32 cs;
+    U8 emulateFPU;
+    U8 segsBefore;
+    U8 segsAfter; // translating can set KProcess::hasSetSeg, this is replayed when the chunk is loaded
+    std::vector<U32> ipAddress;
+    std::vector<U32> ipAddressBufferPos;
+    std::vector<U8> code; // code before linking, host pointers in it are stored relative to x64CodeCacheAnchor
+    std::vector<TodoJump> todoJump;
+    std::vector<U32> relocations;
+};
+
+class X64CodeCacheModule {
+public:
+    X64CodeCacheModule() : file(NULL), staleCount(0) {}
+    FILE* file;
+    U32 staleCount; // entries in the file that were replaced or invalidated since it was last written from scratch
+    std::unordered_map<U32, std::shared_ptr<X64CodeCacheEntry>> entries; // key is the emulated address of the chunk
+};
+
+static std::unordered_map<std::string, std::shared_ptr<X64CodeCacheModule>> modules;
+static BOXEDWINE_MUTEX modulesMutex;
+
+// every pointer into the Boxedwine image is saved as an offset to this function
+static void x64CodeCacheAnchor() {
+}
+
+static U64 getAnchor() {
+    return (U64)(void*)x64CodeCacheAnchor;
+}
+
+static U32 getBuildId() {
+    // host pointers and offsets into CPU are only valid for the build that saved them.  0 means the executable
+    // couldn't be read, in that case nothing is loaded from or saved to disk.
+    static U32 buildId = crc32File(Platform::getExecutableFilePath());
+    return buildId;
+}
+
+static U32 getHostFlags() {
+    return (KSystem::useLargeAddressSpace ? 1 : 0) | (x64CPU::hasBMI2 ? 2 : 0);
+}
+
+static std::string getCacheFilePath(const std::string& modulePath) {
+    std::string name = modulePath;
+    for (auto& c : name) {
+        if (c == '/' || c == '\\' || c == ':') {
+            c = '_';
+        }
+    }
+    return X64CodeCache::path + "/" + name + ".x64cache";
+}
+
+static void writeU32(FILE* f, U32 value) {
+    fwrite(&value, sizeof(U32), 1, f);
+}
+
+static bool readU32(FILE* f, U32* value) {
+    return fread(value, sizeof(U32), 1, f) == 1;
+}
+
+static void writeU32Vector(FILE* f, const std::vector<U32>& v) {
+    writeU32(f, (U32)v.size());
+    if (v.size()) {
+        fwrite(v.data(), sizeof(U32), v.size(), f);
+    }
+}
+
+static bool readU32Vector(FILE* f, std::vector<U32>& v) {
+    U32 count;
+    if (!readU32(f, &count) || count > 0x100000) {
+        return false;
+    }
+    v.resize(count);
+    return count == 0 || fread(v.data(), sizeof(U32), count, f) == count;
+}
+
+static void writeEntry(FILE* f, const std::shared_ptr<X64CodeCacheEntry>& entry) {
+    writeU32(f, entry->eip);
+    writeU32(f, entry->eipLen);
+    writeU32(f, entry->crc);
+    writeU32(f, entry->cs);
+    writeU32(f, entry->emulateFPU | (entry->segsBefore << 8) | (entry->segsAfter << 16));
+    writeU32Vector(f, entry->ipAddress);
+    writeU32Vector(f, entry->ipAddressBufferPos);
+    writeU32(f, (U32)entry->code.size());
+    fwrite(entry->code.data(), 1, entry->code.size(), f);
+    writeU32(f, (U32)entry->todoJump.size());
+    for (auto& jump : entry->todoJump) {
+        writeU32(f, jump.eip);
+        writeU32(f, jump.bufferPos);
+        writeU32(f, jump.offsetSize | (jump.sameChunk ? 0x100 : 0));
+        writeU32(f, jump.opIndex);
+    }
+    writeU32Vector(f, entry->relocations);
+}
+
+static std::shared_ptr<X64CodeCacheEntry> readEntry(FILE* f) {
+    std::shared_ptr<X64CodeCacheEntry> entry = std::make_shared<X64CodeCacheEntry>();
+    U32 flags;
+    U32 count;
+
+    if (!readU32(f, &entry->eip) || !readU32(f, &entry->eipLen) || !readU32(f, &entry->crc) || !readU32(f, &entry->cs) || !readU32(f, &flags)) {
+        return NULL;
+    }
+    entry->emulateFPU = (U8)flags;
+    entry->segsBefore = (U8)(flags >> 8);
+    entry->segsAfter = (U8)(flags >> 16);
+    if (!readU32Vector(f, entry->ipAddress) || !readU32Vector(f, entry->ipAddressBufferPos) || entry->ipAddress.size() != entry->ipAddressBufferPos.size()) {
+        return NULL;
+    }
+    if (!readU32(f, &count) || count > 0x100000) {
+        return NULL;
+    }
+    entry->code.resize(count);
+    if (count && fread(entry->code.data(), 1, count, f) != count) {
+        return NULL;
+    }
+    if (!readU32(f, &count) || count > 0x100000) {
+        return NULL;
+    }
+    for (U32 i = 0; i < count; i++) {
+        U32 eip, bufferPos, size, opIndex;
+        if (!readU32(f, &eip) || !readU32(f, &bufferPos) || !readU32(f, &size) || !readU32(f, &opIndex)) {
+            return NULL;
+        }
+        entry->todoJump.push_back(TodoJump(eip, bufferPos, (U8)size, (size & 0x100) != 0, opIndex));
+    }
+    if (!readU32Vector(f, entry->relocations)) {
+        return NULL;
+    }
+    for (auto& pos : entry->relocations) {
+        if (pos + 8 > entry->code.size()) {
+            return NULL;
+        }
+    }
+    return entry;
+}
+
+static void writeHeader(FILE* f) {
+    writeU32(f, X64_CODE_CACHE_MAGIC);
+    writeU32(f, X64_CODE_CACHE_VERSION);
+    writeU32(f, getBuildId());
+    writeU32(f, getHostFlags());
+    fflush(f);
+}
+
+// rewrites the file with only the entries that are still used, otherwise it would keep growing every time code is
+// invalidated and translated again.  Caller must hold modulesMutex, this closes module->file.
+static bool compactModule(const std::string& modulePath, const std::shared_ptr<X64CodeCacheModule>& module) {
+    std::string filePath = getCacheFilePath(modulePath);
+    std::string tmpPath = filePath + ".tmp";
+
+    if (module->file) {
+        fclose(module->file);
+        module->file = NULL;
+    }
+    FILE* f = fopen(tmpPath.c_str(), "wb");
+    if (!f) {
+        return false;
+    }
+    writeHeader(f);
+    for (auto& it : module->entries) {
+        writeEntry(f, it.second);
+    }
+    fclose(f);
+    remove(filePath.c_str());
+    if (rename(tmpPath.c_str(), filePath.c_str()) != 0) {
+        klog("x64 code cache: could not replace %s", filePath.c_str());
+        return false;
+    }
+    module->staleCount = 0;
+    return true;
+}
+
+// caller must hold modulesMutex
+static std::shared_ptr<X64CodeCacheModule> getModule(const std::string& modulePath) {
+    std::shared_ptr<X64CodeCacheModule> module = modules[modulePath];
+    if (module) {
+        return module;
+    }
+    module = std::make_shared<X64CodeCacheModule>();
+    modules[modulePath] = module;
+    if (!getBuildId()) {
+        return module;
+    }
+
+    std::string filePath = getCacheFilePath(modulePath);
+    FILE* f = fopen(filePath.c_str(), "rb");
+    bool valid = false;
+    if (f) {
+        U32 magic = 0, version = 0, buildId = 0, hostFlags = 0;
+        if (readU32(f, &magic) && readU32(f, &version) && readU32(f, &buildId) && readU32(f, &hostFlags) && magic == X64_CODE_CACHE_MAGIC && version == X64_CODE_CACHE_VERSION && buildId == getBuildId() && hostFlags == getHostFlags()) {
+            valid = true;
+            while (true) {
+                // a partially written entry at the end of the file will be ignored
+                std::shared_ptr<X64CodeCacheEntry> entry = readEntry(f);
+                if (!entry) {
+                    break;
+                }
+                std::shared_ptr<X64CodeCacheEntry>& existing = module->entries[entry->cs + entry->eip];
+                if (existing) {
+                    // saved again after it was invalidated, the last one wins
+                    module->staleCount++;
+                }
+                existing = entry;
+            }
+        }
+        fclose(f);
+    }
+    if (valid && module->staleCount && !compactModule(modulePath, module)) {
+        // Boxedwine didn't shut down cleanly last time and the file couldn't be rewritten
+        valid = false;
+    }
+    if (valid) {
+        module->file = fopen(filePath.c_str(), "ab");
+    } else {
+        // missing or from a different build, start over
+        module->file = fopen(filePath.c_str(), "wb");
+        if (module->file) {
+            writeHeader(module->file);
+        }
+    }
+    if (!module->file) {
+        klog("x64 code cache: could not open %s", filePath.c_str());
+    }
+    return module;
+}
+
+U8 X64CodeCache::getSegMask(x64CPU* cpu) {
+    U8 result = 0;
+    for (int i = 0; i < 6; i++) {
+        if (cpu->thread->process->hasSetSeg[i]) {
+            result |= (1 << i);
+        }
+    }
+    return result;
+}
+
+static bool isCodeCacheable(x64CPU* cpu, U32 address, U32 len) {
+    Memory* memory = cpu->thread->memory;
+
+    // the crc reads the whole range and load can be called from a translator thread, which can't handle a fault
+    if (!X64Translator::isCodeReadable(memory, address, len)) {
+        return false;
+    }
+    U32 startPage = memory->getNativePage(address >> K_PAGE_SHIFT);
+    U32 endPage = memory->getNativePage((address + len - 1) >> K_PAGE_SHIFT);
+    for (U32 page = startPage; page <= endPage; page++) {
+        // self modifying code will be checked at run time, there is no point in caching it
+        if (memory->dynamicCodePageUpdateCount[page] == MAX_DYNAMIC_CODE_PAGE_COUNT) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static U32 getCodeCrc(U32 address, U32 len) {
+    std::vector<U8> bytes(len);
+    readMemory(bytes.data(), address, len);
+    return crc32b(bytes.data(), len);
+}
+
+std::shared_ptr<BtCodeChunk> X64CodeCache::load(x64CPU* cpu, U32 ip) {
+    if (!X64CodeCache::path.length() || !cpu->isBig()) {
+        return NULL;
+    }
+    U32 address = cpu->seg[CS].address + ip;
+    std::string modulePath = cpu->thread->process->getModulePath(address);
+    if (!modulePath.length()) {
+        return NULL;
+    }
+    std::shared_ptr<X64CodeCacheEntry> entry;
+    {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(modulesMutex);
+        std::shared_ptr<X64CodeCacheModule> module = getModule(modulePath);
+        auto it = module->entries.find(address);
+        if (it == module->entries.end()) {
+            X64CodeCache::misses++;
+            return NULL;
+        }
+        entry = it->second;
+        if (entry->cs != cpu->seg[CS].address || entry->segsBefore != X64CodeCache::getSegMask(cpu) || entry->emulateFPU != (cpu->thread->process->emulateFPU ? 1 : 0) || !entry->eipLen || !entry->ipAddress.size()) {
+            X64CodeCache::misses++;
+            return NULL;
+        }
+        if (!isCodeCacheable(cpu, address, entry->eipLen) || getCodeCrc(address, entry->eipLen) != entry->crc) {
+            // the module was updated or the code was patched after it was loaded
+            X64CodeCache::invalidations++;
+            module->entries.erase(it);
+            module->staleCount++;
+            return NULL;
+        }
+    }
+    // the chunk might overlap code that was already translated starting at a different eip, or it might contain an op
+    // that needs to be translated differently because it keeps accessing host mapped memory or pages with code
+    for (auto& eip : entry->ipAddress) {
+        if (cpu->thread->memory->getExistingHostAddress(eip) || cpu->isMappedHostOp(eip) || cpu->isCodePageWriteOp(eip)) {
+            BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(modulesMutex);
+            X64CodeCache::misses++;
+            return NULL;
+        }
+    }
+
+    X64Asm data(cpu);
+    data.ip = entry->eip + entry->eipLen;
+    data.startOfDataIp = entry->eip;
+    for (U32 i = 0; i < entry->ipAddress.size(); i++) {
+        data.mapAddress(entry->ipAddress[i], entry->ipAddressBufferPos[i]);
+    }
+    for (auto& b : entry->code) {
+        data.write8(b);
+    }
+    U64 anchor = getAnchor();
+    for (auto& pos : entry->relocations) {
+        U64 value;
+        memcpy(&value, data.buffer + pos, 8);
+        data.write64Buffer(data.buffer + pos, value + anchor);
+    }
+    data.todoJump = entry->todoJump;
+    for (int i = 0; i < 6; i++) {
+        if (entry->segsAfter & (1 << i)) {
+            cpu->thread->process->hasSetSeg[i] = true;
+        }
+    }
+    std::shared_ptr<BtCodeChunk> chunk = data.commit(false);
+    cpu->link(&data, chunk);
+    {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(modulesMutex);
+        X64CodeCache::hits++;
+    }
+    return chunk;
+}
+
+void X64CodeCache::save(x64CPU* cpu, X64Asm* data, U8 segsBeforeTranslation) {
+    if (!X64CodeCache::path.length() || !cpu->isBig() || data->dynamic) {
+        return;
+    }
+    U32 address = cpu->seg[CS].address + data->startOfDataIp;
+    U32 eipLen = data->ip - data->startOfDataIp;
+    if (!eipLen || !isCodeCacheable(cpu, address, eipLen)) {
+        return;
+    }
+    std::string modulePath = cpu->thread->process->getModulePath(address);
+    if (!modulePath.length()) {
+        return;
+    }
+    std::shared_ptr<X64CodeCacheEntry> entry = std::make_shared<X64CodeCacheEntry>();
+    entry->eip = data->startOfDataIp;
+    entry->eipLen = eipLen;
+    entry->crc = getCodeCrc(address, eipLen);
+    entry->cs = cpu->seg[CS].address;
+    entry->emulateFPU = cpu->thread->process->emulateFPU ? 1 : 0;
+    entry->segsBefore = segsBeforeTranslation;
+    entry->segsAfter = X64CodeCache::getSegMask(cpu);
+    entry->ipAddress.assign(data->ipAddress, data->ipAddress + data->ipAddressCount);
+    entry->ipAddressBufferPos.assign(data->ipAddressBufferPos, data->ipAddressBufferPos + data->ipAddressCount);
+    entry->code.assign(data->buffer, data->buffer + data->bufferPos);
+    entry->todoJump = data->todoJump;
+    entry->relocations = data->relocations;
+
+    U64 anchor = getAnchor();
+    for (auto& pos : entry->relocations) {
+        U64 value;
+        memcpy(&value, entry->code.data() + pos, 8);
+        data->write64Buffer(entry->code.data() + pos, value - anchor);
+    }
+
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(modulesMutex);
+    std::shared_ptr<X64CodeCacheModule> module = getModule(modulePath);
+    std::shared_ptr<X64CodeCacheEntry>& existing = module->entries[address];
+    if (existing) {
+        module->staleCount++;
+    }
+    existing = entry;
+    if (module->file) {
+        writeEntry(module->file, entry);
+        // flush now, Boxedwine doesn't always get a chance to shut down cleanly
+        fflush(module->file);
+    }
+}
+
+void X64CodeCache::shutDown() {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(modulesMutex);
+    if (X64CodeCache::path.length()) {
+        klog("x64 code cache: %d hits, %d misses, %d invalidations", X64CodeCache::hits, X64CodeCache::misses, X64CodeCache::invalidations);
+    }
+    for (auto& module : modules) {
+        if (module.second->staleCount && module.second->file) {
+            compactModule(module.first, module.second);
+        } else if (module.second->file) {
+            fclose(module.second->file);
+        }
+    }
+    modules.clear();
+}
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef __X64_CODE_CACHE_H__
+#define __X64_CODE_CACHE_H__
+
+#ifdef BOXEDWINE_X64
+
+class X64Asm;
+class x64CPU;
+class BtCodeChunk;
+
+// Persists translated chunks to disk so that the next run of the same app doesn't need to translate them again.
+//
+// Chunks are grouped by the path of the module (mapped file) they came from and looked up by their starting
+// eip.  A cached chunk is only used if the crc of the emulated code it was translated from still matches and
+// the state that effects translation (CS, hasSetSeg, FPU emulation) is the same as when it was saved.
+class X64CodeCache {
+public:
+    static std::string path; // directory to store the cache in, empty means the cache is disabled
+
+    static std::shared_ptr<BtCodeChunk> load(x64CPU* cpu, U32 ip);
+    static void save(x64CPU* cpu, X64Asm* data, U8 segsBeforeTranslation);
+    static U8 getSegMask(x64CPU* cpu);
+    static void shutDown();
+
+    static U32 hits;
+    static U32 misses;
+    static U32 invalidations;
+};
+
+#endif
+
+#endif
@@ -12,10 +12,11 @@ bool X64CodeChunk::retranslateSingleInstruction(BtCPU* btCPU, void* address) {
     data.ip = eip;
     data.startOfDataIp = eip;
     data.dynamic = this->dynamic;
-    cpu->translateInstruction(&data, NULL);
+    cpu->translateInstruction(&data);
     U32 eipLen = data.ip - data.startOfOpIp;
     U32 hostLen = data.bufferPos;
-    if (eipLen == this->emulatedInstructionLen[index] && hostLen == this->hostInstructionLen[index]) {
+    // jumps need to be linked, which needs the whole chunk
+    if (!data.todoJump.size() && eipLen == this->emulatedInstructionLen[index] && hostLen == this->hostInstructionLen[index]) {
         Platform::writeCodeToMemory(startofHostInstruction, hostLen, [startofHostInstruction, &data, hostLen]() {
             memcpy(startofHostInstruction, data.buffer, hostLen);
             });
@@ -20,9 +20,10 @@ X64Data::X64Data(x64CPU* cpu) : cpu(cpu) {
     this->ip = 0;
     this->startOfDataIp = 0;
     this->startOfOpIp = 0;
-    this->calculatedEipLen = 0;
-    this->stopAfterInstruction = -1;
     this->dynamic = false;
+    this->useMemOffsets = false;
+    this->checkCodePageWrite = false;
+    this->startOfOpBufferPos = 0;
 }
 
 X64Data::~X64Data() {
@@ -138,16 +139,15 @@ void X64Data::resetForNewOp() {
     this->isG8bitWritten = false;
 }
 
-U8 X64Data::calculateEipLen(U32 eip) {    
+// eip is relative to CS
+bool X64Data::isStartOfInstruction(U32 eip) {
+    eip += this->cpu->seg[CS].address;
     for (U32 i=0;i<this->ipAddressCount;i++) {
         if (this->ipAddress[i]==eip) {
-            if (i==this->ipAddressCount-1) {
-                return this->ip-this->ipAddress[i];
-            }
-            return this->ipAddress[i+1]-this->ipAddress[i];
+            return true;
         }
     }
-    return 0;
+    return false;
 }
 
 void X64Data::mapAddress(U32 ip, U32 bufferPos) {
@@ -49,6 +49,18 @@ public:
     U32 opIndex;
 };
 
+// A jump to an eip that wasn't translated yet when the jump was emitted.  These are emitted in the long form that
+// can jump to another chunk.  Once the whole chunk is translated X64Asm::resolveJumpFixups rewrites the ones that
+// ended up pointing into the chunk as a near jump in the same space.
+class JumpFixup {
+public:
+    JumpFixup(U32 todoJumpIndex, U32 pos, U32 endPos, S8 condition) : todoJumpIndex(todoJumpIndex), pos(pos), endPos(endPos), condition(condition) {}
+    U32 todoJumpIndex;
+    U32 pos;
+    U32 endPos;
+    S8 condition; // -1 for jmp
+};
+
 class X64Data {
 public:
     X64Data(x64CPU* cpu);
@@ -72,7 +84,6 @@ public:
     U32 ip;
     U32 startOfDataIp;
     U32 startOfOpIp;
-    U32 calculatedEipLen;
     bool done;
     U32 op;
     U32 inst; // full op, like 0x200 while op would be 0x00
@@ -109,9 +120,12 @@ public:
     x64CPU* cpu;
 
     std::vector<TodoJump> todoJump;
-    S32 stopAfterInstruction;
+    // buffer positions of 64-bit host pointers (helper functions, globals) that were written into the code,
+    // X64CodeCache needs these to relocate the code if Boxedwine is loaded at a different address next time
+    std::vector<U32> relocations;
+    std::vector<JumpFixup> jumpFixups;
 
-    U8 calculateEipLen(U32 eip);
+    bool isStartOfInstruction(U32 eip);
 
     U32* ipAddress;
     U32* ipAddressBufferPos;
@@ -124,6 +138,11 @@ public:
     U32 bufferPos;
     U8 bufferInternal[256];
     bool dynamic;
+    // the current op keeps faulting on PAGE_MAPPED_HOST memory, its memory operand will look up memOffsets[page]
+    bool useMemOffsets;
+    // the current op keeps faulting writing to pages with code, its memory operand checks the page before the op runs
+    bool checkCodePageWrite;
+    U32 startOfOpBufferPos;
 
     bool skipWriteOp;
     bool isG8bitWritten;
@@ -0,0 +1,236 @@
+#include "boxedwine.h"
+
+#ifdef BOXEDWINE_X64
+#include "x64Translator.h"
+#include "x64CPU.h"
+#include "x64CodeChunk.h"
+#include "x64CodeCache.h"
+#include "x64Asm.h"
+#include "../normal/normalCPU.h"
+#include "../../hardmmu/hard_memory.h"
+#include "knativethread.h"
+
+// a stub translated by a worker can create more stubs, this limits how far ahead of the emulated thread we will go
+#define X64_TRANSLATOR_MAX_DEPTH 2
+#define X64_TRANSLATOR_MAX_PENDING 4096
+
+U32 X64Translator::threadCount;
+U32 X64Translator::translated;
+U32 X64Translator::dropped;
+
+// the parts of the requesting thread's cpu that translation reads.  The worker's cpu never runs, so without these it
+// would translate with whatever the last request left in it.
+class X64TranslateCpuState {
+public:
+    void save(x64CPU* cpu) {
+        for (int i = 0; i < 7; i++) {
+            this->seg[i] = cpu->seg[i];
+        }
+        this->big = cpu->isBig() ? 1 : 0;
+        this->stackMask = cpu->stackMask;
+        this->stackNotMask = cpu->stackNotMask;
+    }
+    void restore(x64CPU* cpu, Memory* memory) {
+        for (int i = 0; i < 7; i++) {
+            cpu->seg[i] = this->seg[i];
+        }
+        for (int i = 0; i < 6; i++) {
+            cpu->negSegAddress[i] = (U32)(-((S32)(cpu->seg[i].address)));
+        }
+        cpu->setIsBig(this->big);
+        cpu->stackMask = this->stackMask;
+        cpu->stackNotMask = this->stackNotMask;
+        cpu->memOffset = memory->id;
+        cpu->negMemOffset = (U64)(-(S64)cpu->memOffset);
+        cpu->memOffsets = memory->memOffsets;
+        cpu->nativeFlags = memory->nativeFlags;
+        cpu->eipToHostInstructionPages = memory->eipToHostInstructionPages;
+        cpu->eipToHostInstructionAddressSpaceMapping = memory->eipToHostInstructionAddressSpaceMapping;
+    }
+
+    Seg seg[7];
+    U32 big;
+    U32 stackMask;
+    U32 stackNotMask;
+};
+
+class X64TranslateRequest {
+public:
+    std::weak_ptr<KProcess> process;
+    std::weak_ptr<BtCodeChunk> stub;
+    Memory* memory;
+    X64TranslateCpuState cpuState;
+    U32 depth;
+};
+
+static BOXEDWINE_CONDITION translatorCond("X64Translator::translatorCond");
+static std::deque<X64TranslateRequest> pendingRequests;
+static std::vector<Memory*> activeMemory; // Memory that a worker is currently translating for
+static std::vector<KNativeThread*> translatorThreads;
+static bool translatorShutDown;
+
+// 0 for emulated threads, for workers it is the depth of the request being translated
+static THREAD_LOCAL U32 currentDepth;
+
+static bool translate(KThread* context, const std::shared_ptr<KProcess>& process, const std::shared_ptr<BtCodeChunk>& stub, X64TranslateRequest& request) {
+    Memory* memory = request.memory;
+    context->process = process;
+    context->memory = memory;
+    x64CPU* cpu = (x64CPU*)context->cpu;
+    request.cpuState.restore(cpu, memory);
+    KThread::setCurrentThread(context);
+    currentDepth = request.depth;
+
+    U32 eip = stub->getEip();
+    U32 ip = eip - cpu->seg[CS].address;
+    bool result = false;
+    if (X64Translator::isCodeReadable(memory, eip, K_MAX_X86_OP_LEN)) {
+        // decoding is most of the work and only reads the emulated code, so it is done without the lock.  The chunk
+        // isn't cached, X64CodeCache::load would have to replace the stub before we knew whether it had the code.
+        U8 segsBeforeTranslation = X64CodeCache::getSegMask(cpu);
+        X64Asm data(cpu);
+        data.ip = ip;
+        data.startOfDataIp = ip;
+        cpu->translateData(&data);
+        data.resolveJumpFixups();
+
+        U32 eipLen = data.ip - data.startOfDataIp;
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(memory->executableMemoryMutex);
+        // the emulated thread might have already run into the stub and replaced it, or the code might have been
+        // unmapped while it was being decoded
+        if (eipLen && memory->getCodeChunkContainingEip(eip) == stub && X64Translator::isCodeReadable(memory, eip, eipLen)) {
+            stub->releaseAndReplace(cpu, [cpu, &data, segsBeforeTranslation]() {
+                return cpu->commitChunk(&data, segsBeforeTranslation);
+                });
+            result = true;
+        }
+    }
+    currentDepth = 0;
+    KThread::setCurrentThread(NULL);
+    context->process = NULL;
+    context->memory = NULL;
+    return result;
+}
+
+static int translatorThreadProc(void* data) {
+    KThread* context = NULL;
+
+    while (true) {
+        X64TranslateRequest request;
+        {
+            BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(translatorCond);
+            while (!translatorShutDown && !pendingRequests.size()) {
+                BOXEDWINE_CONDITION_WAIT(translatorCond);
+            }
+            if (translatorShutDown) {
+                break;
+            }
+            request = pendingRequests.front();
+            pendingRequests.pop_front();
+            activeMemory.push_back(request.memory);
+        }
+        // these must outlive the activeMemory entry, releasing the last reference to the process will delete its
+        // memory and Memory::~Memory waits for activeMemory
+        std::shared_ptr<KProcess> process = request.process.lock();
+        std::shared_ptr<BtCodeChunk> stub = request.stub.lock();
+        bool wasTranslated = false;
+
+        if (process && stub && !process->terminated && process->memory == request.memory) {
+            if (!context) {
+                // never added to the process, it only exists so that the translator has a cpu and memory to work with
+                context = new KThread(KSystem::getNextThreadId(), process);
+            }
+            wasTranslated = translate(context, process, stub, request);
+        }
+        {
+            BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(translatorCond);
+            VECTOR_REMOVE(activeMemory, request.memory);
+            if (wasTranslated) {
+                X64Translator::translated++;
+            }
+            BOXEDWINE_CONDITION_SIGNAL_ALL(translatorCond);
+        }
+    }
+    delete context;
+    // decoding the ops of a chunk fills this thread's free lists
+    DecodedOp::releaseThreadCache();
+    NormalCPU::releaseThreadCache();
+    return 0;
+}
+
+void X64Translator::queueStub(x64CPU* cpu, const std::shared_ptr<BtCodeChunk>& stub) {
+    if (!X64Translator::threadCount || currentDepth >= X64_TRANSLATOR_MAX_DEPTH) {
+        return;
+    }
+    BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(translatorCond);
+    if (translatorShutDown) {
+        return;
+    }
+    if (pendingRequests.size() >= X64_TRANSLATOR_MAX_PENDING) {
+        X64Translator::dropped++;
+        return;
+    }
+    if (!translatorThreads.size()) {
+        for (U32 i = 0; i < X64Translator::threadCount; i++) {
+            translatorThreads.push_back(KNativeThread::createAndStartThread(translatorThreadProc, "X64Translator", NULL));
+        }
+    }
+    X64TranslateRequest request;
+    request.process = cpu->thread->process;
+    request.stub = stub;
+    request.memory = cpu->thread->memory;
+    request.cpuState.save(cpu);
+    request.depth = currentDepth + 1;
+    pendingRequests.push_back(request);
+    BOXEDWINE_CONDITION_SIGNAL(translatorCond);
+}
+
+bool X64Translator::isCodeReadable(Memory* memory, U32 address, U32 len) {
+    // a fault on a worker thread can't be handled, so the whole range must be readable
+    U32 startPage = address >> K_PAGE_SHIFT;
+    U32 endPage = (U32)(((U64)address + len - 1) >> K_PAGE_SHIFT);
+    for (U32 page = startPage; page <= endPage && page < K_NUMBER_OF_PAGES; page++) {
+        if (!(memory->flags[page] & PAGE_READ) || !(memory->nativeFlags[memory->getNativePage(page)] & NATIVE_FLAG_COMMITTED)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool X64Translator::isBackgroundThread() {
+    return currentDepth != 0;
+}
+
+void X64Translator::memoryReleased(Memory* memory) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(translatorCond);
+    for (auto it = pendingRequests.begin(); it != pendingRequests.end();) {
+        if (it->memory == memory) {
+            it = pendingRequests.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    while (VECTOR_CONTAINS(activeMemory, memory)) {
+        BOXEDWINE_CONDITION_WAIT(translatorCond);
+    }
+}
+
+void X64Translator::shutDown() {
+    std::vector<KNativeThread*> threads;
+    {
+        BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(translatorCond);
+        translatorShutDown = true;
+        pendingRequests.clear();
+        threads = translatorThreads;
+        translatorThreads.clear();
+        BOXEDWINE_CONDITION_SIGNAL_ALL(translatorCond);
+    }
+    for (auto& thread : threads) {
+        thread->wait();
+    }
+    if (X64Translator::threadCount) {
+        klog("x64 translator: %d chunks translated in the background, %d requests dropped because the queue was full", X64Translator::translated, X64Translator::dropped);
+    }
+}
+
+#endif
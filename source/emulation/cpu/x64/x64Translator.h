@@ -0,0 +1,35 @@
+#ifndef __X64_TRANSLATOR_H__
+#define __X64_TRANSLATOR_H__
+
+#ifdef BOXEDWINE_X64
+
+class x64CPU;
+class BtCodeChunk;
+
+// Translates code ahead of time on background threads.
+//
+// When x64CPU::link finds a jump to code that hasn't been translated yet it creates a small stub chunk for the
+// target.  Without the translator the emulated thread will hit that stub and have to stop and translate the
+// target itself.  With the translator the stub is queued and a worker thread replaces it with the real chunk,
+// using the same releaseAndRetranslate path another emulated thread would use, so usually the emulated thread
+// never sees the stub.
+//
+// Workers decode without Memory::executableMemoryMutex and only take it to publish the chunk, the same way an
+// emulated thread does.  Each request carries the parts of the requesting cpu that translation reads.
+class X64Translator {
+public:
+    static U32 threadCount; // 0 means all code is translated by the emulated thread when it is needed
+
+    static void queueStub(x64CPU* cpu, const std::shared_ptr<BtCodeChunk>& stub);
+    static bool isCodeReadable(Memory* memory, U32 address, U32 len);
+    static bool isBackgroundThread();
+    static void memoryReleased(Memory* memory);
+    static void shutDown();
+
+    static U32 translated;
+    static U32 dropped;
+};
+
+#endif
+
+#endif
@@ -23,9 +23,15 @@
 #include <setjmp.h>
 #include "hard_memory.h"
 #include "../cpu/binaryTranslation/btCodeMemoryWrite.h"
+#ifdef BOXEDWINE_X64
+#include "../cpu/x64/x64Translator.h"
+#endif
 #include "../cpu/binaryTranslation/btCodeChunk.h"
 
-Memory::Memory() : allocated(0), callbackPos(0) {
+Memory::Memory() : Memory(NULL) {
+}
+
+Memory::Memory(Memory* from) : allocated(0), callbackPos(0) {
     memset(flags, 0, sizeof(flags));
     memset(nativeFlags, 0, sizeof(nativeFlags));
     memset(memOffsets, 0, sizeof(memOffsets));
@@ -42,7 +48,8 @@ Memory::Memory() : allocated(0), callbackPos(0) {
     memset(this->dynamicCodePageUpdateCount, 0, sizeof(this->dynamicCodePageUpdateCount));
     memset(this->committedEipPages, 0, sizeof(this->committedEipPages));
 #endif    
-    reserveNativeMemory(this);
+    // cloneNativeMemory replaces all of it with a copy-on-write view of the parent's file
+    reserveNativeMemory(this, !from || !from->nativeMemoryFile);
 
     allocNativeMemory(this, CALL_BACK_ADDRESS >> K_PAGE_SHIFT, K_NATIVE_PAGES_PER_PAGE, PAGE_READ | PAGE_EXEC | PAGE_WRITE);
     this->addCallback(onExitSignal);
@@ -52,9 +59,15 @@ Memory::Memory() : allocated(0), callbackPos(0) {
 #endif
 
     this->refCount = 1;
+    if (from) {
+        this->clone(from);
+    }
 }
 
 Memory::~Memory() {    
+#ifdef BOXEDWINE_X64
+    X64Translator::memoryReleased(this);
+#endif
     releaseNativeMemory(this);
 #ifdef BOXEDWINE_BINARY_TRANSLATOR
     if (this->eipToHostInstructionPages) {
@@ -93,7 +106,13 @@ void Memory::log_pf(KThread* thread, U32 address) {
 
 void Memory::reset() {
     releaseNativeMemory(this);
-    reserveNativeMemory(this);
+    reserveNativeMemory(this, true);
+#ifdef BOXEDWINE_BINARY_TRANSLATOR
+    this->mappedHostFaults.clear();
+    this->codePageWriteFaults.clear();
+    this->translatedBytesByEmulationPage.clear();
+    this->codePageDataWrites.clear();
+#endif
 
     this->callbackPos = 0;
     allocNativeMemory(this, CALL_BACK_ADDRESS >> K_PAGE_SHIFT, K_NATIVE_PAGES_PER_PAGE, PAGE_READ | PAGE_EXEC | PAGE_WRITE);
@@ -108,14 +127,23 @@ void Memory::clone(Memory* from) {
     int i=0;    
 
     for (i=0;i<0x100000;i++) {
-        if (from->isPageAllocated(i)) {
-            if ((from->flags[i] & PAGE_SHARED) && (from->flags[i] & PAGE_WRITE)) {
-                static U32 shown = 0;
-                if (!shown) {
-                    kdebug("forking a process with shared memory is not fully supported with BOXEDWINE_64BIT_MMU");
-                    shown=1;
-                }
+        if (from->isPageAllocated(i) && (from->flags[i] & PAGE_SHARED) && (from->flags[i] & PAGE_WRITE)) {
+            static U32 shown = 0;
+            if (!shown) {
+                kdebug("forking a process with shared memory is not fully supported with BOXEDWINE_64BIT_MMU");
+                shown=1;
             }
+            break;
+        }
+    }
+#ifdef BOXEDWINE_MEMFD_MEMORY
+    // if the platform can share the pages copy-on-write then there is nothing to copy here
+    if (cloneNativeMemory(this, from)) {
+        return;
+    }
+#endif
+    for (i=0;i<0x100000;i++) {
+        if (from->isPageAllocated(i)) {
             allocNativeMemory(this, i, 1, from->flags[i]);
             memcpy(getNativeAddress(this, i << K_PAGE_SHIFT), getNativeAddress(from, i << K_PAGE_SHIFT), K_PAGE_SIZE);
         } else {
@@ -161,6 +189,20 @@ void Memory::allocPages(U32 page, U32 pageCount, U8 permissions, FD fd, U64 offs
     for (U32 i = 0; i < pageCount; i++) {
         this->clearCodePageFromCache(page + i);
     }
+#ifdef BOXEDWINE_MEMFD_MEMORY
+    if (mappedFile) {
+        // when the host maps the file itself, its pages are shared with every other process that maps the same file
+        // and are only read when they are touched
+        U32 mappedPageCount = mapNativeFile(this, page, pageCount, permissions, mappedFile->file, offset);
+        if (mappedPageCount == pageCount) {
+            return;
+        }
+        // the rest is past the end of the file
+        page += mappedPageCount;
+        pageCount -= mappedPageCount;
+        offset += ((U64)mappedPageCount) << K_PAGE_SHIFT;
+    }
+#endif
     if ((permissions & PAGE_PERMISSION_MASK) || mappedFile) {
         allocNativeMemory(this, page, pageCount, permissions);
     } else {
@@ -331,6 +373,22 @@ U32 getNativeStringLen(U32 address) {
     return (U32)strlen((char*)getNativeAddress(KThread::currentThread()->memory, address));
 }
 
+#ifdef BOXEDWINE_BINARY_TRANSLATOR
+void writeNativeSlow(Memory* memory, U32 address, U64 value, U32 len) {
+    U32 page = address >> K_PAGE_SHIFT;
+    U8 flags = memory->nativeFlags[memory->getNativePage(page)];
+
+    if (flags & NATIVE_FLAG_CODEPAGE_READONLY) {
+        BtCodeMemoryWrite w((BtCPU*)KThread::currentThread()->cpu, address, len);
+        memcpy(getNativeAddress(memory, address), &value, len);
+    } else if ((flags & NATIVE_FLAG_COMMITTED) || (memory->flags[page] & PAGE_MAPPED_HOST)) {
+        memcpy(getNativeAddress(memory, address), &value, len);
+    } else {
+        kpanic("write of %d bytes to %X about to crash", len, address);
+    }
+}
+#endif
+
 U8 readb(U32 address) {
 #ifdef LOG_OPS
     U8 result = *(U8*)getNativeAddress(thread->process->memory, address);
@@ -338,7 +396,7 @@ U8 readb(U32 address) {
         fprintf(logFile, "readb %X @%X\n", result, address);
     return result;
 #else
-    return *(U8*)getNativeAddress(KThread::currentThread()->memory, address);
+    return readb(KThread::currentThread()->memory, address);
 #endif
 }
 
@@ -347,23 +405,7 @@ void writeb(U32 address, U8 value) {
     if (thread->process->memory->log)
         fprintf(logFile, "writeb %X @%X\n", value, address);
 #endif
-#ifdef BOXEDWINE_BINARY_TRANSLATOR
-    Memory* m = KThread::currentThread()->memory;
-    U32 page = address >> K_PAGE_SHIFT;
-    U32 nativePage = m->getNativePage(page);
-    U8 flags = m->nativeFlags[nativePage];
-
-    if (flags & NATIVE_FLAG_CODEPAGE_READONLY) {
-        BtCodeMemoryWrite w((BtCPU*)KThread::currentThread()->cpu, address, 1);
-        *(U8*)getNativeAddress(m, address) = value;
-    } else if ((flags & NATIVE_FLAG_COMMITTED) || (m->flags[page] & PAGE_MAPPED_HOST)) {
-        *(U8*)getNativeAddress(KThread::currentThread()->memory, address) = value;
-    } else {
-        kpanic("writeb about to crash");
-    }
-#else
-    *(U8*)getNativeAddress(KThread::currentThread()->memory, address) = value;
-#endif
+    writeb(KThread::currentThread()->memory, address, value);
 }
 
 U16 readw(U32 address) {
@@ -373,7 +415,7 @@ U16 readw(U32 address) {
         fprintf(logFile, "readw %X @%X\n", result, address);
     return result;
 #else
-    return *(U16*)getNativeAddress(KThread::currentThread()->memory, address);
+    return readw(KThread::currentThread()->memory, address);
 #endif
 }
 
@@ -384,23 +426,7 @@ void writew( U32 address, U16 value) {
     if (thread->process->memory->log)
         fprintf(logFile, "writew %X @%X\n", value, address);
 #endif
-#ifdef BOXEDWINE_BINARY_TRANSLATOR
-    Memory* m = KThread::currentThread()->memory;
-    U32 page = address >> K_PAGE_SHIFT;
-    U32 nativePage = m->getNativePage(page);
-    U8 flags = m->nativeFlags[nativePage];
-
-    if (flags & NATIVE_FLAG_CODEPAGE_READONLY) {
-        BtCodeMemoryWrite w((BtCPU*)KThread::currentThread()->cpu, address, 2);
-        *(U16*)getNativeAddress(m, address) = value;
-    } else if (flags & NATIVE_FLAG_COMMITTED) {
-        *(U16*)getNativeAddress(KThread::currentThread()->memory, address) = value;
-    } else {
-        kpanic("writew about to crash");
-    }
-#else
-    *(U16*)getNativeAddress(KThread::currentThread()->memory, address) = value;
-#endif
+    writew(KThread::currentThread()->memory, address, value);
 }
 
 U32 readd(U32 address) {
@@ -410,7 +436,7 @@ U32 readd(U32 address) {
         fprintf(logFile, "readd %X @%X\n", result, address);
     return result;
 #else
-    return *(U32*)getNativeAddress(KThread::currentThread()->memory, address);
+    return readd(KThread::currentThread()->memory, address);
 #endif
 }
 
@@ -419,47 +445,15 @@ void writed(U32 address, U32 value) {
     if (thread->process->memory->log)
         fprintf(logFile, "writed %X @%X\n", value, address);
 #endif
-#ifdef BOXEDWINE_BINARY_TRANSLATOR
-    Memory* m = KThread::currentThread()->memory;
-    U32 page = address >> K_PAGE_SHIFT;
-    U32 nativePage = m->getNativePage(page);
-    U8 flags = m->nativeFlags[nativePage];
-
-    if (flags & NATIVE_FLAG_CODEPAGE_READONLY) {
-        BtCodeMemoryWrite w((BtCPU*)KThread::currentThread()->cpu, address, 4);
-        *(U32*)getNativeAddress(m, address) = value;
-    } else if ((flags & NATIVE_FLAG_COMMITTED) || (m->flags[page] & PAGE_MAPPED_HOST)) {
-        *(U32*)getNativeAddress(KThread::currentThread()->memory, address) = value;
-    } else {
-        kpanic("writed about to crash");
-    }
-#else
-    *(U32*)getNativeAddress(KThread::currentThread()->memory, address) = value;
-#endif
+    writed(KThread::currentThread()->memory, address, value);
 }
 
 U64 readq(U32 address) {
-    return *(U64*)getNativeAddress(KThread::currentThread()->memory, address);
+    return readq(KThread::currentThread()->memory, address);
 }
 
 void writeq(U32 address, U64 value) {
-#ifdef BOXEDWINE_BINARY_TRANSLATOR
-    Memory* m = KThread::currentThread()->memory;
-    U32 page = address >> K_PAGE_SHIFT;
-    U32 nativePage = m->getNativePage(page);
-    U8 flags = m->nativeFlags[nativePage];
-
-    if (flags & NATIVE_FLAG_CODEPAGE_READONLY) {
-        BtCodeMemoryWrite w((BtCPU*)KThread::currentThread()->cpu, address, 8);
-        *(U64*)getNativeAddress(m, address) = value;
-    } else if ((flags & NATIVE_FLAG_COMMITTED) || (m->flags[page] & PAGE_MAPPED_HOST)) {
-        *(U64*)getNativeAddress(KThread::currentThread()->memory, address) = value;
-    } else {
-        kpanic("writeq about to crash");
-    }
-#else
-    *(U64*)getNativeAddress(KThread::currentThread()->memory, address) = value;
-#endif
+    writeq(KThread::currentThread()->memory, address, value);
 }
 
 void Memory::addCallback(OpCallback func) {
@@ -656,9 +650,12 @@ void Memory::clearCodePageFromCache(U32 page) {
         }
     }
     
+    this->translatedBytesByEmulationPage.erase(page);
+
     U32 nativePage = this->getNativePage(page);
     U32 startingPage = this->getEmulatedPage(nativePage);
     this->dynamicCodePageUpdateCount[nativePage] = 0;
+    this->codePageDataWrites.erase(nativePage);
     if (this->eipToHostInstructionPages) {
         for (int i=0;i<K_NATIVE_PAGES_PER_PAGE;i++) {
             if (this->eipToHostInstructionPages[startingPage+i]) {
@@ -735,27 +732,37 @@ U8* getPhysicalWriteAddress(U32 address, U32 len) {
 #ifdef BOXEDWINE_BINARY_TRANSLATOR
 // called when BtCodeChunk is being dealloc'd
 void Memory::removeCodeChunk(const std::shared_ptr<BtCodeChunk>& chunk) {
+    auto position = this->codeChunkPositions.find(chunk.get());
+    if (position == this->codeChunkPositions.end()) {
+        return;
+    }
     U32 hostPage = (U32)(((size_t)chunk->getHostAddress()) >> K_PAGE_SHIFT);
-    if (this->codeChunksByHostPage.count(hostPage)) {
-        std::shared_ptr< std::list<std::shared_ptr<BtCodeChunk>> > chunks = this->codeChunksByHostPage[hostPage];
-        chunks->remove(chunk);
-        if (chunks->size() == 0) {
-            this->codeChunksByHostPage.erase(hostPage);
+    auto hostChunks = this->codeChunksByHostPage.find(hostPage);
+    if (hostChunks != this->codeChunksByHostPage.end()) {
+        hostChunks->second->erase(position->second.hostPagePos);
+        if (hostChunks->second->size() == 0) {
+            this->codeChunksByHostPage.erase(hostChunks);
         }
     }
 
     U32 emulationPage = (chunk->getEip()) >> K_PAGE_SHIFT;
-    if (this->codeChunksByEmulationPage.count(emulationPage)) {
-        std::shared_ptr< std::list<std::shared_ptr<BtCodeChunk>> > chunks = this->codeChunksByEmulationPage[emulationPage];
-        chunks->remove(chunk);
-        if (chunks->size() == 0) {
-            this->codeChunksByEmulationPage.erase(emulationPage);
+    auto chunks = this->codeChunksByEmulationPage.find(emulationPage);
+    if (chunks != this->codeChunksByEmulationPage.end()) {
+        chunks->second->erase(position->second.emulationPagePos);
+        if (chunks->second->size() == 0) {
+            this->codeChunksByEmulationPage.erase(chunks);
         }
     }
+    this->codeChunkPositions.erase(position);
+
+    this->setTranslatedBytes(chunk->getEip(), chunk->getEipLen(), false);
 }
 
 // called when BtCodeChunk is being alloc'd
 void Memory::addCodeChunk(const std::shared_ptr<BtCodeChunk>& chunk) {
+    if (this->codeChunkPositions.count(chunk.get())) {
+        return;
+    }
     U32 hostPage = (U32)(((size_t)chunk->getHostAddress()) >> K_PAGE_SHIFT);
     U32 emulationPage = (chunk->getEip()) >> K_PAGE_SHIFT;
 #ifdef _DEBUG
@@ -776,14 +783,84 @@ void Memory::addCodeChunk(const std::shared_ptr<BtCodeChunk>& chunk) {
         hostChunks = std::make_shared< std::list<std::shared_ptr<BtCodeChunk>> >();
         this->codeChunksByHostPage[hostPage] = hostChunks;
     }
-    hostChunks->push_back(chunk);
+    CodeChunkPosition& position = this->codeChunkPositions[chunk.get()];
+    position.hostPagePos = hostChunks->insert(hostChunks->end(), chunk);
 
     std::shared_ptr< std::list<std::shared_ptr<BtCodeChunk>> > chunks = this->codeChunksByEmulationPage[emulationPage];
     if (!chunks) {
         chunks = std::make_shared< std::list<std::shared_ptr<BtCodeChunk>> >();
         this->codeChunksByEmulationPage[emulationPage] = chunks;
     }
-    chunks->push_back(chunk);
+    position.emulationPagePos = chunks->insert(chunks->end(), chunk);
+    this->setTranslatedBytes(chunk->getEip(), chunk->getEipLen(), true);
+}
+
+void Memory::setTranslatedBytes(U32 address, U32 len, bool translated) {
+    while (len) {
+        U32 page = address >> K_PAGE_SHIFT;
+        U32 offset = address & K_PAGE_MASK;
+        U32 todo = std::min(len, K_PAGE_SIZE - offset);
+        auto it = this->translatedBytesByEmulationPage.find(page);
+
+        if (it == this->translatedBytesByEmulationPage.end() && translated) {
+            it = this->translatedBytesByEmulationPage.insert(std::make_pair(page, std::make_shared<TranslatedBytes>())).first;
+        }
+        if (it != this->translatedBytesByEmulationPage.end()) {
+            TranslatedBytes* bytes = it->second.get();
+            U32 end = offset + todo;
+
+            // a chunk that starts in the middle of another chunk's instruction will share some bytes with it,
+            // once that happens the page keeps its bits until clearCodePageFromCache drops it
+            if (translated || !bytes->overlapped) {
+                for (U32 i = offset; i < end;) {
+                    U32 bit = i & 63;
+                    U32 count = std::min(64 - bit, end - i);
+                    U64 mask = (count == 64 ? ~(U64)0 : (((U64)1 << count) - 1)) << bit;
+                    U64& word = bytes->bits[i >> 6];
+
+                    if (translated) {
+                        if (word & mask) {
+                            bytes->overlapped = true;
+                        }
+                        word |= mask;
+                    } else {
+                        word &= ~mask;
+                    }
+                    i += count;
+                }
+            }
+        }
+        address += todo;
+        len -= todo;
+    }
+}
+
+bool Memory::isTranslatedCode(U32 address, U32 len) {
+    while (len) {
+        U32 page = address >> K_PAGE_SHIFT;
+        U32 offset = address & K_PAGE_MASK;
+        U32 todo = std::min(len, K_PAGE_SIZE - offset);
+        auto it = this->translatedBytesByEmulationPage.find(page);
+
+        if (it != this->translatedBytesByEmulationPage.end()) {
+            U64* bits = it->second->bits;
+            U32 end = offset + todo;
+
+            for (U32 i = offset; i < end;) {
+                U32 bit = i & 63;
+                U32 count = std::min(64 - bit, end - i);
+                U64 mask = (count == 64 ? ~(U64)0 : (((U64)1 << count) - 1)) << bit;
+
+                if (bits[i >> 6] & mask) {
+                    return true;
+                }
+                i += count;
+            }
+        }
+        address += todo;
+        len -= todo;
+    }
+    return false;
 }
 
 void Memory::makeNativePageDynamic(U32 nativePage) {
@@ -869,6 +946,19 @@ std::shared_ptr<BtCodeChunk> Memory::getCodeChunkContainingEip(U32 eip) {
 }
 
 void Memory::invalideHostCode(U32 eip, U32 len) {
+    U32 startPage = this->getNativePage(eip >> K_PAGE_SHIFT);
+    U32 endPage = this->getNativePage((eip+len) >> K_PAGE_SHIFT);
+
+    if (!this->isTranslatedCode(eip, len)) {
+        // data that shares a page with code, there is nothing to invalidate.  Enough of these will still make the page
+        // dynamic so that the writes stop being trapped.
+        for (U32 nativePage = startPage; nativePage <= endPage; nativePage++) {
+            if (++this->codePageDataWrites[nativePage] % CODE_PAGE_DATA_WRITES_PER_UPDATE == 0) {
+                this->codePageUpdated(nativePage);
+            }
+        }
+        return;
+    }
     for (U32 i=eip;i<eip+len;i++) {
         std::shared_ptr<BtCodeChunk> chunk = getCodeChunkContainingEip(i);
         if (chunk && !chunk->isDynamicAware()) {
@@ -876,15 +966,16 @@ void Memory::invalideHostCode(U32 eip, U32 len) {
             i=chunk->getEip()+chunk->getEipLen()-1;
         }
     }
-
-    U32 startPage = this->getNativePage(eip >> K_PAGE_SHIFT);
-    U32 endPage = this->getNativePage((eip+len) >> K_PAGE_SHIFT);
     for (U32 nativePage = startPage; nativePage <= endPage; nativePage++) {
-        if (dynamicCodePageUpdateCount[nativePage]!=MAX_DYNAMIC_CODE_PAGE_COUNT) {
-            dynamicCodePageUpdateCount[nativePage]++;
-            if (dynamicCodePageUpdateCount[nativePage]==MAX_DYNAMIC_CODE_PAGE_COUNT) {
-                this->makeNativePageDynamic(nativePage);
-            }
+        this->codePageUpdated(nativePage);
+    }
+}
+
+void Memory::codePageUpdated(U32 nativePage) {
+    if (dynamicCodePageUpdateCount[nativePage]!=MAX_DYNAMIC_CODE_PAGE_COUNT) {
+        dynamicCodePageUpdateCount[nativePage]++;
+        if (dynamicCodePageUpdateCount[nativePage]==MAX_DYNAMIC_CODE_PAGE_COUNT) {
+            this->makeNativePageDynamic(nativePage);
         }
     }
 }
@@ -990,6 +1081,7 @@ void Memory::executableMemoryReleased() {
 #ifdef BOXEDWINE_BINARY_TRANSLATOR
     this->codeChunksByHostPage.clear();
     this->codeChunksByEmulationPage.clear();
+    this->codeChunkPositions.clear();
     for (U32 i = 0; i < EXECUTABLE_SIZES; i++) {
         this->freeExecutableMemory[i].clear();
     }
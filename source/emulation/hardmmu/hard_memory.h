@@ -23,6 +23,14 @@
 
 #define NATIVE_FLAG_COMMITTED 0x01
 #define NATIVE_FLAG_CODEPAGE_READONLY 0x02
+#define NATIVE_FLAG_FILE_MAPPED 0x04
+
+// The emulated memory is a shared mapping of a memfd, so fork can share it copy-on-write and host files can be mapped
+// straight into it.  Windows can't map a view into part of the region reserved for the process, so there fork copies
+// every page and mmap reads files into private memory.
+#if !defined(BOXEDWINE_MSVC) && !defined(__MACH__) && !defined(__ANDROID__)
+#define BOXEDWINE_MEMFD_MEMORY
+#endif
 
 INLINE void* getNativeAddress(Memory* memory, U32 address) {
     U32 page = address >> K_PAGE_SHIFT;
@@ -39,10 +47,49 @@ INLINE U32 getHostAddress(KThread* thread, void* address) {
     return (U32)(size_t)address; // size_t because of xcode
 }
 
-void reserveNativeMemory(Memory* memory);
+#ifdef BOXEDWINE_BINARY_TRANSLATOR
+// writes to code that has been translated, or to memory that isn't committed
+void writeNativeSlow(Memory* memory, U32 address, U64 value, U32 len);
+
+INLINE bool canWriteNativeDirectly(Memory* memory, U32 address) {
+    return (memory->nativeFlags[memory->getNativePage(address >> K_PAGE_SHIFT)] & (NATIVE_FLAG_COMMITTED | NATIVE_FLAG_CODEPAGE_READONLY)) == NATIVE_FLAG_COMMITTED;
+}
+#endif
+
+// These take the memory instead of looking up the current thread like readd(address) does, the cpu helpers and the
+// syscall/opengl marshalling code already have the thread so this saves a thread local lookup on every access
+template<typename T> INLINE T readNative(Memory* memory, U32 address) {
+    return *(T*)getNativeAddress(memory, address);
+}
+
+template<typename T> INLINE void writeNative(Memory* memory, U32 address, T value) {
+#ifdef BOXEDWINE_BINARY_TRANSLATOR
+    if (!canWriteNativeDirectly(memory, address)) {
+        writeNativeSlow(memory, address, value, sizeof(T));
+        return;
+    }
+#endif
+    *(T*)getNativeAddress(memory, address) = value;
+}
+
+INLINE U8 readb(Memory* memory, U32 address) {return readNative<U8>(memory, address);}
+INLINE U16 readw(Memory* memory, U32 address) {return readNative<U16>(memory, address);}
+INLINE U32 readd(Memory* memory, U32 address) {return readNative<U32>(memory, address);}
+INLINE U64 readq(Memory* memory, U32 address) {return readNative<U64>(memory, address);}
+INLINE void writeb(Memory* memory, U32 address, U8 value) {writeNative<U8>(memory, address, value);}
+INLINE void writew(Memory* memory, U32 address, U16 value) {writeNative<U16>(memory, address, value);}
+INLINE void writed(Memory* memory, U32 address, U32 value) {writeNative<U32>(memory, address, value);}
+INLINE void writeq(Memory* memory, U32 address, U64 value) {writeNative<U64>(memory, address, value);}
+
+// withFile is false when the memory is about to be a clone of memory that already has a file
+void reserveNativeMemory(Memory* memory, bool withFile);
 void releaseNativeMemory(Memory* memory);
 void allocNativeMemory(Memory* memory, U32 page, U32 pageCount, U32 flags);
 void freeNativeMemory(Memory* memory, U32 page, U32 pageCount);
+#ifdef BOXEDWINE_MEMFD_MEMORY
+bool cloneNativeMemory(Memory* memory, Memory* from);
+U32 mapNativeFile(Memory* memory, U32 page, U32 pageCount, U32 flags, const std::shared_ptr<KFile>& file, U64 offset);
+#endif
 void makeCodePageReadOnly(Memory* memory, U32 page);
 bool clearCodePageReadOnly(Memory* memory, U32 page);
 void updateNativePermission(Memory* memory, U32 nativePage, U32 nativePageCount, bool canRead, bool canWrite);
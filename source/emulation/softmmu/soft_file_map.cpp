@@ -47,10 +47,7 @@ void FilePage::ondemmandFile(U32 address) {
     } 
     if (!ram) {
         ram = ramPageAlloc();
-        U64 pos = this->mapped->file->getPos();
-        this->mapped->file->seek(((U64)this->index) << K_PAGE_SHIFT);
-        this->mapped->file->readNative(ram, K_PAGE_SIZE);
-        this->mapped->file->seek(pos);
+        this->mapped->file->preadNative(ram, ((U64)this->index) << K_PAGE_SHIFT, K_PAGE_SIZE);
         if (!write) {
             mapped->systemCacheEntry->data[this->index] = ram;
             ramPageIncRef(ram);
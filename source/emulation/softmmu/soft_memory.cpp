@@ -126,6 +126,10 @@ Memory::Memory() : nativeAddressStart(0) {
     this->refCount = 1;
 }
 
+Memory::Memory(Memory* from) : Memory() {
+    this->clone(from);
+}
+
 Memory::~Memory() {
     for (int i=0;i<K_NUMBER_OF_PAGES;i++) {
         this->mmu[i]->close();
@@ -213,7 +217,7 @@ void Memory::clone(Memory* from) {
             this->setPage(i, from->getPage(i));
         } 
         else if (page->type == Page::Type::Frame_Buffer) { 
-            this->setPage(i, allocFBPage(from->getPageFlags(i)));
+            this->setPage(i, allocFBPage(this, i << K_PAGE_SHIFT, from->getPageFlags(i)));
         } 
         else {
             kpanic("unhandled case when cloning memory: page type = %d", page->type);
@@ -117,5 +117,15 @@ inline void writeq(U32 address, U64 value) {
 #endif
     writed(address, (U32)value); writed(address + 4, (U32)(value >> 32));
 }
+
+// Memory::onThreadChanged points currentMMU at the running thread's memory, so there is nothing to look up here
+inline U8 readb(Memory* memory, U32 address) {return readb(address);}
+inline U16 readw(Memory* memory, U32 address) {return readw(address);}
+inline U32 readd(Memory* memory, U32 address) {return readd(address);}
+inline U64 readq(Memory* memory, U32 address) {return readq(address);}
+inline void writeb(Memory* memory, U32 address, U8 value) {writeb(address, value);}
+inline void writew(Memory* memory, U32 address, U16 value) {writew(address, value);}
+inline void writed(Memory* memory, U32 address, U32 value) {writed(address, value);}
+inline void writeq(Memory* memory, U32 address, U64 value) {writeq(address, value);}
 #endif
 #endif
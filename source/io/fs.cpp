@@ -9,6 +9,7 @@
 #endif
 
 #include <stdio.h>
+#include <map>
 #include <fcntl.h>
 #include <sys/stat.h>
 
@@ -21,7 +22,39 @@ BOXEDWINE_MUTEX Fs::nextNodeIdMutex;
 BoxedPtr<FsFileNode> Fs::rootNode;
 std::string Fs::nativePathSeperator;
 
+U32 Fs::pathCacheHits;
+U32 Fs::pathCacheMisses;
+
+class FsPathCacheEntry {
+public:
+    FsPathCacheEntry() {
+        this->cached[0] = this->cached[1] = false;
+        this->isLink[0] = this->isLink[1] = false;
+    }
+    // indexed by followLink, a NULL node is a cached ENOENT
+    bool cached[2];
+    bool isLink[2];
+    BoxedPtr<FsNode> node[2];
+};
+
+// keyed by the cleaned up full path.  Lookups that didn't go through a link only depend on the nodes along their own
+// path, so they are kept sorted in order to drop a whole subtree at once.  Lookups that followed a link can depend on
+// any part of the tree, so those are all dropped on every change.
+static std::map<std::string, FsPathCacheEntry> pathCache;
+static std::unordered_map<std::string, FsPathCacheEntry> linkedPathCache;
+static U32 pathCacheGeneration;
+static BOXEDWINE_MUTEX pathCacheMutex;
+
 void Fs::shutDown() {
+    {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(pathCacheMutex);
+        if (Fs::pathCacheHits || Fs::pathCacheMisses) {
+            kdebug("fs path cache: %d hits, %d misses", Fs::pathCacheHits, Fs::pathCacheMisses);
+        }
+        pathCache.clear();
+        linkedPathCache.clear();
+        pathCacheGeneration++;
+    }
 	rootNode = NULL;
 }
 bool Fs::initFileSystem(const std::string& rootPath) {
@@ -101,10 +134,92 @@ BoxedPtr<FsNode> Fs::addDynamicLinkFile(const std::string& path, U32 rdev, const
     return result;
 }
 
+static FsPathCacheEntry* getPathCacheEntry(const std::string& path, U32 index) {
+    auto it = pathCache.find(path);
+    if (it != pathCache.end() && it->second.cached[index]) {
+        return &it->second;
+    }
+    auto linkedIt = linkedPathCache.find(path);
+    if (linkedIt != linkedPathCache.end() && linkedIt->second.cached[index]) {
+        return &linkedIt->second;
+    }
+    return NULL;
+}
+
+bool cleanPath(std::vector<std::string>& parts);
+
 BoxedPtr<FsNode> Fs::getNodeFromLocalPath(const std::string& currentDirectory, const std::string& path, bool followLink, bool* isLink) {
+    std::string fullpath = Fs::getFullPath(currentDirectory, path);
+
+    if (fullpath.length()==0 || fullpath=="/" || !Fs::rootNode)
+        return Fs::rootNode;
+    std::vector<std::string> parts;
+    Fs::splitPath(fullpath, parts);
+    if (!cleanPath(parts))
+        return NULL;
+    std::string cleanedPath;
+    for (auto& part : parts) {
+        if (part!=".") {
+            cleanedPath+="/";
+            cleanedPath+=part;
+        }
+    }
+    if (cleanedPath.length()==0)
+        return Fs::rootNode;
+
+    U32 index = followLink?1:0;
+    U32 generation;
+    {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(pathCacheMutex);
+        FsPathCacheEntry* entry = getPathCacheEntry(cleanedPath, index);
+        if (entry) {
+            Fs::pathCacheHits++;
+            if (isLink && entry->isLink[index]) {
+                *isLink = true;
+            }
+            return entry->node[index];
+        }
+        Fs::pathCacheMisses++;
+        generation = pathCacheGeneration;
+    }
+
+    // the cache lock isn't held while walking the tree since loading a directory's children adds nodes
     BoxedPtr<FsNode> lastNode;
     std::vector<std::string> missingParts;
-    return Fs::getNodeFromLocalPath(currentDirectory, path, lastNode, missingParts, followLink, isLink);
+    bool nodeIsLink = false;
+    U32 followedLinks = 0;
+    BoxedPtr<FsNode> result = Fs::getNodeFromLocalPath("", cleanedPath, lastNode, missingParts, followLink, &nodeIsLink, &followedLinks);
+    if (isLink && nodeIsLink) {
+        *isLink = true;
+    }
+    // where a dynamic link points can change without the tree changing, like /proc/self
+    if (!(followedLinks & FS_PATH_FOLLOWED_DYNAMIC_LINK)) {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(pathCacheMutex);
+        // if the tree changed during the walk then the result might already be stale
+        if (generation==pathCacheGeneration) {
+            if (pathCache.size()+linkedPathCache.size()>=FS_PATH_CACHE_MAX_SIZE) {
+                pathCache.clear();
+                linkedPathCache.clear();
+            }
+            FsPathCacheEntry& entry = followedLinks?linkedPathCache[cleanedPath]:pathCache[cleanedPath];
+            entry.cached[index] = true;
+            entry.isLink[index] = nodeIsLink;
+            entry.node[index] = result;
+        }
+    }
+    return result;
+}
+
+void Fs::invalidatePathCache(const std::string& path) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(pathCacheMutex);
+    pathCacheGeneration++;
+    linkedPathCache.clear();
+    pathCache.erase(path);
+    std::string prefix = path+"/";
+    auto it = pathCache.lower_bound(prefix);
+    while (it != pathCache.end() && stringStartsWith(it->first, prefix)) {
+        it = pathCache.erase(it);
+    }
 }
 
 std::string Fs::getFullPath(const std::string& currentDirectory, const std::string& path) {
@@ -141,7 +256,7 @@ bool cleanPath(std::vector<std::string>& parts) {
     return true;
 }
 
-BoxedPtr<FsNode> Fs::getNodeFromLocalPath(const std::string& currentDirectory, const std::string& path, BoxedPtr<FsNode>& lastNode, std::vector<std::string>& missingParts, bool followLink, bool* isLink) {
+BoxedPtr<FsNode> Fs::getNodeFromLocalPath(const std::string& currentDirectory, const std::string& path, BoxedPtr<FsNode>& lastNode, std::vector<std::string>& missingParts, bool followLink, bool* isLink, U32* followedLinks) {
     std::string fullpath = Fs::getFullPath(currentDirectory, path);
 
     if (fullpath.length()==0 || fullpath=="/")
@@ -180,6 +295,9 @@ BoxedPtr<FsNode> Fs::getNodeFromLocalPath(const std::string& currentDirectory, c
             if (i==parts.size()-1 && isLink) {
                 *isLink = true;
             }
+            if (followedLinks) {
+                *followedLinks |= (node->type==FsNode::Type::Virtual)?FS_PATH_FOLLOWED_DYNAMIC_LINK:FS_PATH_FOLLOWED_LINK;
+            }
 
             std::vector<std::string> linkParts;
             Fs::splitPath(node->getLink(), linkParts);
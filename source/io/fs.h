@@ -43,6 +43,13 @@
 
 #define FS_BLOCK_SIZE 8192
 
+// number of resolved paths remembered by getNodeFromLocalPath, the cache is emptied when it fills up
+#define FS_PATH_CACHE_MAX_SIZE 4096
+
+// reported by the internal getNodeFromLocalPath about the links it followed
+#define FS_PATH_FOLLOWED_LINK 0x01
+#define FS_PATH_FOLLOWED_DYNAMIC_LINK 0x02
+
 typedef FsOpenNode* (*OpenVirtualNode)(const BoxedPtr<FsNode>& node, U32 flags, U32 data);
 
 class FsFileNode;
@@ -80,14 +87,19 @@ public:
     static std::vector<std::string> getFilesInNativeDirectoryWhereFileMatches(const std::string& dirPath, const std::string& startsWith, const std::string& endsWith, bool ignoreCase);
     static void trimTrailingSlash(std::string& s);
 
+    // must be called when the node at path is added or removed, cached lookups of it and anything below it are dropped
+    static void invalidatePathCache(const std::string& path);
+
     static std::string nativePathSeperator;
 
     static BoxedPtr<FsFileNode> rootNode;
+    static U32 pathCacheHits;
+    static U32 pathCacheMisses;
 	static void shutDown();
 private:
     friend class KUnixSocketObject;
 
-    static BoxedPtr<FsNode> getNodeFromLocalPath(const std::string& currentDirectory, const std::string& path, BoxedPtr<FsNode>& lastNode, std::vector<std::string>& missingParts, bool followLink, bool* isLink=NULL);
+    static BoxedPtr<FsNode> getNodeFromLocalPath(const std::string& currentDirectory, const std::string& path, BoxedPtr<FsNode>& lastNode, std::vector<std::string>& missingParts, bool followLink, bool* isLink=NULL, U32* followedLinks=NULL);
 
     static U32 nextNodeId;    
     static BOXEDWINE_MUTEX nextNodeIdMutex;
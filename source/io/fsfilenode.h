@@ -27,6 +27,14 @@ public:
     virtual U32 setTimes(U64 lastAccessTime, U32 lastAccessTimeNano, U64 lastModifiedTime, U32 lastModifiedTimeNano);
     static std::set<std::string> nonExecFileFullPaths;
 private:
+    // size of the file shared by its open nodes, they are the only thing that changes it while it is open, -1 if it
+    // needs to be read again.  A rename can replace the file while it is open, so it only applies to open nodes of the
+    // file with openLengthDev and openLengthIno.
+    S64 openLength;
+    U64 openLengthDev;
+    U64 openLengthIno;
+    BOXEDWINE_MUTEX openLengthMutex;
+
     friend class FsFileOpenNode;
     friend class FsDirOpenNode;
     friend class Platform;
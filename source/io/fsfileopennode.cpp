@@ -3,8 +3,18 @@
 #include UNISTD
 #include <fcntl.h>
 #include "fsfilenode.h"
+#include <sys/stat.h>
+#ifndef BOXEDWINE_MSVC
+#include <sys/uio.h>
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+#endif
 
-FsFileOpenNode::FsFileOpenNode(BoxedPtr<FsFileNode> node, U32 flags, U32 handle) : FsOpenNode(node, flags), fileNode(node), handle(handle) {
+FsFileOpenNode::FsFileOpenNode(BoxedPtr<FsFileNode> node, U32 flags, U32 handle) : FsOpenNode(node, flags), fileNode(node), handle(handle), dev(0), ino(0) {
+    // K_O_TRUNC or something outside of Boxedwine could have changed it since it was last open
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->fileNode->openLengthMutex);
+    this->readLength();
 }
 
 FsFileOpenNode::~FsFileOpenNode() {
@@ -12,14 +22,43 @@ FsFileOpenNode::~FsFileOpenNode() {
 }
 
 S64 FsFileOpenNode::length() {
-    S64 currentPos = lseek64(this->handle, 0, SEEK_CUR);
-    S64 size = lseek64(this->handle, 0, SEEK_END);
-    lseek64(this->handle, currentPos, SEEK_SET);
-    return size;
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->fileNode->openLengthMutex);
+    if (this->fileNode->openLength<0 || this->fileNode->openLengthDev!=this->dev || this->fileNode->openLengthIno!=this->ino) {
+        this->readLength();
+    }
+    return this->fileNode->openLength;
+}
+
+// caller must hold openLengthMutex, also refreshes dev and ino since reopen can open a file that replaced the one that was open
+void FsFileOpenNode::readLength() {
+    PLATFORM_STAT_STRUCT buf;
+    if (PLATFORM_FSTAT(this->handle, &buf)==0) {
+        this->dev = (U64)buf.st_dev;
+        this->ino = (U64)buf.st_ino;
+        this->fileNode->openLength = buf.st_size;
+    } else {
+        this->fileNode->openLength = -1;
+    }
+    this->fileNode->openLengthDev = this->dev;
+    this->fileNode->openLengthIno = this->ino;
+}
+
+// the lock makes sure a length() that read the size before the change finishes storing it before this clears it
+void FsFileOpenNode::lengthChanged() {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->fileNode->openLengthMutex);
+    if (this->fileNode->openLengthDev==this->dev && this->fileNode->openLengthIno==this->ino) {
+        this->fileNode->openLength = -1;
+    }
+}
+
+void FsFileOpenNode::syncedMapping() {
+    this->lengthChanged();
 }
 
 bool FsFileOpenNode::setLength(S64 len) {
-    return ftruncate(this->handle, (S32)len)==0;
+    bool result = ftruncate(this->handle, (S32)len)==0;
+    this->lengthChanged();
+    return result;
 }
 
 S64 FsFileOpenNode::getFilePointer() {
@@ -40,6 +79,10 @@ bool FsFileOpenNode::isOpen() {
     return this->handle!=0xFFFFFFFF;
 }
 
+S32 FsFileOpenNode::getNativeHandle() {
+    return (S32)this->handle;
+}
+
 void FsFileOpenNode::reopen() {
     int openFlags = O_BINARY;
     int flags = this->flags;
@@ -56,6 +99,8 @@ void FsFileOpenNode::reopen() {
     }
 
     this->handle = ::open(this->fileNode->nativePath.c_str(), openFlags, 0666);
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->fileNode->openLengthMutex);
+    this->readLength();
 }
 
 U32 FsFileOpenNode::ioctl(U32 request) {
@@ -96,5 +141,125 @@ U32 FsFileOpenNode::readNative(U8* buffer, U32 len) {
 }
 
 U32 FsFileOpenNode::writeNative(U8* buffer, U32 len) {
-    return (U32)::write(this->handle, buffer, len);
+    U32 result = (U32)::write(this->handle, buffer, len);
+    this->lengthChanged();
+    return result;
+}
+
+#ifdef BOXEDWINE_MSVC
+bool FsFileOpenNode::hasNativePositionalIO() {
+    return false;
+}
+
+U32 FsFileOpenNode::preadNative(U8* buffer, U32 len, S64 offset) {
+    return FsOpenNode::preadNative(buffer, len, offset);
+}
+
+U32 FsFileOpenNode::pwriteNative(U8* buffer, U32 len, S64 offset) {
+    U32 result = FsOpenNode::pwriteNative(buffer, len, offset);
+    this->lengthChanged();
+    return result;
+}
+
+U32 FsFileOpenNode::readv(U32 iov, S32 iovcnt) {
+    return FsOpenNode::readv(iov, iovcnt);
+}
+
+U32 FsFileOpenNode::writev(U32 iov, S32 iovcnt) {
+    return FsOpenNode::writev(iov, iovcnt);
+}
+
+U32 FsFileOpenNode::preadv(U32 iov, S32 iovcnt, S64 offset) {
+    return FsOpenNode::preadv(iov, iovcnt, offset);
+}
+
+U32 FsFileOpenNode::pwritev(U32 iov, S32 iovcnt, S64 offset) {
+    return FsOpenNode::pwritev(iov, iovcnt, offset);
+}
+#else
+bool FsFileOpenNode::hasNativePositionalIO() {
+    return true;
+}
+
+U32 FsFileOpenNode::preadNative(U8* buffer, U32 len, S64 offset) {
+    return (U32)::pread(this->handle, buffer, len, (off_t)offset);
+}
+
+U32 FsFileOpenNode::pwriteNative(U8* buffer, U32 len, S64 offset) {
+    U32 result = (U32)::pwrite(this->handle, buffer, len, (off_t)offset);
+    this->lengthChanged();
+    return result;
+}
+
+// returns false if part of the emulated iovec array isn't directly addressable or it needs more than one host call
+static bool getHostIoVecs(U32 iov, S32 iovcnt, bool intoMemory, std::vector<struct iovec>& results) {
+    Memory* memory = KThread::currentThread()->memory;
+
+    for (S32 i=0;i<iovcnt;i++) {
+        U32 address = readd(memory, iov + i * 8);
+        U32 len = readd(memory, iov + i * 8 + 4);
+
+        while (len) {
+            U32 todo = K_PAGE_SIZE-(address & (K_PAGE_SIZE-1));
+
+            if (todo>len)
+                todo = len;
+            U8* ram = intoMemory?getPhysicalWriteAddress(address, todo):getPhysicalReadAddress(address, todo);
+            if (!ram) {
+                return false;
+            }
+            // emulated pages are usually contiguous on the host
+            if (results.size() && (U8*)results.back().iov_base+results.back().iov_len==ram) {
+                results.back().iov_len+=todo;
+            } else {
+                if (results.size()==IOV_MAX) {
+                    return false;
+                }
+                struct iovec v;
+                v.iov_base = ram;
+                v.iov_len = todo;
+                results.push_back(v);
+            }
+            address+=todo;
+            len-=todo;
+        }
+    }
+    return true;
+}
+
+U32 FsFileOpenNode::readv(U32 iov, S32 iovcnt) {
+    std::vector<struct iovec> v;
+    if (!getHostIoVecs(iov, iovcnt, true, v)) {
+        return FsOpenNode::readv(iov, iovcnt);
+    }
+    return (U32)::readv(this->handle, v.data(), (int)v.size());
+}
+
+U32 FsFileOpenNode::writev(U32 iov, S32 iovcnt) {
+    std::vector<struct iovec> v;
+    if (!getHostIoVecs(iov, iovcnt, false, v)) {
+        return FsOpenNode::writev(iov, iovcnt);
+    }
+    U32 result = (U32)::writev(this->handle, v.data(), (int)v.size());
+    this->lengthChanged();
+    return result;
+}
+
+U32 FsFileOpenNode::preadv(U32 iov, S32 iovcnt, S64 offset) {
+    std::vector<struct iovec> v;
+    if (!getHostIoVecs(iov, iovcnt, true, v)) {
+        return FsOpenNode::preadv(iov, iovcnt, offset);
+    }
+    return (U32)::preadv(this->handle, v.data(), (int)v.size(), (off_t)offset);
+}
+
+U32 FsFileOpenNode::pwritev(U32 iov, S32 iovcnt, S64 offset) {
+    std::vector<struct iovec> v;
+    if (!getHostIoVecs(iov, iovcnt, false, v)) {
+        return FsOpenNode::pwritev(iov, iovcnt, offset);
+    }
+    U32 result = (U32)::pwritev(this->handle, v.data(), (int)v.size(), (off_t)offset);
+    this->lengthChanged();
+    return result;
 }
+#endif
@@ -24,13 +24,29 @@ public:
     virtual bool isReadReady();
     virtual U32 readNative(U8* buffer, U32 len);
     virtual U32 writeNative(U8* buffer, U32 len);
+    virtual U32 readv(U32 iov, S32 iovcnt);
+    virtual U32 writev(U32 iov, S32 iovcnt);
+    virtual U32 preadv(U32 iov, S32 iovcnt, S64 offset);
+    virtual U32 pwritev(U32 iov, S32 iovcnt, S64 offset);
+    virtual U32 preadNative(U8* buffer, U32 len, S64 offset);
+    virtual U32 pwriteNative(U8* buffer, U32 len, S64 offset);
+    virtual bool hasNativePositionalIO();
     virtual void close();
     virtual void reopen();
     virtual bool isOpen();
+    virtual S32 getNativeHandle();
+
+    virtual void syncedMapping();
 
 private:
+    void lengthChanged();
+    void readLength();
+
     BoxedPtr<FsFileNode> fileNode;
     U32 handle;
+    // identify the file that handle has open, MSVC always sets st_ino to 0 so there all open nodes of a path share openLength
+    U64 dev;
+    U64 ino;
 };
 
 #endif
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "boxedwine.h"
 
 #include "kstat.h"
+#ifdef BOXEDWINE_ZLIB
+#include "fszip.h"
+#endif
 
 FsNode::FsNode(Type type, U32 id, U32 rdev, const std::string& path, const std::string& link, const std::string& nativePath, bool isDirectory, BoxedPtr<FsNode> parent) : 
     path(path),
@@ -13,7 +16,9 @@ FsNode::FsNode(Type type, U32 id, U32 rdev, const std::string& path, const std::
     type(type),  
     parent(parent),
     isDir(isDirectory),  
-    hasLoadedChildrenFromFileSystem(false)
+    hasLoadedChildrenFromFileSystem(false),
+    addingChildren(false),
+    addedChildChangesPaths(false)
  {   
 }
 
@@ -32,13 +37,34 @@ bool FsNode::canWrite() {
 
 void FsNode::removeNodeFromParent() {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->parent->childrenByNameMutex);
-    this->parent->childrenByName.erase(this->name);
+    this->parent->removeChild(this->name);
+}
+
+void FsNode::removeChild(const std::string& name) {
+    auto child = this->childrenByName.find(name);
+    if (child == this->childrenByName.end()) {
+        return;
+    }
+    Fs::invalidatePathCache(child->second->path);
+    this->childrenByName.erase(child);
+    std::string lowerCaseName = name;
+    stringToLower(lowerCaseName);
+    auto range = this->childNamesByLowerCaseName.equal_range(lowerCaseName);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == name) {
+            this->childNamesByLowerCaseName.erase(it);
+            break;
+        }
+    }
 }
 
 void FsNode::loadChildren() {
     // don't need to protect from threads since this is private
     if (!this->hasLoadedChildrenFromFileSystem) {
         this->hasLoadedChildrenFromFileSystem = true;
+        // nothing below this directory could have been looked up before it was loaded, so only the links and
+        // directories it turns out to have can change a path that was resolved
+        this->addingChildren = true;
         if (this->nativePath.length()) {
             std::vector<Platform::ListNodeResult> results;
             Platform::listNodes(nativePath, results);
@@ -66,9 +92,40 @@ void FsNode::loadChildren() {
                 }           
             }
         }
+#ifdef BOXEDWINE_ZLIB
+        // added after the file system so that the zip's nodes replace any with the same name
+        for (auto& zip : this->zips) {
+            zip->addChildren(this);
+        }
+        this->zips.clear();
+#endif
+        this->endAddingChildren();
+    }
+}
+
+void FsNode::endAddingChildren() {
+    this->addingChildren = false;
+    if (this->addedChildChangesPaths) {
+        this->addedChildChangesPaths = false;
+        Fs::invalidatePathCache(this->path);
     }
 }
 
+#ifdef BOXEDWINE_ZLIB
+void FsNode::addZipChildren(const std::shared_ptr<FsZip>& zip) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->childrenByNameMutex);
+    if (this->hasLoadedChildrenFromFileSystem) {
+        // the directory could already have been looked up through, so any of the zip's entries can change a path
+        this->addingChildren = true;
+        this->addedChildChangesPaths = true;
+        zip->addChildren(this);
+        this->endAddingChildren();
+    } else {
+        this->zips.push_back(zip);
+    }
+}
+#endif
+
 BoxedPtr<FsNode> FsNode::getChildByName(const std::string& name) {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->childrenByNameMutex);
     this->loadChildren();
@@ -80,10 +137,11 @@ BoxedPtr<FsNode> FsNode::getChildByName(const std::string& name) {
 BoxedPtr<FsNode> FsNode::getChildByNameIgnoreCase(const std::string& name) {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->childrenByNameMutex);
     this->loadChildren();
-    for (auto& n : this->childrenByName) {
-        if (stringCaseInSensativeEquals(n.first, name)) {
-            return n.second;
-        }
+    std::string lowerCaseName = name;
+    stringToLower(lowerCaseName);
+    auto it = this->childNamesByLowerCaseName.find(lowerCaseName);
+    if (it != this->childNamesByLowerCaseName.end()) {
+        return this->childrenByName[it->second];
     }
     return NULL;
 }
@@ -97,13 +155,23 @@ U32 FsNode::getChildCount() {
 void FsNode::addChild(BoxedPtr<FsNode> node) {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->childrenByNameMutex);
     this->loadChildren();
+    if (!this->childrenByName.count(node->name)) {
+        std::string lowerCaseName = node->name;
+        stringToLower(lowerCaseName);
+        this->childNamesByLowerCaseName.insert(std::make_pair(lowerCaseName, node->name));
+    }
     this->childrenByName[node->name] = node;
+    if (!this->addingChildren) {
+        Fs::invalidatePathCache(node->path);
+    } else if (node->isLink() || node->isDirectory()) {
+        this->addedChildChangesPaths = true;
+    }
 }
 
 void FsNode::removeChildByName(const std::string& name) {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->childrenByNameMutex);
     this->loadChildren();
-    this->childrenByName.erase(name);
+    this->removeChild(name);
 }
 
 void FsNode::getAllChildren(std::vector<BoxedPtr<FsNode> > & results) {
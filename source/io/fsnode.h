@@ -8,6 +8,9 @@ class FsOpenNode;
 class KProcess;
 class KThread;
 class KObject;
+#ifdef BOXEDWINE_ZLIB
+class FsZip;
+#endif
 
 class FsNode : public BoxedPtrBase {
 public:
@@ -66,6 +69,11 @@ public:
     KFileLock* getLock(KFileLock* lock);
 
     void addOpenNode(KListNode<FsOpenNode*>* node);
+
+#ifdef BOXEDWINE_ZLIB
+    // the zip's entries for this directory are added the next time the children are needed
+    void addZipChildren(const std::shared_ptr<FsZip>& zip);
+#endif
 protected:
     BoxedPtr<FsNode> parent;
 
@@ -75,14 +83,24 @@ protected:
 private:
     const bool isDir;
     bool hasLoadedChildrenFromFileSystem;    
+    // set while children are added in bulk, addChild then leaves invalidating the path cache to endAddingChildren
+    bool addingChildren;
+    bool addedChildChangesPaths;
 
     std::unordered_map<std::string, BoxedPtr<FsNode> > childrenByName;
+    // lower case name to the key in childrenByName, more than one child can have the same lower case name
+    std::unordered_multimap<std::string, std::string> childNamesByLowerCaseName;
     BOXEDWINE_MUTEX childrenByNameMutex;
+#ifdef BOXEDWINE_ZLIB
+    std::vector<std::shared_ptr<FsZip> > zips; // zips that still need to add their entries for this directory
+#endif
 
     std::vector<KFileLock> locks;       
     BOXEDWINE_MUTEX locksMutex;    
 
     void loadChildren();
+    void removeChild(const std::string& name); // caller must hold childrenByNameMutex
+    void endAddingChildren(); // caller must hold childrenByNameMutex
 };
 
 #endif
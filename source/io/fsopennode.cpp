@@ -84,6 +84,163 @@ U32 FsOpenNode::write(U32 address, U32 len) {
     return wrote;
 }
 
+U32 FsOpenNode::pread(U32 address, U32 len, S64 offset) {
+    U32 result = 0;
+    while (len) {
+        U32 todo = K_PAGE_SIZE-(address & (K_PAGE_SIZE-1));
+        U32 didRead;
+
+        if (todo>len)
+            todo = len;
+        U8* ram = getPhysicalWriteAddress(address, todo);
+        if (ram) {
+            didRead = this->preadNative(ram, todo, offset);
+        } else {
+            char tmp[K_PAGE_SIZE];
+            didRead = this->preadNative((U8*)tmp, todo, offset);
+            if ((S32)didRead>0) {
+                memcopyFromNative(address, tmp, didRead);
+            }
+        }
+        if ((S32)didRead<=0) {
+            return result?result:didRead;
+        }
+        len-=didRead;
+        address+=didRead;
+        offset+=didRead;
+        result+=didRead;
+        if (didRead<todo) {
+            break; // end of file
+        }
+    }
+    return result;
+}
+
+U32 FsOpenNode::pwrite(U32 address, U32 len, S64 offset) {
+    U32 wrote = 0;
+    while (len) {
+        U32 todo = K_PAGE_SIZE-(address & (K_PAGE_SIZE-1));
+        U32 didWrite;
+
+        if (todo>len)
+            todo = len;
+        U8* ram = getPhysicalReadAddress(address, todo);
+        if (ram) {
+            didWrite = this->pwriteNative(ram, todo, offset);
+        } else {
+            char tmp[K_PAGE_SIZE];
+            memcopyToNative(address, tmp, todo);
+            didWrite = this->pwriteNative((U8*)tmp, todo, offset);
+        }
+        if ((S32)didWrite<=0) {
+            return wrote?wrote:didWrite;
+        }
+        len-=didWrite;
+        address+=didWrite;
+        offset+=didWrite;
+        wrote+=didWrite;
+    }
+    return wrote;
+}
+
+U32 FsOpenNode::preadNative(U8* buffer, U32 len, S64 offset) {
+    S64 previousOffset = this->getFilePointer();
+    this->seek(offset);
+    U32 result = this->readNative(buffer, len);
+    this->seek(previousOffset);
+    return result;
+}
+
+U32 FsOpenNode::pwriteNative(U8* buffer, U32 len, S64 offset) {
+    S64 previousOffset = this->getFilePointer();
+    this->seek(offset);
+    U32 result = this->writeNative(buffer, len);
+    this->seek(previousOffset);
+    return result;
+}
+
+U32 FsOpenNode::readv(U32 iov, S32 iovcnt) {
+    Memory* memory = KThread::currentThread()->memory;
+    U32 result = 0;
+
+    for (S32 i=0;i<iovcnt;i++) {
+        U32 buf = readd(memory, iov + i * 8);
+        U32 len = readd(memory, iov + i * 8 + 4);
+        U32 didRead = this->read(buf, len);
+
+        if ((S32)didRead<0) {
+            return result?result:didRead;
+        }
+        result+=didRead;
+        if (didRead<len) {
+            break;
+        }
+    }
+    return result;
+}
+
+U32 FsOpenNode::writev(U32 iov, S32 iovcnt) {
+    Memory* memory = KThread::currentThread()->memory;
+    U32 result = 0;
+
+    for (S32 i=0;i<iovcnt;i++) {
+        U32 buf = readd(memory, iov + i * 8);
+        U32 len = readd(memory, iov + i * 8 + 4);
+        U32 didWrite = this->write(buf, len);
+
+        if ((S32)didWrite<0) {
+            return result?result:didWrite;
+        }
+        result+=didWrite;
+        if (didWrite<len) {
+            break;
+        }
+    }
+    return result;
+}
+
+U32 FsOpenNode::preadv(U32 iov, S32 iovcnt, S64 offset) {
+    Memory* memory = KThread::currentThread()->memory;
+    U32 result = 0;
+
+    for (S32 i=0;i<iovcnt;i++) {
+        U32 buf = readd(memory, iov + i * 8);
+        U32 len = readd(memory, iov + i * 8 + 4);
+        U32 didRead = this->pread(buf, len, offset);
+
+        if ((S32)didRead<0) {
+            return result?result:didRead;
+        }
+        result+=didRead;
+        offset+=didRead;
+        if (didRead<len) {
+            break;
+        }
+    }
+    return result;
+}
+
+U32 FsOpenNode::pwritev(U32 iov, S32 iovcnt, S64 offset) {
+    Memory* memory = KThread::currentThread()->memory;
+    U32 result = 0;
+
+    for (S32 i=0;i<iovcnt;i++) {
+        U32 buf = readd(memory, iov + i * 8);
+        U32 len = readd(memory, iov + i * 8 + 4);
+        U32 didWrite = this->pwrite(buf, len, offset);
+
+        if ((S32)didWrite<0) {
+            return result?result:didWrite;
+        }
+        result+=didWrite;
+        offset+=didWrite;
+        if (didWrite<len) {
+            break;
+        }
+    }
+    return result;
+}
+
 void FsOpenNode::loadDirEntries() {
     BOXEDWINE_CRITICAL_SECTION;
     if (this->dirEntries.size()==0 && this->node) {
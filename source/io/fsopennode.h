@@ -10,6 +10,8 @@ public:
 
     U32 read(U32 address, U32 len); // will call into readNative
     U32 write(U32 address, U32 len); // will call into writeNative
+    U32 pread(U32 address, U32 len, S64 offset); // will call into preadNative
+    U32 pwrite(U32 address, U32 len, S64 offset); // will call into pwriteNative
 
     U32 getDirectoryEntryCount();
     BoxedPtr<FsNode> getDirectoryEntry(U32 index, std::string& name);
@@ -30,9 +32,20 @@ public:
     virtual bool isReadReady()=0;    
     virtual U32 readNative(U8* buffer, U32 len)=0;
     virtual U32 writeNative(U8* buffer, U32 len)=0;
+    virtual U32 readv(U32 iov, S32 iovcnt);
+    virtual U32 writev(U32 iov, S32 iovcnt);
+    virtual U32 preadv(U32 iov, S32 iovcnt, S64 offset);
+    virtual U32 pwritev(U32 iov, S32 iovcnt, S64 offset);
+    // the default seeks to offset and back, so the caller must keep anything else from using the file pointer
+    virtual U32 preadNative(U8* buffer, U32 len, S64 offset);
+    virtual U32 pwriteNative(U8* buffer, U32 len, S64 offset);
+    virtual bool hasNativePositionalIO() {return false;} // true if the positional calls never touch the file pointer
     virtual void close()=0;
     virtual void reopen()=0;
     virtual bool isOpen()=0;
+    virtual S32 getNativeHandle() {return -1;} // host file descriptor that can be mmap'd, -1 if there isn't one
+    virtual bool hasFixedContent() {return false;} // true if the content can never change, so it is safe to cache
+    virtual void syncedMapping() {} // msync was called on a shared mapping of this, the host might have written to it
 
     BoxedPtr<FsNode> const node;
     const U32 flags;     
@@ -9,26 +9,275 @@ extern "C"
 #include "fsfilenode.h"
 #include "fszip.h"
 #include "fszipnode.h"
+#include UNISTD
+#include <fcntl.h>
 #include <time.h> 
 
-void FsZip::setupZipRead(U64 zipOffset, U64 zipFileOffset) {
-#ifdef BOXEDWINE_ZLIB
-    char tmp[4096];
-
-    if (zipOffset != lastZipOffset || zipFileOffset < lastZipFileOffset) {
-        unzCloseCurrentFile(this->zipfile);
-        unzSetOffset64(this->zipfile, zipOffset);
-        lastZipFileOffset = 0;
-        unzOpenCurrentFile(this->zipfile);
-        lastZipOffset = zipOffset;
-    }
-    if (zipFileOffset != lastZipFileOffset) {
-        U32 todo = (U32)(zipFileOffset - lastZipFileOffset);
-        while (todo) {
-            todo-=unzReadCurrentFile(this->zipfile, tmp, todo>4096?4096:todo);
+// Decompressed data is cached in chunks so that seeking backwards, like the loader does when it goes back to the PE
+// header, or switching between files doesn't mean inflating the entry again from the start.
+#define FS_ZIP_CHUNK_SIZE (64 * 1024)
+#define FS_ZIP_CACHE_SIZE (32 * 1024 * 1024)
+// The inflate state is saved every 16 chunks, about 40KB for every 1MB, so that a read deep into an entry that isn't
+// cached only has to inflate from the closest checkpoint before it.
+#define FS_ZIP_CHECKPOINT_CHUNKS 16
+#define FS_ZIP_MAX_FREE_READERS 4
+
+class FsZipCachedChunk {
+public:
+    FsZipCachedChunk(const std::tuple<U32, U64, U64>& key, const std::shared_ptr<std::vector<U8> >& data) : key(key), data(data) {}
+    std::tuple<U32, U64, U64> key; // zip id, entry offset in the zip, chunk index
+    std::shared_ptr<std::vector<U8> > data;
+};
+
+static std::list<FsZipCachedChunk> cachedChunks; // most recently used first
+static std::map<std::tuple<U32, U64, U64>, std::list<FsZipCachedChunk>::iterator> cachedChunksByKey;
+static U32 cachedChunksSize;
+static BOXEDWINE_MUTEX cachedChunksMutex;
+static U32 nextZipId;
+
+static std::shared_ptr<std::vector<U8> > getCachedChunk(const std::tuple<U32, U64, U64>& key) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(cachedChunksMutex);
+    auto it = cachedChunksByKey.find(key);
+    if (it == cachedChunksByKey.end()) {
+        return NULL;
+    }
+    cachedChunks.splice(cachedChunks.begin(), cachedChunks, it->second);
+    return it->second->data;
+}
+
+static void addCachedChunk(const std::tuple<U32, U64, U64>& key, const std::shared_ptr<std::vector<U8> >& data) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(cachedChunksMutex);
+    if (cachedChunksByKey.count(key)) {
+        return; // another thread inflated it at the same time
+    }
+    cachedChunks.emplace_front(key, data);
+    cachedChunksByKey[key] = cachedChunks.begin();
+    cachedChunksSize += (U32)data->size();
+    while (cachedChunksSize > FS_ZIP_CACHE_SIZE) {
+        FsZipCachedChunk& chunk = cachedChunks.back();
+        cachedChunksSize -= (U32)chunk.data->size();
+        cachedChunksByKey.erase(chunk.key);
+        cachedChunks.pop_back();
+    }
+}
+
+FsZipReader::~FsZipReader() {
+    if (this->inflating) {
+        inflateEnd(&this->strm);
+    }
+    if (this->handle >= 0) {
+        ::close(this->handle);
+    }
+}
+
+std::shared_ptr<FsZipEntry> FsZip::getEntry(U64 zipOffset) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->entriesMutex);
+    auto it = this->openedEntries.find(zipOffset);
+    if (it != this->openedEntries.end()) {
+        return it->second;
+    }
+    // minizip is only used to find the compressed data, it is inflated directly so that the state can be saved
+    unz_file_info64 info;
+    if (unzSetOffset64(this->zipfile, zipOffset) != UNZ_OK || unzGetCurrentFileInfo64(this->zipfile, &info, NULL, 0, NULL, 0, NULL, 0) != UNZ_OK) {
+        return NULL;
+    }
+    if ((info.flag & 1) || (info.compression_method != 0 && info.compression_method != Z_DEFLATED)) {
+        klog("%s: encrypted or unsupported compression method %d", this->zipPath.c_str(), (int)info.compression_method);
+        return NULL;
+    }
+    if (unzOpenCurrentFile(this->zipfile) != UNZ_OK) {
+        return NULL;
+    }
+    std::shared_ptr<FsZipEntry> result = std::make_shared<FsZipEntry>();
+    result->dataOffset = unzGetCurrentFileZStreamPos64(this->zipfile);
+    result->compressedSize = info.compressed_size;
+    result->method = (U32)info.compression_method;
+    unzCloseCurrentFile(this->zipfile);
+    this->openedEntries[zipOffset] = result;
+    return result;
+}
+
+FsZipReader* FsZip::getReader(U64 zipOffset, U64 pos) {
+    {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->readersMutex);
+        // prefer a handle that can keep going forward in this entry, otherwise any free handle will do
+        S32 found = -1;
+        for (U32 i = 0; i < this->readers.size(); i++) {
+            if (this->readers[i]->zipOffset == zipOffset && this->readers[i]->pos <= pos && (found < 0 || this->readers[i]->pos > this->readers[found]->pos)) {
+                found = i;
+            }
         }
-    }  
-#endif
+        if (found < 0 && this->readers.size()) {
+            found = (S32)this->readers.size() - 1;
+        }
+        if (found >= 0) {
+            FsZipReader* result = this->readers[found];
+            this->readers.erase(this->readers.begin() + found);
+            return result;
+        }
+    }
+    // every handle is busy on another thread, reads from different files shouldn't have to wait for each other
+    int handle = ::open(this->zipPath.c_str(), O_RDONLY | O_BINARY);
+    if (handle < 0) {
+        return NULL;
+    }
+    return new FsZipReader(handle);
+}
+
+// only a few handles are kept around for later, the others were only needed while a lot of threads read at once
+void FsZip::releaseReader(FsZipReader* reader) {
+    {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->readersMutex);
+        if (this->readers.size() < FS_ZIP_MAX_FREE_READERS) {
+            this->readers.push_back(reader);
+            return;
+        }
+    }
+    delete reader;
+}
+
+// moves reader to the closest checkpoint at or before pos, or the start of the entry if there isn't one
+void FsZip::startReader(FsZipReader* reader, const std::shared_ptr<FsZipEntry>& entry, U64 zipOffset, U64 pos) {
+    std::shared_ptr<FsZipCheckpoint> checkpoint;
+    {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->entriesMutex);
+        auto it = std::upper_bound(entry->checkpoints.begin(), entry->checkpoints.end(), pos, [](U64 pos, const std::shared_ptr<FsZipCheckpoint>& checkpoint) {
+            return pos < checkpoint->pos;
+        });
+        if (it != entry->checkpoints.begin()) {
+            checkpoint = *(it - 1);
+        }
+    }
+    if (reader->zipOffset == zipOffset && reader->pos <= pos && (!checkpoint || reader->pos >= checkpoint->pos)) {
+        return; // going forward from where it is is closer
+    }
+    if (reader->inflating) {
+        inflateEnd(&reader->strm);
+        reader->inflating = false;
+    }
+    reader->zipOffset = 0xFFFFFFFFFFFFFFFFl;
+    if (checkpoint) {
+        if (inflateCopy(&reader->strm, &checkpoint->strm) != Z_OK) {
+            return;
+        }
+        reader->pos = checkpoint->pos;
+        reader->in = checkpoint->in;
+    } else {
+        memset(&reader->strm, 0, sizeof(reader->strm));
+        if (inflateInit2(&reader->strm, -MAX_WBITS) != Z_OK) {
+            return;
+        }
+        reader->pos = 0;
+        reader->in = 0;
+    }
+    // the copy still points to the input of the reader that saved it
+    reader->strm.next_in = reader->input;
+    reader->strm.avail_in = 0;
+    reader->inflating = true;
+    reader->zipOffset = zipOffset;
+}
+
+bool FsZip::inflateChunk(FsZipReader* reader, const std::shared_ptr<FsZipEntry>& entry, U8* buffer, U32 len) {
+    reader->strm.next_out = buffer;
+    reader->strm.avail_out = len;
+    while (reader->strm.avail_out) {
+        if (!reader->strm.avail_in && reader->in < entry->compressedSize) {
+            U32 todo = (U32)std::min((U64)sizeof(reader->input), entry->compressedSize - reader->in);
+            if (lseek64(reader->handle, entry->dataOffset + reader->in, SEEK_SET) < 0 || ::read(reader->handle, reader->input, todo) != (int)todo) {
+                return false;
+            }
+            reader->strm.next_in = reader->input;
+            reader->strm.avail_in = todo;
+            reader->in += todo;
+        }
+        int status = inflate(&reader->strm, Z_NO_FLUSH);
+        if (status == Z_STREAM_END) {
+            return reader->strm.avail_out == 0;
+        }
+        if (status != Z_OK) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::shared_ptr<std::vector<U8> > FsZip::getChunk(U64 zipOffset, U64 length, U64 chunk) {
+    std::shared_ptr<std::vector<U8> > result = getCachedChunk(std::make_tuple(this->id, zipOffset, chunk));
+    if (result) {
+        return result;
+    }
+    std::shared_ptr<FsZipEntry> entry = this->getEntry(zipOffset);
+    if (!entry) {
+        return NULL;
+    }
+    U64 chunkPos = chunk * FS_ZIP_CHUNK_SIZE;
+    U32 chunkLen = (U32)std::min((U64)FS_ZIP_CHUNK_SIZE, length - chunkPos);
+    FsZipReader* reader = this->getReader(zipOffset, chunkPos);
+    if (!reader) {
+        return NULL;
+    }
+    if (entry->method == 0) {
+        // stored, it can be read straight out of the zip
+        result = std::make_shared<std::vector<U8> >(chunkLen);
+        if (lseek64(reader->handle, entry->dataOffset + chunkPos, SEEK_SET) < 0 || ::read(reader->handle, result->data(), chunkLen) != (int)chunkLen) {
+            result = NULL;
+        }
+    } else {
+        this->startReader(reader, entry, zipOffset, chunkPos);
+        // reader->pos is always at the start of a chunk since whole chunks are read, only the chunk that was asked
+        // for is cached so that a cold read deep into a big entry doesn't push everything else out of the cache
+        while (reader->zipOffset == zipOffset && reader->pos <= chunkPos) {
+            if (reader->pos && reader->pos % (FS_ZIP_CHUNK_SIZE * FS_ZIP_CHECKPOINT_CHUNKS) == 0) {
+                std::shared_ptr<FsZipCheckpoint> checkpoint = std::make_shared<FsZipCheckpoint>(reader->pos, reader->in - reader->strm.avail_in);
+                BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->entriesMutex);
+                auto it = std::lower_bound(entry->checkpoints.begin(), entry->checkpoints.end(), reader->pos, [](const std::shared_ptr<FsZipCheckpoint>& checkpoint, U64 pos) {
+                    return checkpoint->pos < pos;
+                });
+                if ((it == entry->checkpoints.end() || (*it)->pos != reader->pos) && inflateCopy(&checkpoint->strm, &reader->strm) == Z_OK) {
+                    entry->checkpoints.insert(it, checkpoint);
+                }
+            }
+            U32 len = (U32)std::min((U64)FS_ZIP_CHUNK_SIZE, length - reader->pos);
+            std::shared_ptr<std::vector<U8> > data = std::make_shared<std::vector<U8> >(len);
+            if (!this->inflateChunk(reader, entry, data->data(), len)) {
+                // corrupt or truncated entry, start over next time
+                reader->zipOffset = 0xFFFFFFFFFFFFFFFFl;
+                break;
+            }
+            reader->pos += len;
+            result = data;
+        }
+        if (reader->zipOffset != zipOffset) {
+            result = NULL;
+        }
+    }
+    if (result) {
+        addCachedChunk(std::make_tuple(this->id, zipOffset, chunk), result);
+    }
+    this->releaseReader(reader);
+    return result;
+}
+
+U32 FsZip::read(U64 zipOffset, U64 length, U64 pos, U8* buffer, U32 len) {
+    U32 result = 0;
+
+    while (result < len && pos < length) {
+        std::shared_ptr<std::vector<U8> > data = this->getChunk(zipOffset, length, pos / FS_ZIP_CHUNK_SIZE);
+        if (!data) {
+            break;
+        }
+        U32 chunkOffset = (U32)(pos % FS_ZIP_CHUNK_SIZE);
+        U32 todo = std::min(len - result, (U32)data->size() - chunkOffset);
+        memcpy(buffer + result, data->data() + chunkOffset, todo);
+        result += todo;
+        pos += todo;
+    }
+    return result;
+}
+
+// compares the directory part of path with dir
+static int compareParentPath(const std::string& path, const std::string& dir) {
+    return path.compare(0, path.rfind('/'), dir);
 }
 
 bool FsZip::init(const std::string& zipPath, const std::string& mount) {
@@ -39,11 +288,14 @@ bool FsZip::init(const std::string& zipPath, const std::string& mount) {
         Fs::makeLocalDirs(mount);
         strippedMount = mount.substr(0, mount.length() - 1);
     }
-    this->lastZipOffset = 0xFFFFFFFFFFFFFFFFl;
+    {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(cachedChunksMutex);
+        this->id = nextZipId++;
+    }
+    this->zipPath = zipPath;
     if (zipPath.length()) {
         unz_global_info global_info;
         U32 i;
-        fsZipInfo* zipInfo;
 
         this->zipfile = unzOpen(zipPath.c_str());
         if (!this->zipfile) {
@@ -55,37 +307,33 @@ bool FsZip::init(const std::string& zipPath, const std::string& mount) {
             unzClose( this->zipfile );
             return false;
         }
-        zipInfo = new fsZipInfo[global_info.number_entry];
+        // only the central directory is read here, the nodes are created as each directory is used and the
+        // contents of links are read then too
+        this->entries.reserve(global_info.number_entry);
         for (i = 0; i < global_info.number_entry; ++i) {
             unz_file_info file_info;
             struct tm tm={0};
             char tmp[MAX_FILEPATH_LEN];
+            fsZipInfo zipInfo;
 
-            zipInfo[i].filename="/";
+            zipInfo.filename="/";
             if ( unzGetCurrentFileInfo(this->zipfile, &file_info, tmp, MAX_FILEPATH_LEN, NULL, 0, NULL, 0 ) != UNZ_OK ) {
                 klog("Could not read file info from zip file: %s", zipPath.c_str());
                 unzClose( zipfile );
                 return false;
             }
-            zipInfo[i].filename.append(tmp);
-            zipInfo[i].offset = unzGetOffset64(this->zipfile);
-            Fs::remoteNameToLocal(zipInfo[i].filename); // converts special characters like :
-            if (stringHasEnding(zipInfo[i].filename, ".link")) {
-                U32 read;
-
-                zipInfo[i].filename.resize(zipInfo[i].filename.length()-5);
-                zipInfo[i].isLink = true;
-                unzOpenCurrentFile(zipfile);
-                read = unzReadCurrentFile(this->zipfile, tmp, MAX_FILEPATH_LEN);
-                tmp[read]=0;
-                zipInfo[i].link = tmp;                
-                unzCloseCurrentFile(this->zipfile);
+            zipInfo.filename.append(tmp);
+            zipInfo.offset = unzGetOffset64(this->zipfile);
+            Fs::remoteNameToLocal(zipInfo.filename); // converts special characters like :
+            if (stringHasEnding(zipInfo.filename, ".link")) {
+                zipInfo.filename.resize(zipInfo.filename.length()-5);
+                zipInfo.isLink = true;
             }                       
-            if (stringHasEnding(zipInfo[i].filename, "/")) {
-                zipInfo[i].filename.resize(zipInfo[i].filename.length()-1);
-                zipInfo[i].isDirectory = true;
+            if (stringHasEnding(zipInfo.filename, "/")) {
+                zipInfo.filename.resize(zipInfo.filename.length()-1);
+                zipInfo.isDirectory = true;
             } else {
-                zipInfo[i].length = file_info.uncompressed_size;
+                zipInfo.length = file_info.uncompressed_size;
             }               
             tm.tm_sec = file_info.tmu_date.tm_sec;
             tm.tm_min = file_info.tmu_date.tm_min;
@@ -96,31 +344,88 @@ bool FsZip::init(const std::string& zipPath, const std::string& mount) {
             if (tm.tm_year>1900)
                 tm.tm_year-=1900;
 
-            zipInfo[i].lastModified = ((U64)mktime(&tm))*1000l;
+            zipInfo.lastModified = ((U64)mktime(&tm))*1000l;
 
             unzGoToNextFile(this->zipfile);
+
+            if (zipInfo.filename.length() > 1) {
+                zipInfo.filename = strippedMount + zipInfo.filename;
+                this->entries.push_back(zipInfo);
+            }
+        }
+        // stable so that if an entry is in the zip more than once, the last one still wins like it would if the
+        // nodes were added in zip order
+        std::stable_sort(this->entries.begin(), this->entries.end(), [](const fsZipInfo& a, const fsZipInfo& b) {
+            int result = a.filename.compare(0, a.filename.rfind('/'), b.filename, 0, b.filename.rfind('/'));
+            if (result) {
+                return result < 0;
+            }
+            return a.filename < b.filename;
+        });
+        BoxedPtr<FsNode> mountNode = Fs::getNodeFromLocalPath("", strippedMount, true);
+        if (mountNode) {
+            mountNode->addZipChildren(shared_from_this());
         }
-        for (i = 0; i < global_info.number_entry; ++i) {
-            std::string localZipPart = zipInfo[i].filename;
-            Fs::remoteNameToLocal(localZipPart);
-            std::string localPath = strippedMount + localZipPart;
-            std::string parentPath = Fs::getParentPath(localPath);
-            BoxedPtr<FsNode> parent = Fs::getNodeFromLocalPath("", parentPath, true);            
-            std::string localFileName = Fs::getFileNameFromPath(localPath);
-            std::string nativePath = Fs::getNativePathFromParentAndLocalFilename(parent, localFileName);
-            BoxedPtr<FsFileNode> node = (FsFileNode*)Fs::addFileNode(localPath, zipInfo[i].link, nativePath, zipInfo[i].isDirectory, parent).get();
-            std::shared_ptr<FsZip> thisShared = shared_from_this();
-            node->zipNode = std::make_shared<FsZipNode>(zipInfo[i], thisShared);
-        }   
-        delete[] zipInfo;
     }
 #endif
     return true;
 }
 
+void FsZip::addChildren(const BoxedPtr<FsNode>& parent) {
+#ifdef BOXEDWINE_ZLIB
+    std::string dirPath = (parent->path == "/") ? "" : parent->path;
+    std::shared_ptr<FsZip> thisShared = shared_from_this();
+    unzFile linkZip = NULL; // links are read with their own handle so that they don't disturb FsZipOpenNode reads
+
+    auto it = std::lower_bound(this->entries.begin(), this->entries.end(), dirPath, [](const fsZipInfo& info, const std::string& dir) {
+        return compareParentPath(info.filename, dir) < 0;
+    });
+    for (; it != this->entries.end() && compareParentPath(it->filename, dirPath) == 0; ++it) {
+        fsZipInfo& zipInfo = *it;
+        std::string localFileName = Fs::getFileNameFromPath(zipInfo.filename);
+
+        if (zipInfo.isDirectory) {
+            // another zip, or the file system, already has this directory, this zip's entries are added to it
+            BoxedPtr<FsNode> existing = parent->getChildByName(localFileName);
+            if (existing && existing->isDirectory()) {
+                existing->addZipChildren(thisShared);
+                continue;
+            }
+        }
+        if (zipInfo.isLink && !zipInfo.link.length()) {
+            if (!linkZip) {
+                linkZip = unzOpen(this->zipPath.c_str());
+            }
+            if (linkZip) {
+                char tmp[MAX_FILEPATH_LEN];
+
+                unzSetOffset64(linkZip, zipInfo.offset);
+                unzOpenCurrentFile(linkZip);
+                int read = unzReadCurrentFile(linkZip, tmp, MAX_FILEPATH_LEN - 1);
+                unzCloseCurrentFile(linkZip);
+                tmp[read > 0 ? read : 0] = 0;
+                zipInfo.link = tmp;
+            }
+        }
+        std::string nativePath = Fs::getNativePathFromParentAndLocalFilename(parent, localFileName);
+        BoxedPtr<FsFileNode> node = (FsFileNode*)Fs::addFileNode(zipInfo.filename, zipInfo.link, nativePath, zipInfo.isDirectory, parent).get();
+        node->zipNode = std::make_shared<FsZipNode>(zipInfo, thisShared);
+        if (zipInfo.isDirectory) {
+            node->addZipChildren(thisShared);
+        }
+    }
+    if (linkZip) {
+        unzClose(linkZip);
+    }
+#endif
+}
+
 FsZip::~FsZip() {
 #ifdef BOXEDWINE_ZLIB
     unzClose(this->zipfile);
+    for (auto& reader : this->readers) {
+        delete reader;
+    }
 #endif
 }
 
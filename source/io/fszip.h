@@ -25,21 +25,74 @@ public:
     U64 offset;
 };
 
+class FsNode;
+
+// the inflate state at a chunk boundary of an entry, a read past it can start there instead of at the start of the entry
+class FsZipCheckpoint {
+public:
+    FsZipCheckpoint(U64 pos, U64 in) : pos(pos), in(in) {memset(&this->strm, 0, sizeof(this->strm));}
+    ~FsZipCheckpoint() {inflateEnd(&this->strm);}
+    U64 pos; // uncompressed offset
+    U64 in; // compressed bytes that were consumed to get to pos
+    z_stream strm;
+};
+
+// where the compressed data of an entry starts, looked up the first time the entry is read
+class FsZipEntry {
+public:
+    FsZipEntry() : dataOffset(0), compressedSize(0), method(0) {}
+    U64 dataOffset;
+    U64 compressedSize;
+    U32 method;
+    std::vector<std::shared_ptr<FsZipCheckpoint> > checkpoints; // sorted by pos, guarded by FsZip::entriesMutex
+};
+
+// a handle to the zip file along with the entry it is inflating and how far into it it has read, it can't be copied
+// since zlib keeps a pointer to strm
+class FsZipReader {
+public:
+    FsZipReader(int handle) : handle(handle), inflating(false), zipOffset(0xFFFFFFFFFFFFFFFFl), pos(0), in(0) {memset(&this->strm, 0, sizeof(this->strm));}
+    ~FsZipReader();
+    int handle;
+    z_stream strm;
+    bool inflating; // strm has been initialized
+    U64 zipOffset;
+    U64 pos;
+    U64 in; // compressed bytes of the entry that have been read into input
+    U8 input[16 * 1024];
+};
+
 class FsZip : public std::enable_shared_from_this<FsZip> {
 public:
     ~FsZip();
     bool init(const std::string& zipPath, const std::string& mount);
+    // creates the nodes for the zip entries that are directly in parent, init only builds the index
+    void addChildren(const BoxedPtr<FsNode>& parent);
     unzFile zipfile;
 
-    U64 lastZipOffset = 0xFFFFFFFFFFFFFFFFl;
-    U64 lastZipFileOffset;
-
-    void setupZipRead(U64 zipOffset, U64 zipFileOffset);
+    // reads len bytes starting at pos of the entry at zipOffset, returns the number of bytes read
+    U32 read(U64 zipOffset, U64 length, U64 pos, U8* buffer, U32 len);
 
     static bool readFileFromZip(const std::string& zipFile, const std::string& file, std::string& result);
     static bool extractFileFromZip(const std::string& zipFile, const std::string& file, const std::string& path);
     static std::string unzip(const std::string& zipFile, const std::string& path, std::function<void(U32, std::string)> percentDone);
     static bool iterateFiles(const std::string& zipFile, std::function<void(const std::string&)> it);
+
+private:
+    std::shared_ptr<std::vector<U8> > getChunk(U64 zipOffset, U64 length, U64 chunk);
+    std::shared_ptr<FsZipEntry> getEntry(U64 zipOffset);
+    FsZipReader* getReader(U64 zipOffset, U64 pos);
+    void releaseReader(FsZipReader* reader);
+    void startReader(FsZipReader* reader, const std::shared_ptr<FsZipEntry>& entry, U64 zipOffset, U64 pos);
+    bool inflateChunk(FsZipReader* reader, const std::shared_ptr<FsZipEntry>& entry, U8* buffer, U32 len);
+
+    U32 id;
+    std::string zipPath;
+    std::vector<FsZipReader*> readers; // handles that aren't being used right now
+    BOXEDWINE_MUTEX readersMutex;
+    std::map<U64, std::shared_ptr<FsZipEntry> > openedEntries; // by the offset of the entry in the zip
+    BOXEDWINE_MUTEX entriesMutex;
+    std::vector<fsZipInfo> entries; // sorted by parent directory so that the entries of a directory are next to each other
 };
 #endif
 #endif
@@ -39,6 +39,11 @@ bool FsZipOpenNode::isOpen() {
     return true;
 }
 
+bool FsZipOpenNode::hasFixedContent() {
+    // a zip file that is opened for writing is copied out of the zip first
+    return true;
+}
+
 U32 FsZipOpenNode::ioctl(U32 request) {
     return -K_ENODEV;
 }
@@ -73,13 +78,8 @@ bool FsZipOpenNode::canMap() {
 }
 
 U32 FsZipOpenNode::readNative(U8* buffer, U32 len) {
-    U32 result;
-    BOXEDWINE_CRITICAL_SECTION;
-
-    this->zipNode->fsZip->setupZipRead(this->offset, this->pos);    
-    result = unzReadCurrentFile(this->zipNode->fsZip->zipfile, buffer, len);
+    U32 result = this->zipNode->fsZip->read(this->offset, this->zipNode->length(), this->pos, buffer, len);
     this->pos+=result;
-    this->zipNode->fsZip->lastZipFileOffset = this->pos;
     return result;
 }
 
@@ -25,6 +25,7 @@ public:
     virtual void close();
     virtual void reopen();
     virtual bool isOpen();
+    virtual bool hasFixedContent();
 
 private:
     std::shared_ptr<FsZipNode> zipNode;
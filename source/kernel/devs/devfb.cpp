@@ -26,7 +26,6 @@
 #include "../../../platform/sdl/sdlcallback.h"
 
 static U32 screenBPP=32;
-static U32 updateAvailable;
 static U32 paletteChanged;
 static U8* screenPixels;
 #ifdef BOXEDWINE_64BIT_MMU
@@ -323,39 +322,53 @@ void fbSetupScreenForMesa(int width, int height, int depth) {
     bOpenGL = 1;	
 }
 
-void fbSetupScreen() {
-    bOpenGL = 0;
-    DISPATCH_MAIN_THREAD_BLOCK_BEGIN
-    destroySDL2();
-    sdlWindow = SDL_CreateWindow("", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, fb_var_screeninfo.xres, fb_var_screeninfo.yres, SDL_WINDOW_SHOWN);
-    sdlRenderer = SDL_CreateRenderer(sdlWindow, -1, 0);
-    sdlTexture = SDL_CreateTexture(sdlRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, fb_var_screeninfo.xres, fb_var_screeninfo.yres);    
+#ifdef BOXEDWINE_DEFAULT_MMU
+// Reads go straight to screenPixels.  Writes only do that once a page has been written to since the last flip, the
+// first write after a flip comes through FBPage which marks the page as dirty before giving the mmu a write pointer.
+// flipFB then only needs to upload the rows covered by the dirty pages, and takes the write pointers back.
+#define FB_MAX_PAGES ((16 * 1024 * 1024) >> K_PAGE_SHIFT)
 
-    SDL_ShowCursor(0);
-    DISPATCH_MAIN_THREAD_BLOCK_END
+class FBPage;
 
-    fb_fix_screeninfo.visual = 2; // FB_VISUAL_TRUECOLOR
-    fb_fix_screeninfo.type = 0; // FB_TYPE_PACKED_PIXELS
-    //fb_fix_screeninfo.smem_start = ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS;		
+static std::vector<FBPage*> fbPages;
+static U32 fbDirtyPages[FB_MAX_PAGES / 32];
+static bool fbDirty;
+static U32 screenPixelsSize;
 
-    fb_var_screeninfo.red.offset = 16;
-    fb_var_screeninfo.green.offset = 8;
-    fb_var_screeninfo.blue.offset = 0;
-    fb_var_screeninfo.red.length = 8;			
-    fb_var_screeninfo.green.length = 8;		
-    fb_var_screeninfo.blue.length = 8;
-    fb_fix_screeninfo.line_length = 4 * fb_var_screeninfo.xres;
-#ifndef BOXEDWINE_64BIT_MMU
-    screenPixels = new U8[fb_fix_screeninfo.line_length*fb_var_screeninfo.yres];
-#endif
-    updateAvailable = 1;
-    
-    fb_fix_screeninfo.smem_len = fb_fix_screeninfo.line_length*fb_var_screeninfo.yres_virtual;	
+static bool isFbPageDirty(U32 index) {
+    return index < FB_MAX_PAGES && (fbDirtyPages[index >> 5] & (1 << (index & 31))) != 0;
+}
+
+static void markFbDirty(U32 offset, U32 len) {
+    if (!len || offset >= FB_MAX_PAGES * K_PAGE_SIZE) {
+        return;
+    }
+    U32 lastPage = std::min((offset + len - 1) >> K_PAGE_SHIFT, (U32)FB_MAX_PAGES - 1);
+    for (U32 i = offset >> K_PAGE_SHIFT; i <= lastPage; i++) {
+        fbDirtyPages[i >> 5] |= 1 << (i & 31);
+    }
+    fbDirty = true;
+}
+
+static void markFbAllDirty() {
+    memset(fbDirtyPages, 0xFF, sizeof(fbDirtyPages));
+    fbDirty = true;
+}
+
+// NULL if the bytes aren't backed by screenPixels
+static U8* getFbPixels(U32 address, U32 len) {
+    U32 offset = address - ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS;
+    if (bOpenGL || !screenPixels || offset >= screenPixelsSize || screenPixelsSize - offset < len) {
+        return NULL;
+    }
+    return screenPixels + offset;
 }
 
 class FBPage : public Page {
 public:
-    FBPage(U32 flags) : Page(Frame_Buffer, flags) {}
+    FBPage(Memory* memory, U32 address, U32 flags) : Page(Frame_Buffer, flags), memory(memory), address(address) {
+        fbPages.push_back(this);
+    }
 
     U8 readb(U32 address);
     void writeb(U32 address, U8 value);
@@ -369,51 +382,75 @@ public:
     U8* getWriteAddress(U32 address, U32 len);
     U8* getReadWriteAddress(U32 address, U32 len);
     bool inRam() {return true;}
-    void close() {delete this;}
+    void close() {VECTOR_REMOVE(fbPages, this); delete this;}
+
+    // called after a flip or after screenPixels changes, the next write will come through this page again
+    void resetPtrs();
+
+    U32 getIndex() {return (this->address - ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS) >> K_PAGE_SHIFT;}
+
+private:
+    void onWrite();
+
+    Memory* memory;
+    U32 address;
 };
 
-Page* allocFBPage(U32 flags) {
-    return new FBPage(flags);
+Page* allocFBPage(Memory* memory, U32 address, U32 flags) {
+    return new FBPage(memory, address, flags);
 }
 
-U8 FBPage::readb(U32 address) {	
-    if (!bOpenGL && (address-ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS)<fb_fix_screeninfo.smem_len)
-        return ((U8*)screenPixels)[address-ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS];
-    return 0;
+void FBPage::onWrite() {
+    markFbDirty(this->address - ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS, K_PAGE_SIZE);
+    this->memory->mmuWritePtr[this->address >> K_PAGE_SHIFT] = getFbPixels(this->address, K_PAGE_SIZE);
+}
+
+void FBPage::resetPtrs() {
+    this->memory->mmuReadPtr[this->address >> K_PAGE_SHIFT] = this->getCurrentReadPtr();
+    this->memory->mmuWritePtr[this->address >> K_PAGE_SHIFT] = NULL;
+}
+
+U8 FBPage::readb(U32 address) {
+    U8* p = getFbPixels(address, 1);
+    return p ? *p : 0;
 }
 
 void FBPage::writeb(U32 address, U8 value) {
-    updateAvailable=1;
-    if (!bOpenGL && (address-ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS)<fb_fix_screeninfo.smem_len)
-        ((U8*)screenPixels)[address-ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS] = value;
+    U8* p = getFbPixels(address, 1);
+    if (p) {
+        *p = value;
+    }
+    this->onWrite();
 }
 
 U16 FBPage::readw(U32 address) {
-    if (!bOpenGL && (address-ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS)<fb_fix_screeninfo.smem_len)
-        return ((U16*)screenPixels)[(address-ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS)>>1];
-    return 0;
+    U8* p = getFbPixels(address, 2);
+    return p ? *(U16*)p : 0;
 }
 
 void FBPage::writew(U32 address, U16 value) {
-    updateAvailable=1;
-    if (!bOpenGL && (address-ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS)<fb_fix_screeninfo.smem_len)
-        ((U16*)screenPixels)[(address-ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS)>>1] = value;
+    U8* p = getFbPixels(address, 2);
+    if (p) {
+        *(U16*)p = value;
+    }
+    this->onWrite();
 }
 
 U32 FBPage::readd(U32 address) {
-    if (!bOpenGL && (address-ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS)<fb_fix_screeninfo.smem_len)
-        return ((U32*)screenPixels)[(address-ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS)>>2];
-    return 0;
+    U8* p = getFbPixels(address, 4);
+    return p ? *(U32*)p : 0;
 }
 
 void FBPage::writed(U32 address, U32 value) {
-    updateAvailable=1;
-    if (!bOpenGL && (address-ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS)<fb_fix_screeninfo.smem_len)
-        ((U32*)screenPixels)[(address-ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS)>>2] = value;
+    U8* p = getFbPixels(address, 4);
+    if (p) {
+        *(U32*)p = value;
+    }
+    this->onWrite();
 }
 
 U8* FBPage::getCurrentReadPtr() {
-    return NULL;
+    return getFbPixels(this->address, K_PAGE_SIZE);
 }
 
 U8* FBPage::getCurrentWritePtr() {
@@ -421,18 +458,93 @@ U8* FBPage::getCurrentWritePtr() {
 }
 
 U8* FBPage::getReadAddress(U32 address, U32 len) {    
-    updateAvailable=1;
-    return &((U8*)screenPixels)[address-ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS];
+    return getFbPixels(address, len);
 }
 
 U8* FBPage::getWriteAddress(U32 address, U32 len) {
-    updateAvailable=1;
-    return &((U8*)screenPixels)[address-ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS];
+    markFbDirty(address - ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS, len);
+    return getFbPixels(address, len);
 }
 
 U8* FBPage::getReadWriteAddress(U32 address, U32 len) {
-    updateAvailable=1;
-    return &((U8*)screenPixels)[address-ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS];
+    markFbDirty(address - ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS, len);
+    return getFbPixels(address, len);
+}
+
+static void resetFbPages() {
+    for (auto& page : fbPages) {
+        page->resetPtrs();
+    }
+}
+
+static void uploadDirtyFB() {
+    U32 pitch = fb_fix_screeninfo.line_length;
+    U32 pageCount = std::min((screenPixelsSize + K_PAGE_SIZE - 1) >> K_PAGE_SHIFT, (U32)FB_MAX_PAGES);
+
+    for (U32 i = 0; i < pageCount && pitch; i++) {
+        if (!isFbPageDirty(i)) {
+            continue;
+        }
+        U32 first = i;
+        while (i + 1 < pageCount && isFbPageDirty(i + 1)) {
+            i++;
+        }
+        // the dirty pages become a band of whole rows
+        SDL_Rect rect;
+        rect.x = 0;
+        rect.w = fb_var_screeninfo.xres;
+        rect.y = (first << K_PAGE_SHIFT) / pitch;
+        U32 bottom = std::min((((i + 1) << K_PAGE_SHIFT) + pitch - 1) / pitch, fb_var_screeninfo.yres);
+        if ((U32)rect.y >= bottom) {
+            break;
+        }
+        rect.h = bottom - rect.y;
+        SDL_UpdateTexture(sdlTexture, &rect, screenPixels + rect.y * pitch, pitch);
+    }
+    for (auto& page : fbPages) {
+        if (isFbPageDirty(page->getIndex())) {
+            page->resetPtrs();
+        }
+    }
+    memset(fbDirtyPages, 0, sizeof(fbDirtyPages));
+    fbDirty = false;
+}
+#endif
+
+void fbSetupScreen() {
+    bOpenGL = 0;
+    DISPATCH_MAIN_THREAD_BLOCK_BEGIN
+    destroySDL2();
+    sdlWindow = SDL_CreateWindow("", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, fb_var_screeninfo.xres, fb_var_screeninfo.yres, SDL_WINDOW_SHOWN);
+    sdlRenderer = SDL_CreateRenderer(sdlWindow, -1, 0);
+    sdlTexture = SDL_CreateTexture(sdlRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, fb_var_screeninfo.xres, fb_var_screeninfo.yres);    
+
+    SDL_ShowCursor(0);
+    DISPATCH_MAIN_THREAD_BLOCK_END
+
+    fb_fix_screeninfo.visual = 2; // FB_VISUAL_TRUECOLOR
+    fb_fix_screeninfo.type = 0; // FB_TYPE_PACKED_PIXELS
+    //fb_fix_screeninfo.smem_start = ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS;		
+
+    fb_var_screeninfo.red.offset = 16;
+    fb_var_screeninfo.green.offset = 8;
+    fb_var_screeninfo.blue.offset = 0;
+    fb_var_screeninfo.red.length = 8;			
+    fb_var_screeninfo.green.length = 8;		
+    fb_var_screeninfo.blue.length = 8;
+    fb_fix_screeninfo.line_length = 4 * fb_var_screeninfo.xres;
+#ifdef BOXEDWINE_DEFAULT_MMU
+    if (screenPixels) {
+        delete[] screenPixels;
+    }
+    screenPixelsSize = fb_fix_screeninfo.line_length*fb_var_screeninfo.yres;
+    screenPixels = new U8[screenPixelsSize];
+    // the mmu might still have pointers into the old buffer
+    resetFbPages();
+    markFbAllDirty();
+#endif
+    
+    fb_fix_screeninfo.smem_len = fb_fix_screeninfo.line_length*fb_var_screeninfo.yres_virtual;	
 }
 
 class DevFB : public FsVirtualOpenNode {
@@ -515,6 +627,9 @@ U32 DevFB::writeNative(U8* buffer, U32 len) {
     if (this->pos+len>fb_fix_screeninfo.line_length)
         len = (U32)(fb_fix_screeninfo.line_length-this->pos);
     memcpy(screenPixels+this->pos, buffer, len);
+#ifdef BOXEDWINE_DEFAULT_MMU
+    markFbDirty((U32)this->pos, len);
+#endif
     this->pos+=len;
     return len;
 }
@@ -591,7 +706,7 @@ U32 DevFB::map(U32 address, U32 len, S32 prot, S32 flags, U64 off) {
         if (memory->getPage(i+pageStart)->type!=Page::Type::Invalid_Page && memory->getPage(i+pageStart)->type!=Page::Type::Frame_Buffer) {
             kpanic("Something else got mapped into the framebuffer address");
         }
-        memory->setPage(i+pageStart, new FBPage(flags));
+        memory->setPage(i+pageStart, new FBPage(memory, (i+pageStart) << K_PAGE_SHIFT, flags));
     }
 #endif
     return fb_fix_screeninfo.smem_start;
@@ -604,16 +719,14 @@ bool DevFB::canMap() {
 void flipFB() {
 #ifdef BOXEDWINE_64BIT_MMU
     if (isFbActive && !bOpenGL && sdlTexture) {
+        SDL_UpdateTexture(sdlTexture, NULL, screenPixels, fb_fix_screeninfo.line_length);
 #else
-    if (updateAvailable && !bOpenGL) {
+    if (fbDirty && !bOpenGL && sdlTexture) {
+        uploadDirtyFB();
 #endif
-
-        SDL_UpdateTexture(sdlTexture, NULL, screenPixels, fb_fix_screeninfo.line_length);
         SDL_RenderClear(sdlRenderer);
         SDL_RenderCopy(sdlRenderer, sdlTexture, NULL, NULL);
         SDL_RenderPresent(sdlRenderer);
-
-        updateAvailable=0;
     }
 }
 
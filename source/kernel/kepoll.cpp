@@ -22,12 +22,12 @@
 
 #include <string.h>
 
-KEPoll::KEPoll() : KObject(KTYPE_EPOLL) {
+KEPoll::KEPoll() : KObject(KTYPE_EPOLL), readyCond("KEPoll::readyCond") {
 }
 
 KEPoll::~KEPoll() {
-     for( const auto& n : this->data ) {
-         delete n.second;
+    for (const auto& n : this->data) {
+        this->removeEntry(n.second);
     }
 }
 
@@ -129,14 +129,51 @@ void KEPoll::close() {
 #define K_EPOLL_CTL_DEL 2
 #define K_EPOLL_CTL_MOD 3
 
+#define K_EPOLLIN 0x001
+#define K_EPOLLOUT 0x004
+#define K_EPOLLHUP 0x010
+#define K_EPOLLEXCLUSIVE (1u << 28)
+#define K_EPOLLWAKEUP (1u << 29)
+#define K_EPOLLONESHOT (1u << 30)
+#define K_EPOLLET (1u << 31)
+
+#define K_EPOLL_FLAGS (K_EPOLLEXCLUSIVE | K_EPOLLWAKEUP | K_EPOLLONESHOT | K_EPOLLET)
+
+void KEPoll::Data::onObjectChanged() {
+    this->epoll->setReady(this);
+}
+
+void KEPoll::setReady(Data* d) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(this->readyCond);
+    if (d->watched && !d->node.isInList()) {
+        this->readyList.addToBack(&d->node);
+    }
+    // wake up epoll_wait, this also makes it check the polled entries again
+    BOXEDWINE_CONDITION_SIGNAL_ALL(this->readyCond);
+}
+
+void KEPoll::removeEntry(Data* d) {
+    std::shared_ptr<KObject> object = d->object.lock();
+    if (object && d->watched) {
+        // once this returns the object won't call onObjectChanged for d again
+        object->removeWatcher(d);
+    }
+    BOXEDWINE_CONDITION_LOCK(this->readyCond);
+    d->node.remove();
+    BOXEDWINE_CONDITION_UNLOCK(this->readyCond);
+    delete d;
+}
+
 U32 KEPoll::ctl(U32 op, FD fd, U32 address) {
     KFileDescriptor* targetFD = KThread::currentThread()->process->getFileDescriptor(fd);
     Data* existing = NULL;
+    U32 events;
 
     if (!targetFD) {
         return -K_EBADF;
     }
 
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->entriesMutex);
     if (this->data.count(fd))
         existing = this->data[fd];
 
@@ -145,23 +182,41 @@ U32 KEPoll::ctl(U32 op, FD fd, U32 address) {
             if (existing) {
                 return -K_EEXIST;
             }
-            existing = new Data();
+            existing = new Data(this);
             existing->fd = fd;
             existing->events = readd(address);
             existing->data = readq(address + 4);
+            existing->object = targetFD->kobject;
+            existing->watched = targetFD->kobject->addWatcher(existing);
+            if (!existing->watched && (existing->events & K_EPOLLET)) {
+                // without being told about changes there is no way to tell a new event from one that was already reported
+                delete existing;
+                return -K_EINVAL;
+            }
             this->data[fd] = existing;
+            if (!existing->watched) {
+                this->polledList.addToBack(&existing->node);
+            }
+            // it might already be ready
+            this->setReady(existing);
             break;
         case K_EPOLL_CTL_DEL:
             if (!existing)
                 return -K_ENOENT;
             this->data.erase(fd);
-            delete existing;
+            this->removeEntry(existing);
             break;
         case K_EPOLL_CTL_MOD:
             if (!existing)
                 return -K_ENOENT;
-            existing->events = readd(address);
+            events = readd(address);
+            if (!existing->watched && (events & K_EPOLLET)) {
+                return -K_EINVAL;
+            }
+            // this also re-arms a K_EPOLLONESHOT entry and reports a K_EPOLLET entry again if it is still ready
+            existing->events = events;
             existing->data = readq(address + 4);
+            this->setReady(existing);
             break;
         default:
             return -K_EINVAL;
@@ -169,37 +224,170 @@ U32 KEPoll::ctl(U32 op, FD fd, U32 address) {
     return 0;
 }
 
-U32 KEPoll::wait(U32 events, U32 maxevents, U32 timeout) {    
-    S32 result = 0;
-    U32 i;
-    THREAD_LOCAL static KPollData pollData[256];	
-    U32 pollCount=0;
-
-    for( const auto& n : this->data ) {
-        if (pollCount>=256) {
-            kpanic("Wasn't expect a poll count of more than 256");
-            break;
+U32 KEPoll::getReadyEvents(Data* d) {
+    if (!(d->events & ~K_EPOLL_FLAGS)) {
+        return 0; // a K_EPOLLONESHOT entry that already fired
+    }
+    std::shared_ptr<KObject> object = d->object.lock();
+    if (!object) {
+        return 0;
+    }
+    U32 result = 0;
+    if (!object->isOpen()) {
+        result = K_EPOLLHUP;
+    } else {
+        if ((d->events & K_EPOLLIN) && object->isReadReady()) {
+            result |= K_EPOLLIN;
         }
-        Data* next = n.second;
-        pollData[pollCount].events = next->events;
-        pollData[pollCount].fd = next->fd;
-        pollData[pollCount].data = next->data;
-        pollCount++;	
-    }
-    result = internal_poll(pollData, pollCount, timeout);
-    if (result >= 0) {
-        result = 0;
-        for (i=0;i<pollCount;i++) {
-            if (pollData[i].revents!=0) {
-                writed(events + result * 12, pollData[i].revents);        
-                writeq(events + result * 12 + 4, pollData[i].data);
-                result++;
-                if (result>=(S32)maxevents) {
-                    kwarn("possible starvation in epoll, more events are ready than can be received.");
-                    break;
-                }
-            }        
+        if ((d->events & K_EPOLLOUT) && object->isWriteReady()) {
+            result |= K_EPOLLOUT;
         }
     }
     return result;
 }
+
+void KEPoll::reportEntry(Data* d, U32 revents, U32 events, U32 index) {
+    writed(events + index * 12, revents);
+    writeq(events + index * 12 + 4, d->data);
+    if (d->events & K_EPOLLONESHOT) {
+        d->events &= K_EPOLL_FLAGS;
+    }
+}
+
+U32 KEPoll::getReadyWatchedEntries(U32 events, U32 maxevents) {
+    U32 result = 0;
+    std::vector<Data*> changed;
+    std::vector<Data*> stillReady;
+
+    // the objects are checked without readyCond held, one that changes in the mean time goes back on readyList
+    BOXEDWINE_CONDITION_LOCK(this->readyCond);
+    for (KListNode<Data*>* node = this->readyList.front(); node; node = this->readyList.front()) {
+        changed.push_back(node->data);
+        node->remove();
+    }
+    BOXEDWINE_CONDITION_UNLOCK(this->readyCond);
+
+    for (auto& d : changed) {
+        if (result == maxevents) {
+            stillReady.push_back(d); // not checked yet
+            continue;
+        }
+        U32 revents = this->getReadyEvents(d);
+        if (revents) {
+            this->reportEntry(d, revents, events, result);
+            result++;
+            // a level triggered entry is reported until a check finds it isn't ready, an edge triggered one waits for the next change
+            if (!(d->events & (K_EPOLLET | K_EPOLLONESHOT))) {
+                stillReady.push_back(d);
+            }
+        }
+    }
+    if (stillReady.size()) {
+        BOXEDWINE_CONDITION_LOCK(this->readyCond);
+        for (auto& d : stillReady) {
+            if (!d->node.isInList()) {
+                this->readyList.addToBack(&d->node);
+            }
+        }
+        BOXEDWINE_CONDITION_UNLOCK(this->readyCond);
+    }
+    return result;
+}
+
+U32 KEPoll::getReadyPolledEntries(U32 events, U32 maxevents, U32 result) {
+    std::vector<Data*> reported;
+
+    for (KListNode<Data*>* node = this->polledList.front(); node && result < maxevents; node = node->getNext()) {
+        Data* d = node->data;
+        U32 revents = this->getReadyEvents(d);
+
+        if (revents) {
+            this->reportEntry(d, revents, events, result);
+            result++;
+            reported.push_back(d);
+        }
+    }
+    for (auto& d : reported) {
+        d->node.remove();
+        this->polledList.addToBack(&d->node);
+    }
+    return result;
+}
+
+U32 KEPoll::wait(U32 events, U32 maxevents, U32 timeout) {    
+    KThread* thread = KThread::currentThread();
+
+    if ((S32)maxevents <= 0) {
+        return -K_EINVAL;
+    }
+    while (true) {
+        BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(thread->pollCond);
+        bool interrupted = !thread->inSignal && thread->interrupted;
+
+        if (interrupted)
+            thread->interrupted = false;
+
+        BOXEDWINE_MUTEX_LOCK(this->entriesMutex);
+        U32 result = this->getReadyWatchedEntries(events, maxevents);
+        result = this->getReadyPolledEntries(events, maxevents, result);
+        if (!result && timeout != 0 && !interrupted) {
+            // gather locks before we check the polled entries again so that we don't miss one
+            for (KListNode<Data*>* node = this->polledList.front(); node; node = node->getNext()) {
+                Data* d = node->data;
+                std::shared_ptr<KObject> object = d->object.lock();
+                if (object && (d->events & ~K_EPOLL_FLAGS)) {
+                    object->waitForEvents(thread->pollCond, d->events & ~K_EPOLL_FLAGS);
+                }
+            }
+            // the watched entries signal readyCond when they change
+            BOXEDWINE_CONDITION_ADD_CHILD_CONDITION(thread->pollCond, this->readyCond, nullptr);
+            result = this->getReadyPolledEntries(events, maxevents, 0);
+            if (!result && !this->readyList.isEmpty()) {
+                // a watched entry changed after it was checked
+                thread->pollCond.unlockAndRemoveChildren();
+                BOXEDWINE_MUTEX_UNLOCK(this->entriesMutex);
+                continue;
+            }
+        }
+        BOXEDWINE_MUTEX_UNLOCK(this->entriesMutex);
+        if (result > 0) {
+            thread->condStartWaitTime = 0;
+            thread->pollCond.unlockAndRemoveChildren();
+            return result;
+        }
+        if (timeout == 0) {
+            thread->pollCond.unlockAndRemoveChildren();
+            return 0;
+        }
+        if (interrupted) {
+            thread->condStartWaitTime = 0;
+            thread->pollCond.unlockAndRemoveChildren();
+            return -K_EINTR;
+        }
+        if (!thread->condStartWaitTime) {
+            thread->condStartWaitTime = KSystem::getMilliesSinceStart();
+        } else {
+            U32 diff = KSystem::getMilliesSinceStart() - thread->condStartWaitTime;
+            if (diff > timeout) {
+                thread->condStartWaitTime = 0;
+                thread->pollCond.unlockAndRemoveChildren();
+                return 0;
+            }
+            timeout -= diff;
+        }
+        if (timeout > 0xF0000000) {
+            BOXEDWINE_CONDITION_WAIT(thread->pollCond);
+        } else {
+            BOXEDWINE_CONDITION_WAIT_TIMEOUT(thread->pollCond, timeout);
+        }
+#ifdef BOXEDWINE_MULTI_THREADED
+        if (thread->terminating) {
+            return -K_EINTR;
+        }
+        if (thread->startSignal) {
+            thread->startSignal = false;
+            return -K_CONTINUE;
+        }
+#endif
+    }
+}
@@ -134,20 +134,54 @@ S64 KFile::length() {
     return this->openFile->length();
 }
 
+U32 KFile::readv(U32 iov, S32 iovcnt) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(filePosMutex);
+    return this->openFile->readv(iov, iovcnt);
+}
+
+U32 KFile::writev(U32 iov, S32 iovcnt) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(filePosMutex);
+    return this->openFile->writev(iov, iovcnt);
+}
+
+// when the open node can't do positional io without moving the file pointer, it has to be serialized with the other
+// users of the file pointer
 U32 KFile::pread(U32 buffer, S64 offset, U32 len) {
+    if (this->openFile->hasNativePositionalIO()) {
+        return this->openFile->pread(buffer, len, offset);
+    }
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(filePosMutex);
+    return this->openFile->pread(buffer, len, offset);
+}
+
+U32 KFile::preadNative(U8* buffer, S64 offset, U32 len) {
+    if (this->openFile->hasNativePositionalIO()) {
+        return this->openFile->preadNative(buffer, len, offset);
+    }
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(filePosMutex);
-    S64 previousOffset = this->openFile->getFilePointer();
-    this->openFile->seek(offset);
-    U32 result = this->openFile->read(buffer, len);
-    this->openFile->seek(previousOffset);
-    return result;
+    return this->openFile->preadNative(buffer, len, offset);
 }
 
 U32 KFile::pwrite(U32 buffer, S64 offset, U32 len) {
+    if (this->openFile->hasNativePositionalIO()) {
+        return this->openFile->pwrite(buffer, len, offset);
+    }
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(filePosMutex);
+    return this->openFile->pwrite(buffer, len, offset);
+}
+
+U32 KFile::preadv(U32 iov, S32 iovcnt, S64 offset) {
+    if (this->openFile->hasNativePositionalIO()) {
+        return this->openFile->preadv(iov, iovcnt, offset);
+    }
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(filePosMutex);
+    return this->openFile->preadv(iov, iovcnt, offset);
+}
+
+U32 KFile::pwritev(U32 iov, S32 iovcnt, S64 offset) {
+    if (this->openFile->hasNativePositionalIO()) {
+        return this->openFile->pwritev(iov, iovcnt, offset);
+    }
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(filePosMutex);
-    S64 previousOffset = this->openFile->getFilePointer();
-    this->openFile->seek(offset);
-    U32 result = this->openFile->write(buffer, len);
-    this->openFile->seek(previousOffset);
-    return result;
+    return this->openFile->pwritev(iov, iovcnt, offset);
 }
\ No newline at end of file
@@ -12,10 +12,11 @@ KObject::KObject(U32 type) : type(type) {
 U32 KObject::writev(U32 iov, S32 iovcnt) {
     U32 len=0;
     S32 i;
+    Memory* memory = KThread::currentThread()->memory;
 
     for (i=0;i<iovcnt;i++) {
-        U32 buf = readd(iov + i * 8);
-        U32 toWrite = readd(iov + i * 8 + 4);
+        U32 buf = readd(memory, iov + i * 8);
+        U32 toWrite = readd(memory, iov + i * 8 + 4);
         S32 result;
 
         result = this->write(buf, toWrite);
@@ -30,6 +31,28 @@ U32 KObject::writev(U32 iov, S32 iovcnt) {
     return len;
 }
 
+U32 KObject::readv(U32 iov, S32 iovcnt) {
+    U32 len=0;
+    S32 i;
+    Memory* memory = KThread::currentThread()->memory;
+
+    for (i=0;i<iovcnt;i++) {
+        U32 buf = readd(memory, iov + i * 8);
+        U32 toRead = readd(memory, iov + i * 8 + 4);
+        S32 result;
+
+        result = this->read(buf, toRead);
+        if (result<0) {
+            return len?len:result;
+        }
+        len+=result;
+        if ((U32)result<toRead) {
+            break;
+        }
+    }
+    return len;
+}
+
 U32 KObject::read(U32 address, U32 len) {
     if (K_PAGE_SIZE-(address & (K_PAGE_SIZE-1)) >= len) {
         U8* ram = getPhysicalWriteAddress(address, len);
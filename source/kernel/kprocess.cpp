@@ -702,24 +702,42 @@ bool KProcess::isTerminated() {
 
 std::string KProcess::getModuleName(U32 eip) {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(mappedFilesMutex);
-    for (auto& n : this->mappedFiles) {
-        BoxedPtr<MappedFile> mappedFile = n.second;
-        if (eip >= mappedFile->address && eip < mappedFile->address + mappedFile->len) {
-            return mappedFile->file->openFile->node->name;
-        }
+    BoxedPtr<MappedFile> mappedFile = this->getMappedFile(eip);
+    if (mappedFile) {
+        return mappedFile->file->openFile->node->name;
     }
     return "Unknown";
 }
 
+// returns an empty string if eip isn't in a mapped file
+std::string KProcess::getModulePath(U32 eip) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(mappedFilesMutex);
+    BoxedPtr<MappedFile> mappedFile = this->getMappedFile(eip);
+    if (mappedFile) {
+        return mappedFile->path;
+    }
+    return "";
+}
+
+BoxedPtr<MappedFile> KProcess::getMappedFile(U32 eip) {
+    // the closest mapping that starts at or before eip
+    auto it = this->mappedFiles.upper_bound(eip);
+    if (it != this->mappedFiles.begin()) {
+        --it;
+        if (eip < it->second->address + it->second->len) {
+            return it->second;
+        }
+    }
+    return NULL;
+}
+
 U32 KProcess::getModuleEip(U32 eip) {    
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(mappedFilesMutex);
     if (eip<0xd0000000)
         return eip;
-    for (auto& n : this->mappedFiles) {
-        BoxedPtr<MappedFile> mappedFile = n.second;
-        if (eip>=mappedFile->address && eip<mappedFile->address+mappedFile->len)
-            return (U32)(eip-mappedFile->address+mappedFile->offset);
-    }
+    BoxedPtr<MappedFile> mappedFile = this->getMappedFile(eip);
+    if (mappedFile)
+        return (U32)(eip-mappedFile->address+mappedFile->offset);
     return 0;
 }
 
@@ -732,12 +750,9 @@ U32 KProcess::alarm(U32 seconds) {
         }
     } else {
         this->timer.resetMillies = 0;
-        if (this->timer.millies!=0) {
-            this->timer.millies = seconds*1000 + KSystem::getMilliesSinceStart();
-        } else {
-            this->timer.millies = seconds*1000 + KSystem::getMilliesSinceStart();
-            addTimer(&this->timer);
-        }
+        // addTimer will move the timer if it was already queued
+        this->timer.millies = seconds*1000 + KSystem::getMilliesSinceStart();
+        addTimer(&this->timer);
     }
     if (prev) {
         return (prev - KSystem::getMilliesSinceStart())/1000;
@@ -1436,6 +1451,7 @@ U32 KProcess::mmap(U32 addr, U32 len, S32 prot, S32 flags, FD fildes, U64 off) {
             mappedFile->len = ((U64)pageCount) << K_PAGE_SHIFT;
             mappedFile->offset = off;     
             mappedFile->file = std::dynamic_pointer_cast<KFile>(fd->kobject);
+            mappedFile->path = mappedFile->file->openFile->node->path;
 #ifdef BOXEDWINE_DEFAULT_MMU
             BoxedPtr<MappedFileCache> cache = KSystem::getFileCache(mappedFile->file->openFile->node->path);
             if (!cache) {
@@ -1574,12 +1590,8 @@ U32 KProcess::setitimer(U32 which, U32 newValue, U32 oldValue) {
             }
         } else {
             this->timer.resetMillies = resetMillies;			
-            if (this->timer.millies!=0) {
-                this->timer.millies = millies + KSystem::getMilliesSinceStart();
-            } else {
-                this->timer.millies = millies + KSystem::getMilliesSinceStart();
-                addTimer(&this->timer);
-            }
+            this->timer.millies = millies + KSystem::getMilliesSinceStart();
+            addTimer(&this->timer);
         }
     }	
     return 0;
@@ -1633,8 +1645,7 @@ U32 KProcess::clone(U32 flags, U32 child_stack, U32 ptid, U32 tls, U32 ctid) {
             newProcess->memory = this->memory;
             newProcess->memory->incRefCount();
         } else {            
-            newProcess->memory = new Memory();
-            newProcess->memory->clone(this->memory);
+            newProcess->memory = new Memory(this->memory);
         }
         KThread* newThread = newProcess->createThread();
 
@@ -1935,13 +1946,29 @@ U32 KProcess::msync(U32 addr, U32 len, U32 flags) {
     for (auto& n : this->mappedFiles) {
         BoxedPtr<MappedFile> m = n.second;
         if (m->address<=addr && addr+len<m->address+m->len) {
-            klog("msync not implemented");
+            // shared mappings of a native file write straight to it, so the size its open nodes cached could be stale
+            m->file->openFile->syncedMapping();
             return 0;
         }
     }
     return -K_ENOMEM;
 }
 
+U32 KProcess::readv(FD handle, U32 iov, S32 iovcnt) {
+    KFileDescriptor* fd = this->getFileDescriptor(handle);
+
+    if (fd==0) {
+        return -K_EBADF;
+    }
+    if (!fd->canRead()) {
+        return -K_EINVAL;
+    }
+    if (iovcnt<0 || iovcnt>K_UIO_MAXIOV) {
+        return -K_EINVAL;
+    }
+    return fd->kobject->readv(iov, iovcnt);    
+}
+
 U32 KProcess::writev(FD handle, U32 iov, S32 iovcnt) {
     KFileDescriptor* fd = this->getFileDescriptor(handle);
 
@@ -1951,6 +1978,9 @@ U32 KProcess::writev(FD handle, U32 iov, S32 iovcnt) {
     if (!fd->canWrite()) {
         return -K_EINVAL;
     }
+    if (iovcnt<0 || iovcnt>K_UIO_MAXIOV) {
+        return -K_EINVAL;
+    }
     return fd->kobject->writev(iov, iovcnt);    
 }
 
@@ -2060,8 +2090,9 @@ U32 KProcess::sigaction(U32 sig, U32 act, U32 oact, U32 sigsetSize) {
     return 0;
 }
 
-U32 KProcess::pread64(FD fildes, U32 address, U32 len, U64 offset) {
-    KFileDescriptor* fd = this->getFileDescriptor(fildes);
+// returns 0 and sets file if fildes can be used with pread64, pwrite64, preadv and pwritev
+static U32 getPositionalFile(KProcess* process, FD fildes, std::shared_ptr<KFile>& file) {
+    KFileDescriptor* fd = process->getFileDescriptor(fildes);
 
     if (!fd) {
         return -K_EBADF;
@@ -2072,12 +2103,20 @@ U32 KProcess::pread64(FD fildes, U32 address, U32 len, U64 offset) {
     if (fd->kobject->type!=KTYPE_FILE) {
         return -K_EINVAL;
     }
-    std::shared_ptr<KFile> p = std::dynamic_pointer_cast<KFile>(fd->kobject);
-    FsOpenNode* openNode = p->openFile;
-
-    if (openNode->node->isDirectory()) {
+    file = std::dynamic_pointer_cast<KFile>(fd->kobject);
+    if (file->openFile->node->isDirectory()) {
         return -K_EISDIR;
     }
+    return 0;
+}
+
+U32 KProcess::pread64(FD fildes, U32 address, U32 len, U64 offset) {
+    std::shared_ptr<KFile> p;
+    U32 result = getPositionalFile(this, fildes, p);
+
+    if (result) {
+        return result;
+    }
     if (!this->memory->isValidWriteAddress(address, len)) {
         return -K_EFAULT;
     }
@@ -2085,27 +2124,48 @@ U32 KProcess::pread64(FD fildes, U32 address, U32 len, U64 offset) {
 }
 
 U32 KProcess::pwrite64(FD fildes, U32 address, U32 len, U64 offset) {
-    KFileDescriptor* fd = this->getFileDescriptor(fildes);
+    std::shared_ptr<KFile> p;
+    U32 result = getPositionalFile(this, fildes, p);
 
-    if (!fd) {
-        return -K_EBADF;
+    if (result) {
+        return result;
     }
-    if (fd->kobject->type==KTYPE_NATIVE_SOCKET || fd->kobject->type==KTYPE_UNIX_SOCKET) {
-        return -K_ESPIPE;
+    if (!this->memory->isValidReadAddress(address, len)) {
+        return -K_EFAULT;
     }
-    if (fd->kobject->type!=KTYPE_FILE) {
+    return p->pwrite(address, (S64)offset, len);
+}
+
+U32 KProcess::preadv(FD fildes, U32 iov, S32 iovcnt, U64 offset) {
+    std::shared_ptr<KFile> p;
+    U32 result = getPositionalFile(this, fildes, p);
+
+    if (result) {
+        return result;
+    }
+    if (iovcnt<0 || iovcnt>K_UIO_MAXIOV) {
         return -K_EINVAL;
     }
-    std::shared_ptr<KFile> p = std::dynamic_pointer_cast<KFile>(fd->kobject);
-    FsOpenNode* openNode = p->openFile;
+    if (!this->memory->isValidReadAddress(iov, iovcnt*8)) {
+        return -K_EFAULT;
+    }
+    return p->preadv(iov, iovcnt, (S64)offset);
+}
 
-    if (openNode->node->isDirectory()) {
-        return -K_EISDIR;
+U32 KProcess::pwritev(FD fildes, U32 iov, S32 iovcnt, U64 offset) {
+    std::shared_ptr<KFile> p;
+    U32 result = getPositionalFile(this, fildes, p);
+
+    if (result) {
+        return result;
     }
-    if (!this->memory->isValidReadAddress(address, len)) {
+    if (iovcnt<0 || iovcnt>K_UIO_MAXIOV) {
+        return -K_EINVAL;
+    }
+    if (!this->memory->isValidReadAddress(iov, iovcnt*8)) {
         return -K_EFAULT;
     }
-    return p->pwrite(address, (S64)offset, len);
+    return p->pwritev(iov, iovcnt, (S64)offset);
 }
 
 U32 KProcess::getcwd(U32 buffer, U32 size) {
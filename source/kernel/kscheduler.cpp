@@ -17,55 +17,123 @@
  */
 #include "boxedwine.h"
 
-#ifdef BOXEDWINE_MULTI_THREADED
-static KList<KTimer*> timers;
+// Timers are kept in a binary min-heap ordered by when they expire, so the next timer to expire is always timers[0].
+// Each timer remembers where it is in the heap so that removing it doesn't need a search.
+static std::vector<KTimer*> timers;
 static BOXEDWINE_MUTEX timerMutex;
-void runTimers() {
-    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(timerMutex);
-    U32 millies = KSystem::getMilliesSinceStart();
-    timers.for_each([millies](KListNode<KTimer*>* node) {
-        KTimer* timer = node->data;
 
-        if (timer->millies <= millies) {
-            if (timer->run()) {
-                timer->node.remove();
-            }
-        }
-        });
+static void setTimerAt(U32 index, KTimer* timer) {
+    timers[index] = timer;
+    timer->heapIndex = index;
 }
 
-U32 getNextTimer() {
-    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(timerMutex);
-    U32 millies = KSystem::getMilliesSinceStart();
-    U32 result = 0xFFFFFFFF;
+static void siftTimerUp(U32 index) {
+    KTimer* timer = timers[index];
+    while (index) {
+        U32 parent = (index - 1) / 2;
+        if (timers[parent]->millies <= timer->millies) {
+            break;
+        }
+        setTimerAt(index, timers[parent]);
+        index = parent;
+    }
+    setTimerAt(index, timer);
+}
 
-    timers.for_each([millies, &result](KListNode<KTimer*>* node) {
-        KTimer* timer = node->data;
-        U32 next;
-        if (timer->millies <= millies) {
-            next = 0;
+static void siftTimerDown(U32 index) {
+    KTimer* timer = timers[index];
+    U32 count = (U32)timers.size();
+    while (true) {
+        U32 child = index * 2 + 1;
+        if (child >= count) {
+            break;
         }
-        else {
-            next = timer->millies - millies;
+        if (child + 1 < count && timers[child + 1]->millies < timers[child]->millies) {
+            child++;
         }
-        if (next < result) {
-            result = next;
+        if (timer->millies <= timers[child]->millies) {
+            break;
         }
-        });
-    return result;
+        setTimerAt(index, timers[child]);
+        index = child;
+    }
+    setTimerAt(index, timer);
+}
+
+static void insertTimer(KTimer* timer) {
+    timers.push_back(timer);
+    siftTimerUp((U32)timers.size() - 1);
+}
+
+static void eraseTimer(KTimer* timer) {
+    U32 index = timer->heapIndex;
+    KTimer* last = timers.back();
+
+    timers.pop_back();
+    timer->heapIndex = K_TIMER_NOT_QUEUED;
+    if (last != timer) {
+        setTimerAt(index, last);
+        siftTimerDown(index);
+        siftTimerUp(last->heapIndex);
+    }
 }
 
 void addTimer(KTimer* timer) {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(timerMutex);
-    timers.addToBack(&timer->node);
+    if (timer->heapIndex != K_TIMER_NOT_QUEUED) {
+        eraseTimer(timer);
+    }
+    insertTimer(timer);
     timer->active = true;
 }
 
 void removeTimer(KTimer* timer) {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(timerMutex);
-    timer->node.remove();
+    if (timer->heapIndex != K_TIMER_NOT_QUEUED) {
+        eraseTimer(timer);
+    }
     timer->active = false;
 }
+
+void runTimers() {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(timerMutex);
+    U32 millies = KSystem::getMilliesSinceStart();
+
+    if (!timers.size() || timers[0]->millies > millies) {
+        return;
+    }
+    // take all the expired timers out first, running a timer can add or remove timers
+    std::vector<KTimer*> expired;
+    while (timers.size() && timers[0]->millies <= millies) {
+        KTimer* timer = timers[0];
+        expired.push_back(timer);
+        eraseTimer(timer);
+    }
+    for (auto& timer : expired) {
+        // skip it if an earlier timer removed it or added it again
+        if (!timer->active || timer->heapIndex != K_TIMER_NOT_QUEUED) {
+            continue;
+        }
+        if (timer->run()) {
+            timer->active = false;
+        } else if (timer->active && timer->heapIndex == K_TIMER_NOT_QUEUED) {
+            insertTimer(timer);
+        }
+    }
+}
+
+#ifdef BOXEDWINE_MULTI_THREADED
+U32 getNextTimer() {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(timerMutex);
+    if (!timers.size()) {
+        return 0xFFFFFFFF;
+    }
+    U32 millies = KSystem::getMilliesSinceStart();
+    if (timers[0]->millies <= millies) {
+        return 0;
+    }
+    return timers[0]->millies - millies;
+}
 #else
 #include "devfb.h"
 #include "kscheduler.h"
@@ -77,18 +145,6 @@ void removeTimer(KTimer* timer) {
 
 KList<KThread*> scheduledThreads;
 KList<KThread*> waitThreads;
-KList<KTimer*> timers;
-
-void addTimer(KTimer* timer) {
-    timers.addToBack(&timer->node);
-    timer->active = true;
-}
-
-void removeTimer(KTimer* timer) {
-    timer->node.remove();
-    timer->active = false;
-}
-
 void scheduleThread(KThread* thread) {
 #ifdef _DEBUG
     if (thread->waitingCond) {
@@ -148,19 +204,6 @@ void runThreadSlice(KThread* thread) {
     cpu->instructionCount+=cpu->blockInstructionCount;
 }
 
-void runTimers() {
-    U32 millies = KSystem::getMilliesSinceStart();
-    timers.for_each([millies] (KListNode<KTimer*>* node) {
-        KTimer* timer = node->data;
-
-        if (timer->millies<=millies) {
-            if (timer->run()) {                
-                timer->node.remove();
-            }
-        }
-    });
-}
-
 extern U64 sysCallTime;
 U64 elapsedTimeMIPS;
 U64 elapsedInstructionsMIPS;
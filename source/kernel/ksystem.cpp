@@ -23,6 +23,10 @@
 #include "kscheduler.h"
 #include "../emulation/softmmu/soft_ram.h"
 #include "../emulation/cpu/normal/normalCPU.h"
+#ifdef BOXEDWINE_X64
+#include "../emulation/cpu/x64/x64CodeCache.h"
+#include "../emulation/cpu/x64/x64Translator.h"
+#endif
 #include "knativesystem.h"
 #include "pixelformat.h"
 
@@ -118,6 +122,11 @@ void KSystem::destroy() {
 #endif
 	KSystem::shutingDown = false;
 	Fs::shutDown();
+#ifdef BOXEDWINE_X64
+    // the translator threads give their free ops back when they exit
+    X64Translator::shutDown();
+    X64CodeCache::shutDown();
+#endif
     DecodedOp::clearCache();
     NormalCPU::clearCache();
     if (KSystem::logFile) {
@@ -22,6 +22,11 @@
 #include "ksignal.h"
 #include "kscheduler.h"
 #include "ksignal.h"
+
+#ifdef BOXEDWINE_BINARY_TRANSLATOR
+#include "../emulation/cpu/binaryTranslation/btCodeMemoryWrite.h"
+#endif
+
 #include <string.h>
 #include <setjmp.h>
 
@@ -30,8 +35,6 @@ THREAD_LOCAL
 #endif
 KThread* KThread::runningThread;
 
-BOXEDWINE_MUTEX KThread::futexesMutex;
-
 KThread::~KThread() {    
     this->cleanup();
     CPU* cpu = this->cpu;
@@ -43,7 +46,7 @@ void KThread::cleanup() {
     BOXEDWINE_CONDITION_SIGNAL_ALL_NEED_LOCK(this->waitingForSignalToEndCond);
     if (!KSystem::shutingDown && this->clear_child_tid && this->process && this->process->memory->isValidWriteAddress(this->clear_child_tid, 4)) {
         writed(this->clear_child_tid, 0);
-        this->futex(this->clear_child_tid, 1, 1, 0);        
+        this->futex(this->clear_child_tid, 1, 1, 0, 0, 0);        
     }
 	this->clear_child_tid = 0;
 #ifndef BOXEDWINE_MULTI_THREADED
@@ -125,7 +128,8 @@ KThread::KThread(U32 id, const std::shared_ptr<KProcess>& process) :
     waitThreadNode(this),            
 #endif
     condStartWaitTime(0),
-    sleepCond("KThread::sleepCond")
+    sleepCond("KThread::sleepCond"),
+    futexWaiter(NULL)
     {
     int i;
 
@@ -216,139 +220,348 @@ U32 KThread::signal(U32 signal, bool wait) {
 
 #define FUTEX_WAIT 0
 #define FUTEX_WAKE 1
-#define FUTEX_WAIT_PRIVATE 128
-#define FUTEX_WAKE_PRIVATE 129
-
-struct futex {
+#define FUTEX_REQUEUE 3
+#define FUTEX_CMP_REQUEUE 4
+#define FUTEX_WAKE_OP 5
+#define FUTEX_WAIT_BITSET 9
+#define FUTEX_WAKE_BITSET 10
+#define FUTEX_PRIVATE_FLAG 128
+#define FUTEX_CLOCK_REALTIME 256
+#define FUTEX_CMD_MASK ~(FUTEX_PRIVATE_FLAG | FUTEX_CLOCK_REALTIME)
+
+#define FUTEX_BITSET_MATCH_ANY 0xFFFFFFFF
+
+#define FUTEX_OP_SET 0
+#define FUTEX_OP_ADD 1
+#define FUTEX_OP_OR 2
+#define FUTEX_OP_ANDN 3
+#define FUTEX_OP_XOR 4
+#define FUTEX_OP_OPARG_SHIFT 8
+
+#define FUTEX_OP_CMP_EQ 0
+#define FUTEX_OP_CMP_NE 1
+#define FUTEX_OP_CMP_LT 2
+#define FUTEX_OP_CMP_LE 3
+#define FUTEX_OP_CMP_GT 4
+#define FUTEX_OP_CMP_GE 5
+
+// Waiting threads are kept in a hash table keyed by the host address of the futex, so a wake only looks at the
+// threads waiting on futexes that hash to the same bucket.  Each thread has at most one KFutexWaiter, it is created
+// the first time the thread waits and it stays in a bucket's list until it is woken, times out or the thread exits.
+// Lock order is bucket (lowest address first if there are two), then the waiter's condition.
+#define FUTEX_HASH_SIZE 256
+
+class KFutexWaiter {
 public:
-    futex() : cond("futex") {}
+    KFutexWaiter(KThread* thread) : thread(thread), address(NULL), waitAddress(0), expireTimeInMillies(0), bitset(0), wake(false), node(this), cond("KFutexWaiter::cond") {}
+
     KThread* thread;
-    U8* address;  
+    U8* address; // what wakes are matched on, a requeue will change this
+    U32 waitAddress; // emulated address that was passed to the wait, used to recognize a restarted syscall
     U32 expireTimeInMillies;
+    U32 bitset;
     bool wake;
+    KListNode<KFutexWaiter*> node;
     BOXEDWINE_CONDITION cond;
 };
 
-#define MAX_FUTEXES 128
+class KFutexBucket {
+public:
+    BOXEDWINE_MUTEX mutex;
+    KList<KFutexWaiter*> waiters;
+};
+
+static KFutexBucket futexBuckets[FUTEX_HASH_SIZE];
+
+static KFutexBucket* getFutexBucket(U8* address) {
+    size_t a = (size_t)address >> 2;
+    return &futexBuckets[(a ^ (a >> 8) ^ (a >> 16)) & (FUTEX_HASH_SIZE - 1)];
+}
 
-struct futex system_futex[MAX_FUTEXES];
+static void lockFutexBuckets(KFutexBucket* bucket1, KFutexBucket* bucket2) {
+    if (bucket1 > bucket2) {
+        std::swap(bucket1, bucket2);
+    }
+    BOXEDWINE_MUTEX_LOCK(bucket1->mutex);
+    if (bucket1 != bucket2) {
+        BOXEDWINE_MUTEX_LOCK(bucket2->mutex);
+    }
+}
 
-struct futex* getFutex(KThread* thread, U8* address) {
-    int i=0;
+static void unlockFutexBuckets(KFutexBucket* bucket1, KFutexBucket* bucket2) {
+    BOXEDWINE_MUTEX_UNLOCK(bucket1->mutex);
+    if (bucket1 != bucket2) {
+        BOXEDWINE_MUTEX_UNLOCK(bucket2->mutex);
+    }
+}
 
-    for (i=0;i<MAX_FUTEXES;i++) {
-        if (system_futex[i].address == address && system_futex[i].thread==thread) {
-            return &system_futex[i];
+// bucket must be locked
+static U32 wakeFutex(KFutexBucket* bucket, U8* address, U32 count, U32 bitset) {
+    U32 result = 0;
+    KListNode<KFutexWaiter*>* node = bucket->waiters.front();
+
+    while (node && result < count) {
+        KListNode<KFutexWaiter*>* next = node->getNext();
+        KFutexWaiter* waiter = node->data;
+
+        if (waiter->address == address && (waiter->bitset & bitset)) {
+            node->remove();
+            BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(waiter->cond);
+            waiter->wake = true;
+            BOXEDWINE_CONDITION_SIGNAL(waiter->cond);
+            result++;
         }
+        node = next;
     }
-    return 0;
+    return result;
 }
 
-struct futex* allocFutex(KThread* thread, U8* address, U32 millies) {
-    BOXEDWINE_CRITICAL_SECTION;
-    int i=0;
-
-    for (i=0;i<MAX_FUTEXES;i++) {
-        if (system_futex[i].thread==0) {
-            system_futex[i].thread = thread;
-            system_futex[i].address = address;
-            system_futex[i].expireTimeInMillies = millies;
-            system_futex[i].wake = false;
-            return &system_futex[i];
+// both buckets must be locked
+static U32 requeueFutex(KFutexBucket* bucket, U8* address, KFutexBucket* bucket2, U8* address2, U32 count) {
+    U32 result = 0;
+    KListNode<KFutexWaiter*>* node = bucket->waiters.front();
+
+    while (node && result < count) {
+        KListNode<KFutexWaiter*>* next = node->getNext();
+        KFutexWaiter* waiter = node->data;
+
+        if (waiter->address == address) {
+            waiter->address = address2;
+            if (bucket != bucket2) {
+                node->remove();
+                bucket2->waiters.addToBack(node);
+            }
+            result++;
         }
+        node = next;
     }
-    kpanic("ran out of futexes");
-    return 0;
+    return result;
 }
 
-void freeFutex(struct futex* f) {
-    f->thread = 0;
-    f->address = 0;
+// returns true if the waiter was still waiting, false if it was already woken
+static bool removeFutexWaiter(KFutexWaiter* waiter) {
+    while (true) {
+        U8* address = waiter->address;
+        if (!address) {
+            return false;
+        }
+        KFutexBucket* bucket = getFutexBucket(address);
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(bucket->mutex);
+        if (waiter->address != address) {
+            continue; // requeued before the bucket was locked
+        }
+        bool result = waiter->node.isInList();
+        waiter->node.remove();
+        return result;
+    }
 }
 
-void KThread::clearFutexes() {
-    U32 i;
+static U32 getFutexExpireTime(U32 pTime, U32 op) {
+    if (pTime == 0) {
+        return 0xFFFFFFFF;
+    }
+    U64 seconds = readd(pTime);
+    U64 nano = readd(pTime + 4);
+    U64 micro = seconds * 1000000l + nano / 1000;
+
+    if ((op & FUTEX_CMD_MASK) == FUTEX_WAIT_BITSET) {
+        // the timeout is absolute
+        U64 now = (op & FUTEX_CLOCK_REALTIME) ? KSystem::getSystemTimeAsMicroSeconds() : KSystem::getMicroCounter();
+        micro = (micro > now) ? micro - now : 0;
+    }
+    return (U32)(micro / 1000) + KSystem::getMilliesSinceStart();
+}
+
+static U32 applyFutexOp(U32 op, S32 opArg, U32 value) {
+    switch (op & ~FUTEX_OP_OPARG_SHIFT) {
+    case FUTEX_OP_SET: return opArg;
+    case FUTEX_OP_ADD: return value + opArg;
+    case FUTEX_OP_OR: return value | opArg;
+    case FUTEX_OP_ANDN: return value & ~opArg;
+    case FUTEX_OP_XOR: return value ^ opArg;
+    default: return value;
+    }
+}
 
-    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(KThread::futexesMutex);
-    for (i=0;i<MAX_FUTEXES;i++) {
-        if (system_futex[i].thread == this) {
-            freeFutex(&system_futex[i]);
+static bool doFutexOp(U32 encodedOp, U32 addr, U32* oldValue) {
+    U32 op = (encodedOp >> 28) & 0xf;
+    U32 cmp = (encodedOp >> 24) & 0xf;
+    S32 opArg = ((S32)(encodedOp << 8)) >> 20;
+    S32 cmpArg = ((S32)(encodedOp << 20)) >> 20;
+
+    if (op & FUTEX_OP_OPARG_SHIFT) {
+        opArg = 1 << (opArg & 31);
+    }
+    if ((op & ~FUTEX_OP_OPARG_SHIFT) > FUTEX_OP_XOR) {
+        kwarn("futex wake op %d not implemented", op);
+    }
+#ifdef BOXEDWINE_MULTI_THREADED
+    {
+        // other threads can be changing the word at the same time, so like the kernel this has to be a compare exchange
+        // loop instead of a read then a write
+#ifdef BOXEDWINE_BINARY_TRANSLATOR
+        BtCodeMemoryWrite w((BtCPU*)KThread::currentThread()->cpu, addr, 4);
+#endif
+        U32* ram = (U32*)getPhysicalWriteAddress(addr, 4);
+        while (true) {
+            U32 value = *(volatile U32*)ram;
+            if (ATOMIC_COMPARE_EXCHANGE32(ram, value, applyFutexOp(op, opArg, value)) == value) {
+                *oldValue = value;
+                break;
+            }
         }
     }
+#else
+    *oldValue = readd(addr);
+    writed(addr, applyFutexOp(op, opArg, *oldValue));
+#endif
+
+    S32 old = (S32)*oldValue;
+    switch (cmp) {
+    case FUTEX_OP_CMP_EQ: return old == cmpArg;
+    case FUTEX_OP_CMP_NE: return old != cmpArg;
+    case FUTEX_OP_CMP_LT: return old < cmpArg;
+    case FUTEX_OP_CMP_LE: return old <= cmpArg;
+    case FUTEX_OP_CMP_GT: return old > cmpArg;
+    case FUTEX_OP_CMP_GE: return old >= cmpArg;
+    default:
+        kwarn("futex wake op cmp %d not implemented", cmp);
+        return false;
+    }
 }
 
-U32 KThread::futex(U32 addr, U32 op, U32 value, U32 pTime) {    
-    U8* ramAddress = getPhysicalReadAddress(addr, 4);
+void KThread::clearFutexes() {
+    if (this->futexWaiter) {
+        removeFutexWaiter(this->futexWaiter);
+        delete this->futexWaiter;
+        this->futexWaiter = NULL;
+    }
+}
 
-    if (ramAddress==0) {
-        kpanic("Could not find futex address: %0.8X", addr);
+U32 KThread::futexWait(U32 addr, U8* ramAddress, U32 value, U32 pTime, U32 op, U32 bitset) {
+    if (!this->futexWaiter) {
+        this->futexWaiter = new KFutexWaiter(this);
     }
-    if (op==FUTEX_WAIT || op==FUTEX_WAIT_PRIVATE) {
-        struct futex* f=getFutex(this, ramAddress);
-        U32 expireTime;
+    KFutexWaiter* waiter = this->futexWaiter;
 
-        if (pTime == 0) {
-            expireTime = 0xFFFFFFFF;
-        } else {
-            U32 seconds = readd(pTime);
-            U32 nano = readd(pTime + 4);
-            expireTime = seconds * 1000 + nano / 1000000 + KSystem::getMilliesSinceStart();
+    // in single threaded mode waiting returns and the syscall will be called again when the condition is signaled
+    if (waiter->waitAddress != addr || (!waiter->wake && !waiter->node.isInList())) {
+        if (!bitset) {
+            return -K_EINVAL;
         }
-        bool checkValue = false;
-
-        if (!f) {
-            checkValue = true;
-            f = allocFutex(this, ramAddress, expireTime);
+        removeFutexWaiter(waiter); // an earlier wait could have been interrupted
+        waiter->expireTimeInMillies = getFutexExpireTime(pTime, op);
+
+        KFutexBucket* bucket = getFutexBucket(ramAddress);
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(bucket->mutex);
+        // checked with the bucket locked so that a wake after the value changes can't be missed
+        if (readd(addr) != value) {
+            return -K_EWOULDBLOCK;
         }
-        while (true) {
-            BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(f->cond);
-            if (checkValue) {
-                checkValue = false;
-                if (readd(addr) != value) { // needs to be protected
-                    freeFutex(f);
-                    return -K_EWOULDBLOCK;
-                } 
-            }
-            if (f->wake) {
-                freeFutex(f);
+        waiter->address = ramAddress;
+        waiter->waitAddress = addr;
+        waiter->bitset = bitset;
+        waiter->wake = false;
+        bucket->waiters.addToBack(&waiter->node);
+    }
+    while (true) {
+        {
+            BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(waiter->cond);
+            if (waiter->wake) {
+                waiter->wake = false;
                 return 0;
-            }            
-            if (f->expireTimeInMillies<0x7FFFFFFF) {
-                S32 diff = f->expireTimeInMillies - KSystem::getMilliesSinceStart();
-                if (diff<=0) {
-                    freeFutex(f);
-                    return -K_ETIMEDOUT;
+            }
+            if (waiter->expireTimeInMillies != 0xFFFFFFFF) {
+                S32 diff = waiter->expireTimeInMillies - KSystem::getMilliesSinceStart();
+                if (diff > 0) {
+                    BOXEDWINE_CONDITION_WAIT_TIMEOUT(waiter->cond, (U32)diff);
                 }
-                BOXEDWINE_CONDITION_WAIT_TIMEOUT(f->cond, (U32)diff);
             } else {
-                BOXEDWINE_CONDITION_WAIT(f->cond);
+                BOXEDWINE_CONDITION_WAIT(waiter->cond);
             }
-#ifdef BOXEDWINE_MULTI_THREADED
-			if (this->terminating) {
-				return -K_EINTR; // probably doesn't matter
-			}
-            if (KThread::currentThread()->startSignal) {
-                KThread::currentThread()->startSignal = false;
-                return -K_CONTINUE;
+        }
+        if (waiter->expireTimeInMillies != 0xFFFFFFFF && (S32)(waiter->expireTimeInMillies - KSystem::getMilliesSinceStart()) <= 0) {
+            // the waker removes the waiter from the bucket before setting wake, so this tells us if we lost that race
+            if (!removeFutexWaiter(waiter)) {
+                waiter->wake = false;
+                return 0;
             }
+            return -K_ETIMEDOUT;
+        }
+#ifdef BOXEDWINE_MULTI_THREADED
+        if (this->terminating) {
+            return -K_EINTR; // probably doesn't matter
+        }
+        if (KThread::currentThread()->startSignal) {
+            KThread::currentThread()->startSignal = false;
+            return -K_CONTINUE;
+        }
 #endif
+    }
+}
+
+U32 KThread::futex(U32 addr, U32 op, U32 value, U32 pTime, U32 addr2, U32 value3) {
+    U8* ramAddress = getPhysicalReadAddress(addr, 4);
+
+    if (ramAddress==0) {
+        kpanic("Could not find futex address: %0.8X", addr);
+    }
+    U32 cmd = op & FUTEX_CMD_MASK;
+    if (cmd == FUTEX_WAIT) {
+        return this->futexWait(addr, ramAddress, value, pTime, op, FUTEX_BITSET_MATCH_ANY);
+    } else if (cmd == FUTEX_WAIT_BITSET) {
+        return this->futexWait(addr, ramAddress, value, pTime, op, value3);
+    } else if (cmd == FUTEX_WAKE || cmd == FUTEX_WAKE_BITSET) {
+        U32 bitset = (cmd == FUTEX_WAKE) ? FUTEX_BITSET_MATCH_ANY : value3;
+        if (!bitset) {
+            return -K_EINVAL;
         }
-    } else if (op==FUTEX_WAKE_PRIVATE || op==FUTEX_WAKE) {
-        int i;
-        U32 count = 0;
-        for (i=0;i<MAX_FUTEXES && count<value;i++) {
-            if (system_futex[i].address==ramAddress && !system_futex[i].wake) {
-                BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(system_futex[i].cond);
-                system_futex[i].wake = true;
-                BOXEDWINE_CONDITION_SIGNAL(system_futex[i].cond);
-                count++;
+        KFutexBucket* bucket = getFutexBucket(ramAddress);
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(bucket->mutex);
+        return wakeFutex(bucket, ramAddress, value, bitset);
+    }
+
+    // the rest of the ops use a second futex, for these pTime is a count and not a timeout
+    U8* ramAddress2 = getPhysicalReadAddress(addr2, 4);
+    if (ramAddress2 == 0) {
+        return -K_EFAULT;
+    }
+    KFutexBucket* bucket = getFutexBucket(ramAddress);
+    KFutexBucket* bucket2 = getFutexBucket(ramAddress2);
+    U32 result = 0;
+
+    if (cmd == FUTEX_REQUEUE || cmd == FUTEX_CMP_REQUEUE) {
+        lockFutexBuckets(bucket, bucket2);
+        if (cmd == FUTEX_CMP_REQUEUE && readd(addr) != value3) {
+            result = -K_EAGAIN;
+        } else {
+            result = wakeFutex(bucket, ramAddress, value, FUTEX_BITSET_MATCH_ANY);
+            U32 requeued = requeueFutex(bucket, ramAddress, bucket2, ramAddress2, pTime);
+            if (cmd == FUTEX_CMP_REQUEUE) {
+                result += requeued;
             }
         }
-        return count;
+        unlockFutexBuckets(bucket, bucket2);
+    } else if (cmd == FUTEX_WAKE_OP) {
+        if (addr2 & 3) {
+            return -K_EINVAL;
+        }
+        if (!this->memory->isValidWriteAddress(addr2, 4)) {
+            return -K_EFAULT;
+        }
+        lockFutexBuckets(bucket, bucket2);
+        U32 oldValue;
+        bool wake2 = doFutexOp(value3, addr2, &oldValue);
+        result = wakeFutex(bucket, ramAddress, value, FUTEX_BITSET_MATCH_ANY);
+        if (wake2) {
+            result += wakeFutex(bucket2, ramAddress2, pTime, FUTEX_BITSET_MATCH_ANY);
+        }
+        unlockFutexBuckets(bucket, bucket2);
     } else {
         kwarn("syscall __NR_futex op %d not implemented", op);
-        return -1;
+        result = -K_ENOSYS;
     }
+    return result;
 }
 
 static U8 fetchByte(U32* eip) {
@@ -22,6 +22,7 @@ KUnixSocketObject::~KUnixSocketObject() {
             con->connection.reset();
             con->inClosed = true;
             con->outClosed = true;
+            con->notifyWatchers();
             BOXEDWINE_CONDITION_SIGNAL_ALL(con->lockCond);
         }
     }        
@@ -130,23 +131,12 @@ U32 KUnixSocketObject::internal_write(const std::shared_ptr<KUnixSocketObject>&
     if (this->outClosed || !con)
         return -K_EPIPE;  
     
-    //printf("internal_write: %0.8X size=%d capacity=%d writeLen=%d", (int)&this->connection->recvBuffer, (int)this->connection->recvBuffer.size(), (int)this->connection->recvBuffer.capacity(), len);
-
-    while (len) {
-        S8 tmp[4096];
-        U32 todo = len;
-
-        if (todo>4096)
-            todo = 4096;
-        if (!KThread::currentThread()->memory->isValidReadAddress(buffer, todo)) {
-            kwarn("KUnixSocketObject::internal_write about to crash reading buffer to buffer");
-        }
-        memcopyToNative(buffer, tmp, todo);
-        con->recvBuffer.insert(con->recvBuffer.end(), tmp, tmp + todo);
-        buffer+=todo;
-        len-=todo;
-        count+=todo;
-    }     
+    if (!KThread::currentThread()->memory->isValidReadAddress(buffer, len)) {
+        kwarn("KUnixSocketObject::internal_write about to crash reading buffer to buffer");
+    }
+    // straight from the writer's memory into the reader's buffer
+    con->recvBuffer.writeFromMemory(buffer, len);
+    count = len;
     return count;
 }
 
@@ -173,6 +163,7 @@ U32 KUnixSocketObject::writev(U32 iov, S32 iovcnt) {
         len+=result;
     }    
     if (con) {
+        con->notifyWatchers();
         BOXEDWINE_CONDITION_SIGNAL_ALL(cond);
     }
     return len;
@@ -184,6 +175,7 @@ U32 KUnixSocketObject::write(U32 buffer, U32 len) {
     BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(cond);
     U32 result = this->internal_write(con, cond, buffer, len);    
     if (con) {
+        con->notifyWatchers();
         BOXEDWINE_CONDITION_SIGNAL_ALL(con->lockCond);
     }
     return result;
@@ -201,7 +193,8 @@ U32 KUnixSocketObject::writeNative(U8* buffer, U32 len) {
         return -K_EPIPE;
 
     BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(con->lockCond); 
-    con->recvBuffer.insert(con->recvBuffer.end(), buffer, buffer + len);
+    con->recvBuffer.write(buffer, len);
+    con->notifyWatchers();
     BOXEDWINE_CONDITION_SIGNAL_ALL(con->lockCond);
     return len;
 }
@@ -220,7 +213,8 @@ U32 KUnixSocketObject::unixsocket_write_native_nowait(const std::shared_ptr<KObj
 
     BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(con->lockCond);
     //printf("SOCKET write len=%d bufferSize=%d pos=%d\n", len, s->connection->recvBufferLen, s->connection->recvBufferWritePos);
-    con->recvBuffer.insert(con->recvBuffer.end(), value, value + len);
+    con->recvBuffer.write(value, len);
+    con->notifyWatchers();
     BOXEDWINE_CONDITION_SIGNAL_ALL(con->lockCond);
 
     return len;
@@ -250,16 +244,10 @@ U32 KUnixSocketObject::readNative(U8* buffer, U32 len) {
         }
 #endif
     }
-    //printf("readNative: %0.8X size=%d capacity=%d writeLen=%d", (int)&this->recvBuffer, (int)this->recvBuffer.size(), (int)this->recvBuffer.capacity(), len);
-    if (len > this->recvBuffer.size()) {
-        len = (U32)this->recvBuffer.size();
-    }
-    std::copy(this->recvBuffer.begin(), this->recvBuffer.begin() + len, buffer);
-    this->recvBuffer.erase(this->recvBuffer.begin(), this->recvBuffer.begin() + len);
+    len = this->recvBuffer.read(buffer, len);
     if (con) {
         BOXEDWINE_CONDITION_SIGNAL_ALL(this->lockCond);
     }
-    //printf("    readNative: %0.8X size=%d capacity=%d writeLen=%d", (int)&this->recvBuffer, (int)this->recvBuffer.size(), (int)this->recvBuffer.capacity(), len);
     return len;
 }
 
@@ -288,28 +276,13 @@ U32 KUnixSocketObject::read(U32 buffer, U32 len) {
         }
 #endif
     }
-    // :TODO: remove extra copy
-    while (len && this->recvBuffer.size()!=0) {
-        S8 tmp[4096];
-        U32 todo = len;
-
-        if (todo > 4096)
-            todo = 4096;
-        if (todo > this->recvBuffer.size())
-            todo = (U32)this->recvBuffer.size();
-
-        std::copy(this->recvBuffer.begin(), this->recvBuffer.begin() + todo, tmp);
-        this->recvBuffer.erase(this->recvBuffer.begin(), this->recvBuffer.begin() + todo);
-
-        if (!KThread::currentThread()->memory->isValidWriteAddress(buffer, todo)) {
-            kwarn("KUnixSocketObject::read about to crash writing to buffer");
-        }
-        memcopyFromNative(buffer, tmp, todo);
-
-        buffer += todo;
-        count += todo;
-        len -= todo;
-    }      
+    if (len > this->recvBuffer.size()) {
+        len = this->recvBuffer.size();
+    }
+    if (!KThread::currentThread()->memory->isValidWriteAddress(buffer, len)) {
+        kwarn("KUnixSocketObject::read about to crash writing to buffer");
+    }
+    count = this->recvBuffer.readToMemory(buffer, len);
     if (con) {
         BOXEDWINE_CONDITION_SIGNAL_ALL(this->lockCond);
     }
@@ -330,6 +303,24 @@ bool KUnixSocketObject::canMap() {
     return false;
 }
 
+bool KUnixSocketObject::addWatcher(KObjectWatcher* watcher) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(this->lockCond);
+    this->watchers.push_back(watcher);
+    return true;
+}
+
+void KUnixSocketObject::removeWatcher(KObjectWatcher* watcher) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(this->lockCond);
+    VECTOR_REMOVE(this->watchers, watcher);
+}
+
+// reading doesn't need to call this, the other end is always ready to write while it is connected
+void KUnixSocketObject::notifyWatchers() {
+    for (auto& watcher : this->watchers) {
+        watcher->onObjectChanged();
+    }
+}
+
 S64 KUnixSocketObject::seek(S64 pos) {
     return -K_ESPIPE;
 }
@@ -458,6 +449,7 @@ U32 KUnixSocketObject::connect(KFileDescriptor* fd, U32 address, U32 len) {
                 BOXEDWINE_CONDITION_LOCK(destination->lockCond);
                 std::shared_ptr< KUnixSocketObject> t = std::dynamic_pointer_cast<KUnixSocketObject>(shared_from_this());
                 destination->pendingConnections.push_back(t);
+                destination->notifyWatchers();
                 BOXEDWINE_CONDITION_SIGNAL_ALL(destination->lockCond);
                 BOXEDWINE_CONDITION_UNLOCK(destination->lockCond);
 
@@ -547,6 +539,7 @@ U32 KUnixSocketObject::accept(KFileDescriptor* fd, U32 address, U32 len, U32 fla
     resultSocket->connected = true;
     resultSocket->connection = pendingConnection; // weak reference
     
+    pendingConnection->notifyWatchers();
     BOXEDWINE_CONDITION_SIGNAL_ALL(pendingConnection->lockCond);
 
     return result->handle;
@@ -601,19 +594,24 @@ U32 KUnixSocketObject::shutdown(KFileDescriptor* fd, U32 how) {
     if (how == K_SHUT_RD) {
         this->inClosed=true;
         con->outClosed=true;
-        BOXEDWINE_CONDITION_SIGNAL_ALL_NEED_LOCK(con->lockCond);
     } else if (how == K_SHUT_WR) {
         this->outClosed=true;
         con->inClosed=true;
-        BOXEDWINE_CONDITION_SIGNAL_ALL_NEED_LOCK(con->lockCond);
     } else if (how == K_SHUT_RDWR) {
         this->outClosed=true;
         this->inClosed=true;
         con->outClosed=true;
         con->inClosed=true;
-        BOXEDWINE_CONDITION_SIGNAL_ALL_NEED_LOCK(con->lockCond);
     }
-    BOXEDWINE_CONDITION_SIGNAL_ALL_NEED_LOCK(this->lockCond);
+    BOXEDWINE_CONDITION_LOCK(con->lockCond);
+    con->notifyWatchers();
+    BOXEDWINE_CONDITION_SIGNAL_ALL(con->lockCond);
+    BOXEDWINE_CONDITION_UNLOCK(con->lockCond);
+
+    BOXEDWINE_CONDITION_LOCK(this->lockCond);
+    this->notifyWatchers();
+    BOXEDWINE_CONDITION_SIGNAL_ALL(this->lockCond);
+    BOXEDWINE_CONDITION_UNLOCK(this->lockCond);
     return 0;
 }
 
@@ -743,6 +741,7 @@ U32 KUnixSocketObject::sendmsg(KFileDescriptor* fd, U32 address, U32 flags) {
         }
     }
     con->msgs.push(msg);
+    con->notifyWatchers();
     BOXEDWINE_CONDITION_SIGNAL_ALL(con->lockCond);
 
     return result;
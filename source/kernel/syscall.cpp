@@ -750,6 +750,13 @@ static U32 syscall_msync(CPU* cpu, U32 eipCount) {
     return result;
 }
 
+static U32 syscall_readv(CPU* cpu, U32 eipCount) {
+    SYS_LOG1(SYSCALL_READ, cpu, "readv: filds=%d iov=0x%X iovcn=%d", ARG1, ARG2, ARG3);
+    U32 result = cpu->thread->process->readv(ARG1, ARG2, ARG3);
+    SYS_LOG(SYSCALL_READ, cpu, " result=%d(0x%X)\n", result, result);
+    return result;
+}
+
 static U32 syscall_writev(CPU* cpu, U32 eipCount) {
     SYS_LOG1(SYSCALL_WRITE, cpu, "writev: filds=%d iov=0x%X iovcn=%d", ARG1, ARG2, ARG3);    
     U32 result = cpu->thread->process->writev(ARG1, ARG2, ARG3);
@@ -882,6 +889,20 @@ static U32 syscall_pwrite64(CPU* cpu, U32 eipCount) {
     return result;
 }
 
+static U32 syscall_preadv(CPU* cpu, U32 eipCount) {
+    SYS_LOG1(SYSCALL_READ, cpu, "preadv: fd=%d iov=0x%X iovcnt=%d offset=%d", ARG1, ARG2, ARG3, ARG4);
+    U32 result = cpu->thread->process->preadv(ARG1, ARG2, ARG3, ARG4 | ((U64)ARG5) << 32);
+    SYS_LOG(SYSCALL_READ, cpu, " result=%d(0x%X)\n", result, result);
+    return result;
+}
+
+static U32 syscall_pwritev(CPU* cpu, U32 eipCount) {
+    SYS_LOG1(SYSCALL_WRITE, cpu, "pwritev: fd=%d iov=0x%X iovcnt=%d offset=%d", ARG1, ARG2, ARG3, ARG4);
+    U32 result = cpu->thread->process->pwritev(ARG1, ARG2, ARG3, ARG4 | ((U64)ARG5) << 32);
+    SYS_LOG(SYSCALL_WRITE, cpu, " result=%d(0x%X)\n", result, result);
+    return result;
+}
+
 static U32 syscall_getcwd(CPU* cpu, U32 eipCount) {
     SYS_LOG1(SYSCALL_PROCESS, cpu, "getcwd: buf=%X size=%d (%s)", ARG1, ARG2, cpu->thread->process->currentDirectory.c_str());
     U32 result = cpu->thread->process->getcwd(ARG1, ARG2);
@@ -1126,16 +1147,21 @@ static U32 syscall_flistxattr(CPU* cpu, U32 eipCount) {
     return result;
 }
 
-#define FUTEX_WAIT 0
-#define FUTEX_WAKE 1
-#define FUTEX_WAIT_PRIVATE 128
-#define FUTEX_WAKE_PRIVATE 129
-
 static const char* getFutexOp(U32 op) {
     if (op==0) return "WAIT";
     if (op==1) return "WAKE";
+    if (op==3) return "REQUEUE";
+    if (op==4) return "CMP_REQUEUE";
+    if (op==5) return "WAKE_OP";
+    if (op==9) return "WAIT_BITSET";
+    if (op==10) return "WAKE_BITSET";
     if (op==128) return "WAIT PRIVATE";
     if (op==129) return "WAKE PRIVATE";
+    if (op==131) return "REQUEUE PRIVATE";
+    if (op==132) return "CMP_REQUEUE PRIVATE";
+    if (op==133) return "WAKE_OP PRIVATE";
+    if (op==137) return "WAIT_BITSET PRIVATE";
+    if (op==138) return "WAKE_BITSET PRIVATE";
     static std::string tmp;
     tmp = std::to_string(op);
     return tmp.c_str();
@@ -1143,7 +1169,7 @@ static const char* getFutexOp(U32 op) {
 
 static U32 syscall_futex(CPU* cpu, U32 eipCount) {
     SYS_LOG1(SYSCALL_FUTEX, cpu, "futex start: address=%X op=%s value=%d\n", ARG1, getFutexOp(ARG2), ARG3);
-    U32 result = cpu->thread->futex(ARG1, ARG2, ARG3, ARG4);
+    U32 result = cpu->thread->futex(ARG1, ARG2, ARG3, ARG4, ARG5, ARG6);
     SYS_LOG1(SYSCALL_FUTEX, cpu, "futex   end: address=%X op=%s value=%d result=%d(0x%X)\n", ARG1, getFutexOp(ARG2), ARG3, result, result);
     return result;
 }
@@ -1704,7 +1730,7 @@ static const SyscallFunc syscallFunc[] = {
     syscall_newselect,  // 142 __NR_newselect
     syscall_flock,      // 143 __NR_flock
     syscall_msync,      // 144 __NR_msync
-    0,                  // 145
+    syscall_readv,      // 145 __NR_readv
     syscall_writev,     // 146  __NR_writev
     0,                  // 147
     syscall_fdatasync,  // 148 __NR_fdatasync
@@ -1892,8 +1918,8 @@ static const SyscallFunc syscallFunc[] = {
     0,                  // 330
     syscall_pipe2,      // 331 __NR_pipe2
     0,                  // 332
-    0,                  // 333
-    0,                  // 334
+    syscall_preadv,     // 333 __NR_preadv
+    syscall_pwritev,    // 334 __NR_pwritev
     0,                  // 335
     0,                  // 336
     0,                  // 337
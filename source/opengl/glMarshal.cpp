@@ -33,7 +33,7 @@ GLvoid** marshalpp(CPU* cpu, U32 buffer, U32 count, U32 sizes, S32 bytesPerCount
         bufferpp_len = count;
     }
     for (i=0;i<count;i++) {
-        bufferpp[i] = (GLvoid*)getPhysicalAddress(readd(buffer+i*4), 0);
+        bufferpp[i] = (GLvoid*)getPhysicalAddress(readd(cpu->thread->memory, buffer+i*4), 0);
     }
     return bufferpp;
 }
@@ -106,7 +106,7 @@ const GLchar** marshalszArray(CPU* cpu, U32 count, U32 address, U32 addressLengt
         bufferszArray_len = count;
     }
     for (U32 i = 0; i < count; i++) {
-        U32 strAddress = readd(address + i * 4);
+        U32 strAddress = readd(cpu->thread->memory, address + i * 4);
         bufferszArray[i] = (GLchar*)getPhysicalAddress(strAddress, 0);
     }
     return (const GLchar**)bufferszArray;
@@ -124,7 +124,7 @@ const GLcharARB** marshalszArrayARB(CPU* cpu, U32 count, U32 address, U32 addres
         bufferszArrayARB_len = count;
     }
     for (U32 i = 0; i < count; i++) {
-        U32 strAddress = readd(address + i * 4);
+        U32 strAddress = readd(cpu->thread->memory, address + i * 4);
         bufferszArray[i] = (GLcharARB*)getPhysicalAddress(strAddress, 0);
     }
     return (const GLcharARB**)bufferszArrayARB;
@@ -218,7 +218,7 @@ void marshalBackd(CPU* cpu, U32 address, GLdouble* buffer, U32 count) {
         for (i=0;i<count;i++) {
             struct long2Double d;
             d.d = buffer[i];
-            writeq(address, d.l);
+            writeq(cpu->thread->memory, address, d.l);
             address+=8;
         }
     }
@@ -231,7 +231,7 @@ void marshalBackf(CPU* cpu, U32 address, GLfloat* buffer, U32 count) {
         for (i=0;i<count;i++) {
             struct int2Float f;
             f.f = buffer[i];
-            writed(address, f.i);
+            writed(cpu->thread->memory, address, f.i);
             address+=4;
         }
     }
@@ -242,7 +242,7 @@ void marshalBacki(CPU* cpu, U32 address, GLint* buffer, U32 count) {
 
     if (address) {
         for (i=0;i<count;i++) {
-            writed(address, buffer[i]);
+            writed(cpu->thread->memory, address, buffer[i]);
             address+=4;
         }
     }
@@ -257,7 +257,7 @@ void marshalBacki64(CPU* cpu, U32 address, GLint64* buffer, U32 count) {
 
     if (address) {
         for (i=0;i<count;i++) {
-            writeq(address, buffer[i]);
+            writeq(cpu->thread->memory, address, buffer[i]);
             address+=8;
         }
     }
@@ -272,7 +272,7 @@ void marshalBackus(CPU* cpu, U32 address, GLushort* buffer, U32 count) {
 
     if (address) {
         for (i=0;i<count;i++) {
-            writew(address, buffer[i]);
+            writew(cpu->thread->memory, address, buffer[i]);
             address+=2;
         }
     }
@@ -704,10 +704,10 @@ GLvoid** marshalpp(CPU* cpu, U32 buffer, U32 count, U32 sizes, S32 bytesPerCount
     }
     for (i=0;i<count;i++) {
         S32 len = 0;
-        U32 p = readd(buffer+i*4);
+        U32 p = readd(cpu->thread->memory, buffer+i*4);
         if (sizes) {
-            U32 address = readd(sizes+i*4);
-            len = (S32)readd(address);
+            U32 address = readd(cpu->thread->memory, sizes+i*4);
+            len = (S32)readd(cpu->thread->memory, address);
         }
         if (bytesPerCount) {
             if (bytesPerCount==-1 && len<=0) {
@@ -757,9 +757,9 @@ const GLchar** marshalszArray(CPU* cpu, U32 count, U32 address, U32 addressLengt
     }
     for (U32 i = 0; i < count; i++) {
         U32 len;
-        U32 strAddress = readd(address + i * 4);
+        U32 strAddress = readd(cpu->thread->memory, address + i * 4);
         if (addressLengths) {
-            len = readd(addressLengths + i * 4);
+            len = readd(cpu->thread->memory, addressLengths + i * 4);
         } else {
             if (sizeof(GLchar) != 1) {
                 kpanic("marshalszArray sizeof(GLchar)!=1");
@@ -794,9 +794,9 @@ const GLcharARB** marshalszArrayARB(CPU* cpu, U32 count, U32 address, U32 addres
     }
     for (U32 i = 0; i < count; i++) {
         U32 len;
-        U32 strAddress = readd(address + i * 4);
+        U32 strAddress = readd(cpu->thread->memory, address + i * 4);
         if (addressLengths) {
-            len = readd(addressLengths + i * 4);
+            len = readd(cpu->thread->memory, addressLengths + i * 4);
         } else {
             if (sizeof(GLcharARB) != 1) {
                 kpanic("marshalszArrayARB sizeof(GLcharARB)!=1");
@@ -947,7 +947,7 @@ GLhandleARB* marshalhandle(CPU* cpu, U32 address, U32 count) {
     /*
      // not needed
     for (i=0;i<count;i++) {
-        bufferhandle[i] = INDEX_TO_HANDLE(readd(address));
+        bufferhandle[i] = INDEX_TO_HANDLE(readd(cpu->thread->memory, address));
         address+=4;
     }
      */
@@ -958,7 +958,7 @@ void marshalBackhandle(CPU* cpu, U32 address, GLhandleARB* buffer, U32 count) {
     U32 i;
     
     for (i=0;i<count;i++) {
-        writed(address, HANDLE_TO_INDEX(buffer[i]));
+        writed(cpu->thread->memory, address, HANDLE_TO_INDEX(buffer[i]));
         address+=4;
     }
 }
@@ -973,7 +973,7 @@ void marshalBackhandle(CPU* cpu, U32 address, GLhandleARB* buffer, U32 count) {
     if (sizeof(GLhandleARB)!=4)
         kpanic("marshalBackhandle not supported on this platform");
     for (i=0;i<count;i++) {
-        writed(address, buffer[i]);
+        writed(cpu->thread->memory, address, buffer[i]);
         address+=4;
     }
 }
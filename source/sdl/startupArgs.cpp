@@ -26,6 +26,10 @@
 #include "knativesystem.h"
 #include "knativewindow.h"
 #include "knativeaudio.h"
+#ifdef BOXEDWINE_X64
+#include "../emulation/cpu/x64/x64CodeCache.h"
+#include "../emulation/cpu/x64/x64Translator.h"
+#endif
 
 #ifndef BOXEDWINE_DISABLE_UI
 #include "../ui/data/globalSettings.h"
@@ -212,6 +216,14 @@ std::vector<std::string> StartUpArgs::buildArgs() {
         args.push_back("-pollRate");
         args.push_back(std::to_string(this->pollRate));
     }
+    if (codeCachePath.length()) {
+        args.push_back("-codeCache");
+        args.push_back(codeCachePath);
+    }
+    if (translationThreads) {
+        args.push_back("-translationThreads");
+        args.push_back(std::to_string(this->translationThreads));
+    }
     if (logPath.c_str()) {
         args.push_back("-log");
         args.push_back(logPath);
@@ -247,6 +259,10 @@ bool StartUpArgs::apply() {
     KSystem::openglType = this->openGlType;
     KSystem::showWindowImmediately = this->showWindowImmediately;
     KSystem::skipFrameFPS = this->skipFrameFPS;
+#ifdef BOXEDWINE_X64
+    X64CodeCache::path = this->codeCachePath;
+    X64Translator::threadCount = this->translationThreads;
+#endif
     if (!KSystem::logFile && this->logPath.length()) {
         KSystem::logFile = fopen(this->logPath.c_str(), "w");
     }
@@ -674,6 +690,19 @@ bool StartUpArgs::parseStartupArgs(int argc, const char **argv) {
         } else if (!strcmp(argv[i], "-log") && i + 1 < argc) {
             this->logPath = argv[i + 1];
             i++;
+        } else if (!strcmp(argv[i], "-codeCache") && i + 1 < argc) {
+            if (!Fs::doesNativePathExist(argv[i+1])) {
+                MKDIR(argv[i+1]);
+                if (!Fs::doesNativePathExist(argv[i+1])) {
+                    klog("-codeCache path does not exist and could not be created: %s", argv[i+1]);
+                    return false;
+                }
+            }
+            this->codeCachePath = argv[i + 1];
+            i++;
+        } else if (!strcmp(argv[i], "-translationThreads") && i + 1 < argc) {
+            this->translationThreads = atoi(argv[i + 1]);
+            i++;
         }
 #ifdef BOXEDWINE_RECORDER
         else if (!strcmp(argv[i], "-record")) {
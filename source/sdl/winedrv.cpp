@@ -1686,11 +1686,7 @@ void boxeddrv_UnregisterHotKey(CPU* cpu) {
 
 // void boxeddrv_FlushSurface(HWND hwnd, void* bits, int xOrg, int yOrg, int width, int height, zOrder, RECT* rects, int rectCount)
 void boxeddrv_FlushSurface(CPU* cpu) {
-    U32 i;
-
-    for (i=0;i<ARG9;i++) {
-        KNativeWindow::getNativeWindow()->bltWnd(cpu->thread, ARG1, ARG2, ARG3, ARG4, ARG5, ARG6, ARG8+16*i);
-    }
+    KNativeWindow::getNativeWindow()->bltWnd(cpu->thread, ARG1, ARG2, ARG3, ARG4, ARG5, ARG6, ARG8, ARG9);
     KNativeWindow::getNativeWindow()->drawAllWindows(cpu->thread, ARG7+4, readd(ARG7));
 }
 
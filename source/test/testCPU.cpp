@@ -24,6 +24,11 @@
 #include "../emulation/softmmu/soft_memory.h"
 #include "../emulation/hardmmu/hard_memory.h"
 #include "../emulation/cpu/binaryTranslation/btCpu.h"
+#include "../emulation/cpu/binaryTranslation/btCodeChunk.h"
+#ifdef BOXEDWINE_X64
+#include "../emulation/cpu/x64/x64CPU.h"
+#endif
+#include "../emulation/cpu/normal/normalCPU.h"
 #include "knativethread.h"
 
 #ifdef BOXEDWINE_MSVC
@@ -4571,6 +4576,18 @@ void testCmpsd0x2a7() {
 
     // repz (DF)
     strTest(4, 0xf3, 0xa7, DF, "abcdefghijklmnop", 16, "abcdefghijklmnoq", 16, 0x00000010, 0x00000020, 0x00000010, 0x00000000, 0x00000010, 0x0000000C, true, true, false, HEAP_ADDRESS+256);    
+
+    // repz, different on the second page
+    for (U32 i = 0; i < 0x1800; i++) {
+        writeb(HEAP_ADDRESS + i, (U8)i);
+        writeb(HEAP_ADDRESS + 0x2000 + i, (U8)i);
+    }
+    writeb(HEAP_ADDRESS + 0x3403, 0x04);
+    strTest(4, 0xf3, 0xa7, 0, NULL, 0, NULL, 0, 0, 0x2000, 0x600, 0x1404, 0x3404, 0xFF, true, true, false, HEAP_ADDRESS);
+
+    // repz (DF), the same across pages
+    writeb(HEAP_ADDRESS + 0x3403, 0x03);
+    strTest(4, 0xf3, 0xa7, DF, NULL, 0, NULL, 0, 0x17FC, 0x37FC, 0x600, 0xFFFFFFFC, 0x1FFC, 0, true, false, true, HEAP_ADDRESS);
 }
 
 void testScasb0x0ae() {
@@ -4618,6 +4635,12 @@ void testScasb0x2ae() {
 
     // repnz
     strTest(1, 0xf2, 0xae, 0, NULL, 0, "abcd", 4, 0, 256, 256, 0, 260, 252, true, false, true, HEAP_ADDRESS, 0x12345664);
+
+    // repnz, looking for the end of a string that crosses a page
+    for (U32 i = 0; i < 0x1000; i++) {
+        writeb(HEAP_ADDRESS + 0x100 + i, 'a');
+    }
+    strTest(1, 0xf2, 0xae, 0, NULL, 0, NULL, 0, 0, 0x100, 0xFFFFFFFF, 0, 0x1101, 0xFFFFEFFE, true, false, true, HEAP_ADDRESS, 0x12345600);
 }
 
 void testScasw0x0af() {
@@ -4723,6 +4746,18 @@ void testMovsb0x2a4() {
     // repnz (DF)
     strTest(1, 0xf2, 0xa4, DF, "abcd", 4, "0000", 4, 0x40020, 0x40010, 4, 0x4001C, 0x4000C, 0, false, false, false, HEAP_ADDRESS + 256 - 0x40000);
     assertTrue(readd(HEAP_ADDRESS + 256 + 0x10 - 3) == 0x61626364);
+
+    // repz, destination one byte ahead of the source fills memory with the first byte, across pages
+    writeb(HEAP_ADDRESS + 0x100, 'x');
+    strTest(1, 0xf3, 0xa4, 0, NULL, 0, NULL, 0, 0x40100, 0x40101, 0x2000, 0x42100, 0x42101, 0, false, false, false, HEAP_ADDRESS - 0x40000);
+    U32 count = 0;
+    for (U32 i = 0; i <= 0x2000; i++) {
+        if (readb(HEAP_ADDRESS + 0x100 + i) == 'x') {
+            count++;
+        }
+    }
+    assertTrue(count == 0x2001);
+    assertTrue(readb(HEAP_ADDRESS + 0x2101) == 0);
 }
 
 void testMovsw0x0a5() {
@@ -4775,6 +4810,58 @@ void testMovsd0x2a5() {
     strTest(4, 0xf2, 0xa5, DF, "abcdefgh", 8, "00000000", 8, 0x40020, 0x40010, 2, 0x40018, 0x40008, 0, false, false, false, HEAP_ADDRESS + 256 - 0x40000);
     assertTrue(readd(HEAP_ADDRESS + 256 + 0x10) == 0x61626364);
     assertTrue(readd(HEAP_ADDRESS + 256 + 0x10 - 4) == 0x65666768);
+
+    // the overlapping cases must match copying one element at a time, these cross a page
+    static const U32 distances[] = {2, 4, 6};
+    for (U32 d = 0; d < sizeof(distances) / sizeof(distances[0]); d++) {
+        U8 expected[0x1010];
+        for (U32 i = 0; i < sizeof(expected); i++) {
+            expected[i] = (U8)(i * 7);
+            writeb(HEAP_ADDRESS + 0xF00 + i, expected[i]);
+        }
+        for (U32 i = 0; i < 0x400; i++) {
+            memmove(expected + distances[d] + i * 4, expected + i * 4, 4);
+        }
+        // repz, destination ahead of the source
+        strTest(4, 0xf3, 0xa5, 0, NULL, 0, NULL, 0, 0x40F00, 0x40F00 + distances[d], 0x400, 0x41F00, 0x41F00 + distances[d], 0, false, false, false, HEAP_ADDRESS - 0x40000);
+        U32 count = 0;
+        for (U32 i = 0; i < sizeof(expected); i++) {
+            if (readb(HEAP_ADDRESS + 0xF00 + i) == expected[i]) {
+                count++;
+            }
+        }
+        assertTrue(count == sizeof(expected));
+
+        for (U32 i = 0; i < sizeof(expected); i++) {
+            expected[i] = (U8)(i * 7);
+            writeb(HEAP_ADDRESS + 0xF00 + i, expected[i]);
+        }
+        for (U32 i = 0; i < 0x400; i++) {
+            memmove(expected + 0x1000 - i * 4, expected + 0x1000 - i * 4 + distances[d], 4);
+        }
+        // repz (DF), destination below the source
+        strTest(4, 0xf3, 0xa5, DF, NULL, 0, NULL, 0, 0x41F00 + distances[d], 0x41F00, 0x400, 0x40F00 + distances[d], 0x40F00, 0, false, false, false, HEAP_ADDRESS - 0x40000);
+        count = 0;
+        for (U32 i = 0; i < sizeof(expected); i++) {
+            if (readb(HEAP_ADDRESS + 0xF00 + i) == expected[i]) {
+                count++;
+            }
+        }
+        assertTrue(count == sizeof(expected));
+    }
+
+    // repz (DF), destination above the source is a plain move
+    for (U32 i = 0; i < 0x3000; i++) {
+        writeb(HEAP_ADDRESS + i, (U8)(i * 7));
+    }
+    strTest(4, 0xf3, 0xa5, DF, NULL, 0, NULL, 0, 0x427FC, 0x42FFC, 0x800, 0x407FC, 0x40FFC, 0, false, false, false, HEAP_ADDRESS - 0x40000);
+    U32 count = 0;
+    for (U32 i = 0; i < 0x2000; i++) {
+        if (readb(HEAP_ADDRESS + 0x1000 + i) == (U8)((0x800 + i) * 7)) {
+            count++;
+        }
+    }
+    assertTrue(count == 0x2000);
 }
 
 void testStosb0x0aa() {
@@ -4876,6 +4963,18 @@ void testStosd0x2ab() {
     strTest(4, 0xf2, 0xab, DF, NULL, 0, "00000000", 8, 0x40020, 0x40010, 2, 0x40020, 0x40008, 0, false, false, false, HEAP_ADDRESS + 256 - 0x40000, 0x31323334);
     assertTrue(readd(HEAP_ADDRESS + 256 + 0x10) == 0x31323334);
     assertTrue(readd(HEAP_ADDRESS + 256 + 0x10 - 4) == 0x31323334);
+
+    // repz, starting with an element that crosses a page
+    strTest(4, 0xf3, 0xab, 0, NULL, 0, NULL, 0, 0x40000, 0x40FFE, 0x401, 0x40000, 0x42002, 0, false, false, false, HEAP_ADDRESS - 0x40000, 0x11223344);
+    U32 count = 0;
+    for (U32 i = 0; i < 0x401; i++) {
+        if (readd(HEAP_ADDRESS + 0xFFE + i * 4) == 0x11223344) {
+            count++;
+        }
+    }
+    assertTrue(count == 0x401);
+    assertTrue(readw(HEAP_ADDRESS + 0xFFC) == 0);
+    assertTrue(readw(HEAP_ADDRESS + 0x2002) == 0);
 }
 
 void testLodsb0x0ac() {
@@ -9177,10 +9276,174 @@ void test16BitMemoryAccess() {
 }
 
 
+#ifdef BOXEDWINE_BINARY_TRANSLATOR
+// small functions as a compiler would emit them, used to measure how fast code is translated
+static const U8 translationCorpus[] = {
+    // 0x00 if/else chain
+    0x55, 0x89, 0xe5, 0x83, 0xec, 0x10, 0x53, 0x56, 0x57, 0x8b, 0x45, 0x08, 0x83, 0xf8, 0x01, 0x74,
+    0x09, 0x83, 0xf8, 0x02, 0x74, 0x0c, 0x31, 0xc0, 0xeb, 0x0e, 0x8b, 0x45, 0x0c, 0x03, 0x45, 0x10,
+    0xeb, 0x06, 0x8b, 0x45, 0x0c, 0x2b, 0x45, 0x10, 0x5f, 0x5e, 0x5b, 0x89, 0xec, 0x5d, 0xc3,
+    // 0x2f sum loop
+    0x31, 0xc0, 0x8b, 0x4c, 0x24, 0x04, 0x8b, 0x54, 0x24, 0x08, 0x85, 0xc9, 0x74, 0x08, 0x03, 0x02,
+    0x83, 0xc2, 0x04, 0x49, 0x75, 0xf8, 0xc3,
+    // 0x46 memcpy
+    0x56, 0x57, 0x8b, 0x74, 0x24, 0x0c, 0x8b, 0x7c, 0x24, 0x10, 0x8b, 0x4c, 0x24, 0x14, 0x89, 0xc8,
+    0xc1, 0xe9, 0x02, 0xf3, 0xa5, 0x89, 0xc1, 0x83, 0xe1, 0x03, 0xf3, 0xa4, 0x5f, 0x5e, 0xc3,
+    // 0x65 strlen
+    0x8b, 0x54, 0x24, 0x04, 0x89, 0xd0, 0x80, 0x38, 0x00, 0x74, 0x03, 0x40, 0xeb, 0xf8, 0x29, 0xd0,
+    0xc3,
+    // 0x76 arithmetic with an early out
+    0x55, 0x89, 0xe5, 0x8b, 0x45, 0x08, 0x83, 0xf8, 0x03, 0x77, 0x1a, 0x8d, 0x0c, 0x40, 0xc1, 0xe1,
+    0x02, 0x89, 0xca, 0x0f, 0xaf, 0xd0, 0x0f, 0xb6, 0x45, 0x0c, 0x09, 0xd0, 0xa9, 0x80, 0x00, 0x00,
+    0x00, 0x75, 0x02, 0xf7, 0xd8, 0x89, 0xec, 0x5d, 0xc3
+};
+
+// every place the translator would start a chunk in the corpus
+static const U32 translationCorpusBlocks[] = {0x00, 0x1a, 0x22, 0x28, 0x2f, 0x46, 0x65, 0x73, 0x76, 0x9b};
+
+void testTranslationSpeed() {
+    BtCPU* c = (BtCPU*)cpu;
+    U64 bytes = 0;
+    U64 time = 0;
+    U32 chunks = 0;
+
+    cpu->big = 1;
+    for (U32 i = 0; i < sizeof(translationCorpus); i++) {
+        writeb(CODE_ADDRESS + i, translationCorpus[i]);
+    }
+    for (U32 iteration = 0; iteration < 2000; iteration++) {
+        for (U32 block : translationCorpusBlocks) {
+            U64 startTime = KSystem::getMicroCounter();
+            std::shared_ptr<BtCodeChunk> chunk = c->translateChunk(block);
+            time += KSystem::getMicroCounter() - startTime;
+            bytes += chunk->getEipLen();
+            chunks++;
+            chunk->makeLive();
+
+            // release the chunk and the stubs it linked to so that each iteration translates the same code
+            for (U32 eip = CODE_ADDRESS; eip < CODE_ADDRESS + sizeof(translationCorpus); eip++) {
+                std::shared_ptr<BtCodeChunk> existing = memory->getCodeChunkContainingEip(eip);
+                if (existing) {
+                    existing->release(memory);
+                }
+            }
+        }
+    }
+    if (time) {
+        printf("Translated %d bytes per second, %d chunks in %d us\n", (U32)(bytes * 1000000 / time), chunks, (U32)time);
+    }
+}
+
+#ifdef BOXEDWINE_X64
+extern U32 dynamicCodeExceptionCount;
+extern U32 lastWriteCodePageAddress;
+
+// an op that has faulted enough times writing to a page with code is translated to check the page itself and call
+// x64_writeCodePage instead of taking the exception
+void testCodePageWriteCheck() {
+    U32 exceptionCount = dynamicCodeExceptionCount;
+    U32 nativePage = memory->getNativePage(CODE_ADDRESS >> K_PAGE_SHIFT);
+
+    cpu->big = true;
+    newInstruction(0);
+    EAX = 0x90909090;
+    EBX = 0x100; // code in another chunk
+    ECX = 0x11;
+    EDX = 0xABCD;
+    pushCode8(0x2e); pushCode8(0x89); pushCode8(0x03); // mov cs:[ebx], eax
+    pushCode8(0x01); pushCode8(0xd1); // add ecx, edx
+    pushCode8(0xcd);
+    pushCode8(0x97); // will cause TEST specific return code to be inserted
+    cseip = CODE_ADDRESS + 0x100;
+    pushCode8(0xc3); // ret
+    U8* otherChunk = (U8*)((BtCPU*)cpu)->translateEip(0x100);
+
+    memory->codePageWriteFaults[CODE_ADDRESS] = X64_CODE_PAGE_WRITE_FAULT_LIMIT;
+    ((BtCPU*)cpu)->translateEip(0);
+    makeCodePageReadOnly(memory, nativePage);
+    cpu->run();
+    // x64_writeCodePage was given the address that was written to and the other chunk was invalidated
+    assertTrue(lastWriteCodePageAddress == CODE_ADDRESS + 0x100);
+    assertTrue(*otherChunk == 0xce);
+    clearCodePageReadOnly(memory, nativePage);
+    memory->codePageWriteFaults.clear();
+    memory->clearCodePageFromCache(CODE_ADDRESS >> K_PAGE_SHIFT);
+    ((BtCPU*)cpu)->postTestRun();
+
+    assertTrue(readd(CODE_ADDRESS + 0x100) == 0x90909090);
+    assertTrue(EAX == 0x90909090);
+    assertTrue(EBX == 0x100);
+    assertTrue(ECX == 0x11 + 0xABCD);
+    assertTrue(dynamicCodeExceptionCount == exceptionCount);
+}
+#endif
+#else
+// a loop with a branch in it, it runs enough times to be turned into traces with side exits
+void testTrace() {
+    U32 traceCount = NormalCPU::traceCount;
+
+    cpu->big = true;
+    newInstruction(0);
+    pushCode8(0xb9); pushCode32(200); // mov ecx, 200
+    pushCode8(0x31); pushCode8(0xc0); // xor eax, eax
+    pushCode8(0xf6); pushCode8(0xc1); pushCode8(0x01); // test cl, 1
+    pushCode8(0x74); pushCode8(0x02); // jz over the add
+    pushCode8(0x01); pushCode8(0xc8); // add eax, ecx
+    pushCode8(0x49); // dec ecx
+    pushCode8(0x75); pushCode8(0xf6); // jnz to the test
+
+    runTestCPU();
+
+    assertTrue(EAX == 10000); // sum of the odd numbers from 1 to 199
+    assertTrue(ECX == 0);
+    assertTrue(NormalCPU::traceCount > traceCount);
+}
+
+// every op here except the last has all of its flags overwritten before they are read
+void testNoFlags() {
+    U32 noFlagsOpCount = NormalCPU::noFlagsOpCount;
+
+    cpu->big = true;
+    newInstruction(0);
+    EAX = 0x12345678;
+    ECX = 3;
+    EDX = 0x80;
+    writed(HEAP_ADDRESS + 0x10, 5);
+    pushCode8(0xf9); // stc
+    pushCode8(0x11); pushCode8(0xc8); // adc eax, ecx
+    pushCode8(0x00); pushCode8(0xd0); // add al, dl
+    pushCode8(0xc1); pushCode8(0xe0); pushCode8(0x04); // shl eax, 4
+    pushCode8(0x66); pushCode8(0xc1); pushCode8(0xc0); pushCode8(0x08); // rol ax, 8
+    pushCode8(0xd0); pushCode8(0xfa); // sar dl, 1
+    pushCode8(0x41); // inc ecx
+    pushCode8(0x01); pushCode8(0x0d); pushCode32(0x10); // add [0x10], ecx
+    pushCode8(0x39); pushCode8(0xc0); // cmp eax, eax
+
+    runTestCPU();
+
+    assertTrue(EAX == 0x2345C06F);
+    assertTrue(ECX == 4);
+    assertTrue(EDX == 0xC0);
+    assertTrue(readd(HEAP_ADDRESS + 0x10) == 9);
+    assertTrue(cpu->getZF() != 0);
+    assertTrue(cpu->getCF() == 0);
+    assertTrue(NormalCPU::noFlagsOpCount - noFlagsOpCount >= 7);
+}
+#endif
+
 int main(int argc, char **argv) {	
     printf("Please wait, these first 2 tests can take a while\n");
     run(test32BitMemoryAccess, "32-bit Memory Access");
     run(test16BitMemoryAccess, "16-bit Memory Access");
+#ifdef BOXEDWINE_BINARY_TRANSLATOR
+    run(testTranslationSpeed, "Translation Speed");
+#ifdef BOXEDWINE_X64
+    run(testCodePageWriteCheck, "Code Page Write Check");
+#endif
+#else
+    run(testTrace, "Trace");
+    run(testNoFlags, "No Flags");
+#endif
 
     run(testAdd0x000, "Add 000");
     run(testAdd0x200, "Add 200");
@@ -65,13 +65,13 @@ void testSse128(U8 preOp1, U8 preOp2, U8 op, U64 value1l, U64 value1h, U64 value
                         TestDouble f1;
                         TestDouble t1;
 
-                        t1.i = cpu->xmm[m].pi.u64[0];
+                        t1.i = cpu->xmm[m].u64[0];
                         f1.i = xmmResultl;
-                        if (cpu->xmm[m].pi.u64[0]!=xmmResultl || cpu->xmm[m].pi.u64[1]!=xmmResulth) {
+                        if (cpu->xmm[m].u64[0]!=xmmResultl || cpu->xmm[m].u64[1]!=xmmResulth) {
                             failed("sse failed");
                         }
                     } else {
-                        if (cpu->xmm[m1].pi.u64[0]!=SSE_MEM_VALUE128_DEFAULT1 || cpu->xmm[m1].pi.u64[1]!=SSE_MEM_VALUE128_DEFAULT2) {
+                        if (cpu->xmm[m1].u64[0]!=SSE_MEM_VALUE128_DEFAULT1 || cpu->xmm[m1].u64[1]!=SSE_MEM_VALUE128_DEFAULT2) {
                             failed("sse failed");
                         }
                     }
@@ -97,11 +97,11 @@ void testSse128(U8 preOp1, U8 preOp2, U8 op, U64 value1l, U64 value1h, U64 value
             runTestCPU();
             for (U8 m1=0;m1<8;m1++) {
                 if (m1==m) {
-                    if (cpu->xmm[m].pi.u64[0]!=memResultl || cpu->xmm[m].pi.u64[1]!=memResulth) {
+                    if (cpu->xmm[m].u64[0]!=memResultl || cpu->xmm[m].u64[1]!=memResulth) {
                         failed("sse failed");
                     }
                 } else {
-                    if (cpu->xmm[m1].pi.u64[0]!=SSE_MEM_VALUE128_DEFAULT1 || cpu->xmm[m1].pi.u64[1]!=SSE_MEM_VALUE128_DEFAULT2) {
+                    if (cpu->xmm[m1].u64[0]!=SSE_MEM_VALUE128_DEFAULT1 || cpu->xmm[m1].u64[1]!=SSE_MEM_VALUE128_DEFAULT2) {
                         failed("sse failed");
                     }
                 }
@@ -132,11 +132,11 @@ void testSse16Eimm8(U8 preOp1, U8 preOp2, U8 op, U64 value1l, U64 value1h, U32 v
             runTestCPU();
             for (U8 m1 = 0; m1 < 8; m1++) {
                 if (m1 == m || m1 == from) {
-                    if (cpu->xmm[m].pi.u64[0] != xmmResultl || cpu->xmm[m].pi.u64[1] != xmmResulth) {
+                    if (cpu->xmm[m].u64[0] != xmmResultl || cpu->xmm[m].u64[1] != xmmResulth) {
                         failed("sse failed");
                     }
                 } else {
-                    if (cpu->xmm[m1].pi.u64[0] != SSE_MEM_VALUE128_DEFAULT1 || cpu->xmm[m1].pi.u64[1] != SSE_MEM_VALUE128_DEFAULT2) {
+                    if (cpu->xmm[m1].u64[0] != SSE_MEM_VALUE128_DEFAULT1 || cpu->xmm[m1].u64[1] != SSE_MEM_VALUE128_DEFAULT2) {
                         failed("sse failed");
                     }
                 }
@@ -160,11 +160,11 @@ void testSse16Eimm8(U8 preOp1, U8 preOp2, U8 op, U64 value1l, U64 value1h, U32 v
         runTestCPU();
         for (U8 m1 = 0; m1 < 8; m1++) {
             if (m1 == m) {
-                if (cpu->xmm[m].pi.u64[0] != xmmResultl || cpu->xmm[m].pi.u64[1] != xmmResulth) {
+                if (cpu->xmm[m].u64[0] != xmmResultl || cpu->xmm[m].u64[1] != xmmResulth) {
                     failed("sse failed");
                 }
             } else {
-                if (cpu->xmm[m1].pi.u64[0] != SSE_MEM_VALUE128_DEFAULT1 || cpu->xmm[m1].pi.u64[1] != SSE_MEM_VALUE128_DEFAULT2) {
+                if (cpu->xmm[m1].u64[0] != SSE_MEM_VALUE128_DEFAULT1 || cpu->xmm[m1].u64[1] != SSE_MEM_VALUE128_DEFAULT2) {
                     failed("sse failed");
                 }
             }
@@ -197,13 +197,13 @@ void testSse128imm(U8 preOp1, U8 preOp2, U8 op, U8 imm, U64 value1l, U64 value1h
                     Test_Float f1;
                     Test_Float t1;
 
-                    t1.i = cpu->xmm[m].pi.u32[0];
+                    t1.i = cpu->xmm[m].u32[0];
                     f1.i = (U32)xmmResultl;
-                    if (cpu->xmm[m].pi.u64[0]!=xmmResultl || cpu->xmm[m].pi.u64[1]!=xmmResulth) {
+                    if (cpu->xmm[m].u64[0]!=xmmResultl || cpu->xmm[m].u64[1]!=xmmResulth) {
                         failed("sse failed");
                     }
                 } else {
-                    if (cpu->xmm[m1].pi.u64[0]!=SSE_MEM_VALUE128_DEFAULT1 || cpu->xmm[m1].pi.u64[1]!=SSE_MEM_VALUE128_DEFAULT2) {
+                    if (cpu->xmm[m1].u64[0]!=SSE_MEM_VALUE128_DEFAULT1 || cpu->xmm[m1].u64[1]!=SSE_MEM_VALUE128_DEFAULT2) {
                         failed("sse failed");
                     }
                 }
@@ -228,11 +228,11 @@ void testSse128imm(U8 preOp1, U8 preOp2, U8 op, U8 imm, U64 value1l, U64 value1h
         runTestCPU();
         for (U8 m1=0;m1<8;m1++) {
             if (m1==m) {
-                if (cpu->xmm[m].pi.u64[0]!=xmmResultl || cpu->xmm[m].pi.u64[1]!=xmmResulth) {
+                if (cpu->xmm[m].u64[0]!=xmmResultl || cpu->xmm[m].u64[1]!=xmmResulth) {
                     failed("sse failed");
                 }
             } else {
-                if (cpu->xmm[m1].pi.u64[0]!=SSE_MEM_VALUE128_DEFAULT1 || cpu->xmm[m1].pi.u64[1]!=SSE_MEM_VALUE128_DEFAULT2) {
+                if (cpu->xmm[m1].u64[0]!=SSE_MEM_VALUE128_DEFAULT1 || cpu->xmm[m1].u64[1]!=SSE_MEM_VALUE128_DEFAULT2) {
                     failed("sse failed");
                 }
             }
@@ -255,7 +255,7 @@ void testSse128SubImm(U8 preOp1, U8 preOp2, U8 op, U8 g, U8 imm, U64 value1l, U6
         pushCode8(0xC0 | (g << 3) | m);            
         pushCode8(imm);
         runTestCPU();
-        if (cpu->xmm[m].pi.u64[0]!=xmmResultl || cpu->xmm[m].pi.u64[1]!=xmmResulth) {
+        if (cpu->xmm[m].u64[0]!=xmmResultl || cpu->xmm[m].u64[1]!=xmmResulth) {
             failed("sse failed");
         }
 
@@ -338,11 +338,11 @@ void testSse128r(U8 preOp1, U8 preOp2, U8 op, U64 value1l, U64 value1h, U64 valu
                 runTestCPU();
                 for (U8 m1=0;m1<8;m1++) {
                     if (m1==m || m1==from) {
-                        if (cpu->xmm[m].pi.u64[0]!=xmmResultl || cpu->xmm[m].pi.u64[1]!=xmmResulth) {
+                        if (cpu->xmm[m].u64[0]!=xmmResultl || cpu->xmm[m].u64[1]!=xmmResulth) {
                             failed("sse failed");
                         }
                     } else {
-                        if (cpu->xmm[m1].pi.u64[0]!=SSE_MEM_VALUE128_DEFAULT1 || cpu->xmm[m1].pi.u64[1]!=SSE_MEM_VALUE128_DEFAULT2) {
+                        if (cpu->xmm[m1].u64[0]!=SSE_MEM_VALUE128_DEFAULT1 || cpu->xmm[m1].u64[1]!=SSE_MEM_VALUE128_DEFAULT2) {
                             failed("sse failed");
                         }
                     }
@@ -402,11 +402,11 @@ void testSse128E64(U8 preOp1, U8 preOp2, U8 op, U64 value1l, U64 value1h, U64 va
                 runTestCPU();
                 for (U8 m1=0;m1<8;m1++) {
                     if (m1==m || m1==from) {
-                        if (cpu->xmm[m].pi.u64[0]!=xmmResultl || cpu->xmm[m].pi.u64[1]!=xmmResulth) {
+                        if (cpu->xmm[m].u64[0]!=xmmResultl || cpu->xmm[m].u64[1]!=xmmResulth) {
                             failed("sse failed");
                         }
                     } else {
-                        if (cpu->xmm[m1].pi.u64[0]!=SSE_MEM_VALUE128_DEFAULT1 || cpu->xmm[m1].pi.u64[1]!=SSE_MEM_VALUE128_DEFAULT2) {
+                        if (cpu->xmm[m1].u64[0]!=SSE_MEM_VALUE128_DEFAULT1 || cpu->xmm[m1].u64[1]!=SSE_MEM_VALUE128_DEFAULT2) {
                             failed("sse failed");
                         }
                     }
@@ -430,7 +430,7 @@ void testSse128E64(U8 preOp1, U8 preOp2, U8 op, U64 value1l, U64 value1h, U64 va
             pushCode32(SSE_MEM_VALUE_TMP_OFFSET+16);
             runTestCPU();
 
-            if (cpu->xmm[m].pi.u64[0]!=memResultl || cpu->xmm[m].pi.u64[1]!=memResulth) {
+            if (cpu->xmm[m].u64[0]!=memResultl || cpu->xmm[m].u64[1]!=memResulth) {
                 failed("sse failed");
             }
         }
@@ -461,7 +461,7 @@ void testSse128E64r(U8 preOp1, U8 preOp2, U8 op, U64 value1l, U64 value1h, U64 v
                 pushCode8(op);
                 pushCode8(0xC0 | m | (from << 3));            
                 runTestCPU();
-                if (cpu->xmm[m].pi.u64[0]!=xmmResultl || cpu->xmm[m].pi.u64[1]!=xmmResulth) {
+                if (cpu->xmm[m].u64[0]!=xmmResultl || cpu->xmm[m].u64[1]!=xmmResulth) {
                     failed("sse failed");
                 }
             }
@@ -513,7 +513,7 @@ void testSseMmx64(U8 preOp1, U8 preOp2, U8 op, U64 value1l, U64 value1h, U64 val
             pushCode8(0xC0 | (m << 3) | from);            
             runTestCPU();
 
-            if (cpu->xmm[m].pi.u64[0]!=xmmResultl || cpu->xmm[m].pi.u64[1]!=xmmResulth) {
+            if (cpu->xmm[m].u64[0]!=xmmResultl || cpu->xmm[m].u64[1]!=xmmResulth) {
                 failed("sse failed");
             }
         }
@@ -534,7 +534,7 @@ void testSseMmx64(U8 preOp1, U8 preOp2, U8 op, U64 value1l, U64 value1h, U64 val
             pushCode8(0x25);
             pushCode32(SSE_MEM_VALUE_TMP_OFFSET+16);
             runTestCPU();
-            if (cpu->xmm[m].pi.u64[0]!=memResultl || cpu->xmm[m].pi.u64[1]!=memResulth) {
+            if (cpu->xmm[m].u64[0]!=memResultl || cpu->xmm[m].u64[1]!=memResulth) {
                 failed("sse failed");
             }
         }
@@ -631,7 +631,7 @@ void testSseReg32(U8 preOp1, U8 preOp2, U8 op, U64 value1l, U64 value1h, U32 val
             pushCode8(0xC0 | (m << 3) | from);            
             runTestCPU();
 
-            if (cpu->xmm[m].pi.u64[0]!=xmmResultl || cpu->xmm[m].pi.u64[1]!=xmmResulth) {
+            if (cpu->xmm[m].u64[0]!=xmmResultl || cpu->xmm[m].u64[1]!=xmmResulth) {
                 failed("sse failed");
             }
         }
@@ -651,7 +651,7 @@ void testSseReg32(U8 preOp1, U8 preOp2, U8 op, U64 value1l, U64 value1h, U32 val
         pushCode8(0x25);
         pushCode32(SSE_MEM_VALUE_TMP_OFFSET+16);
         runTestCPU();
-        if (cpu->xmm[m].pi.u64[0]!=xmmResultl || cpu->xmm[m].pi.u64[1]!=xmmResulth) {
+        if (cpu->xmm[m].u64[0]!=xmmResultl || cpu->xmm[m].u64[1]!=xmmResulth) {
             failed("sse failed");
         }
     }    
@@ -1486,7 +1486,7 @@ void testSseRsqrtss352() {
     }
 #endif
     // :TODO: not exact match
-#ifdef BOXEDWINE_X64 
+#if defined(BOXEDWINE_X64) || defined(SIMDE_X86_SSE_NATIVE)
     testSse128(0, 0xf3, 0x52, 0x4110000040800000, 0x4000000043800000, 0x4110000040800000, 0x4000000043800000, 0x411000003efff000, 0x4000000043800000);
 #elif defined(BOXEDWINE_BINARY_TRANSLATOR)
     testSse128(0, 0xf3, 0x52, 0x4110000040800000, 0x4000000043800000, 0x4110000040800000, 0x4000000043800000, 0x411000003eff8000, 0x4000000043800000);
@@ -1512,7 +1512,7 @@ void testSseRcpps353() {
     }
 #endif
     // :TODO: not exact match
-#ifdef BOXEDWINE_X64
+#if defined(BOXEDWINE_X64) || defined(SIMDE_X86_SSE_NATIVE)
     testSse128(0, 0, 0x53, 0x4110000040800000, 0x3dcccccd43800000, 0x4110000040800000, 0x3dcccccd43800000, 0x3de380003e7ff000, 0x412000003b7ff000);
 #elif defined(BOXEDWINE_BINARY_TRANSLATOR)
     testSse128(0, 0, 0x53, 0x4110000040800000, 0x3dcccccd43800000, 0x4110000040800000, 0x3dcccccd43800000, 0x3de300003e7f8000, 0x412000003b7f8000);
@@ -1538,7 +1538,7 @@ void testSseRcpss353() {
     }
 #endif
     // :TODO: not exact match
-#ifdef BOXEDWINE_X64
+#if defined(BOXEDWINE_X64) || defined(SIMDE_X86_SSE_NATIVE)
     testSse128(0, 0xf3, 0x53, 0x4110000040800000, 0x3dcccccd43800000, 0x4110000040800000, 0x3dcccccd43800000, 0x411000003e7ff000, 0x3dcccccd43800000);
 #elif defined(BOXEDWINE_BINARY_TRANSLATOR)
     testSse128(0, 0xf3, 0x53, 0x4110000040800000, 0x3dcccccd43800000, 0x4110000040800000, 0x3dcccccd43800000, 0x411000003e7f8000, 0x3dcccccd43800000);
@@ -0,0 +1,108 @@
+#ifndef __KRINGBUFFER_H__
+#define __KRINGBUFFER_H__
+
+// A growable byte queue.  The storage is a single power of 2 sized block so that at most two copies are needed to
+// move data in or out, and data can be copied directly between the buffer and emulated memory without going through
+// a temporary buffer.
+#define K_RING_BUFFER_MIN_SIZE K_PAGE_SIZE
+#define K_RING_BUFFER_KEEP_SIZE (16 * K_PAGE_SIZE) // once empty, anything larger than this is freed
+
+class KRingBuffer {
+public:
+    KRingBuffer() : buffer(NULL), capacity(0), readPos(0), count(0) {}
+    ~KRingBuffer() {
+        if (this->buffer) {
+            delete[] this->buffer;
+        }
+    }
+
+    U32 size() {return this->count;}
+    bool isEmpty() {return this->count == 0;}
+
+    void write(const U8* data, U32 len) {
+        this->reserve(len);
+        U32 pos = this->writePos();
+        U32 todo = std::min(len, this->capacity - pos);
+        memcpy(this->buffer + pos, data, todo);
+        memcpy(this->buffer, data + todo, len - todo);
+        this->count += len;
+    }
+
+    U32 read(U8* data, U32 len) {
+        len = std::min(len, this->count);
+        U32 todo = std::min(len, this->capacity - this->readPos);
+        memcpy(data, this->buffer + this->readPos, todo);
+        memcpy(data + todo, this->buffer, len - todo);
+        this->consume(len);
+        return len;
+    }
+
+    // copies len bytes from emulated memory
+    void writeFromMemory(U32 address, U32 len) {
+        this->reserve(len);
+        U32 pos = this->writePos();
+        U32 todo = std::min(len, this->capacity - pos);
+        memcopyToNative(address, this->buffer + pos, todo);
+        if (len > todo) {
+            memcopyToNative(address + todo, this->buffer, len - todo);
+        }
+        this->count += len;
+    }
+
+    // copies up to len bytes to emulated memory, returns the number of bytes copied
+    U32 readToMemory(U32 address, U32 len) {
+        len = std::min(len, this->count);
+        U32 todo = std::min(len, this->capacity - this->readPos);
+        memcopyFromNative(address, this->buffer + this->readPos, todo);
+        if (len > todo) {
+            memcopyFromNative(address + todo, this->buffer, len - todo);
+        }
+        this->consume(len);
+        return len;
+    }
+
+private:
+    U32 writePos() {return (this->readPos + this->count) & (this->capacity - 1);}
+
+    void consume(U32 len) {
+        this->count -= len;
+        if (!this->count) {
+            // starting over at the beginning keeps the next write in one piece
+            this->readPos = 0;
+            if (this->capacity > K_RING_BUFFER_KEEP_SIZE) {
+                delete[] this->buffer;
+                this->buffer = NULL;
+                this->capacity = 0;
+            }
+        } else {
+            this->readPos = (this->readPos + len) & (this->capacity - 1);
+        }
+    }
+
+    void reserve(U32 len) {
+        if (this->count + len <= this->capacity) {
+            return;
+        }
+        U32 newCapacity = this->capacity ? this->capacity : K_RING_BUFFER_MIN_SIZE;
+        while (newCapacity < this->count + len) {
+            newCapacity *= 2;
+        }
+        U8* newBuffer = new U8[newCapacity];
+        if (this->buffer) {
+            U32 todo = std::min(this->count, this->capacity - this->readPos);
+            memcpy(newBuffer, this->buffer + this->readPos, todo);
+            memcpy(newBuffer + todo, this->buffer, this->count - todo);
+            delete[] this->buffer;
+        }
+        this->buffer = newBuffer;
+        this->capacity = newCapacity;
+        this->readPos = 0;
+    }
+
+    U8* buffer;
+    U32 capacity;
+    U32 readPos;
+    U32 count;
+};
+
+#endif